@@ -28,17 +28,22 @@
 namespace Poco {
 
 
-class ArchiveCompressor;
-
-
 class Foundation_API ArchiveStrategy
 	/// The ArchiveStrategy is used by FileChannel
 	/// to rename a rotated log file for archiving.
 	///
 	/// Archived files can be automatically compressed,
-	/// using the gzip file format.
+	/// using the gzip file format. Compression is done
+	/// by the default ArchiveWorker in the background.
 {
 public:
+	enum
+	{
+		DEFAULT_COMPRESSION_LEVEL = -1, /// zlib's default level (6)
+		FAST_COMPRESSION_LEVEL    = 1,  /// fastest compression
+		BEST_COMPRESSION_LEVEL    = 9   /// best compression
+	};
+
 	ArchiveStrategy();
 	virtual ~ArchiveStrategy();
 
@@ -47,9 +52,21 @@ public:
 		/// and creates and returns a new log file.
 		/// The given LogFile object is deleted.
 
+	virtual void archiveFile(const std::string& path, const std::string& basePath);
+		/// Archives the closed log file with the given path as if it
+		/// were the log file with the given base path. Used by
+		/// FileChannel to archive rotated log files in the background,
+		/// after they have been renamed to a temporary path.
+		///
+		/// The default implementation throws a NotImplementedException.
+
 	void compress(bool flag = true);
 		/// Enables or disables compression of archived files.
 
+	void compressionLevel(int level);
+		/// Sets the zlib compression level (0 to 9, or
+		/// DEFAULT_COMPRESSION_LEVEL) for archived files.
+
 protected:
 	void moveFile(const std::string& oldName, const std::string& newName);
 	bool exists(const std::string& name);
@@ -59,7 +76,7 @@ private:
 	ArchiveStrategy& operator = (const ArchiveStrategy&);
 
 	bool _compress;
-	ArchiveCompressor* _pCompressor;
+	int  _compressionLevel;
 };
 
 
@@ -72,6 +89,7 @@ public:
 	ArchiveByNumberStrategy();
 	~ArchiveByNumberStrategy();
 	LogFile* archive(LogFile* pFile);
+	void archiveFile(const std::string& path, const std::string& basePath);
 };
 
 
@@ -96,14 +114,18 @@ public:
 	{
 		std::string path = pFile->path();
 		delete pFile;
-		std::string archPath = path;
+		archiveFile(path, path);
+		return new LogFile(path);
+	}
+
+	void archiveFile(const std::string& path, const std::string& basePath)
+	{
+		std::string archPath = basePath;
 		archPath.append(".");
 		DateTimeFormatter::append(archPath, DT().timestamp(), "%Y%m%d%H%M%S%i");
 
 		if (exists(archPath)) archiveByNumber(archPath);
-		else moveFile(path, archPath);
-
-		return new LogFile(path);
+		moveFile(path, archPath);
 	}
 
 private:
@@ -0,0 +1,114 @@
+//
+// ArchiveWorker.h
+//
+// Library: Foundation
+// Package: Logging
+// Module:  FileChannel
+//
+// Definition of the ArchiveWorker class.
+//
+// Copyright (c) 2004-2023, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef Foundation_ArchiveWorker_INCLUDED
+#define Foundation_ArchiveWorker_INCLUDED
+
+
+#include "Poco/Foundation.h"
+#include "Poco/Thread.h"
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+
+
+namespace Poco {
+
+
+class Foundation_API ArchiveWorker
+	/// An ArchiveWorker does the file system work needed for
+	/// log file rotation, like renaming, compressing and purging
+	/// archived log files, on a background thread, so that
+	/// logging threads do not have to wait for it.
+	///
+	/// Tasks are run one at a time, in the order they have been
+	/// queued. The queue has a fixed capacity. If it is full,
+	/// enqueue() does not block, but returns false, and the caller
+	/// is expected to do the work itself, after calling wait() so
+	/// that it is not done before the work already queued.
+	///
+	/// All FileChannel and ArchiveStrategy instances share the
+	/// default ArchiveWorker.
+{
+public:
+	using Task = std::function<void()>;
+
+	static const std::size_t DEFAULT_CAPACITY = 256;
+
+	explicit ArchiveWorker(std::size_t capacity = DEFAULT_CAPACITY);
+		/// Creates the ArchiveWorker with the given queue capacity.
+		/// The worker thread is started when the first task is queued.
+
+	~ArchiveWorker();
+		/// Runs all queued tasks and stops the worker thread.
+
+	bool enqueue(Task task);
+		/// Queues the given task. Returns false if the
+		/// queue is full.
+		///
+		/// Exceptions thrown by a task are reported
+		/// to the ErrorHandler.
+
+	void wait();
+		/// Waits until all queued tasks have been run.
+		///
+		/// If called from a task, returns immediately, as all
+		/// tasks queued before it have already been run.
+
+	std::size_t queued() const;
+		/// Returns the number of tasks waiting to be run.
+
+	std::size_t capacity() const;
+		/// Returns the capacity of the queue.
+
+	static ArchiveWorker& defaultWorker();
+		/// Returns a reference to the default ArchiveWorker.
+		///
+		/// The default ArchiveWorker is never destroyed. Its
+		/// worker thread ends with the process, and tasks still
+		/// queued at that time are not run.
+
+private:
+	ArchiveWorker(const ArchiveWorker&);
+	ArchiveWorker& operator = (const ArchiveWorker&);
+
+	void run();
+
+	std::size_t             _capacity;
+	std::deque<Task>        _tasks;
+	bool                    _busy;
+	bool                    _stopped;
+	Thread                  _thread;
+	mutable std::mutex      _mutex;
+	std::condition_variable _taskAvailable;
+	std::condition_variable _idle;
+};
+
+
+//
+// inlines
+//
+inline std::size_t ArchiveWorker::capacity() const
+{
+	return _capacity;
+}
+
+
+} // namespace Poco
+
+
+#endif // Foundation_ArchiveWorker_INCLUDED
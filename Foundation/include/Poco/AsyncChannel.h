@@ -20,12 +20,15 @@
 
 #include "Poco/Foundation.h"
 #include "Poco/Channel.h"
+#include "Poco/Message.h"
 #include "Poco/Thread.h"
 #include "Poco/Mutex.h"
 #include "Poco/Runnable.h"
 #include "Poco/AutoPtr.h"
 #include "Poco/NotificationQueue.h"
 #include <atomic>
+#include <condition_variable>
+#include <memory>
 
 
 namespace Poco {
@@ -40,10 +43,34 @@ class Foundation_API AsyncChannel: public Channel, public Runnable
 	///
 	/// All log messages are put into a queue and this queue is
 	/// then processed by a separate thread.
+	///
+	/// In the default "queue" mode, every message is copied into
+	/// a newly allocated notification and enqueued in a
+	/// NotificationQueue, and the messages are passed on to the
+	/// target channel one at a time.
+	///
+	/// In "ring" mode, messages are copied into the pre-allocated
+	/// slots of a fixed-size ring buffer. Logging threads claim a
+	/// slot with a single compare-and-swap, and the string buffers
+	/// of a slot are reused for later messages, so logging neither
+	/// takes a lock nor (once the buffers have grown to the typical
+	/// message size) allocates memory. The background thread takes
+	/// all available messages out of the ring and passes them on
+	/// to the target channel with a single call to
+	/// Channel::logBatch(), which, e.g., FileChannel implements
+	/// as a single write to the log file.
 {
 public:
 	using Ptr = AutoPtr<AsyncChannel>;
 
+	enum
+	{
+		DEFAULT_RING_SIZE = 8192,
+			/// Number of slots in the ring buffer if no "queueSize" is given.
+		MAX_BATCH_SIZE = 1024
+			/// Maximum number of messages passed to Channel::logBatch() at once.
+	};
+
 	AsyncChannel(Channel::Ptr pChannel = 0, Thread::Priority prio = Thread::PRIO_NORMAL);
 		/// Creates the AsyncChannel and connects it to
 		/// the given channel.
@@ -97,21 +124,51 @@ public:
 		/// removes the limit.
 		///
 		/// The "queueSize" property is set-only.
+		///
+		/// The "mode" property selects how messages are passed
+		/// to the background thread. The following values are
+		/// supported:
+		///    * queue (default)
+		///    * ring
+		///
+		/// In ring mode, the size of the ring buffer is given by
+		/// the "queueSize" property (rounded up to a power of two),
+		/// or DEFAULT_RING_SIZE if the queue size is unlimited.
+		/// If the ring buffer is full, messages are dropped as
+		/// described above.
+		///
+		/// The "mode" property is set-only and must be set
+		/// before the channel is opened.
 
 protected:
 	~AsyncChannel();
 	void run();
+	void runQueue();
+	void runRing();
 	void setPriority(const std::string& value);
+	void setMode(const std::string& value);
+	void logToRing(const Message& msg);
+	void wakeUpRing();
 
 private:
+	class MessageRing;
+
 	Channel::Ptr _pChannel;
 	Thread    _thread;
 	std::mutex _threadMutex;
 	std::mutex _channelMutex;
 	NotificationQueue _queue;
 	std::size_t _queueSize = 0;
-	std::size_t _dropCount = 0;
+	std::atomic<std::size_t> _dropCount;
 	std::atomic<bool> _closed;
+	std::atomic<bool> _running;
+	bool _ringMode = false;
+	std::unique_ptr<MessageRing> _pRing;
+	MessageBatch _batch;
+	std::atomic<bool> _ringSleeping;
+	bool _ringStop = false;
+	std::mutex _ringMutex;
+	std::condition_variable _ringCondition;
 };
 
 
@@ -0,0 +1,242 @@
+//
+// BoundedNotificationQueue.h
+//
+// Library: Foundation
+// Package: Notifications
+// Module:  BoundedNotificationQueue
+//
+// Definition of the BoundedNotificationQueue class.
+//
+// Copyright (c) 2005-2023, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef Foundation_BoundedNotificationQueue_INCLUDED
+#define Foundation_BoundedNotificationQueue_INCLUDED
+
+
+#include "Poco/Foundation.h"
+#include "Poco/Notification.h"
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <memory>
+
+
+namespace Poco {
+
+
+class Foundation_API BoundedNotificationQueue
+	/// A BoundedNotificationQueue is a fixed-capacity, lock-free
+	/// multi-producer/multi-consumer alternative to NotificationQueue.
+	///
+	/// Notifications are kept in a ring buffer in which every slot
+	/// carries a sequence number, so that producers and consumers
+	/// claim slots with a single compare-and-swap and never take a
+	/// lock as long as the queue is neither empty nor full.
+	/// Only a thread that has to wait for a notification (or, if the
+	/// queue is full, for a free slot) blocks on a condition variable,
+	/// and only then do the other threads touch the associated mutex
+	/// to wake it up.
+	///
+	/// The interface follows NotificationQueue, so that a worker
+	/// pipeline can select either implementation per queue.
+	/// Unlike NotificationQueue, a BoundedNotificationQueue does not
+	/// support urgent notifications, removal of single notifications
+	/// or dispatching to a NotificationCenter, and
+	/// enqueueNotification() waits while the queue is full.
+	///
+	/// The same shutdown sequence as for NotificationQueue applies:
+	///   1. set a termination flag for every worker thread
+	///   2. call the wakeUpAll() method
+	///   3. join each worker thread
+	///   4. destroy the notification queue.
+{
+public:
+	enum
+	{
+		DEFAULT_CAPACITY = 1024
+	};
+
+	explicit BoundedNotificationQueue(std::size_t capacity = DEFAULT_CAPACITY);
+		/// Creates the BoundedNotificationQueue with room for
+		/// (at least) the given number of notifications.
+		/// The capacity is rounded up to the next power of two.
+
+	~BoundedNotificationQueue();
+		/// Destroys the BoundedNotificationQueue, releasing all
+		/// notifications still in the queue.
+
+	void enqueueNotification(Notification::Ptr pNotification);
+		/// Enqueues the given notification by adding it to
+		/// the end of the queue (FIFO). If the queue is full,
+		/// waits until a notification has been dequeued.
+		/// The queue takes ownership of the notification, thus
+		/// a call like
+		///     notificationQueue.enqueueNotification(new MyNotification);
+		/// does not result in a memory leak.
+
+	bool tryEnqueueNotification(Notification::Ptr pNotification);
+		/// Enqueues the given notification if the queue is not full.
+		/// Returns true if the notification has been enqueued,
+		/// or false if the queue is full.
+
+	Notification* dequeueNotification();
+		/// Dequeues the next pending notification.
+		/// Returns 0 (null) if no notification is available.
+		/// The caller gains ownership of the notification and
+		/// is expected to release it when done with it.
+		///
+		/// It is highly recommended that the result is immediately
+		/// assigned to a Notification::Ptr, to avoid potential
+		/// memory management issues.
+
+	Notification* waitDequeueNotification();
+		/// Dequeues the next pending notification.
+		/// If no notification is available, waits for a notification
+		/// to be enqueued.
+		/// The caller gains ownership of the notification and
+		/// is expected to release it when done with it.
+		/// This method returns 0 (null) if wakeUpAll()
+		/// has been called by another thread.
+		///
+		/// It is highly recommended that the result is immediately
+		/// assigned to a Notification::Ptr, to avoid potential
+		/// memory management issues.
+
+	Notification* waitDequeueNotification(long milliseconds);
+		/// Dequeues the next pending notification.
+		/// If no notification is available, waits for a notification
+		/// to be enqueued up to the specified time.
+		/// Returns 0 (null) if no notification is available, or if
+		/// wakeUpAll() has been called by another thread.
+		/// The caller gains ownership of the notification and
+		/// is expected to release it when done with it.
+		///
+		/// It is highly recommended that the result is immediately
+		/// assigned to a Notification::Ptr, to avoid potential
+		/// memory management issues.
+
+	void wakeUpAll();
+		/// Wakes up all threads that wait for a notification.
+
+	bool empty() const;
+		/// Returns true iff the queue is empty.
+
+	int size() const;
+		/// Returns the number of notifications in the queue.
+		/// The result is only a snapshot if other threads
+		/// are using the queue concurrently.
+
+	std::size_t capacity() const;
+		/// Returns the maximum number of notifications in the queue.
+
+	void clear();
+		/// Removes all notifications from the queue.
+
+	bool hasIdleThreads() const;
+		/// Returns true if the queue has at least one thread waiting
+		/// for a notification.
+
+protected:
+	Notification* dequeueOne();
+	bool enqueueOne(Notification* pNotification);
+
+private:
+	BoundedNotificationQueue(const BoundedNotificationQueue&);
+	BoundedNotificationQueue& operator = (const BoundedNotificationQueue&);
+
+	struct Cell
+	{
+		std::atomic<std::size_t> sequence;
+		Notification* pNf;
+	};
+
+	class EventCount
+		/// Blocks threads waiting for a condition that is checked
+		/// without holding a lock. Notifying is a single atomic
+		/// load if no thread is waiting, or if all waiting threads
+		/// have already been signalled.
+	{
+	public:
+		EventCount();
+
+		void prepareWait();
+			/// Registers the calling thread as a waiter. The condition
+			/// must be checked again after calling prepareWait(), and
+			/// either cancelWait() or wait() must be called.
+
+		void cancelWait();
+			/// Unregisters the calling thread if the condition
+			/// has become true after prepareWait().
+
+		bool wait(long milliseconds);
+			/// Waits until signalled, or, if milliseconds is not
+			/// negative, until the timeout expires.
+			/// Returns false on timeout.
+
+		void notifyOne();
+		void notifyAll();
+
+		bool hasWaiters() const;
+
+	private:
+		static const Poco::UInt64 WAITER = Poco::UInt64(1) << 32;
+		static const Poco::UInt64 SIGNAL_MASK = WAITER - 1;
+
+		bool consumeSignal();
+		void notify(bool all);
+
+		std::atomic<Poco::UInt64> _state; // waiters << 32 | pending signals
+		std::mutex _mutex;
+		std::condition_variable _cond;
+	};
+
+	Notification* waitDequeueOne(long milliseconds);
+
+	enum
+	{
+		CACHE_LINE_SIZE = 64
+	};
+
+	std::size_t _mask;
+	std::unique_ptr<Cell[]> _cells;
+	char _pad0[CACHE_LINE_SIZE];
+	std::atomic<std::size_t> _enqueuePos;
+	char _pad1[CACHE_LINE_SIZE];
+	std::atomic<std::size_t> _dequeuePos;
+	char _pad2[CACHE_LINE_SIZE];
+	std::atomic<Poco::UInt64> _wakeUps;
+	EventCount _notEmpty;
+	EventCount _notFull;
+};
+
+
+//
+// inlines
+//
+inline std::size_t BoundedNotificationQueue::capacity() const
+{
+	return _mask + 1;
+}
+
+
+inline bool BoundedNotificationQueue::hasIdleThreads() const
+{
+	return _notEmpty.hasWaiters();
+}
+
+
+inline bool BoundedNotificationQueue::EventCount::hasWaiters() const
+{
+	return (_state.load(std::memory_order_relaxed) >> 32) > 0;
+}
+
+
+} // namespace Poco
+
+
+#endif // Foundation_BoundedNotificationQueue_INCLUDED
@@ -23,6 +23,7 @@
 #include "Poco/Mutex.h"
 #include "Poco/RefCountedObject.h"
 #include "Poco/AutoPtr.h"
+#include <vector>
 
 
 namespace Poco {
@@ -40,6 +41,7 @@ class Foundation_API Channel: public Configurable, public RefCountedObject
 {
 public:
 	using Ptr = AutoPtr<Channel>;
+	using MessageBatch = std::vector<Message>;
 
 	Channel();
 		/// Creates the channel and initializes
@@ -60,6 +62,15 @@ public:
 		/// If the channel has not been opened yet, the log()
 		/// method will open it.
 
+	virtual void logBatch(const MessageBatch& batch);
+		/// Logs all messages in the given batch to the channel,
+		/// in order.
+		///
+		/// The default implementation calls log() for every
+		/// message. Channels that can write several messages
+		/// more efficiently at once (e.g., FileChannel) override
+		/// this method. It is called by AsyncChannel in ring mode.
+
 	void setProperty(const std::string& name, const std::string& value);
 		/// Throws a PropertyNotSupportedException.
 
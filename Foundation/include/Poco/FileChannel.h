@@ -126,6 +126,21 @@ class Foundation_API FileChannel: public Channel
 	///   * true:       Compress archived log files.
 	///   * false:      Do not compress archived log files.
 	///
+	/// The zlib compression level can be set with the "compressionLevel"
+	/// property. The following values are supported:
+	///
+	///   * fast:       Fastest compression (level 1). Compresses log files
+	///                 several times faster than the default level, with
+	///                 a somewhat lower compression ratio.
+	///   * default:    zlib's default level (6). This is the default.
+	///   * best:       Best compression (level 9).
+	///   * <n>:        Compression level <n>, from 0 (no compression)
+	///                 to 9.
+	///
+	/// Compression is always done in the background, by the
+	/// default ArchiveWorker, which is shared by all FileChannel
+	/// instances.
+	///
 	/// Archived log files can be automatically purged, either if
 	/// they reach a certain age, or if the number of archived
 	/// log files reaches a given maximum number. This is
@@ -162,6 +177,25 @@ class Foundation_API FileChannel: public Channel
 	///            if it exists (unless other conditions for a rotation are met).
 	///            This is the default.
 	///
+	/// The asyncArchive property specifies whether archiving and purging
+	/// of rotated log files is done in the background. Valid values are:
+	///
+	///   * true:  When the log file is rotated, it is only renamed to
+	///            a temporary name (the log file's name, followed by
+	///            a tilde and a number), and a new log file is created.
+	///            Renaming the archived log files, and purging, is done
+	///            by the default ArchiveWorker, so a thread logging a
+	///            message never waits for a directory scan or the
+	///            renaming of archived log files. If the ArchiveWorker's
+	///            queue is full, the work is done by the logging thread.
+	///   * false: Rotated log files are archived, and archived log files
+	///            purged, by the thread logging the message that
+	///            causes the rotation. This is the default.
+	///
+	/// Rotated log files still having a temporary name, because the
+	/// process terminated before they could be archived, are archived
+	/// when the FileChannel is opened.
+	///
 	/// For a more lightweight file channel class, see SimpleFileChannel.
 {
 public:
@@ -180,6 +214,13 @@ public:
 	void log(const Message& msg);
 		/// Logs the given message to the file.
 
+	void logBatch(const MessageBatch& batch);
+		/// Logs all messages in the batch to the file
+		/// with a single write (and flush, if enabled).
+		///
+		/// Rotation is checked once per batch, so a log file
+		/// may exceed its rotation size by up to one batch.
+
 	void setProperty(const std::string& name, const std::string& value);
 		/// Sets the property with the given name.
 		///
@@ -205,6 +246,11 @@ public:
 		///                   for details.
 		///   * rotateOnOpen: Specifies whether an existing log file should be
 		///                   rotated and archived when the channel is opened.
+		///   * compressionLevel: The zlib compression level for archived
+		///                   files. See the FileChannel class for details.
+		///   * asyncArchive: Specifies whether rotated log files are archived
+		///                   and purged in the background. See the FileChannel
+		///                   class for details.
 
 	std::string getProperty(const std::string& name) const;
 		/// Returns the value of the property with the given name.
@@ -229,6 +275,8 @@ public:
 	static const std::string PROP_PURGECOUNT;
 	static const std::string PROP_FLUSH;
 	static const std::string PROP_ROTATEONOPEN;
+	static const std::string PROP_COMPRESSIONLEVEL;
+	static const std::string PROP_ASYNCARCHIVE;
 
 protected:
 	~FileChannel();
@@ -239,12 +287,32 @@ protected:
 	void setPurgeCount(const std::string& count);
 	void setFlush(const std::string& flush);
 	void setRotateOnOpen(const std::string& rotateOnOpen);
+	void setCompressionLevel(const std::string& level);
+	void setAsyncArchive(const std::string& asyncArchive);
 	void purge();
 
+	virtual LogFile* newLogFile(const std::string& path);
+		/// Creates the LogFile for the log file with the given path.
+		///
+		/// Subclasses can override this to use a
+		/// different kind of LogFile.
+
+	virtual LogFile* archive(LogFile* pFile);
+		/// Archives the given log file, using the archive strategy,
+		/// and returns the LogFile for the new, empty log file.
+		/// The given LogFile is deleted.
+		///
+		/// If asyncArchive is enabled, the log file is renamed
+		/// to a temporary name and archived in the background.
+
 private:
 	bool setNoPurge(const std::string& value);
 	int extractDigit(const std::string& value, std::string::const_iterator* nextToDigit = NULL) const;
 	void setPurgeStrategy(PurgeStrategy* strategy);
+	void rotateIfNeeded();
+	void waitForArchive();
+	void recoverArchives();
+	static int parseCompressionLevel(const std::string& level);
 	Timespan::TimeDiff extractFactor(const std::string& value, std::string::const_iterator start) const;
 
 	std::string      _path;
@@ -256,10 +324,14 @@ private:
 	std::string      _purgeCount;
 	bool             _flush;
 	bool             _rotateOnOpen;
+	std::string      _compressionLevel;
+	bool             _asyncArchive;
+	bool             _archivePending;
 	LogFile*         _pFile;
 	RotateStrategy*  _pRotateStrategy;
 	ArchiveStrategy* _pArchiveStrategy;
 	PurgeStrategy*   _pPurgeStrategy;
+	std::string      _batchText;
 	std::mutex        _mutex;
 };
 
@@ -47,6 +47,8 @@ class Foundation_API FileIOS: public virtual std::ios
 	/// On Windows platforms, UTF-8 encoded Unicode paths are correctly handled.
 {
 public:
+	using NativeHandle = FileStreamBuf::NativeHandle;
+
 	FileIOS(std::ios::openmode defaultMode);
 		/// Creates the basic stream.
 
@@ -70,6 +72,17 @@ public:
 	FileStreamBuf* rdbuf();
 		/// Returns a pointer to the underlying streambuf.
 
+	NativeHandle nativeHandle() const;
+		/// Returns the native file handle (a file descriptor on
+		/// POSIX platforms, a HANDLE on Windows) of the open file.
+		///
+		/// The handle can be used for operations not supported
+		/// by the stream interface, e.g. StreamSocket::sendFile().
+		/// It must not be closed by the caller.
+
+	Poco::UInt64 size() const;
+		/// Returns the size of the open file in bytes.
+
 protected:
 	FileStreamBuf _buf;
 	std::ios::openmode _defaultMode;
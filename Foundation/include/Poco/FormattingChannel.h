@@ -22,6 +22,7 @@
 #include "Poco/Channel.h"
 #include "Poco/Formatter.h"
 #include "Poco/AutoPtr.h"
+#include <mutex>
 
 
 namespace Poco {
@@ -70,6 +71,14 @@ public:
 		/// passes the formatted message on to the destination
 		/// Channel.
 
+	void logBatch(const MessageBatch& batch);
+		/// Formats all messages in the batch using the Formatter
+		/// and passes the formatted messages on to the destination
+		/// Channel as a single batch.
+		///
+		/// The formatted batch, and its messages, are reused
+		/// for the next batch.
+
 	void setProperty(const std::string& name, const std::string& value);
 		/// Sets or changes a configuration property.
 		///
@@ -91,6 +100,9 @@ protected:
 private:
 	Formatter::Ptr _pFormatter;
 	Channel::Ptr   _pChannel;
+	MessageBatch   _batch;
+	std::string    _batchText;
+	std::mutex     _batchMutex;
 };
 
 
@@ -34,23 +34,27 @@ namespace Poco {
 class Foundation_API LogFile: public LogFileImpl
 	/// This class is used by FileChannel to work
 	/// with a log file.
+	///
+	/// write(), size() and creationDate() are virtual, so that
+	/// subclasses like MappedLogFile can be used with the
+	/// RotateStrategy and ArchiveStrategy classes.
 {
 public:
 	LogFile(const std::string& path);
 		/// Creates the LogFile.
 
-	~LogFile();
+	virtual ~LogFile();
 		/// Destroys the LogFile.
 
-	void write(const std::string& text, bool flush = true);
+	virtual void write(const std::string& text, bool flush = true);
 		/// Writes the given text to the log file.
 		/// If flush is true, the text will be immediately
 		/// flushed to the file.
 
-	UInt64 size() const;
+	virtual UInt64 size() const;
 		/// Returns the current size in bytes of the log file.
 
-	Timestamp creationDate() const;
+	virtual Timestamp creationDate() const;
 		/// Returns the date and time the log file was created.
 
 	const std::string& path() const;
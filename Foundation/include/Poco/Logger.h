@@ -23,6 +23,7 @@
 #include "Poco/Message.h"
 #include "Poco/Format.h"
 #include "Poco/AutoPtr.h"
+#include <atomic>
 #include <map>
 #include <vector>
 #include <cstddef>
@@ -397,6 +398,9 @@ public:
 		/// Returns a reference to the Logger with the given name.
 		/// If the Logger does not yet exist, it is created, based
 		/// on its parent logger.
+		///
+		/// Looking up an existing Logger does not take a lock.
+		/// To avoid the lookup altogether, keep a LoggerHandle.
 
 	static Logger& unsafeGet(const std::string& name);
 		/// Returns a reference to the Logger with the given name.
@@ -480,7 +484,7 @@ private:
 
 	std::string _name;
 	Channel::Ptr _pChannel;
-	int         _level;
+	std::atomic<int> _level;
 
 	// definitions in Foundation.cpp
 	static LoggerMapPtr _pLoggerMap;
@@ -662,13 +666,13 @@ inline const std::string& Logger::name() const
 
 inline int Logger::getLevel() const
 {
-	return _level;
+	return _level.load(std::memory_order_relaxed);
 }
 
 
 inline void Logger::log(const std::string& text, Message::Priority prio)
 {
-	if (_level >= prio && _pChannel)
+	if (getLevel() >= prio && _pChannel)
 	{
 		_pChannel->log(Message(_name, text, prio));
 	}
@@ -677,7 +681,7 @@ inline void Logger::log(const std::string& text, Message::Priority prio)
 
 inline void Logger::log(const std::string& text, Message::Priority prio, const char* file, int line)
 {
-	if (_level >= prio && _pChannel)
+	if (getLevel() >= prio && _pChannel)
 	{
 		_pChannel->log(Message(_name, text, prio, file, line));
 	}
@@ -792,55 +796,55 @@ inline void Logger::trace(const std::string& msg, const char* file, int line)
 
 inline bool Logger::is(int level) const
 {
-	return _level >= level;
+	return getLevel() >= level;
 }
 
 
 inline bool Logger::fatal() const
 {
-	return _level >= Message::PRIO_FATAL;
+	return getLevel() >= Message::PRIO_FATAL;
 }
 
 
 inline bool Logger::critical() const
 {
-	return _level >= Message::PRIO_CRITICAL;
+	return getLevel() >= Message::PRIO_CRITICAL;
 }
 
 
 inline bool Logger::error() const
 {
-	return _level >= Message::PRIO_ERROR;
+	return getLevel() >= Message::PRIO_ERROR;
 }
 
 
 inline bool Logger::warning() const
 {
-	return _level >= Message::PRIO_WARNING;
+	return getLevel() >= Message::PRIO_WARNING;
 }
 
 
 inline bool Logger::notice() const
 {
-	return _level >= Message::PRIO_NOTICE;
+	return getLevel() >= Message::PRIO_NOTICE;
 }
 
 
 inline bool Logger::information() const
 {
-	return _level >= Message::PRIO_INFORMATION;
+	return getLevel() >= Message::PRIO_INFORMATION;
 }
 
 
 inline bool Logger::debug() const
 {
-	return _level >= Message::PRIO_DEBUG;
+	return getLevel() >= Message::PRIO_DEBUG;
 }
 
 
 inline bool Logger::trace() const
 {
-	return _level >= Message::PRIO_TRACE;
+	return getLevel() >= Message::PRIO_TRACE;
 }
 
 
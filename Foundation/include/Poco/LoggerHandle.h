@@ -0,0 +1,202 @@
+//
+// LoggerHandle.h
+//
+// Library: Foundation
+// Package: Logging
+// Module:  Logger
+//
+// Definition of the LoggerHandle class.
+//
+// Copyright (c) 2004-2023, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef Foundation_LoggerHandle_INCLUDED
+#define Foundation_LoggerHandle_INCLUDED
+
+
+#include "Poco/Foundation.h"
+#include "Poco/Logger.h"
+
+
+namespace Poco {
+
+
+class LoggerHandle
+	/// A LoggerHandle looks up a Logger once, when it is
+	/// created, and then gives direct access to it.
+	///
+	/// Checking whether a message with a given priority would
+	/// be logged, e.g. with debug(), is a single relaxed atomic load
+	/// of the Logger's level, so disabled log statements cost next
+	/// to nothing, even in hot code paths:
+	///
+	///     class RequestHandler
+	///     {
+	///     public:
+	///         RequestHandler(): _logger("RequestHandler")
+	///         {
+	///         }
+	///
+	///         void handle()
+	///         {
+	///             poco_debug(*_logger, "handling request");
+	///             ...
+	///         }
+	///
+	///     private:
+	///         Poco::LoggerHandle _logger;
+	///     };
+	///
+	/// Changes to the Logger's level and channel are seen by
+	/// the handle. The handle holds a reference to the Logger,
+	/// so it remains valid after the Logger has been removed
+	/// with Logger::destroy() or Logger::shutdown().
+	///
+	/// A LoggerHandle should not have static storage duration
+	/// at namespace scope, as it would look up the Logger during
+	/// static initialization.
+{
+public:
+	explicit LoggerHandle(const std::string& name);
+		/// Creates the LoggerHandle for the Logger with the given name.
+		/// If the Logger does not yet exist, it is created.
+
+	explicit LoggerHandle(Logger& logger);
+		/// Creates the LoggerHandle for the given Logger.
+
+	Logger& logger() const;
+		/// Returns a reference to the Logger.
+
+	Logger& operator * () const;
+		/// Returns a reference to the Logger.
+
+	Logger* operator -> () const;
+		/// Returns a pointer to the Logger.
+
+	bool is(int level) const;
+		/// Returns true if at least the given log level is set.
+
+	bool fatal() const;
+		/// Returns true if the log level is at least PRIO_FATAL.
+
+	bool critical() const;
+		/// Returns true if the log level is at least PRIO_CRITICAL.
+
+	bool error() const;
+		/// Returns true if the log level is at least PRIO_ERROR.
+
+	bool warning() const;
+		/// Returns true if the log level is at least PRIO_WARNING.
+
+	bool notice() const;
+		/// Returns true if the log level is at least PRIO_NOTICE.
+
+	bool information() const;
+		/// Returns true if the log level is at least PRIO_INFORMATION.
+
+	bool debug() const;
+		/// Returns true if the log level is at least PRIO_DEBUG.
+
+	bool trace() const;
+		/// Returns true if the log level is at least PRIO_TRACE.
+
+private:
+	mutable Logger::Ptr _pLogger;
+};
+
+
+//
+// inlines
+//
+inline LoggerHandle::LoggerHandle(const std::string& name):
+	_pLogger(&Logger::get(name), true)
+{
+}
+
+
+inline LoggerHandle::LoggerHandle(Logger& logger):
+	_pLogger(&logger, true)
+{
+}
+
+
+inline Logger& LoggerHandle::logger() const
+{
+	return *_pLogger;
+}
+
+
+inline Logger& LoggerHandle::operator * () const
+{
+	return *_pLogger;
+}
+
+
+inline Logger* LoggerHandle::operator -> () const
+{
+	return _pLogger.get();
+}
+
+
+inline bool LoggerHandle::is(int level) const
+{
+	return _pLogger->is(level);
+}
+
+
+inline bool LoggerHandle::fatal() const
+{
+	return _pLogger->fatal();
+}
+
+
+inline bool LoggerHandle::critical() const
+{
+	return _pLogger->critical();
+}
+
+
+inline bool LoggerHandle::error() const
+{
+	return _pLogger->error();
+}
+
+
+inline bool LoggerHandle::warning() const
+{
+	return _pLogger->warning();
+}
+
+
+inline bool LoggerHandle::notice() const
+{
+	return _pLogger->notice();
+}
+
+
+inline bool LoggerHandle::information() const
+{
+	return _pLogger->information();
+}
+
+
+inline bool LoggerHandle::debug() const
+{
+	return _pLogger->debug();
+}
+
+
+inline bool LoggerHandle::trace() const
+{
+	return _pLogger->trace();
+}
+
+
+} // namespace Poco
+
+
+#endif // Foundation_LoggerHandle_INCLUDED
@@ -0,0 +1,105 @@
+//
+// MappedFileChannel.h
+//
+// Library: Foundation
+// Package: Logging
+// Module:  MappedFileChannel
+//
+// Definition of the MappedFileChannel class.
+//
+// Copyright (c) 2004-2023, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef Foundation_MappedFileChannel_INCLUDED
+#define Foundation_MappedFileChannel_INCLUDED
+
+
+#include "Poco/Foundation.h"
+#include "Poco/FileChannel.h"
+#include <mutex>
+
+
+namespace Poco {
+
+
+class Foundation_API MappedFileChannel: public FileChannel
+	/// A FileChannel that writes to a memory-mapped log file.
+	///
+	/// The log file is extended in segments of a fixed size and
+	/// mapped into memory (see MappedLogFile), so logging a message
+	/// just copies its text into the mapping, without a system call.
+	/// The mapping is synced to disk at a configurable interval.
+	///
+	/// Rotation, archiving and purging work as described
+	/// for the FileChannel, and are configured with the same
+	/// properties. If no rotation is set, the log file is
+	/// rotated when a segment is full.
+	///
+	/// In addition to the properties of the FileChannel, the
+	/// following properties are supported:
+	///
+	///   * segmentSize:  The size the log file is extended by when full,
+	///                   in bytes, or with a K (kilobytes) or M (megabytes)
+	///                   suffix. The default is 4M.
+	///   * syncInterval: The interval, in milliseconds, at which the
+	///                   mapping is synced to disk. A message written
+	///                   before a sync will not be lost even if the system
+	///                   crashes. If the interval is 0, the mapping is synced
+	///                   after every message. The default is 1000.
+	///                   The sync happens at the first message logged after
+	///                   the interval has elapsed, and when the channel is closed.
+	///
+	/// The flush property defaults to false for this channel.
+	/// If set to true, the mapping is synced after every message.
+	///
+	/// Messages written, but not synced, survive a crash of the
+	/// process, but not necessarily a crash of the operating system.
+{
+public:
+	MappedFileChannel();
+		/// Creates the MappedFileChannel.
+
+	MappedFileChannel(const std::string& path);
+		/// Creates the MappedFileChannel for a file with the given path.
+
+	void setProperty(const std::string& name, const std::string& value);
+		/// Sets the property with the given name.
+		///
+		/// See the MappedFileChannel and FileChannel classes
+		/// for the supported properties.
+
+	std::string getProperty(const std::string& name) const;
+		/// Returns the value of the property with the given name.
+		/// See setProperty() for a description of the supported
+		/// properties.
+
+	static const std::string PROP_SEGMENTSIZE;
+	static const std::string PROP_SYNCINTERVAL;
+
+	static const UInt64 DEFAULT_SEGMENT_SIZE = 4*1024*1024;
+	static const int DEFAULT_SYNC_INTERVAL = 1000;
+
+protected:
+	~MappedFileChannel();
+	LogFile* newLogFile(const std::string& path);
+	LogFile* archive(LogFile* pFile);
+	void setSegmentSize(const std::string& size);
+	void setSyncInterval(const std::string& interval);
+
+private:
+	UInt64             _segmentSize;
+	std::string        _segmentSizeValue;
+	Timespan           _syncInterval;
+	bool               _rotateBySegment;
+	mutable std::mutex _mutex;
+};
+
+
+} // namespace Poco
+
+
+#endif // Foundation_MappedFileChannel_INCLUDED
@@ -0,0 +1,116 @@
+//
+// MappedLogFile.h
+//
+// Library: Foundation
+// Package: Logging
+// Module:  MappedLogFile
+//
+// Definition of the MappedLogFile class.
+//
+// Copyright (c) 2004-2023, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef Foundation_MappedLogFile_INCLUDED
+#define Foundation_MappedLogFile_INCLUDED
+
+
+#include "Poco/Foundation.h"
+#include "Poco/LogFile.h"
+#include "Poco/SharedMemory.h"
+#include "Poco/Timestamp.h"
+#include "Poco/Timespan.h"
+
+
+namespace Poco {
+
+
+class Foundation_API MappedLogFile: public LogFile
+	/// This class is used by MappedFileChannel to work
+	/// with a memory-mapped log file.
+	///
+	/// The file is extended to a multiple of the segment size
+	/// and mapped into memory. Writing a message copies its text,
+	/// followed by a newline, into the mapping. When the mapping
+	/// is full, the file is extended by another segment and mapped again.
+	///
+	/// Modified pages are written to the file by the operating system
+	/// at its own discretion, so messages survive a crash of the
+	/// process, but not necessarily of the system. To survive the
+	/// latter, the mapping is synced (written to the file, waiting
+	/// until this has been done) whenever write() is called with flush set,
+	/// and at the first write after the sync interval has elapsed.
+	///
+	/// Disk space for the file is allocated before it is mapped
+	/// (using posix_fallocate(), where available), so that a full disk
+	/// results in a FileException instead of a SIGBUS signal.
+	///
+	/// When the MappedLogFile is destroyed, the file is truncated
+	/// to the size of the text written. If the process crashes,
+	/// the file keeps its trailing zero bytes; these are
+	/// skipped when the file is opened again.
+{
+public:
+	MappedLogFile(const std::string& path, UInt64 segmentSize, const Timespan& syncInterval);
+		/// Creates the MappedLogFile for the file with the given path,
+		/// which is created if it does not exist. New text is appended
+		/// to existing text.
+		///
+		/// Throws a NotImplementedException if memory-mapped files
+		/// are not supported on the platform.
+
+	~MappedLogFile();
+		/// Syncs and unmaps the file and truncates it to
+		/// the size of the text written.
+
+	void write(const std::string& text, bool flush = true);
+		/// Copies the given text, followed by a newline, to the file.
+		/// If flush is true, or the sync interval has elapsed since the
+		/// last sync, the mapping is synced.
+
+	void sync();
+		/// Writes all modified pages to the file and waits until
+		/// they have been written.
+
+	UInt64 size() const;
+		/// Returns the size in bytes of the text in the log file.
+
+	UInt64 capacity() const;
+		/// Returns the size in bytes of the mapped file.
+
+private:
+	void map(UInt64 capacity);
+	void reserve(UInt64 capacity);
+	void unmap();
+
+	UInt64       _segmentSize;
+	Timespan     _syncInterval;
+	SharedMemory _memory;
+	UInt64       _size;
+	UInt64       _capacity;
+	Timestamp    _lastSync;
+};
+
+
+//
+// inlines
+//
+inline UInt64 MappedLogFile::size() const
+{
+	return _size;
+}
+
+
+inline UInt64 MappedLogFile::capacity() const
+{
+	return _capacity;
+}
+
+
+} // namespace Poco
+
+
+#endif // Foundation_MappedLogFile_INCLUDED
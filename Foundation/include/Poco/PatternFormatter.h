@@ -21,6 +21,7 @@
 #include "Poco/Foundation.h"
 #include "Poco/Formatter.h"
 #include "Poco/Message.h"
+#include "Poco/DateTime.h"
 #include <vector>
 
 
@@ -76,6 +77,29 @@ class Foundation_API PatternFormatter: public Formatter
 	///   * %v[width] - the message source (%s) but text length is padded/cropped to 'width'
 	///   * %[name] - the value of the message parameter with the given name
 	///   * %% - percent sign
+	///
+	/// If the "compiled" property is set to "true", the pattern is
+	/// compiled into a sequence of writers that append to the result.
+	/// All date/time fields with a resolution of one second or
+	/// coarser, together with the text between them, are rendered
+	/// only once per second and cached (per thread), so that
+	/// only the sub-second fields (%i, %c, %F) and the message
+	/// fields have to be formatted for every message. The host name
+	/// (%N) is determined once, when the pattern is compiled.
+	///
+	/// If the "output" property is set to "json", every message is
+	/// formatted as a JSON object, always using the compiled
+	/// pattern. Text outside of specifiers is not written, except for
+	/// the text between date/time specifiers, which are combined into
+	/// a single "timestamp" string member. The other specifiers become
+	/// members named "source" (%s, %v), "text" (%t), "level" (%l),
+	/// "priority" (%p, %q), "pid" (%P), "thread" (%T), "tid" (%I),
+	/// "ostid" (%J), "node" (%N), "file" (%U, %O) and "line" (%u).
+	/// The value of %[name] becomes a member with the given name.
+	/// For example, the pattern
+	///     %Y-%m-%d %H:%M:%S.%i [%p] %s: %t
+	/// results in
+	///     {"timestamp":"2005-01-01 14:30:15.500","priority":"Error","source":"TestSource","text":"Test message text"}
 
 {
 public:
@@ -108,6 +132,10 @@ public:
 		///       or taken as they are in UTC. Supported values are "local" and "UTC".
 		///     * priorityNames: Provide a comma-separated list of custom priority names,
 		///       e.g. "Fatal, Critical, Error, Warning, Notice, Information, Debug, Trace"
+		///     * compiled: Specifies whether the compiled pattern with cached
+		///       date/time rendering is used. Supported values are "true" and "false" (default).
+		///     * output: Specifies the output format. Supported values are
+		///       "text" (default) and "json".
 		///
 		/// If any other property name is given, a PropertyNotSupported
 		/// exception is thrown.
@@ -120,6 +148,8 @@ public:
 	static const std::string PROP_PATTERN;
 	static const std::string PROP_TIMES;
 	static const std::string PROP_PRIORITY_NAMES;
+	static const std::string PROP_COMPILED;
+	static const std::string PROP_OUTPUT;
 
 protected:
 	const std::string& getPriorityName(int);
@@ -138,16 +168,52 @@ private:
 		std::string prepend;
 	};
 
+	struct CompiledAction
+	{
+		enum Type
+		{
+			LITERAL, /// writes text
+			CACHED,  /// writes the cached rendering of actions
+			FIELD    /// writes the field given by action
+		};
+
+		CompiledAction(): type(LITERAL), json(false), localTime(false), slot(0)
+		{
+		}
+
+		Type type;
+		bool json;
+		bool localTime;
+		std::size_t slot;
+		std::string text;
+		PatternAction action;
+		std::vector<PatternAction> actions;
+	};
+
 	void parsePattern();
 		/// Will parse the _pattern string into the vector of PatternActions,
 		/// which contains the message key, any text that needs to be written first
 		/// a property in case of %[] and required length.
 
+	void compilePattern();
+		/// Compiles the vector of PatternActions into the vector
+		/// of CompiledActions used by formatCompiled().
+
+	void formatCompiled(const Message& msg, std::string& text);
+	bool appendMessageField(const PatternAction& pa, const Message& msg, std::string& text);
+	void appendTimeField(char key, const Message& msg, const DateTime& dateTime, bool localTime, std::string& text);
+	void addLiteral(const std::string& text);
+	void addCached(const PatternAction& pa, bool localTime);
 	void parsePriorityNames();
 
 	static const std::string DEFAULT_PRIORITY_NAMES;
 
 	std::vector<PatternAction> _patternActions;
+	std::vector<CompiledAction> _compiledActions;
+	std::size_t _cachedCount;
+	Poco::UInt64 _generation;
+	bool _compiled;
+	bool _json;
 	bool _localTime;
 	std::string _pattern;
 	std::string _priorityNames;
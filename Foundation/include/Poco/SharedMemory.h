@@ -92,6 +92,11 @@ public:
 		/// Returns the one-past-end end address of the shared memory segment.
 		/// Will be NULL for illegal segments.
 
+	void flush();
+		/// Writes all modified pages of a shared memory segment that
+		/// maps a file to the file, and waits until they have been
+		/// written. Does nothing for other segments.
+
 private:
 	SharedMemoryImpl* _pImpl;
 };
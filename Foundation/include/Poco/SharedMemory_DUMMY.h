@@ -56,6 +56,9 @@ public:
 	char* end() const;
 		/// Returns the one-past-end end address of the shared memory segment.
 
+	void flush();
+		/// Writes all modified pages of a file mapping to the file.
+
 protected:
 	~SharedMemoryImpl();
 		/// Destroys the SharedMemoryImpl.
@@ -82,6 +85,11 @@ inline char* SharedMemoryImpl::end() const
 }
 
 
+inline void SharedMemoryImpl::flush()
+{
+}
+
+
 } // namespace Poco
 
 
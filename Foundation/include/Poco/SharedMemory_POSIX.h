@@ -58,6 +58,9 @@ public:
 	char* end() const;
 		/// Returns the one-past-end end address of the shared memory segment.
 
+	void flush();
+		/// Writes all modified pages of a file mapping to the file.
+
 protected:
 	void map(const void* addrHint);
 		/// Maps the shared memory object.
@@ -55,6 +55,9 @@ public:
 	char* end() const;
 		/// Points past the last byte of the end address of the SharedMemory segment. Will be null for illegal segments.
 
+	void flush();
+		/// Writes all modified pages of a file mapping to the file.
+
 protected:
 	void map();
 		/// Maps the shared memory object.
@@ -32,6 +32,7 @@ namespace Poco {
 
 class Notification;
 class ThreadPool;
+class WorkStealingExecutor;
 class Exception;
 
 
@@ -62,12 +63,22 @@ public:
 		/// given ThreadPool (should be used
 		/// by this TaskManager exclusively).
 
+	TaskManager(WorkStealingExecutor& executor);
+		/// Creates the TaskManager, using the
+		/// given WorkStealingExecutor (should be used
+		/// by this TaskManager exclusively).
+		///
+		/// Tasks are queued by the executor if all its
+		/// worker threads are busy, instead of failing with
+		/// a NoThreadAvailableException.
+
 	~TaskManager();
 		/// Destroys the TaskManager.
 
 	void start(Task* pTask);
 		/// Starts the given task in a thread obtained
-		/// from the thread pool.
+		/// from the thread pool, or queues it for execution
+		/// by the executor.
 		///
 		/// The TaskManager takes ownership of the Task object
 		/// and deletes it when it it finished.
@@ -117,8 +128,9 @@ private:
 	using MutexT = FastMutex;
 	using ScopedLockT = MutexT::ScopedLock;
 
-	ThreadPool&        _threadPool;
-	bool               _ownPool;
+	ThreadPool*           _pThreadPool;
+	WorkStealingExecutor* _pExecutor;
+	bool                  _ownPool;
 	TaskList           _taskList;
 	Timestamp          _lastProgressNotification;
 	NotificationCenter _nc;
@@ -0,0 +1,219 @@
+//
+// WorkStealingExecutor.h
+//
+// Library: Foundation
+// Package: Threading
+// Module:  WorkStealingExecutor
+//
+// Definition of the WorkStealingExecutor class.
+//
+// Copyright (c) 2005-2023, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef Foundation_WorkStealingExecutor_INCLUDED
+#define Foundation_WorkStealingExecutor_INCLUDED
+
+
+#include "Poco/Foundation.h"
+#include "Poco/Thread.h"
+#include "Poco/ActiveRunnable.h"
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+
+namespace Poco {
+
+
+class Runnable;
+
+
+class Foundation_API WorkStealingExecutor
+	/// A WorkStealingExecutor runs tasks on a fixed number of
+	/// worker threads.
+	///
+	/// Unlike ThreadPool, which needs an idle thread for every
+	/// start() call and throws a NoThreadAvailableException if all
+	/// threads are busy, a WorkStealingExecutor queues tasks, so
+	/// submitting a task never blocks and never fails (except for
+	/// running out of memory).
+	///
+	/// Every worker thread has its own task queue. Tasks submitted
+	/// by a worker thread are added to the worker's own queue and
+	/// are run by that worker in last-in, first-out order, which keeps
+	/// their data in the worker's CPU cache. Tasks submitted by other
+	/// threads are added to a shared injection queue. A worker that
+	/// has run out of work takes tasks from the injection queue, or
+	/// steals the oldest task from the queue of a randomly chosen
+	/// other worker. Only workers without any work block.
+	///
+	/// A WorkStealingExecutor can be used instead of a ThreadPool
+	/// with TaskManager and TCPServer, and for ActiveMethod with the
+	/// WorkStealingStarter policy.
+	///
+	/// Note that tasks should not block for extended periods of
+	/// time, as every blocked task occupies a worker thread.
+{
+public:
+	using Task = std::function<void()>;
+
+	struct Statistics
+	{
+		Poco::UInt64 submitted = 0; /// Number of tasks submitted.
+		Poco::UInt64 completed = 0; /// Number of tasks completed.
+		Poco::UInt64 steals = 0;    /// Number of tasks taken from another worker's queue.
+		std::size_t  queued = 0;    /// Number of tasks waiting to be run.
+		int          idle = 0;      /// Number of idle worker threads.
+	};
+
+	explicit WorkStealingExecutor(int threads = 0, int stackSize = POCO_THREAD_STACK_SIZE);
+		/// Creates a WorkStealingExecutor with the given number of
+		/// worker threads, or one worker thread per processor if
+		/// threads is 0.
+
+	WorkStealingExecutor(const std::string& name, int threads = 0, int stackSize = POCO_THREAD_STACK_SIZE);
+		/// Creates a WorkStealingExecutor with the given name and number
+		/// of worker threads, or one worker thread per processor if
+		/// threads is 0. Worker threads are named after the executor.
+
+	~WorkStealingExecutor();
+		/// Waits for all submitted tasks to complete and stops
+		/// the worker threads.
+
+	void start(Runnable& target);
+		/// Queues the given target for execution.
+		///
+		/// The target must remain valid until its run() method
+		/// has returned.
+
+	void startFunc(Task task);
+		/// Queues the given function for execution.
+
+	void joinAll();
+		/// Waits until all submitted tasks, including tasks
+		/// submitted while waiting, have completed.
+		///
+		/// Must not be called from a task running on this executor.
+
+	void stopAll();
+		/// Waits for all submitted tasks to complete and stops
+		/// the worker threads. Tasks submitted after calling
+		/// stopAll() are rejected with an IllegalStateException.
+
+	int threads() const;
+		/// Returns the number of worker threads.
+
+	std::size_t queueDepth() const;
+		/// Returns the number of tasks waiting to be run.
+
+	Poco::UInt64 steals() const;
+		/// Returns the number of tasks that have been
+		/// stolen from another worker's queue.
+
+	Statistics statistics() const;
+		/// Returns the executor's statistics.
+
+	const std::string& name() const;
+		/// Returns the name of the executor,
+		/// or an empty string if no name has been
+		/// specified in the constructor.
+
+	static WorkStealingExecutor& defaultExecutor();
+		/// Returns a reference to the default executor,
+		/// which has one worker thread per processor.
+
+protected:
+	class Worker;
+
+	void init(int threads, int stackSize);
+	void submit(Task&& task);
+	bool takeTask(Worker& worker, Task& task);
+	bool stealTask(Worker& worker, Task& task);
+	void runTask(Task& task);
+	void work(Worker& worker);
+	void wakeUp();
+
+private:
+	WorkStealingExecutor(const WorkStealingExecutor&);
+	WorkStealingExecutor& operator = (const WorkStealingExecutor&);
+
+	std::string _name;
+	std::vector<std::unique_ptr<Worker>> _workers;
+	std::mutex _injectionMutex;
+	std::deque<Task> _injectionQueue;
+	std::atomic<std::size_t> _queued;
+	std::atomic<Poco::UInt64> _submitted;
+	std::atomic<Poco::UInt64> _completed;
+	std::atomic<Poco::UInt64> _steals;
+	std::atomic<Poco::UInt64> _pending;
+	std::atomic<int> _idle;
+	std::atomic<bool> _stopped;
+	Poco::UInt64 _wakeUps;
+	std::mutex _idleMutex;
+	std::condition_variable _idleCondition;
+	std::mutex _doneMutex;
+	std::condition_variable _doneCondition;
+};
+
+
+template <class OwnerType>
+class WorkStealingStarter
+	/// A StarterType policy for ActiveMethod that runs the
+	/// method on the default WorkStealingExecutor.
+{
+public:
+	static void start(OwnerType* /*pOwner*/, ActiveRunnableBase::Ptr pRunnable)
+	{
+		pRunnable->duplicate(); // The runnable will release itself.
+		try
+		{
+			WorkStealingExecutor::defaultExecutor().start(*pRunnable);
+		}
+		catch (...)
+		{
+			pRunnable->release();
+			throw;
+		}
+	}
+};
+
+
+//
+// inlines
+//
+inline int WorkStealingExecutor::threads() const
+{
+	return static_cast<int>(_workers.size());
+}
+
+
+inline std::size_t WorkStealingExecutor::queueDepth() const
+{
+	return _queued.load(std::memory_order_relaxed);
+}
+
+
+inline Poco::UInt64 WorkStealingExecutor::steals() const
+{
+	return _steals.load(std::memory_order_relaxed);
+}
+
+
+inline const std::string& WorkStealingExecutor::name() const
+{
+	return _name;
+}
+
+
+} // namespace Poco
+
+
+#endif // Foundation_WorkStealingExecutor_INCLUDED
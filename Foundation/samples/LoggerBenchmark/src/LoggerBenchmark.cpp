@@ -0,0 +1,99 @@
+//
+// LoggerBenchmark.cpp
+//
+// This sample measures the cost of disabled debug log statements,
+// with the Logger looked up by name for every statement, and with
+// a LoggerHandle, using an increasing number of threads.
+//
+// Copyright (c) 2005-2023, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "Poco/Logger.h"
+#include "Poco/LoggerHandle.h"
+#include "Poco/ConsoleChannel.h"
+#include "Poco/AutoPtr.h"
+#include "Poco/Stopwatch.h"
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <thread>
+#include <cstdlib>
+
+
+using Poco::Logger;
+using Poco::LoggerHandle;
+using Poco::ConsoleChannel;
+using Poco::AutoPtr;
+using Poco::Stopwatch;
+
+
+namespace
+{
+	template <typename F>
+	double run(int threads, int iterations, F func)
+		/// Calls func(iterations) on the given number of threads
+		/// and returns the number of iterations per second.
+	{
+		Stopwatch sw;
+		sw.start();
+		std::vector<std::thread> threadVec;
+		for (int i = 0; i < threads; ++i)
+		{
+			threadVec.emplace_back([&func, iterations]() { func(iterations); });
+		}
+		for (auto& t: threadVec) t.join();
+		sw.stop();
+
+		return double(threads)*iterations/(sw.elapsed()/1000000.0);
+	}
+}
+
+
+int main(int argc, char** argv)
+{
+	int iterations = argc > 1 ? std::atoi(argv[1]) : 1000000;
+
+	AutoPtr<ConsoleChannel> pChannel = new ConsoleChannel;
+	Logger::root().setChannel(pChannel);
+	Logger::root().setLevel(Poco::Message::PRIO_INFORMATION);
+	for (int i = 0; i < 100; ++i)
+	{
+		Logger::get("Benchmark.Logger" + std::to_string(i));
+	}
+
+	const std::string name("Benchmark.Logger42");
+	const std::string text("request handled");
+
+	std::cout << std::setw(8) << "threads"
+		<< std::setw(26) << "Logger::get().debug()"
+		<< std::setw(26) << "LoggerHandle->debug()" << std::endl;
+
+	const int threadCounts[] = {1, 2, 4, 8, 16};
+	for (int threads: threadCounts)
+	{
+		double byName = run(threads, iterations, [&name, &text](int n)
+		{
+			for (int i = 0; i < n; ++i)
+			{
+				Logger::get(name).debug(text);
+			}
+		});
+		double byHandle = run(threads, iterations, [&name, &text](int n)
+		{
+			LoggerHandle logger(name);
+			for (int i = 0; i < n; ++i)
+			{
+				logger->debug(text);
+			}
+		});
+		std::cout << std::setw(8) << threads
+			<< std::setw(18) << static_cast<long>(byName) << " calls/s"
+			<< std::setw(18) << static_cast<long>(byHandle) << " calls/s" << std::endl;
+	}
+	return 0;
+}
@@ -0,0 +1,111 @@
+//
+// NotificationQueueBenchmark.cpp
+//
+// This sample measures the throughput of NotificationQueue and
+// BoundedNotificationQueue with an increasing number of producer
+// and consumer threads.
+//
+// Copyright (c) 2005-2023, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "Poco/NotificationQueue.h"
+#include "Poco/BoundedNotificationQueue.h"
+#include "Poco/Notification.h"
+#include "Poco/Stopwatch.h"
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <cstdlib>
+
+
+using Poco::NotificationQueue;
+using Poco::BoundedNotificationQueue;
+using Poco::Notification;
+using Poco::Stopwatch;
+
+
+namespace
+{
+	class StopNotification: public Notification
+	{
+	};
+
+	template <typename Q>
+	double run(Q& queue, int threads, int messages)
+		/// Runs threads/2 producers and threads/2 consumers, each
+		/// producer enqueueing messages notifications, and returns
+		/// the number of notifications passed per second.
+	{
+		int producers = threads/2;
+		int consumers = threads - producers;
+		std::atomic<long> received(0);
+
+		Stopwatch sw;
+		sw.start();
+		std::vector<std::thread> consumerThreads;
+		for (int i = 0; i < consumers; ++i)
+		{
+			consumerThreads.emplace_back([&queue, &received]()
+			{
+				long n = 0;
+				for (;;)
+				{
+					Notification::Ptr pNf = queue.waitDequeueNotification();
+					if (!pNf || pNf.template cast<StopNotification>()) break;
+					++n;
+				}
+				received += n;
+			});
+		}
+		std::vector<std::thread> producerThreads;
+		for (int i = 0; i < producers; ++i)
+		{
+			producerThreads.emplace_back([&queue, messages]()
+			{
+				Notification::Ptr pNf = new Notification;
+				for (int k = 0; k < messages; ++k)
+				{
+					queue.enqueueNotification(pNf);
+				}
+			});
+		}
+		for (auto& t: producerThreads) t.join();
+		for (int i = 0; i < consumers; ++i) queue.enqueueNotification(new StopNotification);
+		for (auto& t: consumerThreads) t.join();
+		sw.stop();
+
+		if (received != long(producers)*messages) std::cerr << "lost notifications!" << std::endl;
+		return received/(sw.elapsed()/1000000.0);
+	}
+}
+
+
+int main(int argc, char** argv)
+{
+	int messages = argc > 1 ? std::atoi(argv[1]) : 100000;
+
+	std::cout << std::setw(8) << "threads"
+		<< std::setw(22) << "NotificationQueue"
+		<< std::setw(28) << "BoundedNotificationQueue" << std::endl;
+
+	const int threadCounts[] = {2, 4, 8, 16, 32, 64};
+	for (int threads: threadCounts)
+	{
+		int perProducer = messages/(threads/2);
+		NotificationQueue queue;
+		double locked = run(queue, threads, perProducer);
+		BoundedNotificationQueue boundedQueue;
+		double lockFree = run(boundedQueue, threads, perProducer);
+		std::cout << std::setw(8) << threads
+			<< std::setw(16) << static_cast<long>(locked) << " nf/s"
+			<< std::setw(22) << static_cast<long>(lockFree) << " nf/s" << std::endl;
+	}
+	return 0;
+}
@@ -19,36 +19,18 @@
 #include "Poco/DeflatingStream.h"
 #include "Poco/StreamCopier.h"
 #include "Poco/Exception.h"
-#include "Poco/ActiveDispatcher.h"
-#include "Poco/ActiveMethod.h"
-#include "Poco/Void.h"
 #include "Poco/FileStream.h"
+#include "Poco/ArchiveWorker.h"
 
 
 namespace Poco {
 
 
-//
-// ArchiveCompressor
-//
-
-
-class ArchiveCompressor: public ActiveDispatcher
+namespace
 {
-public:
-	ArchiveCompressor():
-		compress(this, &ArchiveCompressor::compressImpl)
-	{
-	}
-
-	~ArchiveCompressor()
-	{
-	}
-
-	ActiveMethod<void, std::string, ArchiveCompressor, ActiveStarter<ActiveDispatcher>> compress;
-
-protected:
-	void compressImpl(const std::string& path)
+	void compressFile(const std::string& path, int level)
+		/// Compresses the given file to a gzip file and
+		/// removes the original file.
 	{
 		std::string gzPath(path);
 		gzPath.append(".gz");
@@ -56,7 +38,7 @@ protected:
 		FileOutputStream ostr(gzPath);
 		try
 		{
-			DeflatingOutputStream deflater(ostr, DeflatingStreamBuf::STREAM_GZIP);
+			DeflatingOutputStream deflater(ostr, DeflatingStreamBuf::STREAM_GZIP, level);
 			StreamCopier::copyStream(istr, deflater);
 			if (!deflater.good() || !ostr.good()) throw WriteFileException(gzPath);
 			deflater.close();
@@ -73,9 +55,8 @@ protected:
 		}
 		File f(path);
 		f.remove();
-		return;
 	}
-};
+}
 
 
 //
@@ -85,14 +66,19 @@ protected:
 
 ArchiveStrategy::ArchiveStrategy():
 	_compress(false),
-	_pCompressor(0)
+	_compressionLevel(DEFAULT_COMPRESSION_LEVEL)
 {
 }
 
 
 ArchiveStrategy::~ArchiveStrategy()
 {
-	delete _pCompressor;
+}
+
+
+void ArchiveStrategy::archiveFile(const std::string& path, const std::string& /*basePath*/)
+{
+	throw NotImplementedException("archiveFile", path);
 }
 
 
@@ -102,6 +88,15 @@ void ArchiveStrategy::compress(bool flag)
 }
 
 
+void ArchiveStrategy::compressionLevel(int level)
+{
+	if (level < DEFAULT_COMPRESSION_LEVEL || level > 9)
+		throw InvalidArgumentException("compression level", NumberFormatter::format(level));
+
+	_compressionLevel = level;
+}
+
+
 void ArchiveStrategy::moveFile(const std::string& oldPath, const std::string& newPath)
 {
 	bool compressed = false;
@@ -122,8 +117,14 @@ void ArchiveStrategy::moveFile(const std::string& oldPath, const std::string& ne
 	else
 	{
 		f.renameTo(newPath);
-		if (!_pCompressor) _pCompressor = new ArchiveCompressor;
-		_pCompressor->compress(newPath);
+		int level = _compressionLevel;
+		ArchiveWorker& worker = ArchiveWorker::defaultWorker();
+		if (!worker.enqueue([newPath, level]() { compressFile(newPath, level); }))
+		{
+			// does not block if we are running on the worker thread
+			worker.wait();
+			compressFile(newPath, level);
+		}
 	}
 }
 
@@ -165,21 +166,29 @@ LogFile* ArchiveByNumberStrategy::archive(LogFile* pFile)
 {
 	std::string basePath = pFile->path();
 	delete pFile;
+	archiveFile(basePath, basePath);
+	return new LogFile(basePath);
+}
+
+
+void ArchiveByNumberStrategy::archiveFile(const std::string& path, const std::string& basePath)
+{
 	int n = -1;
-	std::string path;
+	std::string archPath;
 	do
 	{
-		path = basePath;
-		path.append(".");
-		NumberFormatter::append(path, ++n);
+		archPath = basePath;
+		archPath.append(".");
+		NumberFormatter::append(archPath, ++n);
 	}
-	while (exists(path));
+	while (exists(archPath));
 
 	while (n >= 0)
 	{
-		std::string oldPath = basePath;
+		std::string oldPath = path;
 		if (n > 0)
 		{
+			oldPath = basePath;
 			oldPath.append(".");
 			NumberFormatter::append(oldPath, n - 1);
 		}
@@ -189,7 +198,6 @@ LogFile* ArchiveByNumberStrategy::archive(LogFile* pFile)
 		moveFile(oldPath, newPath);
 		--n;
 	}
-	return new LogFile(basePath);
 }
 
 
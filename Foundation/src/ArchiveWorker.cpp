@@ -0,0 +1,131 @@
+//
+// ArchiveWorker.cpp
+//
+// Library: Foundation
+// Package: Logging
+// Module:  FileChannel
+//
+// Copyright (c) 2004-2023, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "Poco/ArchiveWorker.h"
+#include "Poco/ErrorHandler.h"
+#include "Poco/Exception.h"
+
+
+namespace Poco {
+
+
+ArchiveWorker::ArchiveWorker(std::size_t capacity):
+	_capacity(capacity),
+	_busy(false),
+	_stopped(false),
+	_thread("ArchiveWorker")
+{
+	poco_assert (capacity > 0);
+}
+
+
+ArchiveWorker::~ArchiveWorker()
+{
+	try
+	{
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+			_stopped = true;
+		}
+		_taskAvailable.notify_one();
+		if (_thread.isRunning()) _thread.join();
+	}
+	catch (...)
+	{
+		poco_unexpected();
+	}
+}
+
+
+bool ArchiveWorker::enqueue(Task task)
+{
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+
+		if (_stopped || _tasks.size() >= _capacity) return false;
+		_tasks.push_back(std::move(task));
+		if (!_thread.isRunning())
+		{
+			_thread.startFunc([this]() { run(); });
+		}
+	}
+	_taskAvailable.notify_one();
+	return true;
+}
+
+
+void ArchiveWorker::wait()
+{
+	if (Thread::current() == &_thread) return;
+
+	std::unique_lock<std::mutex> lock(_mutex);
+
+	_idle.wait(lock, [this]() { return _tasks.empty() && !_busy; });
+}
+
+
+std::size_t ArchiveWorker::queued() const
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+
+	return _tasks.size();
+}
+
+
+void ArchiveWorker::run()
+{
+	std::unique_lock<std::mutex> lock(_mutex);
+	for (;;)
+	{
+		_taskAvailable.wait(lock, [this]() { return _stopped || !_tasks.empty(); });
+		if (_tasks.empty()) break;
+
+		Task task = std::move(_tasks.front());
+		_tasks.pop_front();
+		_busy = true;
+		lock.unlock();
+		try
+		{
+			task();
+		}
+		catch (Exception& exc)
+		{
+			ErrorHandler::handle(exc);
+		}
+		catch (std::exception& exc)
+		{
+			ErrorHandler::handle(exc);
+		}
+		catch (...)
+		{
+			ErrorHandler::handle();
+		}
+		task = nullptr;
+		lock.lock();
+		_busy = false;
+		if (_tasks.empty()) _idle.notify_all();
+	}
+}
+
+
+ArchiveWorker& ArchiveWorker::defaultWorker()
+{
+	// never destroyed, as FileChannel objects destroyed
+	// during program termination may still use it
+	static ArchiveWorker* pWorker = new ArchiveWorker;
+	return *pWorker;
+}
+
+
+} // namespace Poco
@@ -49,10 +49,124 @@ private:
 };
 
 
+class AsyncChannel::MessageRing
+	/// A fixed-size multi-producer/single-consumer ring buffer
+	/// of messages. Every slot carries a sequence number, so that
+	/// producers claim slots with a single compare-and-swap.
+{
+public:
+	explicit MessageRing(std::size_t size):
+		_mask(0),
+		_enqueuePos(0),
+		_dequeuePos(0)
+	{
+		std::size_t n = 1;
+		while (n < size) n <<= 1;
+		_mask = n - 1;
+		_cells.reset(new Cell[n]);
+		for (std::size_t i = 0; i < n; i++)
+		{
+			_cells[i].sequence.store(i, std::memory_order_relaxed);
+		}
+	}
+
+	bool push(const Message& msg)
+		/// Copies the message into the next free slot.
+		/// Returns false if the ring is full.
+	{
+		std::size_t pos = _enqueuePos.load(std::memory_order_relaxed);
+		for (;;)
+		{
+			Cell& cell = _cells[pos & _mask];
+			std::size_t seq = cell.sequence.load(std::memory_order_acquire);
+			std::ptrdiff_t diff = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos);
+			if (diff == 0)
+			{
+				if (_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+				{
+					try
+					{
+						cell.message = msg; // reuses the slot's string buffers
+					}
+					catch (...)
+					{
+						// The slot must be published in any case,
+						// otherwise the consumer would stall.
+						cell.sequence.store(pos + 1, std::memory_order_release);
+						throw;
+					}
+					cell.sequence.store(pos + 1, std::memory_order_release);
+					return true;
+				}
+			}
+			else if (diff < 0)
+			{
+				return false;
+			}
+			else
+			{
+				pos = _enqueuePos.load(std::memory_order_relaxed);
+			}
+		}
+	}
+
+	std::size_t pop(MessageBatch& batch, std::size_t maxSize)
+		/// Moves up to maxSize messages into batch, which is
+		/// resized to the number of messages taken. The messages
+		/// are swapped with the ones previously held by batch, whose
+		/// buffers are thus recycled. Must only be called by the
+		/// consumer thread.
+	{
+		std::size_t n = 0;
+		while (n < maxSize)
+		{
+			Cell& cell = _cells[_dequeuePos & _mask];
+			if (cell.sequence.load(std::memory_order_acquire) != _dequeuePos + 1) break;
+			if (n == batch.size()) batch.emplace_back();
+			batch[n].swap(cell.message);
+			cell.sequence.store(_dequeuePos + _mask + 1, std::memory_order_release);
+			++_dequeuePos;
+			++n;
+		}
+		if (n > 0 && n < batch.size()) batch.erase(batch.begin() + n, batch.end());
+		return n;
+	}
+
+	bool empty() const
+		/// Returns true if no message is ready to be taken.
+		/// Must only be called by the consumer thread.
+	{
+		return _cells[_dequeuePos & _mask].sequence.load(std::memory_order_acquire) != _dequeuePos + 1;
+	}
+
+private:
+	struct Cell
+	{
+		std::atomic<std::size_t> sequence;
+		Message message;
+	};
+
+	enum
+	{
+		CACHE_LINE_SIZE = 64
+	};
+
+	std::size_t _mask;
+	std::unique_ptr<Cell[]> _cells;
+	char _pad0[CACHE_LINE_SIZE];
+	std::atomic<std::size_t> _enqueuePos;
+	char _pad1[CACHE_LINE_SIZE];
+	std::size_t _dequeuePos;
+};
+
+
 AsyncChannel::AsyncChannel(Channel::Ptr pChannel, Thread::Priority prio):
 	_pChannel(pChannel),
 	_thread("AsyncChannel"),
-	_closed(false)
+	_dropCount(0),
+	_closed(false),
+	_running(false),
+	_ringSleeping(false)
 {
 	_thread.setPriority(prio);
 }
@@ -89,7 +203,23 @@ void AsyncChannel::open()
 {
 	std::lock_guard<std::mutex> lock(_threadMutex);
 
-	if (!_thread.isRunning()) _thread.start(*this);
+	if (!_thread.isRunning())
+	{
+		if (_ringMode && !_pRing)
+		{
+			_pRing.reset(new MessageRing(_queueSize != 0 ? _queueSize : std::size_t(DEFAULT_RING_SIZE)));
+		}
+		_running = true;
+		try
+		{
+			_thread.start(*this);
+		}
+		catch (...)
+		{
+			_running = false;
+			throw;
+		}
+	}
 }
 
 
@@ -99,13 +229,25 @@ void AsyncChannel::close()
 	{
 		if (_thread.isRunning())
 		{
-			while (!_queue.empty()) Thread::sleep(100);
-
-			do
+			if (_pRing)
 			{
-				_queue.wakeUpAll();
+				{
+					std::lock_guard<std::mutex> lock(_ringMutex);
+					_ringStop = true;
+				}
+				_ringCondition.notify_all();
+				_thread.join();
+			}
+			else
+			{
+				while (!_queue.empty()) Thread::sleep(100);
+
+				do
+				{
+					_queue.wakeUpAll();
+				}
+				while (!_thread.tryJoin(100));
 			}
-			while (!_thread.tryJoin(100));
 		}
 	}
 }
@@ -114,6 +256,14 @@ void AsyncChannel::close()
 void AsyncChannel::log(const Message& msg)
 {
 	if (_closed) return;
+	if (!_running.load(std::memory_order_acquire)) open();
+
+	if (_pRing)
+	{
+		logToRing(msg);
+		return;
+	}
+
 	if (_queueSize != 0 && _queue.size() >= _queueSize)
 	{
 		++_dropCount;
@@ -122,16 +272,50 @@ void AsyncChannel::log(const Message& msg)
 
 	if (_dropCount != 0)
 	{
-		_queue.enqueueNotification(new MessageNotification(Message(msg, Poco::format("Dropped %z messages.", _dropCount))));
-		_dropCount = 0;
+		std::size_t dropped = _dropCount.exchange(0);
+		if (dropped != 0)
+		{
+			_queue.enqueueNotification(new MessageNotification(Message(msg, Poco::format("Dropped %z messages.", dropped))));
+		}
 	}
 
-	open();
-
 	_queue.enqueueNotification(new MessageNotification(msg));
 }
 
 
+void AsyncChannel::logToRing(const Message& msg)
+{
+	std::size_t dropped = _dropCount.load(std::memory_order_relaxed);
+	if (dropped != 0 && _dropCount.compare_exchange_strong(dropped, 0))
+	{
+		if (!_pRing->push(Message(msg, Poco::format("Dropped %z messages.", dropped))))
+		{
+			_dropCount += dropped;
+		}
+	}
+
+	if (_pRing->push(msg))
+		wakeUpRing();
+	else
+		++_dropCount;
+}
+
+
+void AsyncChannel::wakeUpRing()
+{
+	// Pairs with the fence in runRing(): either the background
+	// thread sees the new message, or we see it sleeping.
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	if (_ringSleeping.load(std::memory_order_relaxed) && _ringSleeping.exchange(false))
+	{
+		{
+			std::lock_guard<std::mutex> lock(_ringMutex);
+		}
+		_ringCondition.notify_one();
+	}
+}
+
+
 void AsyncChannel::setProperty(const std::string& name, const std::string& value)
 {
 	if (name == "channel")
@@ -142,6 +326,10 @@ void AsyncChannel::setProperty(const std::string& name, const std::string& value
 	{
 		setPriority(value);
 	}
+	else if (name == "mode")
+	{
+		setMode(value);
+	}
 	else if (name == "queueSize")
 	{
 		if (Poco::icompare(value, "none") == 0 || Poco::icompare(value, "unlimited") == 0 || value.empty())
@@ -157,6 +345,24 @@ void AsyncChannel::setProperty(const std::string& name, const std::string& value
 
 
 void AsyncChannel::run()
+{
+	try
+	{
+		if (_pRing)
+			runRing();
+		else
+			runQueue();
+	}
+	catch (...)
+	{
+		_running = false;
+		throw;
+	}
+	_running = false;
+}
+
+
+void AsyncChannel::runQueue()
 {
 	AutoPtr<Notification> nf = _queue.waitDequeueNotification();
 	while (nf)
@@ -172,6 +378,36 @@ void AsyncChannel::run()
 }
 
 
+void AsyncChannel::runRing()
+{
+	for (;;)
+	{
+		if (_pRing->pop(_batch, MAX_BATCH_SIZE) > 0)
+		{
+			std::lock_guard<std::mutex> lock(_channelMutex);
+
+			if (_pChannel) _pChannel->logBatch(_batch);
+			continue;
+		}
+
+		std::unique_lock<std::mutex> lock(_ringMutex);
+		if (_ringStop) break;
+		_ringSleeping.store(true, std::memory_order_seq_cst);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		_ringCondition.wait(lock, [this]() { return _ringStop || !_pRing->empty(); });
+		_ringSleeping.store(false, std::memory_order_relaxed);
+	}
+
+	// Messages logged while the channel was being closed.
+	while (_pRing->pop(_batch, MAX_BATCH_SIZE) > 0)
+	{
+		std::lock_guard<std::mutex> lock(_channelMutex);
+
+		if (_pChannel) _pChannel->logBatch(_batch);
+	}
+}
+
+
 void AsyncChannel::setPriority(const std::string& value)
 {
 	Thread::Priority prio = Thread::PRIO_NORMAL;
@@ -193,4 +429,17 @@ void AsyncChannel::setPriority(const std::string& value)
 }
 
 
+void AsyncChannel::setMode(const std::string& value)
+{
+	if (_running) throw IllegalStateException("AsyncChannel mode cannot be changed while the channel is open");
+
+	if (value == "queue")
+		_ringMode = false;
+	else if (value == "ring")
+		_ringMode = true;
+	else
+		throw InvalidArgumentException("AsyncChannel mode", value);
+}
+
+
 } // namespace Poco
@@ -0,0 +1,345 @@
+//
+// BoundedNotificationQueue.cpp
+//
+// Library: Foundation
+// Package: Notifications
+// Module:  BoundedNotificationQueue
+//
+// Copyright (c) 2005-2023, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "Poco/BoundedNotificationQueue.h"
+#include "Poco/Exception.h"
+#include "Poco/Clock.h"
+#include <chrono>
+
+
+namespace Poco {
+
+
+//
+// BoundedNotificationQueue::EventCount
+//
+
+
+BoundedNotificationQueue::EventCount::EventCount():
+	_state(0)
+{
+}
+
+
+void BoundedNotificationQueue::EventCount::prepareWait()
+{
+	_state.fetch_add(WAITER, std::memory_order_seq_cst);
+}
+
+
+void BoundedNotificationQueue::EventCount::cancelWait()
+{
+	Poco::UInt64 state = _state.load(std::memory_order_relaxed);
+	Poco::UInt64 newState;
+	do
+	{
+		Poco::UInt64 waiters = (state >> 32) - 1;
+		Poco::UInt64 signals = state & SIGNAL_MASK;
+		if (signals > waiters) signals = waiters;
+		newState = (waiters << 32) | signals;
+	}
+	while (!_state.compare_exchange_weak(state, newState, std::memory_order_seq_cst));
+}
+
+
+bool BoundedNotificationQueue::EventCount::consumeSignal()
+{
+	Poco::UInt64 state = _state.load(std::memory_order_relaxed);
+	while (state & SIGNAL_MASK)
+	{
+		if (_state.compare_exchange_weak(state, state - WAITER - 1, std::memory_order_seq_cst))
+			return true;
+	}
+	return false;
+}
+
+
+bool BoundedNotificationQueue::EventCount::wait(long milliseconds)
+{
+	std::unique_lock<std::mutex> lock(_mutex);
+	if (milliseconds < 0)
+	{
+		_cond.wait(lock, [this]() { return consumeSignal(); });
+	}
+	else if (!_cond.wait_for(lock, std::chrono::milliseconds(milliseconds), [this]() { return consumeSignal(); }))
+	{
+		cancelWait();
+		return false;
+	}
+	return true;
+}
+
+
+void BoundedNotificationQueue::EventCount::notifyOne()
+{
+	notify(false);
+}
+
+
+void BoundedNotificationQueue::EventCount::notifyAll()
+{
+	notify(true);
+}
+
+
+void BoundedNotificationQueue::EventCount::notify(bool all)
+{
+	// Pairs with the increment of the waiter count in prepareWait():
+	// either the waiter sees the state change made before notify(),
+	// or we see the waiter.
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	Poco::UInt64 state = _state.load(std::memory_order_relaxed);
+	Poco::UInt64 newState;
+	do
+	{
+		Poco::UInt64 waiters = state >> 32;
+		Poco::UInt64 signals = state & SIGNAL_MASK;
+		if (waiters <= signals) return; // every waiter has already been signalled
+		newState = all ? ((waiters << 32) | waiters) : state + 1;
+	}
+	while (!_state.compare_exchange_weak(state, newState, std::memory_order_seq_cst));
+
+	{
+		// Synchronize with a waiter that has checked the
+		// predicate but is not yet blocked on the condition.
+		std::lock_guard<std::mutex> lock(_mutex);
+	}
+	if (all)
+		_cond.notify_all();
+	else
+		_cond.notify_one();
+}
+
+
+//
+// BoundedNotificationQueue
+//
+
+
+BoundedNotificationQueue::BoundedNotificationQueue(std::size_t capacity):
+	_mask(0),
+	_enqueuePos(0),
+	_dequeuePos(0),
+	_wakeUps(0)
+{
+	if (capacity == 0) throw InvalidArgumentException("BoundedNotificationQueue capacity must not be zero");
+
+	std::size_t size = 1;
+	while (size < capacity) size <<= 1;
+	_mask = size - 1;
+	_cells.reset(new Cell[size]);
+	for (std::size_t i = 0; i < size; i++)
+	{
+		_cells[i].sequence.store(i, std::memory_order_relaxed);
+		_cells[i].pNf = 0;
+	}
+}
+
+
+BoundedNotificationQueue::~BoundedNotificationQueue()
+{
+	try
+	{
+		clear();
+	}
+	catch (...)
+	{
+		poco_unexpected();
+	}
+}
+
+
+bool BoundedNotificationQueue::enqueueOne(Notification* pNotification)
+{
+	std::size_t pos = _enqueuePos.load(std::memory_order_relaxed);
+	for (;;)
+	{
+		Cell& cell = _cells[pos & _mask];
+		std::size_t seq = cell.sequence.load(std::memory_order_acquire);
+		std::ptrdiff_t diff = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos);
+		if (diff == 0)
+		{
+			if (_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+			{
+				cell.pNf = pNotification;
+				cell.sequence.store(pos + 1, std::memory_order_release);
+				return true;
+			}
+		}
+		else if (diff < 0)
+		{
+			return false; // full
+		}
+		else
+		{
+			pos = _enqueuePos.load(std::memory_order_relaxed);
+		}
+	}
+}
+
+
+Notification* BoundedNotificationQueue::dequeueOne()
+{
+	std::size_t pos = _dequeuePos.load(std::memory_order_relaxed);
+	for (;;)
+	{
+		Cell& cell = _cells[pos & _mask];
+		std::size_t seq = cell.sequence.load(std::memory_order_acquire);
+		std::ptrdiff_t diff = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos + 1);
+		if (diff == 0)
+		{
+			if (_dequeuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+			{
+				Notification* pNf = cell.pNf;
+				cell.pNf = 0;
+				cell.sequence.store(pos + _mask + 1, std::memory_order_release);
+				return pNf;
+			}
+		}
+		else if (diff < 0)
+		{
+			return 0; // empty
+		}
+		else
+		{
+			pos = _dequeuePos.load(std::memory_order_relaxed);
+		}
+	}
+}
+
+
+void BoundedNotificationQueue::enqueueNotification(Notification::Ptr pNotification)
+{
+	poco_check_ptr (pNotification);
+	Notification* pNf = pNotification.duplicate();
+	while (!enqueueOne(pNf))
+	{
+		_notFull.prepareWait();
+		if (enqueueOne(pNf))
+		{
+			_notFull.cancelWait();
+			break;
+		}
+		_notFull.wait(-1);
+	}
+	_notEmpty.notifyOne();
+}
+
+
+bool BoundedNotificationQueue::tryEnqueueNotification(Notification::Ptr pNotification)
+{
+	poco_check_ptr (pNotification);
+	Notification* pNf = pNotification.duplicate();
+	if (enqueueOne(pNf))
+	{
+		_notEmpty.notifyOne();
+		return true;
+	}
+	pNf->release();
+	return false;
+}
+
+
+Notification* BoundedNotificationQueue::dequeueNotification()
+{
+	Notification* pNf = dequeueOne();
+	if (pNf) _notFull.notifyAll();
+	return pNf;
+}
+
+
+Notification* BoundedNotificationQueue::waitDequeueNotification()
+{
+	return waitDequeueOne(-1);
+}
+
+
+Notification* BoundedNotificationQueue::waitDequeueNotification(long milliseconds)
+{
+	return waitDequeueOne(milliseconds);
+}
+
+
+Notification* BoundedNotificationQueue::waitDequeueOne(long milliseconds)
+{
+	Poco::UInt64 wakeUps = _wakeUps.load(std::memory_order_acquire);
+	Notification* pNf = dequeueOne();
+	Poco::Clock start;
+	while (!pNf)
+	{
+		_notEmpty.prepareWait();
+		pNf = dequeueOne();
+		if (pNf)
+		{
+			_notEmpty.cancelWait();
+			break;
+		}
+		if (_wakeUps.load(std::memory_order_acquire) != wakeUps)
+		{
+			_notEmpty.cancelWait();
+			return 0;
+		}
+		long remaining = milliseconds;
+		if (milliseconds > 0)
+		{
+			remaining = milliseconds - static_cast<long>(start.elapsed()/1000);
+			if (remaining < 0) remaining = 0;
+		}
+		if (!_notEmpty.wait(remaining))
+		{
+			pNf = dequeueOne();
+			break;
+		}
+		if (_wakeUps.load(std::memory_order_acquire) != wakeUps) return 0;
+		pNf = dequeueOne();
+	}
+	if (pNf) _notFull.notifyAll();
+	return pNf;
+}
+
+
+void BoundedNotificationQueue::wakeUpAll()
+{
+	_wakeUps.fetch_add(1, std::memory_order_acq_rel);
+	_notEmpty.notifyAll();
+}
+
+
+bool BoundedNotificationQueue::empty() const
+{
+	return size() == 0;
+}
+
+
+int BoundedNotificationQueue::size() const
+{
+	std::size_t dequeuePos = _dequeuePos.load(std::memory_order_acquire);
+	std::size_t enqueuePos = _enqueuePos.load(std::memory_order_acquire);
+	return enqueuePos > dequeuePos ? static_cast<int>(enqueuePos - dequeuePos) : 0;
+}
+
+
+void BoundedNotificationQueue::clear()
+{
+	Notification* pNf = dequeueOne();
+	while (pNf)
+	{
+		pNf->release();
+		pNf = dequeueOne();
+	}
+	_notFull.notifyAll();
+}
+
+
+} // namespace Poco
@@ -13,6 +13,7 @@
 
 
 #include "Poco/Channel.h"
+#include "Poco/Message.h"
 
 
 namespace Poco {
@@ -38,6 +39,15 @@ void Channel::close()
 }
 
 
+void Channel::logBatch(const MessageBatch& batch)
+{
+	for (const auto& msg: batch)
+	{
+		log(msg);
+	}
+}
+
+
 void Channel::setProperty(const std::string& name, const std::string& /*value*/)
 {
 	throw PropertyNotSupportedException(name);
@@ -16,7 +16,12 @@
 #include "Poco/ArchiveStrategy.h"
 #include "Poco/RotateStrategy.h"
 #include "Poco/PurgeStrategy.h"
+#include "Poco/ArchiveWorker.h"
+#include "Poco/File.h"
+#include "Poco/Path.h"
+#include "Poco/DirectoryIterator.h"
 #include "Poco/Message.h"
+#include "Poco/NumberFormatter.h"
 #include "Poco/NumberParser.h"
 #include "Poco/DateTimeFormatter.h"
 #include "Poco/DateTime.h"
@@ -24,6 +29,7 @@
 #include "Poco/String.h"
 #include "Poco/Exception.h"
 #include "Poco/Ascii.h"
+#include <map>
 
 
 namespace Poco {
@@ -38,12 +44,17 @@ const std::string FileChannel::PROP_PURGEAGE     = "purgeAge";
 const std::string FileChannel::PROP_PURGECOUNT   = "purgeCount";
 const std::string FileChannel::PROP_FLUSH        = "flush";
 const std::string FileChannel::PROP_ROTATEONOPEN = "rotateOnOpen";
+const std::string FileChannel::PROP_COMPRESSIONLEVEL = "compressionLevel";
+const std::string FileChannel::PROP_ASYNCARCHIVE = "asyncArchive";
 
 FileChannel::FileChannel():
 	_times("utc"),
 	_compress(false),
 	_flush(true),
 	_rotateOnOpen(false),
+	_compressionLevel("default"),
+	_asyncArchive(false),
+	_archivePending(false),
 	_pFile(0),
 	_pRotateStrategy(0),
 	_pArchiveStrategy(new ArchiveByNumberStrategy),
@@ -58,6 +69,9 @@ FileChannel::FileChannel(const std::string& path):
 	_compress(false),
 	_flush(true),
 	_rotateOnOpen(false),
+	_compressionLevel("default"),
+	_asyncArchive(false),
+	_archivePending(false),
 	_pFile(0),
 	_pRotateStrategy(0),
 	_pArchiveStrategy(new ArchiveByNumberStrategy),
@@ -71,6 +85,7 @@ FileChannel::~FileChannel()
 	try
 	{
 		close();
+		waitForArchive();
 		delete _pRotateStrategy;
 		delete _pArchiveStrategy;
 		delete _pPurgeStrategy;
@@ -88,17 +103,18 @@ void FileChannel::open()
 
 	if (!_pFile)
 	{
-		_pFile = new LogFile(_path);
+		recoverArchives();
+		_pFile = newLogFile(_path);
 		if (_rotateOnOpen && _pFile->size() > 0)
 		{
 			try
 			{
-				_pFile = _pArchiveStrategy->archive(_pFile);
+				_pFile = archive(_pFile);
 				purge();
 			}
 			catch (...)
 			{
-				_pFile = new LogFile(_path);
+				_pFile = newLogFile(_path);
 			}
 		}
 	}
@@ -120,23 +136,48 @@ void FileChannel::log(const Message& msg)
 
 	std::lock_guard<std::mutex> lock(_mutex);
 
+	rotateIfNeeded();
+	_pFile->write(msg.getText(), _flush);
+}
+
+
+void FileChannel::logBatch(const MessageBatch& batch)
+{
+	if (batch.empty()) return;
+
+	open();
+
+	std::lock_guard<std::mutex> lock(_mutex);
+
+	rotateIfNeeded();
+	_batchText.assign(batch.front().getText());
+	for (std::size_t i = 1; i < batch.size(); i++)
+	{
+		_batchText += '\n';
+		_batchText += batch[i].getText();
+	}
+	_pFile->write(_batchText, _flush);
+}
+
+
+void FileChannel::rotateIfNeeded()
+{
 	if (_pRotateStrategy && _pArchiveStrategy && _pRotateStrategy->mustRotate(_pFile))
 	{
 		try
 		{
-			_pFile = _pArchiveStrategy->archive(_pFile);
+			_pFile = archive(_pFile);
 			purge();
 		}
 		catch (...)
 		{
-			_pFile = new LogFile(_path);
+			_pFile = newLogFile(_path);
 		}
 		// we must call mustRotate() again to give the
 		// RotateByIntervalStrategy a chance to write its timestamp
 		// to the new file.
 		_pRotateStrategy->mustRotate(_pFile);
 	}
-	_pFile->write(msg.getText(), _flush);
 }
 
 
@@ -170,6 +211,10 @@ void FileChannel::setProperty(const std::string& name, const std::string& value)
 		setFlush(value);
 	else if (name == PROP_ROTATEONOPEN)
 		setRotateOnOpen(value);
+	else if (name == PROP_COMPRESSIONLEVEL)
+		setCompressionLevel(value);
+	else if (name == PROP_ASYNCARCHIVE)
+		setAsyncArchive(value);
 	else
 		Channel::setProperty(name, value);
 }
@@ -195,6 +240,10 @@ std::string FileChannel::getProperty(const std::string& name) const
 		return std::string(_flush ? "true" : "false");
 	else if (name == PROP_ROTATEONOPEN)
 		return std::string(_rotateOnOpen ? "true" : "false");
+	else if (name == PROP_COMPRESSIONLEVEL)
+		return _compressionLevel;
+	else if (name == PROP_ASYNCARCHIVE)
+		return std::string(_asyncArchive ? "true" : "false");
 	else
 		return Channel::getProperty(name);
 }
@@ -294,8 +343,10 @@ void FileChannel::setArchive(const std::string& archive)
 			throw PropertyNotSupportedException("times", _times);
 	}
 	else throw InvalidArgumentException("archive", archive);
+	waitForArchive();
 	delete _pArchiveStrategy;
 	pStrategy->compress(_compress);
+	pStrategy->compressionLevel(parseCompressionLevel(_compressionLevel));
 	_pArchiveStrategy = pStrategy;
 	_archive = archive;
 }
@@ -304,6 +355,7 @@ void FileChannel::setArchive(const std::string& archive)
 void FileChannel::setCompress(const std::string& compress)
 {
 	_compress = icompare(compress, "true") == 0;
+	waitForArchive();
 	if (_pArchiveStrategy)
 		_pArchiveStrategy->compress(_compress);
 }
@@ -343,10 +395,91 @@ void FileChannel::setRotateOnOpen(const std::string& rotateOnOpen)
 }
 
 
+LogFile* FileChannel::newLogFile(const std::string& path)
+{
+	return new LogFile(path);
+}
+
+
+LogFile* FileChannel::archive(LogFile* pFile)
+{
+	if (!_asyncArchive) return _pArchiveStrategy->archive(pFile);
+
+	std::string basePath = pFile->path();
+	delete pFile;
+	std::string path;
+	int n = 0;
+	do
+	{
+		path = basePath;
+		path.append("~");
+		NumberFormatter::append(path, n++);
+	}
+	while (File(path).exists());
+	File(basePath).renameTo(path);
+
+	ArchiveStrategy* pStrategy = _pArchiveStrategy;
+	auto task = [pStrategy, path, basePath]()
+	{
+		pStrategy->archiveFile(path, basePath);
+	};
+	ArchiveWorker& worker = ArchiveWorker::defaultWorker();
+	if (worker.enqueue(task))
+	{
+		_archivePending = true;
+	}
+	else
+	{
+		// queue is full; archive now, but after the queued tasks
+		worker.wait();
+		task();
+	}
+	return new LogFile(basePath);
+}
+
+
+void FileChannel::setCompressionLevel(const std::string& level)
+{
+	int n = parseCompressionLevel(level);
+	waitForArchive();
+	if (_pArchiveStrategy)
+		_pArchiveStrategy->compressionLevel(n);
+	_compressionLevel = level;
+}
+
+
+void FileChannel::setAsyncArchive(const std::string& asyncArchive)
+{
+	_asyncArchive = icompare(asyncArchive, "true") == 0;
+}
+
+
 void FileChannel::purge()
 {
 	if (_pPurgeStrategy)
 	{
+		if (_asyncArchive)
+		{
+			PurgeStrategy* pStrategy = _pPurgeStrategy;
+			std::string path = _path;
+			auto task = [pStrategy, path]()
+			{
+				try
+				{
+					pStrategy->purge(path);
+				}
+				catch (...)
+				{
+				}
+			};
+			ArchiveWorker& worker = ArchiveWorker::defaultWorker();
+			if (worker.enqueue(task))
+			{
+				_archivePending = true;
+				return;
+			}
+			worker.wait();
+		}
 		try
 		{
 			_pPurgeStrategy->purge(_path);
@@ -362,6 +495,7 @@ bool FileChannel::setNoPurge(const std::string& value)
 {
 	if (value.empty() || 0 == icompare(value, "none"))
 	{
+		waitForArchive();
 		delete _pPurgeStrategy;
 		_pPurgeStrategy = 0;
 		_purgeAge = "none";
@@ -394,11 +528,80 @@ int FileChannel::extractDigit(const std::string& value, std::string::const_itera
 
 void FileChannel::setPurgeStrategy(PurgeStrategy* strategy)
 {
+	waitForArchive();
 	delete _pPurgeStrategy;
 	_pPurgeStrategy = strategy;
 }
 
 
+void FileChannel::waitForArchive()
+{
+	// archive and purge tasks still in the ArchiveWorker's
+	// queue use our strategies, so these must not be changed
+	// or deleted before the tasks have been run.
+	if (_archivePending)
+	{
+		ArchiveWorker::defaultWorker().wait();
+		_archivePending = false;
+	}
+}
+
+
+void FileChannel::recoverArchives()
+{
+	// If the process terminated while rotated log files were still
+	// waiting to be archived, they have been left with a temporary
+	// name (<path>~<n>). Archive them now, oldest (lowest n) first.
+	if (!_pArchiveStrategy) return;
+	waitForArchive();
+
+	Path p(_path);
+	p.makeAbsolute();
+	if (!File(p.parent()).exists()) return;
+	std::string prefix = p.getFileName();
+	prefix.append("~");
+	std::map<int, std::string> orphans;
+	DirectoryIterator it(p.parent());
+	DirectoryIterator end;
+	while (it != end)
+	{
+		int n;
+		if (it.name().compare(0, prefix.size(), prefix) == 0 && NumberParser::tryParse(it.name().substr(prefix.size()), n))
+		{
+			orphans[n] = it->path();
+		}
+		++it;
+	}
+	for (const auto& orphan: orphans)
+	{
+		try
+		{
+			_pArchiveStrategy->archiveFile(orphan.second, _path);
+		}
+		catch (...)
+		{
+		}
+	}
+}
+
+
+int FileChannel::parseCompressionLevel(const std::string& level)
+{
+	if (icompare(level, "default") == 0)
+		return ArchiveStrategy::DEFAULT_COMPRESSION_LEVEL;
+	else if (icompare(level, "fast") == 0)
+		return ArchiveStrategy::FAST_COMPRESSION_LEVEL;
+	else if (icompare(level, "best") == 0)
+		return ArchiveStrategy::BEST_COMPRESSION_LEVEL;
+
+	int n;
+	if (NumberParser::tryParse(level, n) && n >= 0 && n <= 9)
+		return n;
+	else
+		throw InvalidArgumentException("compressionLevel", level);
+}
+
+
 Timespan::TimeDiff FileChannel::extractFactor(const std::string& value, std::string::const_iterator start) const
 {
 	while (start != value.end() && Ascii::isSpace(*start)) ++start;
@@ -167,4 +167,21 @@ std::streampos FileStreamBuf::seekpos(std::streampos pos, std::ios::openmode mod
 }
 
 
+FileStreamBuf::NativeHandle FileStreamBuf::nativeHandle() const
+{
+	return _fd;
+}
+
+
+Poco::UInt64 FileStreamBuf::size() const
+{
+	poco_assert (_fd != -1);
+
+	struct stat st;
+	if (::fstat(_fd, &st) != 0)
+		File::handleLastError(_path);
+	return static_cast<Poco::UInt64>(st.st_size);
+}
+
+
 } // namespace Poco
@@ -199,4 +199,21 @@ std::streampos FileStreamBuf::seekpos(std::streampos pos, std::ios::openmode mod
 }
 
 
+FileStreamBuf::NativeHandle FileStreamBuf::nativeHandle() const
+{
+	return _handle;
+}
+
+
+Poco::UInt64 FileStreamBuf::size() const
+{
+	poco_assert (_handle != INVALID_HANDLE_VALUE);
+
+	LARGE_INTEGER li;
+	if (!GetFileSizeEx(_handle, &li))
+		File::handleLastError(_path);
+	return static_cast<Poco::UInt64>(li.QuadPart);
+}
+
+
 } // namespace Poco
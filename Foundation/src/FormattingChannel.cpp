@@ -88,6 +88,34 @@ void FormattingChannel::log(const Message& msg)
 }
 
 
+void FormattingChannel::logBatch(const MessageBatch& batch)
+{
+	if (_pChannel)
+	{
+		if (_pFormatter)
+		{
+			std::lock_guard<std::mutex> lock(_batchMutex);
+
+			// assigning to the messages of the previous batch
+			// reuses the capacity of their strings
+			_batch.resize(batch.size());
+			for (std::size_t i = 0; i < batch.size(); i++)
+			{
+				_batchText.clear();
+				_pFormatter->format(batch[i], _batchText);
+				_batch[i] = batch[i];
+				_batch[i].setText(_batchText);
+			}
+			_pChannel->logBatch(_batch);
+		}
+		else
+		{
+			_pChannel->logBatch(batch);
+		}
+	}
+}
+
+
 void FormattingChannel::setProperty(const std::string& name, const std::string& value)
 {
 	if (name == "channel")
@@ -19,6 +19,9 @@
 #include "Poco/NumberFormatter.h"
 #include "Poco/NumberParser.h"
 #include "Poco/String.h"
+#include <atomic>
+#include <functional>
+#include <memory>
 
 
 namespace Poco {
@@ -29,6 +32,196 @@ std::recursive_mutex Logger::_mapMtx;
 const std::string    Logger::ROOT;
 
 
+namespace
+{
+	class LoggerIndex
+		/// A read-mostly hash index of all loggers in the
+		/// logger map, which allows looking up loggers without
+		/// taking the map mutex.
+		///
+		/// Nodes are immutable once published, except for the
+		/// logger pointer, and are never freed while other threads
+		/// may read them. Removing a logger only clears its pointer.
+		/// If the table has to grow, a new table is built and
+		/// published, and the old one is retired, but kept.
+		/// All modifications are made with Logger::_mapMtx held.
+		///
+		/// The index is never destroyed, so that threads still
+		/// logging during program termination can use it.
+	{
+	public:
+		LoggerIndex():
+			_pTable(0),
+			_count(0)
+		{
+		}
+
+		Logger* lookup(const std::string& name) const
+		{
+			const Table* pTable = _pTable.load(std::memory_order_acquire);
+			if (!pTable) return 0;
+
+			std::size_t hash = std::hash<std::string>()(name);
+			const Node* pNode = pTable->buckets[hash & pTable->mask].load(std::memory_order_acquire);
+			while (pNode)
+			{
+				if (pNode->hash == hash && pNode->name == name)
+					return pNode->pLogger.load(std::memory_order_acquire);
+				pNode = pNode->pNext;
+			}
+			return 0;
+		}
+
+		void insert(const std::string& name, Logger* pLogger)
+		{
+			Table* pTable = _pTable.load(std::memory_order_relaxed);
+			std::size_t hash = std::hash<std::string>()(name);
+			if (pTable)
+			{
+				Node* pNode = findNode(pTable, name, hash);
+				if (pNode)
+				{
+					pNode->pLogger.store(pLogger, std::memory_order_release);
+					return;
+				}
+			}
+			if (!pTable || _count >= 2*(pTable->mask + 1))
+			{
+				pTable = grow(pTable);
+			}
+			addNode(pTable, name, hash, pLogger);
+			++_count;
+		}
+
+		void remove(const std::string& name)
+		{
+			Table* pTable = _pTable.load(std::memory_order_relaxed);
+			if (pTable)
+			{
+				Node* pNode = findNode(pTable, name, std::hash<std::string>()(name));
+				if (pNode) pNode->pLogger.store(0, std::memory_order_release);
+			}
+		}
+
+		void clear()
+		{
+			Table* pTable = _pTable.load(std::memory_order_relaxed);
+			if (pTable)
+			{
+				for (std::size_t i = 0; i <= pTable->mask; i++)
+				{
+					Node* pNode = pTable->buckets[i].load(std::memory_order_relaxed);
+					while (pNode)
+					{
+						pNode->pLogger.store(0, std::memory_order_release);
+						pNode = pNode->pNext;
+					}
+				}
+			}
+		}
+
+	private:
+		struct Node
+		{
+			Node(const std::string& n, std::size_t h, Logger* pL, Node* pN):
+				name(n),
+				hash(h),
+				pLogger(pL),
+				pNext(pN)
+			{
+			}
+
+			const std::string name;
+			const std::size_t hash;
+			std::atomic<Logger*> pLogger;
+			Node* const pNext;
+		};
+
+		struct Table
+		{
+			explicit Table(std::size_t size):
+				mask(size - 1),
+				buckets(new std::atomic<Node*>[size]),
+				pRetired(0)
+			{
+				for (std::size_t i = 0; i < size; i++)
+				{
+					buckets[i].store(0, std::memory_order_relaxed);
+				}
+			}
+
+			~Table()
+			{
+				for (std::size_t i = 0; i <= mask; i++)
+				{
+					Node* pNode = buckets[i].load(std::memory_order_relaxed);
+					while (pNode)
+					{
+						Node* pNext = pNode->pNext;
+						delete pNode;
+						pNode = pNext;
+					}
+				}
+			}
+
+			const std::size_t mask;
+			std::unique_ptr<std::atomic<Node*>[]> buckets;
+			Table* pRetired;
+		};
+
+		static Node* findNode(Table* pTable, const std::string& name, std::size_t hash)
+		{
+			Node* pNode = pTable->buckets[hash & pTable->mask].load(std::memory_order_relaxed);
+			while (pNode)
+			{
+				if (pNode->hash == hash && pNode->name == name) return pNode;
+				pNode = pNode->pNext;
+			}
+			return 0;
+		}
+
+		static void addNode(Table* pTable, const std::string& name, std::size_t hash, Logger* pLogger)
+		{
+			std::atomic<Node*>& bucket = pTable->buckets[hash & pTable->mask];
+			bucket.store(new Node(name, hash, pLogger, bucket.load(std::memory_order_relaxed)), std::memory_order_release);
+		}
+
+		Table* grow(Table* pOldTable)
+		{
+			std::unique_ptr<Table> pTable(new Table(pOldTable ? 2*(pOldTable->mask + 1) : 64));
+			_count = 0;
+			if (pOldTable)
+			{
+				for (std::size_t i = 0; i <= pOldTable->mask; i++)
+				{
+					for (Node* pNode = pOldTable->buckets[i].load(std::memory_order_relaxed); pNode; pNode = pNode->pNext)
+					{
+						Logger* pLogger = pNode->pLogger.load(std::memory_order_relaxed);
+						if (pLogger)
+						{
+							addNode(pTable.get(), pNode->name, pNode->hash, pLogger);
+							++_count;
+						}
+					}
+				}
+			}
+			pTable->pRetired = pOldTable;
+			_pTable.store(pTable.get(), std::memory_order_release);
+			return pTable.release();
+		}
+
+		std::atomic<Table*> _pTable;
+		std::size_t _count;
+	};
+
+	LoggerIndex& loggerIndex()
+	{
+		static LoggerIndex* pIndex = new LoggerIndex;
+		return *pIndex;
+	}
+}
+
+
 Logger::Logger(const std::string& name, Channel::Ptr pChannel, int level): _name(name), _pChannel(pChannel), _level(level)
 {
 }
@@ -53,7 +246,7 @@ Channel::Ptr Logger::getChannel() const
 
 void Logger::setLevel(int level)
 {
-	_level = level;
+	_level.store(level, std::memory_order_relaxed);
 }
 
 
@@ -76,7 +269,7 @@ void Logger::setProperty(const std::string& name, const std::string& value)
 
 void Logger::log(const Message& msg)
 {
-	if (_level >= msg.getPriority() && _pChannel)
+	if (getLevel() >= msg.getPriority() && _pChannel)
 	{
 		_pChannel->log(msg);
 	}
@@ -97,7 +290,7 @@ void Logger::log(const Exception& exc, const char* file, int line)
 
 void Logger::dump(const std::string& msg, const void* buffer, std::size_t length, Message::Priority prio)
 {
-	if (_level >= prio && _pChannel)
+	if (getLevel() >= prio && _pChannel)
 	{
 		std::string text(msg);
 		formatDump(text, buffer, length);
@@ -275,6 +468,9 @@ void Logger::formatDump(std::string& message, const void* buffer, std::size_t le
 
 Logger& Logger::get(const std::string& name)
 {
+	Logger* pLogger = loggerIndex().lookup(name);
+	if (pLogger) return *pLogger;
+
 	std::lock_guard<std::recursive_mutex> lock(_mapMtx);
 
 	return unsafeGet(name);
@@ -314,6 +510,9 @@ Logger& Logger::create(const std::string& name, Channel::Ptr pChannel, int level
 
 Logger& Logger::root()
 {
+	Logger* pLogger = loggerIndex().lookup(ROOT);
+	if (pLogger) return *pLogger;
+
 	std::lock_guard<std::recursive_mutex> lock(_mapMtx);
 
 	return unsafeGet(ROOT);
@@ -322,6 +521,8 @@ Logger& Logger::root()
 
 Logger::Ptr Logger::has(const std::string& name)
 {
+	// Not using the index here, as the Logger could be destroyed
+	// by another thread before we could add a reference to it.
 	std::lock_guard<std::recursive_mutex> lock(_mapMtx);
 
 	return find(name);
@@ -332,6 +533,7 @@ void Logger::shutdown()
 {
 	std::lock_guard<std::recursive_mutex> lock(_mapMtx);
 
+	loggerIndex().clear();
 	_pLoggerMap.reset();
 }
 
@@ -354,7 +556,11 @@ void Logger::destroy(const std::string& name)
 	if (_pLoggerMap)
 	{
 		LoggerMap::iterator it = _pLoggerMap->find(name);
-		if (it != _pLoggerMap->end()) _pLoggerMap->erase(it);
+		if (it != _pLoggerMap->end())
+		{
+			loggerIndex().remove(name);
+			_pLoggerMap->erase(it);
+		}
 	}
 }
 
@@ -429,7 +635,10 @@ int Logger::parseLevel(const std::string& level)
 void Logger::add(Ptr pLogger)
 {
 	if (!_pLoggerMap) _pLoggerMap.reset(new LoggerMap);
-	_pLoggerMap->insert(LoggerMap::value_type(pLogger->name(), pLogger));
+	if (_pLoggerMap->insert(LoggerMap::value_type(pLogger->name(), pLogger)).second)
+	{
+		loggerIndex().insert(pLogger->name(), pLogger.get());
+	}
 }
 
 
@@ -0,0 +1,162 @@
+//
+// MappedFileChannel.cpp
+//
+// Library: Foundation
+// Package: Logging
+// Module:  MappedFileChannel
+//
+// Copyright (c) 2004-2023, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "Poco/MappedFileChannel.h"
+#include "Poco/MappedLogFile.h"
+#include "Poco/NumberFormatter.h"
+#include "Poco/NumberParser.h"
+#include "Poco/Exception.h"
+#include "Poco/Ascii.h"
+
+
+namespace Poco {
+
+
+const std::string MappedFileChannel::PROP_SEGMENTSIZE  = "segmentSize";
+const std::string MappedFileChannel::PROP_SYNCINTERVAL = "syncInterval";
+
+
+MappedFileChannel::MappedFileChannel():
+	_segmentSize(DEFAULT_SEGMENT_SIZE),
+	_segmentSizeValue("4M"),
+	_syncInterval(DEFAULT_SYNC_INTERVAL*Timespan::MILLISECONDS),
+	_rotateBySegment(true)
+{
+	FileChannel::setProperty(PROP_FLUSH, "false");
+	FileChannel::setProperty(PROP_ROTATION, NumberFormatter::format(_segmentSize));
+}
+
+
+MappedFileChannel::MappedFileChannel(const std::string& path):
+	FileChannel(path),
+	_segmentSize(DEFAULT_SEGMENT_SIZE),
+	_segmentSizeValue("4M"),
+	_syncInterval(DEFAULT_SYNC_INTERVAL*Timespan::MILLISECONDS),
+	_rotateBySegment(true)
+{
+	FileChannel::setProperty(PROP_FLUSH, "false");
+	FileChannel::setProperty(PROP_ROTATION, NumberFormatter::format(_segmentSize));
+}
+
+
+MappedFileChannel::~MappedFileChannel()
+{
+	try
+	{
+		close();
+	}
+	catch (...)
+	{
+		poco_unexpected();
+	}
+}
+
+
+void MappedFileChannel::setProperty(const std::string& name, const std::string& value)
+{
+	if (name == PROP_SEGMENTSIZE)
+		setSegmentSize(value);
+	else if (name == PROP_SYNCINTERVAL)
+		setSyncInterval(value);
+	else if (name == PROP_ROTATION)
+	{
+		FileChannel::setProperty(name, value);
+		std::lock_guard<std::mutex> lock(_mutex);
+		_rotateBySegment = false;
+	}
+	else
+		FileChannel::setProperty(name, value);
+}
+
+
+std::string MappedFileChannel::getProperty(const std::string& name) const
+{
+	if (name == PROP_SEGMENTSIZE)
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		return _segmentSizeValue;
+	}
+	else if (name == PROP_SYNCINTERVAL)
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		return NumberFormatter::format(_syncInterval.totalMilliseconds());
+	}
+	else
+		return FileChannel::getProperty(name);
+}
+
+
+LogFile* MappedFileChannel::newLogFile(const std::string& path)
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+
+	return new MappedLogFile(path, _segmentSize, _syncInterval);
+}
+
+
+LogFile* MappedFileChannel::archive(LogFile* pFile)
+{
+	// The archive strategy creates a LogFile for the new
+	// log file, which we replace with a MappedLogFile.
+	LogFile* pNewFile = FileChannel::archive(pFile);
+	std::string path = pNewFile->path();
+	delete pNewFile;
+	return newLogFile(path);
+}
+
+
+void MappedFileChannel::setSegmentSize(const std::string& size)
+{
+	std::string::const_iterator it  = size.begin();
+	std::string::const_iterator end = size.end();
+	UInt64 n = 0;
+	while (it != end && Ascii::isSpace(*it)) ++it;
+	while (it != end && Ascii::isDigit(*it)) { n *= 10; n += *it++ - '0'; }
+	while (it != end && Ascii::isSpace(*it)) ++it;
+	std::string unit;
+	while (it != end && Ascii::isAlpha(*it)) unit += *it++;
+
+	if (unit == "K")
+		n *= 1024;
+	else if (unit == "M")
+		n *= 1024*1024;
+	else if (!unit.empty())
+		throw InvalidArgumentException(PROP_SEGMENTSIZE, size);
+	if (n == 0)
+		throw InvalidArgumentException(PROP_SEGMENTSIZE, size);
+
+	bool rotateBySegment;
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		_segmentSize = n;
+		_segmentSizeValue = size;
+		rotateBySegment = _rotateBySegment;
+	}
+	if (rotateBySegment)
+		FileChannel::setProperty(PROP_ROTATION, NumberFormatter::format(n));
+}
+
+
+void MappedFileChannel::setSyncInterval(const std::string& interval)
+{
+	int ms = NumberParser::parse(interval);
+	if (ms < 0)
+		throw InvalidArgumentException(PROP_SYNCINTERVAL, interval);
+
+	std::lock_guard<std::mutex> lock(_mutex);
+	_syncInterval = Timespan(ms*Timespan::MILLISECONDS);
+}
+
+
+} // namespace Poco
@@ -0,0 +1,137 @@
+//
+// MappedLogFile.cpp
+//
+// Library: Foundation
+// Package: Logging
+// Module:  MappedLogFile
+//
+// Copyright (c) 2004-2023, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "Poco/MappedLogFile.h"
+#include "Poco/File.h"
+#include "Poco/Exception.h"
+#include "Poco/Error.h"
+#include <cstring>
+#if POCO_OS == POCO_OS_LINUX || POCO_OS == POCO_OS_ANDROID || POCO_OS == POCO_OS_FREE_BSD
+#include <fcntl.h>
+#include <unistd.h>
+#include <cerrno>
+#define POCO_HAVE_POSIX_FALLOCATE 1
+#endif
+
+
+namespace Poco {
+
+
+MappedLogFile::MappedLogFile(const std::string& path, UInt64 segmentSize, const Timespan& syncInterval):
+	LogFile(path),
+	_segmentSize(segmentSize),
+	_syncInterval(syncInterval),
+	_size(0),
+	_capacity(0)
+{
+	if (segmentSize == 0) throw InvalidArgumentException("segment size must be greater than zero");
+
+	File file(path);
+	file.createFile();
+	UInt64 fileSize = file.getSize();
+	UInt64 capacity = _segmentSize;
+	while (capacity < fileSize) capacity += _segmentSize;
+	map(capacity);
+
+	// skip the zero bytes left behind if the file has not been closed properly
+	const char* begin = _memory.begin();
+	const char* end = begin + fileSize;
+	while (end != begin && *(end - 1) == 0) --end;
+	_size = static_cast<UInt64>(end - begin);
+}
+
+
+MappedLogFile::~MappedLogFile()
+{
+	try
+	{
+		sync();
+		unmap();
+		File(path()).setSize(_size);
+	}
+	catch (...)
+	{
+		poco_unexpected();
+	}
+}
+
+
+void MappedLogFile::write(const std::string& text, bool flush)
+{
+	UInt64 length = text.size() + 1;
+	if (_size + length > _capacity)
+	{
+		UInt64 capacity = _capacity + _segmentSize;
+		while (capacity < _size + length) capacity += _segmentSize;
+		// the current mapping is kept if the file cannot be extended
+		map(capacity);
+	}
+	char* p = _memory.begin() + _size;
+	std::memcpy(p, text.data(), text.size());
+	p[text.size()] = '\n';
+	_size += length;
+
+	if (flush || _lastSync.isElapsed(_syncInterval.totalMicroseconds()))
+		sync();
+}
+
+
+void MappedLogFile::sync()
+{
+	_memory.flush();
+	_lastSync.update();
+}
+
+
+void MappedLogFile::map(UInt64 capacity)
+{
+	reserve(capacity);
+	File file(path());
+	SharedMemory memory(file, SharedMemory::AM_WRITE);
+	if (!memory.begin()) throw NotImplementedException("Memory-mapped log files", path());
+	_memory.swap(memory);
+	_capacity = capacity;
+}
+
+
+void MappedLogFile::reserve(UInt64 capacity)
+{
+#if defined(POCO_HAVE_POSIX_FALLOCATE)
+	// Allocate the disk space now. If the file were only extended
+	// (leaving a sparse file), running out of disk space would
+	// later raise a SIGBUS when writing to the mapping.
+	int fd = ::open(path().c_str(), O_WRONLY | O_CLOEXEC);
+	if (fd < 0)
+	{
+		int err = errno;
+		throw FileException(Error::getMessage(err), path(), err);
+	}
+	int rc = ::posix_fallocate(fd, 0, static_cast<off_t>(capacity));
+	::close(fd);
+	if (rc == 0) return;
+	if (rc != EOPNOTSUPP) throw FileException(Error::getMessage(rc), path(), rc);
+#endif
+	File file(path());
+	if (file.getSize() < capacity) file.setSize(capacity);
+}
+
+
+void MappedLogFile::unmap()
+{
+	SharedMemory().swap(_memory);
+	_capacity = 0;
+}
+
+
+} // namespace Poco
@@ -147,8 +147,30 @@ Message& Message::operator = (const Message& msg)
 {
 	if (&msg != this)
 	{
-		Message tmp(msg);
-		swap(tmp);
+		// Assign member-wise, so that the strings can reuse
+		// their existing capacity (see AsyncChannel).
+		_source = msg._source;
+		_text = msg._text;
+		_prio = msg._prio;
+		_time = msg._time;
+		_tid = msg._tid;
+		_ostid = msg._ostid;
+		_thread = msg._thread;
+		_pid = msg._pid;
+		_file = msg._file;
+		_line = msg._line;
+		if (msg._pMap)
+		{
+			if (_pMap)
+				*_pMap = *msg._pMap;
+			else
+				_pMap = new StringMap(*msg._pMap);
+		}
+		else
+		{
+			delete _pMap;
+			_pMap = 0;
+		}
 	}
 	return *this;
 }
@@ -24,6 +24,9 @@
 #include "Poco/NumberParser.h"
 #include "Poco/StringTokenizer.h"
 #include "Poco/Path.h"
+#include "Poco/Exception.h"
+#include <atomic>
+#include <cstring>
 
 
 namespace Poco {
@@ -32,9 +35,129 @@ namespace Poco {
 const std::string PatternFormatter::PROP_PATTERN = "pattern";
 const std::string PatternFormatter::PROP_TIMES   = "times";
 const std::string PatternFormatter::PROP_PRIORITY_NAMES = "priorityNames";
+const std::string PatternFormatter::PROP_COMPILED = "compiled";
+const std::string PatternFormatter::PROP_OUTPUT = "output";
 const std::string PatternFormatter::DEFAULT_PRIORITY_NAMES = "Fatal,Critical,Error,Warning,Notice,Information,Debug,Trace";
 
+
+namespace
+{
+	struct FormatCache
+		/// The date/time fields rendered by the compiled pattern
+		/// with the given generation for the given second.
+	{
+		Poco::UInt64 generation = 0;
+		Timestamp::TimeVal second = 0;
+		std::vector<std::string> blocks;
+		std::string scratch;
+	};
+
+	class FormatCacheSet
+		/// The FormatCaches of the compiled patterns most recently
+		/// used by a thread. Threads typically use only a few
+		/// formatters, so a few caches, replaced in turn, suffice.
+	{
+	public:
+		FormatCache& get(Poco::UInt64 generation)
+			/// Returns the cache for the given generation, or the
+			/// one to be replaced if there is none.
+		{
+			for (auto& cache: _caches)
+			{
+				if (cache.generation == generation) return cache;
+			}
+			FormatCache& cache = _caches[_next];
+			_next = (_next + 1) % SIZE;
+			return cache;
+		}
+
+	private:
+		enum
+		{
+			SIZE = 8
+		};
+
+		FormatCache _caches[SIZE];
+		int _next = 0;
+	};
+
+	thread_local FormatCacheSet formatCaches;
+	std::atomic<Poco::UInt64> compileGeneration(0);
+
+	bool isMessageField(char key)
+	{
+		return key != 0 && std::strchr("sltpqPTIJNUOuvx", key) != 0;
+	}
+
+	bool isSubSecondField(char key)
+	{
+		return key == 'i' || key == 'c' || key == 'F';
+	}
+
+	bool isTimeField(char key)
+	{
+		return key != 0 && std::strchr("wWbBdefmnoyYHhaAMSicFzZE", key) != 0;
+	}
+
+	bool isNumericField(char key)
+	{
+		return key == 'l' || key == 'P' || key == 'I' || key == 'J' || key == 'u';
+	}
+
+	const char* jsonName(char key)
+	{
+		switch (key)
+		{
+		case 's': case 'v': return "source";
+		case 't': return "text";
+		case 'l': return "level";
+		case 'p': case 'q': return "priority";
+		case 'P': return "pid";
+		case 'T': return "thread";
+		case 'I': return "tid";
+		case 'J': return "ostid";
+		case 'N': return "node";
+		case 'U': case 'O': return "file";
+		case 'u': return "line";
+		default: return "";
+		}
+	}
+
+	void appendJSON(std::string& text, const std::string& value)
+		/// Appends value to text, escaping all characters
+		/// that must be escaped in a JSON string.
+	{
+		static const char hex[] = "0123456789abcdef";
+		for (char c: value)
+		{
+			switch (c)
+			{
+			case '"':  text += "\\\""; break;
+			case '\\': text += "\\\\"; break;
+			case '\b': text += "\\b"; break;
+			case '\f': text += "\\f"; break;
+			case '\n': text += "\\n"; break;
+			case '\r': text += "\\r"; break;
+			case '\t': text += "\\t"; break;
+			default:
+				if (static_cast<unsigned char>(c) < 0x20)
+				{
+					text += "\\u00";
+					text += hex[(c >> 4) & 0x0F];
+					text += hex[c & 0x0F];
+				}
+				else text += c;
+			}
+		}
+	}
+}
+
+
 PatternFormatter::PatternFormatter():
+	_cachedCount(0),
+	_generation(0),
+	_compiled(false),
+	_json(false),
 	_localTime(false),
 	_priorityNames(DEFAULT_PRIORITY_NAMES)
 {
@@ -43,12 +166,17 @@ PatternFormatter::PatternFormatter():
 
 
 PatternFormatter::PatternFormatter(const std::string& format):
+	_cachedCount(0),
+	_generation(0),
+	_compiled(false),
+	_json(false),
 	_localTime(false),
 	_pattern(format),
 	_priorityNames(DEFAULT_PRIORITY_NAMES)
 {
 	parsePriorityNames();
 	parsePattern();
+	compilePattern();
 }
 
 
@@ -59,6 +187,12 @@ PatternFormatter::~PatternFormatter()
 
 void PatternFormatter::format(const Message& msg, std::string& text)
 {
+	if (_compiled || _json)
+	{
+		formatCompiled(msg, text);
+		return;
+	}
+
 	Timestamp timestamp = msg.getTime();
 	bool localTime = _localTime;
 	if (localTime)
@@ -70,63 +204,8 @@ void PatternFormatter::format(const Message& msg, std::string& text)
 	for (auto& pa:_patternActions)
 	{
 		text.append(pa.prepend);
-		switch (pa.key)
+		if (pa.key == 'L')
 		{
-		case 's': text.append(msg.getSource()); break;
-		case 't': text.append(msg.getText()); break;
-		case 'l': NumberFormatter::append(text, (int) msg.getPriority()); break;
-		case 'p': text.append(getPriorityName((int) msg.getPriority())); break;
-		case 'q': text += getPriorityName((int) msg.getPriority()).at(0); break;
-		case 'P': NumberFormatter::append(text, msg.getPid()); break;
-		case 'T': text.append(msg.getThread()); break;
-		case 'I': NumberFormatter::append(text, msg.getTid()); break;
-		case 'J': NumberFormatter::append(text, msg.getOsTid()); break;
-		case 'N': text.append(Environment::nodeName()); break;
-		case 'U': text.append(msg.getSourceFile() ? msg.getSourceFile() : ""); break;
-		case 'O': text.append(msg.getSourceFile() ? Path(msg.getSourceFile()).getFileName() : ""); break;
-		case 'u': NumberFormatter::append(text, msg.getSourceLine()); break;
-		case 'w': text.append(DateTimeFormat::WEEKDAY_NAMES[dateTime.dayOfWeek()], 0, 3); break;
-		case 'W': text.append(DateTimeFormat::WEEKDAY_NAMES[dateTime.dayOfWeek()]); break;
-		case 'b': text.append(DateTimeFormat::MONTH_NAMES[dateTime.month() - 1], 0, 3); break;
-		case 'B': text.append(DateTimeFormat::MONTH_NAMES[dateTime.month() - 1]); break;
-		case 'd': NumberFormatter::append0(text, dateTime.day(), 2); break;
-		case 'e': NumberFormatter::append(text, dateTime.day()); break;
-		case 'f': NumberFormatter::append(text, dateTime.day(), 2); break;
-		case 'm': NumberFormatter::append0(text, dateTime.month(), 2); break;
-		case 'n': NumberFormatter::append(text, dateTime.month()); break;
-		case 'o': NumberFormatter::append(text, dateTime.month(), 2); break;
-		case 'y': NumberFormatter::append0(text, dateTime.year() % 100, 2); break;
-		case 'Y': NumberFormatter::append0(text, dateTime.year(), 4); break;
-		case 'H': NumberFormatter::append0(text, dateTime.hour(), 2); break;
-		case 'h': NumberFormatter::append0(text, dateTime.hourAMPM(), 2); break;
-		case 'a': text.append(dateTime.isAM() ? "am" : "pm"); break;
-		case 'A': text.append(dateTime.isAM() ? "AM" : "PM"); break;
-		case 'M': NumberFormatter::append0(text, dateTime.minute(), 2); break;
-		case 'S': NumberFormatter::append0(text, dateTime.second(), 2); break;
-		case 'i': NumberFormatter::append0(text, dateTime.millisecond(), 3); break;
-		case 'c': NumberFormatter::append(text, dateTime.millisecond()/100); break;
-		case 'F': NumberFormatter::append0(text, dateTime.millisecond()*1000 + dateTime.microsecond(), 6); break;
-		case 'z': text.append(DateTimeFormatter::tzdISO(localTime ? Timezone::tzd() : DateTimeFormatter::UTC)); break;
-		case 'Z': text.append(DateTimeFormatter::tzdRFC(localTime ? Timezone::tzd() : DateTimeFormatter::UTC)); break;
-		case 'E': NumberFormatter::append(text, msg.getTime().epochTime()); break;
-		case 'v':
-			if (pa.length > msg.getSource().length())	//append spaces
-				text.append(msg.getSource()).append(pa.length - msg.getSource().length(), ' ');
-			else if (pa.length && pa.length < msg.getSource().length()) // crop
-				text.append(msg.getSource(), msg.getSource().length()-pa.length, pa.length);
-			else
-				text.append(msg.getSource());
-			break;
-		case 'x':
-			try
-			{
-				text.append(msg[pa.property]);
-			}
-			catch (...)
-			{
-			}
-			break;
-		case 'L':
 			if (!localTime)
 			{
 				localTime = true;
@@ -134,12 +213,156 @@ void PatternFormatter::format(const Message& msg, std::string& text)
 				timestamp += Timezone::dst()*Timestamp::resolution();
 				dateTime = timestamp;
 			}
+		}
+		else if (!appendMessageField(pa, msg, text))
+		{
+			appendTimeField(pa.key, msg, dateTime, localTime, text);
+		}
+	}
+}
+
+
+void PatternFormatter::formatCompiled(const Message& msg, std::string& text)
+{
+	FormatCache& cache = formatCaches.get(_generation);
+	Timestamp::TimeVal micros = msg.getTime().epochMicroseconds();
+	Timestamp::TimeVal fraction = micros % Timestamp::resolution();
+	if (fraction < 0) fraction += Timestamp::resolution();
+	Timestamp::TimeVal second = (micros - fraction)/Timestamp::resolution();
+
+	if (cache.generation != _generation || cache.second != second)
+	{
+		cache.blocks.resize(_cachedCount);
+		for (const auto& ca: _compiledActions)
+		{
+			if (ca.type != CompiledAction::CACHED) continue;
+
+			Timestamp timestamp(second*Timestamp::resolution());
+			if (ca.localTime)
+			{
+				timestamp += Timezone::utcOffset()*Timestamp::resolution();
+				timestamp += Timezone::dst()*Timestamp::resolution();
+			}
+			DateTime dateTime = timestamp;
+			std::string& block = cache.blocks[ca.slot];
+			block.clear();
+			for (const auto& pa: ca.actions)
+			{
+				block.append(pa.prepend);
+				appendTimeField(pa.key, msg, dateTime, ca.localTime, block);
+			}
+		}
+		cache.generation = _generation;
+		cache.second = second;
+	}
+
+	for (const auto& ca: _compiledActions)
+	{
+		switch (ca.type)
+		{
+		case CompiledAction::LITERAL:
+			text.append(ca.text);
+			break;
+		case CompiledAction::CACHED:
+			text.append(cache.blocks[ca.slot]);
+			break;
+		case CompiledAction::FIELD:
+			switch (ca.action.key)
+			{
+			case 'i': NumberFormatter::append0(text, static_cast<int>(fraction/1000), 3); break;
+			case 'c': NumberFormatter::append(text, static_cast<int>(fraction/100000)); break;
+			case 'F': NumberFormatter::append0(text, static_cast<int>(fraction), 6); break;
+			default:
+				if (ca.json)
+				{
+					cache.scratch.clear();
+					appendMessageField(ca.action, msg, cache.scratch);
+					text += '"';
+					appendJSON(text, cache.scratch);
+					text += '"';
+				}
+				else appendMessageField(ca.action, msg, text);
+				break;
+			}
 			break;
 		}
 	}
 }
 
 
+bool PatternFormatter::appendMessageField(const PatternAction& pa, const Message& msg, std::string& text)
+{
+	switch (pa.key)
+	{
+	case 's': text.append(msg.getSource()); break;
+	case 't': text.append(msg.getText()); break;
+	case 'l': NumberFormatter::append(text, (int) msg.getPriority()); break;
+	case 'p': text.append(getPriorityName((int) msg.getPriority())); break;
+	case 'q': text += getPriorityName((int) msg.getPriority()).at(0); break;
+	case 'P': NumberFormatter::append(text, msg.getPid()); break;
+	case 'T': text.append(msg.getThread()); break;
+	case 'I': NumberFormatter::append(text, msg.getTid()); break;
+	case 'J': NumberFormatter::append(text, msg.getOsTid()); break;
+	case 'N': text.append(Environment::nodeName()); break;
+	case 'U': text.append(msg.getSourceFile() ? msg.getSourceFile() : ""); break;
+	case 'O': text.append(msg.getSourceFile() ? Path(msg.getSourceFile()).getFileName() : ""); break;
+	case 'u': NumberFormatter::append(text, msg.getSourceLine()); break;
+	case 'v':
+		if (pa.length > msg.getSource().length())	//append spaces
+			text.append(msg.getSource()).append(pa.length - msg.getSource().length(), ' ');
+		else if (pa.length && pa.length < msg.getSource().length()) // crop
+			text.append(msg.getSource(), msg.getSource().length()-pa.length, pa.length);
+		else
+			text.append(msg.getSource());
+		break;
+	case 'x':
+		try
+		{
+			text.append(msg[pa.property]);
+		}
+		catch (...)
+		{
+		}
+		break;
+	default:
+		return false;
+	}
+	return true;
+}
+
+
+void PatternFormatter::appendTimeField(char key, const Message& msg, const DateTime& dateTime, bool localTime, std::string& text)
+{
+	switch (key)
+	{
+	case 'w': text.append(DateTimeFormat::WEEKDAY_NAMES[dateTime.dayOfWeek()], 0, 3); break;
+	case 'W': text.append(DateTimeFormat::WEEKDAY_NAMES[dateTime.dayOfWeek()]); break;
+	case 'b': text.append(DateTimeFormat::MONTH_NAMES[dateTime.month() - 1], 0, 3); break;
+	case 'B': text.append(DateTimeFormat::MONTH_NAMES[dateTime.month() - 1]); break;
+	case 'd': NumberFormatter::append0(text, dateTime.day(), 2); break;
+	case 'e': NumberFormatter::append(text, dateTime.day()); break;
+	case 'f': NumberFormatter::append(text, dateTime.day(), 2); break;
+	case 'm': NumberFormatter::append0(text, dateTime.month(), 2); break;
+	case 'n': NumberFormatter::append(text, dateTime.month()); break;
+	case 'o': NumberFormatter::append(text, dateTime.month(), 2); break;
+	case 'y': NumberFormatter::append0(text, dateTime.year() % 100, 2); break;
+	case 'Y': NumberFormatter::append0(text, dateTime.year(), 4); break;
+	case 'H': NumberFormatter::append0(text, dateTime.hour(), 2); break;
+	case 'h': NumberFormatter::append0(text, dateTime.hourAMPM(), 2); break;
+	case 'a': text.append(dateTime.isAM() ? "am" : "pm"); break;
+	case 'A': text.append(dateTime.isAM() ? "AM" : "PM"); break;
+	case 'M': NumberFormatter::append0(text, dateTime.minute(), 2); break;
+	case 'S': NumberFormatter::append0(text, dateTime.second(), 2); break;
+	case 'i': NumberFormatter::append0(text, dateTime.millisecond(), 3); break;
+	case 'c': NumberFormatter::append(text, dateTime.millisecond()/100); break;
+	case 'F': NumberFormatter::append0(text, dateTime.millisecond()*1000 + dateTime.microsecond(), 6); break;
+	case 'z': text.append(DateTimeFormatter::tzdISO(localTime ? Timezone::tzd() : DateTimeFormatter::UTC)); break;
+	case 'Z': text.append(DateTimeFormatter::tzdRFC(localTime ? Timezone::tzd() : DateTimeFormatter::UTC)); break;
+	case 'E': NumberFormatter::append(text, msg.getTime().epochTime()); break;
+	}
+}
+
+
 void PatternFormatter::parsePattern()
 {
 	_patternActions.clear();
@@ -199,16 +422,163 @@ void PatternFormatter::parsePattern()
 }
 
 
+void PatternFormatter::compilePattern()
+{
+	_compiledActions.clear();
+	_cachedCount = 0;
+	_generation = ++compileGeneration;
+
+	bool localTime = _localTime;
+	bool first = true;
+	bool inTimestamp = false;
+	std::string pending;
+	if (_json) addLiteral("{");
+	for (const auto& pa: _patternActions)
+	{
+		pending += pa.prepend;
+		if (pa.key == 'L')
+		{
+			localTime = true;
+		}
+		else if (isTimeField(pa.key))
+		{
+			std::string prepend;
+			if (_json)
+			{
+				if (!inTimestamp)
+				{
+					pending.clear();
+					addLiteral(first ? "\"timestamp\":\"" : ",\"timestamp\":\"");
+					first = false;
+					inTimestamp = true;
+				}
+				appendJSON(prepend, pending);
+			}
+			else prepend = pending;
+			pending.clear();
+
+			PatternAction action(pa);
+			action.prepend = prepend;
+			if (isSubSecondField(pa.key))
+			{
+				addLiteral(prepend);
+				CompiledAction ca;
+				ca.type = CompiledAction::FIELD;
+				ca.action = pa;
+				_compiledActions.push_back(ca);
+			}
+			else addCached(action, localTime);
+		}
+		else if (isMessageField(pa.key))
+		{
+			if (_json)
+			{
+				if (inTimestamp)
+				{
+					addLiteral("\"");
+					inTimestamp = false;
+				}
+				pending.clear();
+				std::string name(first ? "\"" : ",\"");
+				appendJSON(name, pa.key == 'x' ? pa.property : std::string(jsonName(pa.key)));
+				name += "\":";
+				addLiteral(name);
+				first = false;
+			}
+			else
+			{
+				addLiteral(pending);
+				pending.clear();
+			}
+			if (pa.key == 'N')
+			{
+				// the node name does not change, so it is
+				// resolved once, when compiling the pattern
+				if (_json)
+				{
+					std::string node("\"");
+					appendJSON(node, Environment::nodeName());
+					node += '"';
+					addLiteral(node);
+				}
+				else addLiteral(Environment::nodeName());
+			}
+			else
+			{
+				CompiledAction ca;
+				ca.type = CompiledAction::FIELD;
+				ca.json = _json && !isNumericField(pa.key);
+				ca.action = pa;
+				_compiledActions.push_back(ca);
+			}
+		}
+	}
+	if (_json)
+	{
+		if (inTimestamp) addLiteral("\"");
+		addLiteral("}");
+	}
+	else addLiteral(pending);
+}
+
+
+void PatternFormatter::addLiteral(const std::string& text)
+{
+	if (text.empty()) return;
+
+	if (!_compiledActions.empty() && _compiledActions.back().type == CompiledAction::LITERAL)
+	{
+		_compiledActions.back().text += text;
+	}
+	else
+	{
+		CompiledAction ca;
+		ca.text = text;
+		_compiledActions.push_back(ca);
+	}
+}
+
+
+void PatternFormatter::addCached(const PatternAction& pa, bool localTime)
+{
+	if (_compiledActions.empty() || _compiledActions.back().type != CompiledAction::CACHED || _compiledActions.back().localTime != localTime)
+	{
+		CompiledAction ca;
+		ca.type = CompiledAction::CACHED;
+		ca.localTime = localTime;
+		ca.slot = _cachedCount++;
+		_compiledActions.push_back(ca);
+	}
+	_compiledActions.back().actions.push_back(pa);
+}
+
+
 void PatternFormatter::setProperty(const std::string& name, const std::string& value)
 {
 	if (name == PROP_PATTERN)
 	{
 		_pattern = value;
 		parsePattern();
+		compilePattern();
 	}
 	else if (name == PROP_TIMES)
 	{
 		_localTime = (value == "local");
+		compilePattern();
+	}
+	else if (name == PROP_COMPILED)
+	{
+		_compiled = (value == "true");
+	}
+	else if (name == PROP_OUTPUT)
+	{
+		if (value == "json")
+			_json = true;
+		else if (value == "text")
+			_json = false;
+		else
+			throw InvalidArgumentException("PatternFormatter output", value);
+		compilePattern();
 	}
 	else if (name == PROP_PRIORITY_NAMES)
 	{
@@ -230,6 +600,10 @@ std::string PatternFormatter::getProperty(const std::string& name) const
 		return _localTime ? "local" : "UTC";
 	else if (name == PROP_PRIORITY_NAMES)
 		return _priorityNames;
+	else if (name == PROP_COMPILED)
+		return _compiled ? "true" : "false";
+	else if (name == PROP_OUTPUT)
+		return _json ? "json" : "text";
 	else
 		return Formatter::getProperty(name);
 }
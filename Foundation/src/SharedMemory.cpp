@@ -87,4 +87,10 @@ char* SharedMemory::end() const
 }
 
 
+void SharedMemory::flush()
+{
+	if (_pImpl) _pImpl->flush();
+}
+
+
 } // namespace Poco
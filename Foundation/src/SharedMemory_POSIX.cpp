@@ -108,6 +108,16 @@ void SharedMemoryImpl::map(const void* addrHint)
 }
 
 
+void SharedMemoryImpl::flush()
+{
+	if (_address && _fileMapped && _access == SharedMemory::AM_WRITE)
+	{
+		if (::msync(_address, _size, MS_SYNC) != 0)
+			throw SystemException("Cannot flush memory mapped file", _name);
+	}
+}
+
+
 void SharedMemoryImpl::unmap()
 {
 	if (_address)
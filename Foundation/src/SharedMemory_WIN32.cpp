@@ -124,6 +124,16 @@ void SharedMemoryImpl::map()
 }
 
 
+void SharedMemoryImpl::flush()
+{
+	if (_address && _fileHandle != INVALID_HANDLE_VALUE && _mode == PAGE_READWRITE)
+	{
+		if (!FlushViewOfFile(_address, 0) || !FlushFileBuffers(_fileHandle))
+			throw SystemException("Cannot flush memory mapped file", _name);
+	}
+}
+
+
 void SharedMemoryImpl::unmap()
 {
 	if (_address)
@@ -87,6 +87,17 @@ void SplitterChannel::log(const Message& msg)
 }
 
 
+void SplitterChannel::logBatch(const MessageBatch& batch)
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+
+	for (auto& p: _channels)
+	{
+		p->logBatch(batch);
+	}
+}
+
+
 void SplitterChannel::close()
 {
 	std::lock_guard<std::mutex> lock(_mutex);
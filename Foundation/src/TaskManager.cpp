@@ -15,6 +15,7 @@
 #include "Poco/TaskManager.h"
 #include "Poco/TaskNotification.h"
 #include "Poco/ThreadPool.h"
+#include "Poco/WorkStealingExecutor.h"
 #include "Poco/Timespan.h"
 
 
@@ -29,7 +30,8 @@ TaskManager::TaskManager(const std::string& name,
 		int maxCapacity,
 		int idleTime,
 		int stackSize):
-	_threadPool(*new ThreadPool(name, minCapacity, maxCapacity, idleTime, stackSize)),
+	_pThreadPool(new ThreadPool(name, minCapacity, maxCapacity, idleTime, stackSize)),
+	_pExecutor(0),
 	_ownPool(true)
 {
 	// prevent skipping the first progress update
@@ -38,7 +40,18 @@ TaskManager::TaskManager(const std::string& name,
 
 
 TaskManager::TaskManager(ThreadPool& pool):
-	_threadPool(pool),
+	_pThreadPool(&pool),
+	_pExecutor(0),
+	_ownPool(false)
+{
+	// prevent skipping the first progress update
+	_lastProgressNotification -= Timespan(MIN_PROGRESS_NOTIFICATION_INTERVAL*2);
+}
+
+
+TaskManager::TaskManager(WorkStealingExecutor& executor):
+	_pThreadPool(0),
+	_pExecutor(&executor),
 	_ownPool(false)
 {
 	// prevent skipping the first progress update
@@ -48,7 +61,7 @@ TaskManager::TaskManager(ThreadPool& pool):
 
 TaskManager::~TaskManager()
 {
-	if (_ownPool) delete &_threadPool;
+	if (_ownPool) delete _pThreadPool;
 }
 
 
@@ -62,7 +75,10 @@ void TaskManager::start(Task* pTask)
 	_taskList.push_back(pAutoTask);
 	try
 	{
-		_threadPool.start(*pAutoTask, pAutoTask->name());
+		if (_pExecutor)
+			_pExecutor->start(*pAutoTask);
+		else
+			_pThreadPool->start(*pAutoTask, pAutoTask->name());
 	}
 	catch (...)
 	{
@@ -88,7 +104,10 @@ void TaskManager::cancelAll()
 
 void TaskManager::joinAll()
 {
-	_threadPool.joinAll();
+	if (_pExecutor)
+		_pExecutor->joinAll();
+	else
+		_pThreadPool->joinAll();
 }
 
 
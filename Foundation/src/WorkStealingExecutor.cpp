@@ -0,0 +1,355 @@
+//
+// WorkStealingExecutor.cpp
+//
+// Library: Foundation
+// Package: Threading
+// Module:  WorkStealingExecutor
+//
+// Copyright (c) 2005-2023, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "Poco/WorkStealingExecutor.h"
+#include "Poco/Runnable.h"
+#include "Poco/Environment.h"
+#include "Poco/ErrorHandler.h"
+#include "Poco/Exception.h"
+#include "Poco/SingletonHolder.h"
+#include "Poco/NumberFormatter.h"
+
+
+namespace Poco {
+
+
+class WorkStealingExecutor::Worker: public Runnable
+{
+public:
+	Worker(WorkStealingExecutor& executor, int index):
+		_executor(executor),
+		_index(index),
+		_seed(static_cast<Poco::UInt32>(index)*2654435761U + 1)
+	{
+	}
+
+	void run()
+	{
+		_executor.work(*this);
+	}
+
+	int index() const
+	{
+		return _index;
+	}
+
+	Poco::UInt32 random()
+		/// Returns a pseudo random number (xorshift).
+	{
+		_seed ^= _seed << 13;
+		_seed ^= _seed >> 17;
+		_seed ^= _seed << 5;
+		return _seed;
+	}
+
+	Thread thread;
+	std::mutex mutex;
+	std::deque<Task> tasks; // owner takes from the back, thieves from the front
+
+private:
+	WorkStealingExecutor& _executor;
+	int _index;
+	Poco::UInt32 _seed;
+};
+
+
+namespace
+{
+	thread_local WorkStealingExecutor* pCurrentExecutor = 0;
+	thread_local int currentWorker = -1;
+}
+
+
+WorkStealingExecutor::WorkStealingExecutor(int threads, int stackSize):
+	_queued(0),
+	_submitted(0),
+	_completed(0),
+	_steals(0),
+	_pending(0),
+	_idle(0),
+	_stopped(false),
+	_wakeUps(0)
+{
+	init(threads, stackSize);
+}
+
+
+WorkStealingExecutor::WorkStealingExecutor(const std::string& name, int threads, int stackSize):
+	_name(name),
+	_queued(0),
+	_submitted(0),
+	_completed(0),
+	_steals(0),
+	_pending(0),
+	_idle(0),
+	_stopped(false),
+	_wakeUps(0)
+{
+	init(threads, stackSize);
+}
+
+
+WorkStealingExecutor::~WorkStealingExecutor()
+{
+	try
+	{
+		stopAll();
+	}
+	catch (...)
+	{
+		poco_unexpected();
+	}
+}
+
+
+void WorkStealingExecutor::init(int threads, int stackSize)
+{
+	if (threads <= 0) threads = static_cast<int>(Environment::processorCount());
+	if (threads <= 0) threads = 1;
+
+	_workers.reserve(threads);
+	for (int i = 0; i < threads; i++)
+	{
+		_workers.emplace_back(new Worker(*this, i));
+	}
+	for (auto& pWorker: _workers)
+	{
+		std::string threadName(_name.empty() ? std::string("WorkStealingExecutor") : _name);
+		threadName += '[';
+		NumberFormatter::append(threadName, pWorker->index());
+		threadName += ']';
+		pWorker->thread.setName(threadName);
+		pWorker->thread.setStackSize(stackSize);
+		pWorker->thread.start(*pWorker);
+	}
+}
+
+
+void WorkStealingExecutor::start(Runnable& target)
+{
+	Runnable* pTarget = &target;
+	submit([pTarget]() { pTarget->run(); });
+}
+
+
+void WorkStealingExecutor::startFunc(Task task)
+{
+	poco_assert (task);
+
+	submit(std::move(task));
+}
+
+
+void WorkStealingExecutor::submit(Task&& task)
+{
+	if (_stopped) throw IllegalStateException("WorkStealingExecutor has been stopped");
+
+	_pending.fetch_add(1, std::memory_order_relaxed);
+	_submitted.fetch_add(1, std::memory_order_relaxed);
+	_queued.fetch_add(1, std::memory_order_relaxed);
+
+	if (pCurrentExecutor == this)
+	{
+		Worker& worker = *_workers[currentWorker];
+		std::lock_guard<std::mutex> lock(worker.mutex);
+		worker.tasks.push_back(std::move(task));
+	}
+	else
+	{
+		std::lock_guard<std::mutex> lock(_injectionMutex);
+		_injectionQueue.push_back(std::move(task));
+	}
+	wakeUp();
+}
+
+
+void WorkStealingExecutor::wakeUp()
+{
+	// Pairs with the increment of _idle in work(): either the
+	// worker finds the new task, or we see the idle worker.
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	if (_idle.load(std::memory_order_relaxed) > 0)
+	{
+		{
+			std::lock_guard<std::mutex> lock(_idleMutex);
+			++_wakeUps;
+		}
+		_idleCondition.notify_one();
+	}
+}
+
+
+bool WorkStealingExecutor::takeTask(Worker& worker, Task& task)
+{
+	{
+		std::lock_guard<std::mutex> lock(worker.mutex);
+		if (!worker.tasks.empty())
+		{
+			task = std::move(worker.tasks.back());
+			worker.tasks.pop_back();
+			return true;
+		}
+	}
+	{
+		std::lock_guard<std::mutex> lock(_injectionMutex);
+		if (!_injectionQueue.empty())
+		{
+			task = std::move(_injectionQueue.front());
+			_injectionQueue.pop_front();
+			return true;
+		}
+	}
+	return stealTask(worker, task);
+}
+
+
+bool WorkStealingExecutor::stealTask(Worker& worker, Task& task)
+{
+	const std::size_t n = _workers.size();
+	if (n < 2) return false;
+
+	std::size_t start = worker.random() % n;
+	for (std::size_t i = 0; i < n; i++)
+	{
+		Worker& victim = *_workers[(start + i) % n];
+		if (&victim == &worker) continue;
+
+		std::lock_guard<std::mutex> lock(victim.mutex);
+		if (!victim.tasks.empty())
+		{
+			task = std::move(victim.tasks.front());
+			victim.tasks.pop_front();
+			_steals.fetch_add(1, std::memory_order_relaxed);
+			return true;
+		}
+	}
+	return false;
+}
+
+
+void WorkStealingExecutor::runTask(Task& task)
+{
+	_queued.fetch_sub(1, std::memory_order_relaxed);
+	try
+	{
+		task();
+	}
+	catch (Exception& exc)
+	{
+		ErrorHandler::handle(exc);
+	}
+	catch (std::exception& exc)
+	{
+		ErrorHandler::handle(exc);
+	}
+	catch (...)
+	{
+		ErrorHandler::handle();
+	}
+	task = nullptr;
+	_completed.fetch_add(1, std::memory_order_relaxed);
+	if (_pending.fetch_sub(1, std::memory_order_acq_rel) == 1)
+	{
+		std::lock_guard<std::mutex> lock(_doneMutex);
+		_doneCondition.notify_all();
+	}
+}
+
+
+void WorkStealingExecutor::work(Worker& worker)
+{
+	pCurrentExecutor = this;
+	currentWorker = worker.index();
+	Task task;
+	for (;;)
+	{
+		if (takeTask(worker, task))
+		{
+			runTask(task);
+			continue;
+		}
+
+		Poco::UInt64 wakeUps;
+		{
+			std::lock_guard<std::mutex> lock(_idleMutex);
+			wakeUps = _wakeUps;
+		}
+		_idle.fetch_add(1, std::memory_order_seq_cst);
+		if (takeTask(worker, task))
+		{
+			_idle.fetch_sub(1, std::memory_order_relaxed);
+			runTask(task);
+			continue;
+		}
+		{
+			std::unique_lock<std::mutex> lock(_idleMutex);
+			_idleCondition.wait(lock, [this, wakeUps]() { return _wakeUps != wakeUps || _stopped; });
+		}
+		_idle.fetch_sub(1, std::memory_order_relaxed);
+		if (_stopped && _pending.load(std::memory_order_acquire) == 0) break;
+	}
+	pCurrentExecutor = 0;
+	currentWorker = -1;
+}
+
+
+void WorkStealingExecutor::joinAll()
+{
+	std::unique_lock<std::mutex> lock(_doneMutex);
+	_doneCondition.wait(lock, [this]() { return _pending.load(std::memory_order_acquire) == 0; });
+}
+
+
+void WorkStealingExecutor::stopAll()
+{
+	joinAll();
+	if (_stopped.exchange(true)) return;
+
+	{
+		std::lock_guard<std::mutex> lock(_idleMutex);
+		++_wakeUps;
+	}
+	_idleCondition.notify_all();
+	for (auto& pWorker: _workers)
+	{
+		pWorker->thread.join();
+	}
+}
+
+
+WorkStealingExecutor::Statistics WorkStealingExecutor::statistics() const
+{
+	Statistics stats;
+	stats.submitted = _submitted.load(std::memory_order_relaxed);
+	stats.completed = _completed.load(std::memory_order_relaxed);
+	stats.steals = _steals.load(std::memory_order_relaxed);
+	stats.queued = _queued.load(std::memory_order_relaxed);
+	stats.idle = _idle.load(std::memory_order_relaxed);
+	return stats;
+}
+
+
+namespace
+{
+	static SingletonHolder<WorkStealingExecutor> sh;
+}
+
+
+WorkStealingExecutor& WorkStealingExecutor::defaultExecutor()
+{
+	return *sh.get();
+}
+
+
+} // namespace Poco
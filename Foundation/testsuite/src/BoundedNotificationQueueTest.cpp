@@ -0,0 +1,279 @@
+//
+// BoundedNotificationQueueTest.cpp
+//
+// Copyright (c) 2005-2023, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "BoundedNotificationQueueTest.h"
+#include "CppUnit/TestCaller.h"
+#include "CppUnit/TestSuite.h"
+#include "Poco/BoundedNotificationQueue.h"
+#include "Poco/Notification.h"
+#include "Poco/Thread.h"
+#include "Poco/Runnable.h"
+#include "Poco/RunnableAdapter.h"
+#include "Poco/Stopwatch.h"
+#include <atomic>
+
+
+using Poco::BoundedNotificationQueue;
+using Poco::Notification;
+using Poco::Thread;
+using Poco::RunnableAdapter;
+
+
+namespace
+{
+	class QTestNotification: public Notification
+	{
+	public:
+		QTestNotification(const std::string& data): _data(data)
+		{
+		}
+		~QTestNotification()
+		{
+		}
+		const std::string& data() const
+		{
+			return _data;
+		}
+
+	private:
+		std::string _data;
+	};
+
+	class Producer: public Poco::Runnable
+	{
+	public:
+		Producer(BoundedNotificationQueue& queue, int count):
+			_queue(queue),
+			_count(count)
+		{
+		}
+
+		void run()
+		{
+			for (int i = 0; i < _count; ++i)
+			{
+				_queue.enqueueNotification(new Notification);
+			}
+		}
+
+	private:
+		BoundedNotificationQueue& _queue;
+		int _count;
+	};
+}
+
+
+BoundedNotificationQueueTest::BoundedNotificationQueueTest(const std::string& name):
+	CppUnit::TestCase(name),
+	_queue(16)
+{
+}
+
+
+BoundedNotificationQueueTest::~BoundedNotificationQueueTest()
+{
+}
+
+
+void BoundedNotificationQueueTest::testQueueDequeue()
+{
+	BoundedNotificationQueue queue;
+	assertTrue (queue.empty());
+	assertTrue (queue.size() == 0);
+	Notification* pNf = queue.dequeueNotification();
+	assertNullPtr(pNf);
+	queue.enqueueNotification(new Notification);
+	assertTrue (!queue.empty());
+	assertTrue (queue.size() == 1);
+	pNf = queue.dequeueNotification();
+	assertNotNullPtr(pNf);
+	assertTrue (queue.empty());
+	assertTrue (queue.size() == 0);
+	pNf->release();
+
+	queue.enqueueNotification(new QTestNotification("first"));
+	queue.enqueueNotification(new QTestNotification("second"));
+	assertTrue (!queue.empty());
+	assertTrue (queue.size() == 2);
+	QTestNotification* pTNf = dynamic_cast<QTestNotification*>(queue.dequeueNotification());
+	assertNotNullPtr(pTNf);
+	assertTrue (pTNf->data() == "first");
+	pTNf->release();
+	assertTrue (queue.size() == 1);
+	pTNf = dynamic_cast<QTestNotification*>(queue.dequeueNotification());
+	assertNotNullPtr(pTNf);
+	assertTrue (pTNf->data() == "second");
+	pTNf->release();
+	assertTrue (queue.empty());
+
+	pNf = queue.dequeueNotification();
+	assertNullPtr(pNf);
+}
+
+
+void BoundedNotificationQueueTest::testCapacity()
+{
+	BoundedNotificationQueue queue(5);
+	assertTrue (queue.capacity() == 8);
+
+	for (int i = 0; i < 8; ++i)
+	{
+		assertTrue (queue.tryEnqueueNotification(new QTestNotification(std::to_string(i))));
+	}
+	assertTrue (queue.size() == 8);
+	Notification::Ptr pNf = new Notification;
+	assertTrue (!queue.tryEnqueueNotification(pNf));
+	assertTrue (pNf->referenceCount() == 1);
+
+	// wrap around several times
+	for (int i = 8; i < 100; ++i)
+	{
+		Notification::Ptr pTNf = queue.dequeueNotification();
+		assertTrue (pTNf.cast<QTestNotification>()->data() == std::to_string(i - 8));
+		assertTrue (queue.tryEnqueueNotification(new QTestNotification(std::to_string(i))));
+	}
+	queue.clear();
+	assertTrue (queue.empty());
+}
+
+
+void BoundedNotificationQueueTest::testWaitDequeue()
+{
+	BoundedNotificationQueue queue;
+	queue.enqueueNotification(new QTestNotification("third"));
+	queue.enqueueNotification(new QTestNotification("fourth"));
+	assertTrue (queue.size() == 2);
+	QTestNotification* pTNf = dynamic_cast<QTestNotification*>(queue.waitDequeueNotification(10));
+	assertNotNullPtr(pTNf);
+	assertTrue (pTNf->data() == "third");
+	pTNf->release();
+	pTNf = dynamic_cast<QTestNotification*>(queue.waitDequeueNotification(10));
+	assertNotNullPtr(pTNf);
+	assertTrue (pTNf->data() == "fourth");
+	pTNf->release();
+	assertTrue (queue.empty());
+
+	Poco::Stopwatch sw;
+	sw.start();
+	Notification* pNf = queue.waitDequeueNotification(50);
+	sw.stop();
+	assertNullPtr(pNf);
+	assertTrue (sw.elapsed() >= 40000);
+}
+
+
+void BoundedNotificationQueueTest::testWaitFull()
+{
+	BoundedNotificationQueue queue(2);
+	queue.enqueueNotification(new Notification);
+	queue.enqueueNotification(new Notification);
+
+	Producer producer(queue, 1);
+	Thread t;
+	t.start(producer);
+	Thread::sleep(50);
+	assertTrue (t.isRunning());
+	assertTrue (queue.size() == 2);
+
+	Notification::Ptr pNf = queue.dequeueNotification();
+	assertTrue (t.tryJoin(5000));
+	assertTrue (queue.size() == 2);
+}
+
+
+void BoundedNotificationQueueTest::testThreads()
+{
+	const int PRODUCERS = 3;
+	const int NOTIFICATION_COUNT = 5000;
+
+	Thread t1("thread1");
+	Thread t2("thread2");
+	Thread t3("thread3");
+
+	RunnableAdapter<BoundedNotificationQueueTest> ra(*this, &BoundedNotificationQueueTest::work);
+	t1.start(ra);
+	t2.start(ra);
+	t3.start(ra);
+
+	Producer producer(_queue, NOTIFICATION_COUNT);
+	Thread producers[PRODUCERS];
+	for (auto& t: producers) t.start(producer);
+	for (auto& t: producers) t.join();
+
+	while (!_queue.empty()) Thread::sleep(50);
+	Thread::sleep(20);
+	_queue.wakeUpAll();
+	t1.join();
+	t2.join();
+	t3.join();
+	assertTrue (_handled.size() == PRODUCERS*NOTIFICATION_COUNT);
+	assertTrue (_handled.count("thread1") > 0);
+	assertTrue (_handled.count("thread2") > 0);
+	assertTrue (_handled.count("thread3") > 0);
+}
+
+
+void BoundedNotificationQueueTest::testWakeUpAll()
+{
+	RunnableAdapter<BoundedNotificationQueueTest> ra(*this, &BoundedNotificationQueueTest::work);
+	Thread t1;
+	Thread t2;
+	t1.start(ra);
+	t2.start(ra);
+	while (!_queue.hasIdleThreads()) Thread::sleep(10);
+	Thread::sleep(50);
+	_queue.wakeUpAll();
+	assertTrue (t1.tryJoin(5000));
+	assertTrue (t2.tryJoin(5000));
+	assertTrue (!_queue.hasIdleThreads());
+	assertTrue (_handled.empty());
+}
+
+
+void BoundedNotificationQueueTest::setUp()
+{
+	_handled.clear();
+}
+
+
+void BoundedNotificationQueueTest::tearDown()
+{
+}
+
+
+void BoundedNotificationQueueTest::work()
+{
+	Notification* pNf = _queue.waitDequeueNotification();
+	while (pNf)
+	{
+		pNf->release();
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+			_handled.insert(Thread::current()->name());
+		}
+		Thread::yield();
+		pNf = _queue.waitDequeueNotification();
+	}
+}
+
+
+CppUnit::Test* BoundedNotificationQueueTest::suite()
+{
+	CppUnit::TestSuite* pSuite = new CppUnit::TestSuite("BoundedNotificationQueueTest");
+
+	CppUnit_addTest(pSuite, BoundedNotificationQueueTest, testQueueDequeue);
+	CppUnit_addTest(pSuite, BoundedNotificationQueueTest, testCapacity);
+	CppUnit_addTest(pSuite, BoundedNotificationQueueTest, testWaitDequeue);
+	CppUnit_addTest(pSuite, BoundedNotificationQueueTest, testWaitFull);
+	CppUnit_addTest(pSuite, BoundedNotificationQueueTest, testThreads);
+	CppUnit_addTest(pSuite, BoundedNotificationQueueTest, testWakeUpAll);
+
+	return pSuite;
+}
@@ -19,8 +19,12 @@
 #include "Poco/FormattingChannel.h"
 #include "Poco/ConsoleChannel.h"
 #include "Poco/StreamChannel.h"
+#include "Poco/NumberFormatter.h"
+#include "Poco/NumberParser.h"
+#include "Poco/Exception.h"
 #include "TestChannel.h"
 #include <sstream>
+#include <vector>
 
 
 using Poco::SplitterChannel;
@@ -33,6 +37,8 @@ using Poco::Message;
 using Poco::AutoPtr;
 using Poco::Thread;
 using Poco::Runnable;
+using Poco::NumberFormatter;
+using Poco::NumberParser;
 
 
 class SimpleFormatter: public Formatter
@@ -73,6 +79,50 @@ private:
 };
 
 
+class BatchTestChannel: public Poco::Channel
+{
+public:
+	void log(const Message& msg)
+	{
+		messages.push_back(msg);
+	}
+
+	void logBatch(const MessageBatch& batch)
+	{
+		batches.push_back(batch.size());
+		Channel::logBatch(batch);
+	}
+
+	std::vector<Message> messages;
+	std::vector<std::size_t> batches;
+};
+
+
+class RingLogRunnable: public Runnable
+{
+public:
+	RingLogRunnable(AutoPtr<AsyncChannel> pAsync, const std::string& source, int count):
+		_pAsync(pAsync),
+		_source(source),
+		_count(count)
+	{
+	}
+
+	void run()
+	{
+		for (int i = 0; i < _count; ++i)
+		{
+			_pAsync->log(Message(_source, NumberFormatter::format(i), Message::PRIO_INFORMATION));
+		}
+	}
+
+private:
+	AutoPtr<AsyncChannel> _pAsync;
+	std::string _source;
+	int _count;
+};
+
+
 ChannelTest::ChannelTest(const std::string& name): CppUnit::TestCase(name)
 {
 }
@@ -113,6 +163,127 @@ void ChannelTest::testAsync()
 }
 
 
+void ChannelTest::testAsyncRing()
+{
+	const int producers = 4;
+	const int count = 2000;
+
+	AutoPtr<BatchTestChannel> pChannel = new BatchTestChannel;
+	AutoPtr<AsyncChannel> pAsync = new AsyncChannel(pChannel);
+	pAsync->setProperty("mode", "ring");
+	pAsync->setProperty("queueSize", "16384");
+	pAsync->open();
+	try
+	{
+		pAsync->setProperty("mode", "queue");
+		fail("mode cannot be changed while open - must throw");
+	}
+	catch (Poco::IllegalStateException&)
+	{
+	}
+
+	std::vector<RingLogRunnable*> runnables;
+	std::vector<Thread*> threads;
+	for (int i = 0; i < producers; ++i)
+	{
+		runnables.push_back(new RingLogRunnable(pAsync, NumberFormatter::format(i), count));
+		threads.push_back(new Thread);
+	}
+	for (int i = 0; i < producers; ++i)
+	{
+		threads[i]->start(*runnables[i]);
+	}
+	for (int i = 0; i < producers; ++i)
+	{
+		threads[i]->join();
+		delete threads[i];
+		delete runnables[i];
+	}
+	pAsync->close();
+
+	assertTrue (pChannel->messages.size() == producers*count);
+	std::vector<int> next(producers, 0);
+	for (const auto& msg: pChannel->messages)
+	{
+		int producer = NumberParser::parse(msg.getSource());
+		assertTrue (NumberParser::parse(msg.getText()) == next[producer]);
+		++next[producer];
+	}
+	std::size_t total = 0;
+	for (auto n: pChannel->batches)
+	{
+		assertTrue (n > 0 && n <= AsyncChannel::MAX_BATCH_SIZE);
+		total += n;
+	}
+	assertTrue (total == producers*count);
+}
+
+
+void ChannelTest::testAsyncRingDrop()
+{
+	AutoPtr<BatchTestChannel> pChannel = new BatchTestChannel;
+	AutoPtr<AsyncChannel> pAsync = new AsyncChannel;
+	pAsync->setProperty("mode", "ring");
+	pAsync->setProperty("queueSize", "4");
+	try
+	{
+		pAsync->setProperty("mode", "stack");
+		fail("invalid mode - must throw");
+	}
+	catch (Poco::InvalidArgumentException&)
+	{
+	}
+
+	pAsync->setChannel(pChannel);
+	Message msg("source", "text", Message::PRIO_INFORMATION);
+	for (int i = 0; i < 1000; ++i) pAsync->log(msg);
+	Thread::sleep(200);
+	pAsync->log(msg);
+	pAsync->close();
+
+	// Every message has either been logged, or is included
+	// in the number of dropped messages reported by the
+	// last log() call.
+	std::size_t logged = 0;
+	std::size_t dropped = 0;
+	for (const auto& m: pChannel->messages)
+	{
+		if (m.getText() == "text")
+			++logged;
+		else
+			dropped += NumberParser::parseUnsigned(m.getText().substr(8, m.getText().find(' ', 8) - 8));
+	}
+	assertTrue (logged + dropped == 1001);
+	assertTrue (pChannel->messages.back().getText() == "text");
+}
+
+
+void ChannelTest::testBatch()
+{
+	AutoPtr<TestChannel> pChannel = new TestChannel;
+	AutoPtr<Formatter> pFormatter = new SimpleFormatter;
+	AutoPtr<FormattingChannel> pFormatterChannel = new FormattingChannel(pFormatter, pChannel);
+	AutoPtr<SplitterChannel> pSplitter = new SplitterChannel;
+	pSplitter->addChannel(pFormatterChannel);
+	pSplitter->addChannel(pChannel);
+
+	Poco::Channel::MessageBatch batch;
+	batch.emplace_back("Source", "Text1", Message::PRIO_INFORMATION);
+	batch.emplace_back("Source", "Text2", Message::PRIO_INFORMATION);
+	pSplitter->logBatch(batch);
+
+	assertTrue (pChannel->list().size() == 4);
+	TestChannel::MsgList::const_iterator it = pChannel->list().begin();
+	assertTrue (it->getText() == "Source: Text1");
+	++it;
+	assertTrue (it->getText() == "Source: Text2");
+	++it;
+	assertTrue (it->getText() == "Text1");
+	++it;
+	assertTrue (it->getText() == "Text2");
+}
+
+
 void ChannelTest::testFormatting()
 {
 	AutoPtr<TestChannel> pChannel = new TestChannel;
@@ -163,6 +334,9 @@ CppUnit::Test* ChannelTest::suite()
 
 	CppUnit_addTest(pSuite, ChannelTest, testSplitter);
 	CppUnit_addTest(pSuite, ChannelTest, testAsync);
+	CppUnit_addTest(pSuite, ChannelTest, testAsyncRing);
+	CppUnit_addTest(pSuite, ChannelTest, testAsyncRingDrop);
+	CppUnit_addTest(pSuite, ChannelTest, testBatch);
 	CppUnit_addTest(pSuite, ChannelTest, testFormatting);
 	CppUnit_addTest(pSuite, ChannelTest, testConsole);
 	CppUnit_addTest(pSuite, ChannelTest, testStream);
@@ -26,6 +26,9 @@ public:
 
 	void testSplitter();
 	void testAsync();
+	void testAsyncRing();
+	void testAsyncRingDrop();
+	void testBatch();
 	void testFormatting();
 	void testConsole();
 	void testStream();
@@ -26,6 +26,10 @@
 #include "Poco/NumberFormatter.h"
 #include "Poco/DirectoryIterator.h"
 #include "Poco/Exception.h"
+#include "Poco/FileStream.h"
+#include "Poco/ArchiveWorker.h"
+#include "Poco/Event.h"
+#include <atomic>
 #include <vector>
 
 
@@ -44,6 +48,10 @@ using Poco::DateTimeFormatter;
 using Poco::DateTimeFormat;
 using Poco::DirectoryIterator;
 using Poco::InvalidArgumentException;
+using Poco::FileInputStream;
+using Poco::FileOutputStream;
+using Poco::ArchiveWorker;
+using Poco::Event;
 
 
 FileChannelTest::FileChannelTest(const std::string& name): CppUnit::TestCase(name)
@@ -544,6 +552,248 @@ void FileChannelTest::testWrongPurgeOption()
 }
 
 
+void FileChannelTest::testLogBatch()
+{
+	std::string name = filename();
+	try
+	{
+		AutoPtr<FileChannel> pChannel = new FileChannel(name);
+		pChannel->open();
+		pChannel->logBatch(FileChannel::MessageBatch());
+		FileChannel::MessageBatch batch;
+		for (int i = 0; i < 10; ++i)
+		{
+			batch.emplace_back("source", "entry " + NumberFormatter::format(i), Message::PRIO_INFORMATION);
+		}
+		pChannel->logBatch(batch);
+		pChannel->log(Message("source", "last entry", Message::PRIO_INFORMATION));
+		pChannel->close();
+
+		FileInputStream istr(name);
+		std::string line;
+		for (int i = 0; i < 10; ++i)
+		{
+			assertTrue (!std::getline(istr, line).fail());
+			assertTrue (line == "entry " + NumberFormatter::format(i));
+		}
+		assertTrue (!std::getline(istr, line).fail());
+		assertTrue (line == "last entry");
+		assertTrue (std::getline(istr, line).fail());
+	}
+	catch (...)
+	{
+		remove(name);
+		throw;
+	}
+	remove(name);
+}
+
+
+void FileChannelTest::testAsyncArchive()
+{
+	std::string name = filename();
+	try
+	{
+		AutoPtr<FileChannel> pChannel = new FileChannel(name);
+		pChannel->setProperty(FileChannel::PROP_ROTATION, "2 K");
+		pChannel->setProperty(FileChannel::PROP_ARCHIVE, "number");
+		pChannel->setProperty(FileChannel::PROP_PURGECOUNT, "2");
+		pChannel->setProperty(FileChannel::PROP_ASYNCARCHIVE, "true");
+		assertTrue (pChannel->getProperty(FileChannel::PROP_ASYNCARCHIVE) == "true");
+		pChannel->open();
+		Message msg("source", "This is a log file entry", Message::PRIO_INFORMATION);
+		for (int i = 0; i < 400; ++i)
+		{
+			pChannel->log(msg);
+		}
+		ArchiveWorker::defaultWorker().wait();
+
+		File f(name);
+		assertTrue (f.exists());
+
+		int archived = 0;
+		for (DirectoryIterator it(Path::current()), end; it != end; ++it)
+		{
+			if (it.name().find(name) == 0 && it.name() != name)
+			{
+				// no temporary files must be left over
+				assertTrue (it.name().find('~') == std::string::npos);
+				++archived;
+			}
+		}
+		assertTrue (archived == 2);
+	}
+	catch (...)
+	{
+		remove(name);
+		throw;
+	}
+	remove(name);
+}
+
+
+void FileChannelTest::testAsyncArchiveCompress()
+{
+	std::string name = filename();
+	try
+	{
+		AutoPtr<FileChannel> pChannel = new FileChannel(name);
+		pChannel->setProperty(FileChannel::PROP_ROTATION, "1 K");
+		pChannel->setProperty(FileChannel::PROP_ARCHIVE, "number");
+		pChannel->setProperty(FileChannel::PROP_COMPRESS, "true");
+		pChannel->setProperty(FileChannel::PROP_ASYNCARCHIVE, "true");
+		pChannel->open();
+		Message msg("source", "This is a log file entry", Message::PRIO_INFORMATION);
+		for (int i = 0; i < 200; ++i)
+		{
+			pChannel->log(msg);
+		}
+		ArchiveWorker::defaultWorker().wait();
+
+		File f0(name + ".0.gz");
+		assertTrue (f0.exists());
+		File f1(name + ".1.gz");
+		assertTrue (f1.exists());
+		File f2(name + ".0");
+		assertTrue (!f2.exists());
+	}
+	catch (...)
+	{
+		remove(name);
+		throw;
+	}
+	remove(name);
+}
+
+
+void FileChannelTest::testCompressionLevel()
+{
+	std::string name = filename();
+	try
+	{
+		AutoPtr<FileChannel> pChannel = new FileChannel(name);
+		assertTrue (pChannel->getProperty(FileChannel::PROP_COMPRESSIONLEVEL) == "default");
+		pChannel->setProperty(FileChannel::PROP_COMPRESSIONLEVEL, "best");
+		pChannel->setProperty(FileChannel::PROP_COMPRESSIONLEVEL, "0");
+		try
+		{
+			pChannel->setProperty(FileChannel::PROP_COMPRESSIONLEVEL, "10");
+			fail("invalid compression level - must throw");
+		}
+		catch (InvalidArgumentException&)
+		{
+		}
+		try
+		{
+			pChannel->setProperty(FileChannel::PROP_COMPRESSIONLEVEL, "fastest");
+			fail("invalid compression level - must throw");
+		}
+		catch (InvalidArgumentException&)
+		{
+		}
+		assertTrue (pChannel->getProperty(FileChannel::PROP_COMPRESSIONLEVEL) == "0");
+
+		pChannel->setProperty(FileChannel::PROP_COMPRESSIONLEVEL, "fast");
+		pChannel->setProperty(FileChannel::PROP_ROTATION, "1 K");
+		pChannel->setProperty(FileChannel::PROP_ARCHIVE, "timestamp");
+		pChannel->setProperty(FileChannel::PROP_COMPRESS, "true");
+		assertTrue (pChannel->getProperty(FileChannel::PROP_COMPRESSIONLEVEL) == "fast");
+		pChannel->open();
+		Message msg("source", "This is a log file entry", Message::PRIO_INFORMATION);
+		for (int i = 0; i < 50; ++i)
+		{
+			pChannel->log(msg);
+		}
+		ArchiveWorker::defaultWorker().wait();
+
+		int compressed = 0;
+		for (DirectoryIterator it(Path::current()), end; it != end; ++it)
+		{
+			if (it.name().find(name) == 0 && it.name().find(".gz") != std::string::npos)
+			{
+				assertTrue (it->getSize() < 1024);
+				++compressed;
+			}
+		}
+		assertTrue (compressed == 1);
+	}
+	catch (...)
+	{
+		remove(name);
+		throw;
+	}
+	remove(name);
+}
+
+
+void FileChannelTest::testRecoverArchives()
+{
+	std::string name = filename();
+	try
+	{
+		// rotated log files left with a temporary name
+		{
+			FileOutputStream ostr(name + "~0");
+			ostr << "older" << std::endl;
+		}
+		{
+			FileOutputStream ostr(name + "~1");
+			ostr << "newer" << std::endl;
+		}
+		AutoPtr<FileChannel> pChannel = new FileChannel(name);
+		pChannel->setProperty(FileChannel::PROP_ARCHIVE, "number");
+		pChannel->open();
+
+		assertTrue (!File(name + "~0").exists());
+		assertTrue (!File(name + "~1").exists());
+		std::string line;
+		FileInputStream istr0(name + ".0");
+		std::getline(istr0, line);
+		assertTrue (line == "newer");
+		FileInputStream istr1(name + ".1");
+		std::getline(istr1, line);
+		assertTrue (line == "older");
+	}
+	catch (...)
+	{
+		remove(name);
+		throw;
+	}
+	remove(name);
+}
+
+
+void FileChannelTest::testArchiveWorker()
+{
+	ArchiveWorker worker(2);
+	Event started;
+	Event proceed;
+	std::atomic<int> count(0);
+	assertTrue (worker.enqueue([&]()
+	{
+		started.set();
+		proceed.wait();
+		++count;
+	}));
+	started.wait();
+	assertTrue (worker.enqueue([&]() { ++count; }));
+	assertTrue (worker.enqueue([&]() { throw Poco::IOException("ignored"); }));
+	assertTrue (!worker.enqueue([&]() { ++count; }));
+	assertTrue (worker.queued() == 2);
+	proceed.set();
+	worker.wait();
+	assertTrue (count == 2);
+	assertTrue (worker.queued() == 0);
+	assertTrue (worker.enqueue([&]() { ++count; }));
+	worker.wait();
+	assertTrue (count == 3);
+	// wait() must not block when called from a task
+	assertTrue (worker.enqueue([&]() { worker.wait(); ++count; }));
+	worker.wait();
+	assertTrue (count == 4);
+}
+
+
 void FileChannelTest::setUp()
 {
 }
@@ -647,6 +897,12 @@ CppUnit::Test* FileChannelTest::suite()
 	CppUnit_addLongTest(pSuite, FileChannelTest, testPurgeAge);
 	CppUnit_addTest(pSuite, FileChannelTest, testPurgeCount);
 	CppUnit_addTest(pSuite, FileChannelTest, testWrongPurgeOption);
+	CppUnit_addTest(pSuite, FileChannelTest, testLogBatch);
+	CppUnit_addTest(pSuite, FileChannelTest, testAsyncArchive);
+	CppUnit_addTest(pSuite, FileChannelTest, testAsyncArchiveCompress);
+	CppUnit_addTest(pSuite, FileChannelTest, testCompressionLevel);
+	CppUnit_addTest(pSuite, FileChannelTest, testRecoverArchives);
+	CppUnit_addTest(pSuite, FileChannelTest, testArchiveWorker);
 
 	return pSuite;
 }
@@ -44,6 +44,12 @@ public:
 	void testPurgeAge();
 	void testPurgeCount();
 	void testWrongPurgeOption();
+	void testLogBatch();
+	void testAsyncArchive();
+	void testAsyncArchiveCompress();
+	void testCompressionLevel();
+	void testRecoverArchives();
+	void testArchiveWorker();
 
 	void setUp();
 	void tearDown();
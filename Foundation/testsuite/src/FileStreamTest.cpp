@@ -289,6 +289,22 @@ void FileStreamTest::testMultiOpen()
 }
 
 
+void FileStreamTest::testSize()
+{
+	Poco::FileOutputStream ostr("test.txt", std::ios::trunc);
+	ostr << "0123456789abcdef";
+	ostr.close();
+
+	Poco::FileInputStream istr("test.txt");
+#if defined(POCO_OS_FAMILY_WINDOWS)
+	assertTrue (istr.nativeHandle() != INVALID_HANDLE_VALUE);
+#else
+	assertTrue (istr.nativeHandle() != -1);
+#endif
+	assertTrue (istr.size() == 16);
+}
+
+
 void FileStreamTest::setUp()
 {
 }
@@ -314,6 +330,7 @@ CppUnit::Test* FileStreamTest::suite()
 	CppUnit_addTest(pSuite, FileStreamTest, testOpenModeApp);
 	CppUnit_addTest(pSuite, FileStreamTest, testSeek);
 	CppUnit_addTest(pSuite, FileStreamTest, testMultiOpen);
+	CppUnit_addTest(pSuite, FileStreamTest, testSize);
 
 	return pSuite;
 }
@@ -35,6 +35,7 @@ public:
 	void testOpenModeApp();
 	void testSeek();
 	void testMultiOpen();
+	void testSize();
 
 	void setUp();
 	void tearDown();
@@ -12,14 +12,56 @@
 #include "CppUnit/TestCaller.h"
 #include "CppUnit/TestSuite.h"
 #include "Poco/Logger.h"
+#include "Poco/LoggerHandle.h"
 #include "Poco/AutoPtr.h"
+#include "Poco/NumberFormatter.h"
+#include "Poco/Thread.h"
+#include "Poco/Runnable.h"
 #include "TestChannel.h"
+#include <atomic>
+#include <vector>
 
 
 using Poco::Logger;
+using Poco::LoggerHandle;
 using Poco::Channel;
 using Poco::Message;
 using Poco::AutoPtr;
+using Poco::NumberFormatter;
+using Poco::Thread;
+
+
+namespace
+{
+	class GetRunnable: public Poco::Runnable
+	{
+	public:
+		GetRunnable(int count):
+			_count(count),
+			_errors(0)
+		{
+		}
+
+		void run()
+		{
+			for (int i = 0; i < _count; ++i)
+			{
+				std::string name = "Concurrent.Logger" + NumberFormatter::format(i);
+				Logger& logger = Logger::get(name);
+				if (logger.name() != name || &Logger::get(name) != &logger) ++_errors;
+			}
+		}
+
+		int errors() const
+		{
+			return _errors;
+		}
+
+	private:
+		int _count;
+		std::atomic<int> _errors;
+	};
+}
 
 
 LoggerTest::LoggerTest(const std::string& name): CppUnit::TestCase(name)
@@ -290,6 +332,109 @@ void LoggerTest::testDump()
 }
 
 
+void LoggerTest::testRegistry()
+{
+	Logger& root = Logger::root();
+	root.setLevel(Message::PRIO_WARNING);
+
+	std::vector<Logger*> loggers;
+	for (int i = 0; i < 1000; ++i)
+	{
+		loggers.push_back(&Logger::get("Registry.Logger" + NumberFormatter::format(i)));
+	}
+	for (int i = 0; i < 1000; ++i)
+	{
+		std::string name = "Registry.Logger" + NumberFormatter::format(i);
+		assertTrue (&Logger::get(name) == loggers[i]);
+		assertTrue (Logger::has(name).get() == loggers[i]);
+		assertTrue (loggers[i]->getLevel() == Message::PRIO_WARNING);
+	}
+	assertTrue (&Logger::root() == &root);
+
+	Logger::destroy("Registry.Logger1");
+	assertTrue (Logger::has("Registry.Logger1").isNull());
+	assertTrue (Logger::has("Registry.Logger2").get() == loggers[2]);
+	Logger& logger1 = Logger::get("Registry.Logger1");
+	assertTrue (Logger::has("Registry.Logger1").get() == &logger1);
+
+	Logger::shutdown();
+	assertTrue (Logger::has("Registry.Logger2").isNull());
+	assertTrue (Logger::get("Registry.Logger2").getLevel() == Message::PRIO_INFORMATION);
+}
+
+
+void LoggerTest::testConcurrentGet()
+{
+	const int threads = 4;
+	std::vector<GetRunnable*> runnables;
+	std::vector<Thread*> threadVec;
+	for (int i = 0; i < threads; ++i)
+	{
+		runnables.push_back(new GetRunnable(500));
+		threadVec.push_back(new Thread);
+	}
+	for (int i = 0; i < threads; ++i)
+	{
+		threadVec[i]->start(*runnables[i]);
+	}
+	int errors = 0;
+	for (int i = 0; i < threads; ++i)
+	{
+		threadVec[i]->join();
+		errors += runnables[i]->errors();
+		delete threadVec[i];
+		delete runnables[i];
+	}
+	assertTrue (errors == 0);
+
+	std::vector<std::string> names;
+	Logger::names(names);
+	int count = 0;
+	for (const auto& name: names)
+	{
+		if (name.compare(0, 11, "Concurrent.") == 0) ++count;
+	}
+	assertTrue (count == 500);
+}
+
+
+void LoggerTest::testHandle()
+{
+	AutoPtr<TestChannel> pChannel = new TestChannel;
+	Logger::root().setChannel(pChannel);
+
+	LoggerHandle handle("Handle");
+	assertTrue (&handle.logger() == &Logger::get("Handle"));
+	assertTrue (&*handle == &Logger::get("Handle"));
+	assertTrue (handle->name() == "Handle");
+	assertTrue (handle.information());
+	assertTrue (!handle.debug());
+
+	if (handle.debug()) handle->debug("Debug message");
+	assertTrue (pChannel->list().empty());
+
+	Logger::setLevel("Handle", Message::PRIO_DEBUG);
+	assertTrue (handle.debug());
+	assertTrue (!handle.trace());
+	assertTrue (handle.is(Message::PRIO_DEBUG));
+	if (handle.debug()) handle->debug("Debug message");
+	assertTrue (pChannel->list().size() == 1);
+
+	LoggerHandle rootHandle(Logger::root());
+	assertTrue (&rootHandle.logger() == &Logger::root());
+	assertTrue (rootHandle.information());
+	assertTrue (!rootHandle.debug());
+
+	// the handle keeps the Logger alive
+	Logger::destroy("Handle");
+	assertTrue (!Logger::has("Handle"));
+	assertTrue (handle->name() == "Handle");
+	assertTrue (handle.debug());
+	handle->debug("Debug message");
+	assertTrue (pChannel->list().size() == 2);
+}
+
+
 void LoggerTest::setUp()
 {
 	Logger::shutdown();
@@ -309,6 +454,9 @@ CppUnit::Test* LoggerTest::suite()
 	CppUnit_addTest(pSuite, LoggerTest, testFormat);
 	CppUnit_addTest(pSuite, LoggerTest, testFormatAny);
 	CppUnit_addTest(pSuite, LoggerTest, testDump);
+	CppUnit_addTest(pSuite, LoggerTest, testRegistry);
+	CppUnit_addTest(pSuite, LoggerTest, testConcurrentGet);
+	CppUnit_addTest(pSuite, LoggerTest, testHandle);
 
 	return pSuite;
 }
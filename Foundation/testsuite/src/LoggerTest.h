@@ -28,6 +28,9 @@ public:
 	void testFormat();
 	void testFormatAny();
 	void testDump();
+	void testRegistry();
+	void testConcurrentGet();
+	void testHandle();
 
 	void setUp();
 	void tearDown();
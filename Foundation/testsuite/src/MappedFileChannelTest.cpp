@@ -0,0 +1,310 @@
+//
+// MappedFileChannelTest.cpp
+//
+// Copyright (c) 2004-2023, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "MappedFileChannelTest.h"
+#include "CppUnit/TestCaller.h"
+#include "CppUnit/TestSuite.h"
+#include "Poco/MappedFileChannel.h"
+#include "Poco/Message.h"
+#include "Poco/Path.h"
+#include "Poco/File.h"
+#include "Poco/FileStream.h"
+#include "Poco/StreamCopier.h"
+#include "Poco/DirectoryIterator.h"
+#include "Poco/Timestamp.h"
+#include "Poco/DateTimeFormatter.h"
+#include "Poco/AutoPtr.h"
+#include "Poco/Exception.h"
+#include <vector>
+
+
+using Poco::MappedFileChannel;
+using Poco::Channel;
+using Poco::Message;
+using Poco::Path;
+using Poco::File;
+using Poco::FileInputStream;
+using Poco::FileOutputStream;
+using Poco::StreamCopier;
+using Poco::DirectoryIterator;
+using Poco::Timestamp;
+using Poco::DateTimeFormatter;
+using Poco::AutoPtr;
+
+
+MappedFileChannelTest::MappedFileChannelTest(const std::string& name): CppUnit::TestCase(name)
+{
+}
+
+
+MappedFileChannelTest::~MappedFileChannelTest()
+{
+}
+
+
+void MappedFileChannelTest::testWrite()
+{
+	std::string name = filename();
+	try
+	{
+		AutoPtr<MappedFileChannel> pChannel = new MappedFileChannel(name);
+		pChannel->open();
+		assertTrue (File(name).getSize() == MappedFileChannel::DEFAULT_SEGMENT_SIZE);
+		Message msg("source", "This is a log file entry", Message::PRIO_INFORMATION);
+		pChannel->log(msg);
+		msg.setText("This is another log file entry");
+		pChannel->log(msg);
+		assertTrue (pChannel->size() == 56);
+		pChannel->close();
+
+		assertTrue (File(name).getSize() == 56);
+		assertTrue (readFile(name) == "This is a log file entry\nThis is another log file entry\n");
+
+		pChannel->open();
+		msg.setText("Appended");
+		pChannel->log(msg);
+		pChannel->close();
+		assertTrue (readFile(name) == "This is a log file entry\nThis is another log file entry\nAppended\n");
+	}
+	catch (...)
+	{
+		remove(name);
+		throw;
+	}
+	remove(name);
+}
+
+
+void MappedFileChannelTest::testRecover()
+{
+	std::string name = filename();
+	try
+	{
+		// a log file left behind by a crashed process still
+		// has the zero bytes of its unused segment space
+		{
+			FileOutputStream ostr(name);
+			ostr << "first\nsecond\n" << std::string(1000, '\0');
+		}
+		AutoPtr<MappedFileChannel> pChannel = new MappedFileChannel(name);
+		pChannel->setProperty(MappedFileChannel::PROP_SEGMENTSIZE, "1K");
+		pChannel->open();
+		assertTrue (pChannel->size() == 13);
+		pChannel->log(Message("source", "third", Message::PRIO_INFORMATION));
+		pChannel->close();
+		assertTrue (readFile(name) == "first\nsecond\nthird\n");
+	}
+	catch (...)
+	{
+		remove(name);
+		throw;
+	}
+	remove(name);
+}
+
+
+void MappedFileChannelTest::testRotateBySegment()
+{
+	std::string name = filename();
+	try
+	{
+		AutoPtr<MappedFileChannel> pChannel = new MappedFileChannel(name);
+		pChannel->setProperty(MappedFileChannel::PROP_SEGMENTSIZE, "2 K");
+		pChannel->open();
+		Message msg("source", "This is a log file entry", Message::PRIO_INFORMATION);
+		for (int i = 0; i < 400; ++i)
+		{
+			pChannel->log(msg);
+		}
+		pChannel->close();
+
+		File f(name);
+		assertTrue (f.exists());
+		f = name + ".0";
+		assertTrue (f.exists());
+		assertTrue (f.getSize() >= 2048);
+		assertTrue (f.getSize() < 2048 + 25);
+		std::string text = readFile(f.path());
+		assertTrue (text.find('\0') == std::string::npos);
+		assertTrue (text.compare(0, 25, "This is a log file entry\n") == 0);
+		f = name + ".3";
+		assertTrue (f.exists());
+	}
+	catch (...)
+	{
+		remove(name);
+		throw;
+	}
+	remove(name);
+}
+
+
+void MappedFileChannelTest::testRotateBySize()
+{
+	std::string name = filename();
+	try
+	{
+		AutoPtr<MappedFileChannel> pChannel = new MappedFileChannel(name);
+		pChannel->setProperty(MappedFileChannel::PROP_SEGMENTSIZE, "1K");
+		pChannel->setProperty(MappedFileChannel::PROP_ROTATION, "4 K");
+		pChannel->open();
+		Message msg("source", "This is a log file entry", Message::PRIO_INFORMATION);
+		for (int i = 0; i < 200; ++i)
+		{
+			pChannel->log(msg);
+		}
+		pChannel->close();
+
+		File f(name + ".0");
+		assertTrue (f.exists());
+		assertTrue (f.getSize() >= 4096);
+		assertTrue (f.getSize() < 4096 + 25);
+		assertTrue (File(name).getSize() == 200*25 - f.getSize());
+	}
+	catch (...)
+	{
+		remove(name);
+		throw;
+	}
+	remove(name);
+}
+
+
+void MappedFileChannelTest::testBatch()
+{
+	std::string name = filename();
+	try
+	{
+		AutoPtr<MappedFileChannel> pChannel = new MappedFileChannel(name);
+		pChannel->setProperty(MappedFileChannel::PROP_SYNCINTERVAL, "0");
+		pChannel->open();
+		Channel::MessageBatch batch;
+		batch.push_back(Message("source", "one", Message::PRIO_INFORMATION));
+		batch.push_back(Message("source", "two", Message::PRIO_INFORMATION));
+		batch.push_back(Message("source", "three", Message::PRIO_INFORMATION));
+		pChannel->logBatch(batch);
+		pChannel->close();
+		assertTrue (readFile(name) == "one\ntwo\nthree\n");
+	}
+	catch (...)
+	{
+		remove(name);
+		throw;
+	}
+	remove(name);
+}
+
+
+void MappedFileChannelTest::testProperties()
+{
+	AutoPtr<MappedFileChannel> pChannel = new MappedFileChannel;
+	assertTrue (pChannel->getProperty(MappedFileChannel::PROP_SEGMENTSIZE) == "4M");
+	assertTrue (pChannel->getProperty(MappedFileChannel::PROP_SYNCINTERVAL) == "1000");
+	assertTrue (pChannel->getProperty(MappedFileChannel::PROP_FLUSH) == "false");
+	assertTrue (pChannel->getProperty(MappedFileChannel::PROP_ROTATION) == "4194304");
+
+	pChannel->setProperty(MappedFileChannel::PROP_SEGMENTSIZE, "64K");
+	assertTrue (pChannel->getProperty(MappedFileChannel::PROP_SEGMENTSIZE) == "64K");
+	assertTrue (pChannel->getProperty(MappedFileChannel::PROP_ROTATION) == "65536");
+
+	pChannel->setProperty(MappedFileChannel::PROP_ROTATION, "daily");
+	pChannel->setProperty(MappedFileChannel::PROP_SEGMENTSIZE, "1M");
+	assertTrue (pChannel->getProperty(MappedFileChannel::PROP_ROTATION) == "daily");
+
+	pChannel->setProperty(MappedFileChannel::PROP_SYNCINTERVAL, "250");
+	assertTrue (pChannel->getProperty(MappedFileChannel::PROP_SYNCINTERVAL) == "250");
+
+	try
+	{
+		pChannel->setProperty(MappedFileChannel::PROP_SEGMENTSIZE, "0");
+		fail("zero segment size - must throw");
+	}
+	catch (Poco::InvalidArgumentException&)
+	{
+	}
+	try
+	{
+		pChannel->setProperty(MappedFileChannel::PROP_SEGMENTSIZE, "10 G");
+		fail("invalid unit - must throw");
+	}
+	catch (Poco::InvalidArgumentException&)
+	{
+	}
+}
+
+
+void MappedFileChannelTest::setUp()
+{
+}
+
+
+void MappedFileChannelTest::tearDown()
+{
+}
+
+
+void MappedFileChannelTest::remove(const std::string& baseName)
+{
+	DirectoryIterator it(Path::current());
+	DirectoryIterator end;
+	std::vector<std::string> files;
+	while (it != end)
+	{
+		if (it.name().find(baseName) == 0)
+		{
+			files.push_back(it.name());
+		}
+		++it;
+	}
+	for (std::vector<std::string>::iterator it = files.begin(); it != files.end(); ++it)
+	{
+		try
+		{
+			File f(*it);
+			f.remove();
+		}
+		catch (...)
+		{
+		}
+	}
+}
+
+
+std::string MappedFileChannelTest::filename() const
+{
+	std::string name = "mlog_";
+	name.append(DateTimeFormatter::format(Timestamp(), "%Y%m%d%H%M%S"));
+	name.append(".log");
+	return name;
+}
+
+
+std::string MappedFileChannelTest::readFile(const std::string& path)
+{
+	FileInputStream istr(path);
+	std::string text;
+	StreamCopier::copyToString(istr, text);
+	return text;
+}
+
+
+CppUnit::Test* MappedFileChannelTest::suite()
+{
+	CppUnit::TestSuite* pSuite = new CppUnit::TestSuite("MappedFileChannelTest");
+
+	CppUnit_addTest(pSuite, MappedFileChannelTest, testWrite);
+	CppUnit_addTest(pSuite, MappedFileChannelTest, testRecover);
+	CppUnit_addTest(pSuite, MappedFileChannelTest, testRotateBySegment);
+	CppUnit_addTest(pSuite, MappedFileChannelTest, testRotateBySize);
+	CppUnit_addTest(pSuite, MappedFileChannelTest, testBatch);
+	CppUnit_addTest(pSuite, MappedFileChannelTest, testProperties);
+
+	return pSuite;
+}
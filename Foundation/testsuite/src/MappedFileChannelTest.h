@@ -0,0 +1,46 @@
+//
+// MappedFileChannelTest.h
+//
+// Definition of the MappedFileChannelTest class.
+//
+// Copyright (c) 2004-2023, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef MappedFileChannelTest_INCLUDED
+#define MappedFileChannelTest_INCLUDED
+
+
+#include "Poco/Foundation.h"
+#include "CppUnit/TestCase.h"
+
+
+class MappedFileChannelTest: public CppUnit::TestCase
+{
+public:
+	MappedFileChannelTest(const std::string& name);
+	~MappedFileChannelTest();
+
+	void testWrite();
+	void testRecover();
+	void testRotateBySegment();
+	void testRotateBySize();
+	void testBatch();
+	void testProperties();
+
+	void setUp();
+	void tearDown();
+
+	static CppUnit::Test* suite();
+
+private:
+	void remove(const std::string& baseName);
+	std::string filename() const;
+	static std::string readFile(const std::string& path);
+};
+
+
+#endif // MappedFileChannelTest_INCLUDED
@@ -14,11 +14,17 @@
 #include "Poco/PatternFormatter.h"
 #include "Poco/Message.h"
 #include "Poco/DateTime.h"
+#include "Poco/Timespan.h"
+#include "Poco/Stopwatch.h"
+#include "Poco/Environment.h"
+#include <iostream>
 
 
 using Poco::PatternFormatter;
 using Poco::Message;
 using Poco::DateTime;
+using Poco::Timespan;
+using Poco::Stopwatch;
 
 
 PatternFormatterTest::PatternFormatterTest(const std::string& name): CppUnit::TestCase(name)
@@ -106,6 +112,147 @@ void PatternFormatterTest::testPatternFormatter()
 }
 
 
+void PatternFormatterTest::testCompiled()
+{
+	Message msg;
+	msg.setSource("TestSource");
+	msg.setText("Test message text");
+	msg.setPid(1234);
+	msg.setTid(1);
+	msg.setThread("TestThread");
+	msg.setPriority(Message::PRIO_ERROR);
+	msg.setSourceFile(__FILE__);
+	msg.setSourceLine(42);
+	msg["testParam"] = "Test Parameter";
+
+	static const char* patterns[] =
+	{
+		"%Y-%m-%dT%H:%M:%S [%s] %p: %t",
+		"%w, %e %b %y %H:%M:%S.%i [%s:%I:%T] %q: %t",
+		"%Y-%m-%d %H:%M:%S.%F %c [%N:%P:%s]%l-%t",
+		"%W %B %f %o %n %h %a %A %z %Z %E",
+		"[%p] %t (%O:%u) %Y%m%d%H%M%S%i",
+		"%H:%M %L%H:%M %s",
+		"%[testParam] %[missing] %v[8] %v[12]|",
+		"100%% %t",
+		""
+	};
+
+	DateTime dateTime(2005, 1, 1, 14, 30, 15, 500, 250);
+	PatternFormatter fmt;
+	PatternFormatter compiledFmt;
+	compiledFmt.setProperty("compiled", "true");
+	assertTrue (compiledFmt.getProperty("compiled") == "true");
+	for (const auto* pattern: patterns)
+	{
+		for (const auto* times: {"UTC", "local"})
+		{
+			fmt.setProperty("pattern", pattern);
+			fmt.setProperty("times", times);
+			compiledFmt.setProperty("pattern", pattern);
+			compiledFmt.setProperty("times", times);
+			// same second (cached), next second and next day
+			for (int offset: {0, 100, 1000, 86400000})
+			{
+				msg.setTime((dateTime + Timespan(0, 0, 0, 0, offset*1000)).timestamp());
+				std::string expected;
+				fmt.format(msg, expected);
+				std::string result;
+				compiledFmt.format(msg, result);
+				assertEqual (expected, result);
+			}
+		}
+	}
+
+	// compiled formatters used in turn by the same thread
+	PatternFormatter fmt1("%Y-%m-%d %H:%M:%S %t");
+	fmt1.setProperty("compiled", "true");
+	PatternFormatter fmt2("%H:%M:%S.%i %s");
+	fmt2.setProperty("compiled", "true");
+	msg.setTime(dateTime.timestamp());
+	for (int i = 0; i < 3; i++)
+	{
+		std::string result;
+		fmt1.format(msg, result);
+		assertEqual ("2005-01-01 14:30:15 Test message text", result);
+		result.clear();
+		fmt2.format(msg, result);
+		assertEqual ("14:30:15.500 TestSource", result);
+	}
+}
+
+
+void PatternFormatterTest::testJSON()
+{
+	Message msg;
+	msg.setSource("TestSource");
+	msg.setText("Test \"message\"\ttext\n");
+	msg.setTid(1);
+	msg.setPriority(Message::PRIO_ERROR);
+	msg.setTime(DateTime(2005, 1, 1, 14, 30, 15, 500).timestamp());
+	msg["testParam"] = "Test Parameter";
+
+	PatternFormatter fmt("%Y-%m-%d %H:%M:%S.%i [%p] %s: %t");
+	fmt.setProperty("output", "json");
+	assertTrue (fmt.getProperty("output") == "json");
+	std::string result;
+	fmt.format(msg, result);
+	assertEqual ("{\"timestamp\":\"2005-01-01 14:30:15.500\",\"priority\":\"Error\",\"source\":\"TestSource\",\"text\":\"Test \\\"message\\\"\\ttext\\n\"}", result);
+
+	result.clear();
+	fmt.setProperty("pattern", "%I %l %[testParam] %Y");
+	fmt.format(msg, result);
+	assertEqual ("{\"tid\":1,\"level\":3,\"testParam\":\"Test Parameter\",\"timestamp\":\"2005\"}", result);
+
+	result.clear();
+	fmt.setProperty("pattern", "%N");
+	fmt.format(msg, result);
+	assertEqual ("{\"node\":\"" + Poco::Environment::nodeName() + "\"}", result);
+
+	result.clear();
+	fmt.setProperty("pattern", "%I %l %[testParam] %Y");
+	fmt.setProperty("output", "text");
+	fmt.format(msg, result);
+	assertEqual ("1 3 Test Parameter 2005", result);
+
+	try
+	{
+		fmt.setProperty("output", "xml");
+		fail("invalid output - must throw");
+	}
+	catch (Poco::InvalidArgumentException&)
+	{
+	}
+}
+
+
+void PatternFormatterTest::testBenchmark()
+{
+	const int count = 1000000;
+	Message msg("TestSource", "Test message text", Message::PRIO_INFORMATION);
+	msg.setThread("TestThread");
+
+	std::cout << std::endl;
+	for (const auto* mode: {"interpreted", "compiled", "json"})
+	{
+		PatternFormatter fmt("%Y-%m-%d %H:%M:%S.%i [%p] %s <%T>: %t");
+		if (std::string(mode) == "compiled") fmt.setProperty("compiled", "true");
+		if (std::string(mode) == "json") fmt.setProperty("output", "json");
+		std::string text;
+		Stopwatch sw;
+		sw.start();
+		for (int i = 0; i < count; ++i)
+		{
+			text.clear();
+			fmt.format(msg, text);
+		}
+		sw.stop();
+		double perSecond = sw.elapsed() > 0 ? count*1000000.0/sw.elapsed() : 0.0;
+		std::cout << mode << ": " << static_cast<long>(perSecond) << " messages/s" << std::endl;
+	}
+}
+
+
 void PatternFormatterTest::setUp()
 {
 }
@@ -121,6 +268,9 @@ CppUnit::Test* PatternFormatterTest::suite()
 	CppUnit::TestSuite* pSuite = new CppUnit::TestSuite("PatternFormatterTest");
 
 	CppUnit_addTest(pSuite, PatternFormatterTest, testPatternFormatter);
+	CppUnit_addTest(pSuite, PatternFormatterTest, testCompiled);
+	CppUnit_addTest(pSuite, PatternFormatterTest, testJSON);
+	CppUnit_addLongTest(pSuite, PatternFormatterTest, testBenchmark);
 
 	return pSuite;
 }
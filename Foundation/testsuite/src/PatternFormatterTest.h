@@ -25,6 +25,9 @@ public:
 	~PatternFormatterTest();
 
 	void testPatternFormatter();
+	void testCompiled();
+	void testJSON();
+	void testBenchmark();
 
 	void setUp();
 	void tearDown();
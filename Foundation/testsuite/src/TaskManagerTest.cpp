@@ -18,6 +18,7 @@
 #include "Poco/NotificationCenter.h"
 #include "Poco/Thread.h"
 #include "Poco/ThreadPool.h"
+#include "Poco/WorkStealingExecutor.h"
 #include "Poco/Event.h"
 #include "Poco/Observer.h"
 #include "Poco/Exception.h"
@@ -35,6 +36,7 @@ using Poco::TaskProgressNotification;
 using Poco::TaskCustomNotification;
 using Poco::Thread;
 using Poco::ThreadPool;
+using Poco::WorkStealingExecutor;
 using Poco::Event;
 using Poco::Observer;
 using Poco::Exception;
@@ -493,6 +495,27 @@ void TaskManagerTest::testCustomThreadPool()
 	tm.joinAll();
 }
 
+void TaskManagerTest::testCustomExecutor()
+{
+	WorkStealingExecutor executor(2);
+	TaskManager tm(executor);
+
+	// more tasks than worker threads are queued
+	for (int i = 0; i < 5; ++i)
+	{
+		tm.start(new SimpleTask);
+	}
+	assertTrue (tm.count() == 5);
+	while (executor.queueDepth() > 3) Thread::sleep(10);
+	assertTrue (executor.queueDepth() == 3);
+
+	tm.cancelAll();
+	tm.joinAll();
+	assertTrue (tm.count() == 0);
+	assertTrue (executor.statistics().completed == 5);
+}
+
+
 void TaskManagerTest::setUp()
 {
 }
@@ -513,6 +536,7 @@ CppUnit::Test* TaskManagerTest::suite()
 	CppUnit_addTest(pSuite, TaskManagerTest, testMultiTasks);
 	CppUnit_addTest(pSuite, TaskManagerTest, testCustom);
 	CppUnit_addTest(pSuite, TaskManagerTest, testCustomThreadPool);
+	CppUnit_addTest(pSuite, TaskManagerTest, testCustomExecutor);
 
 	return pSuite;
 }
@@ -36,6 +36,7 @@ public:
 	void testCustom();
 	void testMultiTasks();
 	void testCustomThreadPool();
+	void testCustomExecutor();
 
 	void setUp();
 	void tearDown();
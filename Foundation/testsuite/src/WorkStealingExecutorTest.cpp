@@ -0,0 +1,264 @@
+//
+// WorkStealingExecutorTest.cpp
+//
+// Copyright (c) 2005-2023, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "WorkStealingExecutorTest.h"
+#include "CppUnit/TestCaller.h"
+#include "CppUnit/TestSuite.h"
+#include "Poco/WorkStealingExecutor.h"
+#include "Poco/ActiveMethod.h"
+#include "Poco/Runnable.h"
+#include "Poco/Event.h"
+#include "Poco/Thread.h"
+#include "Poco/Exception.h"
+#include <atomic>
+
+
+using Poco::WorkStealingExecutor;
+using Poco::WorkStealingStarter;
+using Poco::ActiveMethod;
+using Poco::ActiveResult;
+using Poco::Runnable;
+using Poco::Event;
+using Poco::Thread;
+
+
+namespace
+{
+	class CountingRunnable: public Runnable
+	{
+	public:
+		CountingRunnable(): _count(0)
+		{
+		}
+
+		void run()
+		{
+			++_count;
+		}
+
+		int count() const
+		{
+			return _count;
+		}
+
+	private:
+		std::atomic<int> _count;
+	};
+
+	class ActiveAdder
+	{
+	public:
+		ActiveAdder():
+			add(this, &ActiveAdder::addImpl)
+		{
+		}
+
+		ActiveMethod<int, std::pair<int, int>, ActiveAdder, WorkStealingStarter<ActiveAdder>> add;
+
+	private:
+		int addImpl(const std::pair<int, int>& args)
+		{
+			return args.first + args.second;
+		}
+	};
+
+	void fibonacci(WorkStealingExecutor& executor, int n, std::atomic<long>& result)
+		/// Computes the n-th Fibonacci number by summing up the leaves
+		/// of the recursion tree, forking a task for every left subtree.
+	{
+		while (n >= 2)
+		{
+			executor.startFunc([&executor, &result, n]()
+			{
+				fibonacci(executor, n - 1, result);
+			});
+			n -= 2;
+		}
+		result += n;
+	}
+}
+
+
+WorkStealingExecutorTest::WorkStealingExecutorTest(const std::string& name): CppUnit::TestCase(name)
+{
+}
+
+
+WorkStealingExecutorTest::~WorkStealingExecutorTest()
+{
+}
+
+
+void WorkStealingExecutorTest::testStart()
+{
+	WorkStealingExecutor executor("test", 2);
+	assertTrue (executor.threads() == 2);
+	assertTrue (executor.name() == "test");
+
+	CountingRunnable runnable;
+	for (int i = 0; i < 100; i++)
+	{
+		executor.start(runnable);
+	}
+	executor.joinAll();
+	assertTrue (runnable.count() == 100);
+	assertTrue (executor.queueDepth() == 0);
+
+	WorkStealingExecutor::Statistics stats = executor.statistics();
+	assertTrue (stats.submitted == 100);
+	assertTrue (stats.completed == 100);
+}
+
+
+void WorkStealingExecutorTest::testStartFunc()
+{
+	WorkStealingExecutor executor(3);
+	std::atomic<int> sum(0);
+	for (int i = 1; i <= 1000; i++)
+	{
+		executor.startFunc([&sum, i]() { sum += i; });
+	}
+	executor.joinAll();
+	assertTrue (sum == 500500);
+}
+
+
+void WorkStealingExecutorTest::testQueueing()
+{
+	WorkStealingExecutor executor(2);
+	Event release(Event::EVENT_MANUALRESET);
+	std::atomic<int> count(0);
+
+	// more tasks than threads must neither block nor fail
+	for (int i = 0; i < 10; i++)
+	{
+		executor.startFunc([&release, &count]()
+		{
+			release.wait();
+			++count;
+		});
+	}
+	while (executor.statistics().queued > 8) Thread::sleep(10);
+	assertTrue (executor.queueDepth() == 8);
+	assertTrue (count == 0);
+
+	release.set();
+	executor.joinAll();
+	assertTrue (count == 10);
+	assertTrue (executor.queueDepth() == 0);
+}
+
+
+void WorkStealingExecutorTest::testStealing()
+{
+	WorkStealingExecutor executor(2);
+	Event release;
+	std::atomic<int> count(0);
+
+	// The subtasks are queued to the first worker's own queue.
+	// As that worker is blocked, the other worker must steal them.
+	executor.startFunc([&executor, &release, &count]()
+	{
+		for (int i = 0; i < 4; i++)
+		{
+			executor.startFunc([&count]() { ++count; });
+		}
+		release.wait();
+	});
+	while (count < 4) Thread::sleep(10);
+	assertTrue (executor.steals() == 4);
+
+	release.set();
+	executor.joinAll();
+}
+
+
+void WorkStealingExecutorTest::testNestedTasks()
+{
+	WorkStealingExecutor executor(4);
+	std::atomic<long> result(0);
+	executor.startFunc([&executor, &result]()
+	{
+		fibonacci(executor, 20, result);
+	});
+	executor.joinAll();
+	assertTrue (result == 6765);
+	assertTrue (executor.statistics().completed == executor.statistics().submitted);
+}
+
+
+void WorkStealingExecutorTest::testException()
+{
+	WorkStealingExecutor executor(1);
+	std::atomic<int> count(0);
+	executor.startFunc([]() { throw Poco::RuntimeException("task failed"); });
+	executor.startFunc([&count]() { ++count; });
+	executor.joinAll();
+	assertTrue (count == 1);
+	assertTrue (executor.statistics().completed == 2);
+}
+
+
+void WorkStealingExecutorTest::testActiveMethod()
+{
+	ActiveAdder adder;
+	ActiveResult<int> result = adder.add(std::make_pair(20, 22));
+	result.wait();
+	assertTrue (result.data() == 42);
+}
+
+
+void WorkStealingExecutorTest::testStopAll()
+{
+	WorkStealingExecutor executor(2);
+	CountingRunnable runnable;
+	for (int i = 0; i < 10; i++)
+	{
+		executor.start(runnable);
+	}
+	executor.stopAll();
+	assertTrue (runnable.count() == 10);
+
+	try
+	{
+		executor.start(runnable);
+		fail("executor stopped - must throw");
+	}
+	catch (Poco::IllegalStateException&)
+	{
+	}
+}
+
+
+void WorkStealingExecutorTest::setUp()
+{
+}
+
+
+void WorkStealingExecutorTest::tearDown()
+{
+}
+
+
+CppUnit::Test* WorkStealingExecutorTest::suite()
+{
+	CppUnit::TestSuite* pSuite = new CppUnit::TestSuite("WorkStealingExecutorTest");
+
+	CppUnit_addTest(pSuite, WorkStealingExecutorTest, testStart);
+	CppUnit_addTest(pSuite, WorkStealingExecutorTest, testStartFunc);
+	CppUnit_addTest(pSuite, WorkStealingExecutorTest, testQueueing);
+	CppUnit_addTest(pSuite, WorkStealingExecutorTest, testStealing);
+	CppUnit_addTest(pSuite, WorkStealingExecutorTest, testNestedTasks);
+	CppUnit_addTest(pSuite, WorkStealingExecutorTest, testException);
+	CppUnit_addTest(pSuite, WorkStealingExecutorTest, testActiveMethod);
+	CppUnit_addTest(pSuite, WorkStealingExecutorTest, testStopAll);
+
+	return pSuite;
+}
@@ -0,0 +1,43 @@
+//
+// WorkStealingExecutorTest.h
+//
+// Definition of the WorkStealingExecutorTest class.
+//
+// Copyright (c) 2005-2023, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef WorkStealingExecutorTest_INCLUDED
+#define WorkStealingExecutorTest_INCLUDED
+
+
+#include "Poco/Foundation.h"
+#include "CppUnit/TestCase.h"
+
+
+class WorkStealingExecutorTest: public CppUnit::TestCase
+{
+public:
+	WorkStealingExecutorTest(const std::string& name);
+	~WorkStealingExecutorTest();
+
+	void testStart();
+	void testStartFunc();
+	void testQueueing();
+	void testStealing();
+	void testNestedTasks();
+	void testException();
+	void testActiveMethod();
+	void testStopAll();
+
+	void setUp();
+	void tearDown();
+
+	static CppUnit::Test* suite();
+};
+
+
+#endif // WorkStealingExecutorTest_INCLUDED
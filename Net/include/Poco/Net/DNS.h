@@ -22,6 +22,9 @@
 #include "Poco/Net/SocketDefs.h"
 #include "Poco/Net/IPAddress.h"
 #include "Poco/Net/HostEntry.h"
+#include "Poco/Net/DNSCache.h"
+#include "Poco/ActiveResult.h"
+#include "Poco/Timespan.h"
 
 
 namespace Poco {
@@ -43,6 +46,12 @@ class Net_API DNS
 	///   * IDNs returned in HostEntry objects are never decoded. They can be
 	///     decoded by calling decodeIDN() (after testing for an encoded IDN by
 	///     calling isEncodedIDN()).
+	///
+	/// The results of hostByName() (and thus of resolve(), and of
+	/// SocketAddress objects created from host names) can be cached
+	/// by enabling the global DNS cache (see enableCache()).
+	/// Host names can also be resolved asynchronously, using
+	/// resolveAsync().
 {
 public:
 	enum HintFlag
@@ -123,6 +132,55 @@ public:
 		/// Convenience method that calls resolve(address) and returns
 		/// the first address from the HostInfo.
 
+	static Poco::ActiveResult<HostEntry> resolveAsync(const std::string& address);
+		/// Calls resolve(address) in a separate thread, taken from
+		/// a thread pool owned by the DNS class, and returns an
+		/// ActiveResult for the HostEntry.
+		///
+		/// Exceptions thrown by resolve() are reported through
+		/// the ActiveResult.
+		///
+		/// Throws a NoThreadAvailableException if all threads of
+		/// the pool are busy.
+
+	static void enableCache(std::size_t maxSize = DNSCache::DEFAULT_MAX_SIZE, const Poco::Timespan& ttl = Poco::Timespan(60, 0), const Poco::Timespan& negativeTTL = Poco::Timespan(5, 0));
+		/// Enables (or re-configures) the global DNS cache used by
+		/// hostByName(), holding at most maxSize entries.
+		///
+		/// Since getaddrinfo() does not report the time to live of
+		/// DNS records, successful lookups are cached for the given
+		/// ttl, which should not exceed the TTLs of the records
+		/// resolved. Lookups that failed with a HostNotFoundException
+		/// or a NoAddressFoundException are cached for negativeTTL.
+		///
+		/// The cache is disabled by default.
+
+	static void disableCache();
+		/// Disables and clears the global DNS cache.
+
+	static bool cacheEnabled();
+		/// Returns true iff the global DNS cache is enabled.
+
+	static void flushCache();
+		/// Removes all entries from the global DNS cache.
+
+	static DNSCache::Statistics cacheStatistics();
+		/// Returns the statistics of the global DNS cache.
+
+	static void setHostsFile(const std::string& path, bool exclusive = false);
+		/// Loads host names and their addresses from the given file in
+		/// hosts(5) format, which hostByName() consults before the
+		/// system resolver.
+		///
+		/// If exclusive is true, host names not found in the file are
+		/// reported with a HostNotFoundException, without querying the
+		/// system resolver. This can be used, e.g., for testing.
+		///
+		/// An empty path removes a previously loaded file.
+		/// The global DNS cache is flushed.
+		///
+		/// Throws a FileNotFoundException if the file cannot be opened.
+
 	static HostEntry thisHost();
 		/// Returns a HostEntry object containing the DNS information
 		/// for this host.
@@ -138,11 +196,11 @@ public:
 		/// Throws an IOException in case of any other error.
 
 	static void reload();
-		/// Reloads the resolver configuration.
+		/// Reloads the resolver configuration and flushes
+		/// the global DNS cache.
 		///
 		/// This method will call res_init() if the Net library
-		/// has been compiled with -DPOCO_HAVE_LIBRESOLV. Otherwise
-		/// it will do nothing.
+		/// has been compiled with -DPOCO_HAVE_LIBRESOLV.
 
 	static std::string hostName();
 		/// Returns the host name of this host.
@@ -180,6 +238,10 @@ protected:
 	static void aierror(int code, const std::string& arg);
 		/// Throws an exception according to the getaddrinfo() error code.
 
+	static HostEntry hostByNameImpl(const std::string& hostname, unsigned hintFlags);
+		/// Looks up the given host name in the hosts file
+		/// (see setHostsFile()) or using the system resolver.
+
 	static std::string encodeIDNLabel(const std::string& idn);
 		/// Encodes the given IDN (internationalized domain name) label, which must
 		/// be in UTF-8 encoding.
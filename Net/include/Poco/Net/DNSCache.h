@@ -0,0 +1,156 @@
+//
+// DNSCache.h
+//
+// Library: Net
+// Package: NetCore
+// Module:  DNSCache
+//
+// Definition of the DNSCache class.
+//
+// Copyright (c) 2005-2023, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef Net_DNSCache_INCLUDED
+#define Net_DNSCache_INCLUDED
+
+
+#include "Poco/Net/Net.h"
+#include "Poco/Net/HostEntry.h"
+#include "Poco/UniqueExpireLRUCache.h"
+#include "Poco/Exception.h"
+#include "Poco/SharedPtr.h"
+#include "Poco/Timestamp.h"
+#include "Poco/Timespan.h"
+#include <atomic>
+
+
+namespace Poco {
+namespace Net {
+
+
+class Net_API DNSCache
+	/// A thread-safe cache for the results of host name lookups,
+	/// used by DNS::hostByName() if enabled with DNS::enableCache().
+	///
+	/// Successful lookups are cached for the positive time to live (TTL).
+	/// Lookups that failed because the host or its addresses do not exist
+	/// (HostNotFoundException, NoAddressFoundException) are cached for the
+	/// negative TTL, and the exception is rethrown by get() until the entry
+	/// expires. Temporary failures are never cached.
+	///
+	/// If the cache is full, the least recently used entries are evicted.
+{
+public:
+	using Ptr = Poco::SharedPtr<DNSCache>;
+
+	enum
+	{
+		DEFAULT_MAX_SIZE = 1024
+	};
+
+	struct Statistics
+		/// Cache statistics.
+	{
+		Poco::UInt64 hits;
+			/// Number of lookups answered with a cached host entry.
+		Poco::UInt64 negativeHits;
+			/// Number of lookups answered with a cached failure.
+		Poco::UInt64 misses;
+			/// Number of lookups not found in the cache.
+		std::size_t size;
+			/// Number of entries in the cache.
+	};
+
+	explicit DNSCache(std::size_t maxSize = DEFAULT_MAX_SIZE, const Poco::Timespan& ttl = Poco::Timespan(60, 0), const Poco::Timespan& negativeTTL = Poco::Timespan(5, 0));
+		/// Creates a DNSCache holding at most maxSize entries, using
+		/// the given positive and negative TTLs. A zero negative TTL
+		/// disables negative caching.
+
+	~DNSCache();
+		/// Destroys the DNSCache.
+
+	bool get(const std::string& key, HostEntry& entry);
+		/// Looks up the given key. If a host entry has been cached
+		/// for the key, stores it in entry and returns true.
+		/// If a failure has been cached for the key, rethrows the
+		/// exception. Otherwise, returns false.
+
+	void add(const std::string& key, const HostEntry& entry);
+		/// Caches the given host entry for the positive TTL.
+
+	void addNegative(const std::string& key, const Poco::Exception& exc);
+		/// Caches the given failure for the negative TTL.
+
+	void remove(const std::string& key);
+		/// Removes the entry for the given key.
+
+	void clear();
+		/// Removes all entries from the cache.
+
+	std::size_t maxSize() const;
+		/// Returns the maximum number of entries.
+
+	const Poco::Timespan& ttl() const;
+		/// Returns the positive TTL.
+
+	const Poco::Timespan& negativeTTL() const;
+		/// Returns the negative TTL.
+
+	Statistics statistics() const;
+		/// Returns the cache statistics.
+
+private:
+	struct Entry
+	{
+		HostEntry hostEntry;
+		Poco::SharedPtr<Poco::Exception> pError;
+		Poco::Timestamp expires;
+
+		const Poco::Timestamp& getExpiration() const
+		{
+			return expires;
+		}
+	};
+
+	DNSCache(const DNSCache&);
+	DNSCache& operator = (const DNSCache&);
+
+	std::size_t _maxSize;
+	Poco::Timespan _ttl;
+	Poco::Timespan _negativeTTL;
+	mutable Poco::UniqueExpireLRUCache<std::string, Entry> _cache;
+	std::atomic<Poco::UInt64> _hits;
+	std::atomic<Poco::UInt64> _negativeHits;
+	std::atomic<Poco::UInt64> _misses;
+};
+
+
+//
+// inlines
+//
+inline std::size_t DNSCache::maxSize() const
+{
+	return _maxSize;
+}
+
+
+inline const Poco::Timespan& DNSCache::ttl() const
+{
+	return _ttl;
+}
+
+
+inline const Poco::Timespan& DNSCache::negativeTTL() const
+{
+	return _negativeTTL;
+}
+
+
+} } // namespace Poco::Net
+
+
+#endif // Net_DNSCache_INCLUDED
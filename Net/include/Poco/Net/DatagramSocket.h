@@ -270,6 +270,88 @@ public:
 		/// The flags parameter can be used to pass system-defined flags
 		/// for recvfrom() like MSG_PEEK.
 
+	int receiveBatch(SocketMsgVec& messages, int flags = 0);
+		/// Receives up to messages.size() datagrams, using a single
+		/// system call where supported (recvmmsg() on Linux).
+		/// For every message received, the payload is stored in buffer,
+		/// and length and the native address of the sender are updated.
+		///
+		/// Blocks until at least one datagram is available, then
+		/// receives all further datagrams available without blocking.
+		///
+		/// Returns the number of messages received.
+		///
+		/// The flags parameter can be used to pass system-defined flags
+		/// for recvmmsg() like MSG_PEEK.
+
+	int sendBatch(SocketMsgVec& messages, int flags = 0);
+		/// Sends the given datagrams, each to its own address,
+		/// using a single system call where supported (sendmmsg()
+		/// on Linux). The length of every message sent is updated.
+		///
+		/// Returns the number of messages sent, which may
+		/// be less than messages.size().
+		///
+		/// The flags parameter can be used to pass system-defined flags
+		/// for sendmmsg() like MSG_DONTROUTE.
+
+	int sendSegments(const void* buffer, int length, int segmentSize, const SocketAddress& address, int flags = 0);
+		/// Sends the contents of the given buffer to the given address
+		/// as a sequence of datagrams of segmentSize bytes each (the last
+		/// one may be shorter).
+		///
+		/// On Linux, UDP generic segmentation offload (GSO) is used to
+		/// pass up to 64 datagrams to the kernel with a single system call.
+		/// Elsewhere, the datagrams are sent one at a time.
+		///
+		/// Returns the number of bytes sent.
+
+	int receiveSegments(void* buffer, int length, SocketAddress& address, int& segmentSize, int flags = 0);
+		/// Receives data from the socket and stores it in buffer.
+		/// Stores the address of the sender in address.
+		///
+		/// If receive offload has been enabled with setReceiveOffload(),
+		/// several datagrams from the same sender may be received at once,
+		/// in which case segmentSize receives the size of the individual
+		/// datagrams (the last one may be shorter). Otherwise, segmentSize
+		/// is set to the number of bytes received. The buffer should be
+		/// large enough for a coalesced datagram (64 KB).
+		///
+		/// Returns the number of bytes received.
+
+	int receiveSegments(void* buffer, int length, struct sockaddr** ppSA, poco_socklen_t** ppSALen, int& segmentSize, int flags = 0);
+		/// Receives data from the socket and stores it in buffer.
+		/// Stores the native address of the sender in
+		/// ppSA, and the length of native address in ppSALen.
+		///
+		/// See receiveSegments() above for the meaning of segmentSize.
+		///
+		/// Returns the number of bytes received.
+
+	void setSegmentSize(int size);
+		/// Sets the value of the UDP_SEGMENT socket option, which
+		/// makes the kernel split every datagram sent that is larger
+		/// than size into datagrams of size bytes (generic segmentation
+		/// offload). A size of 0 disables segmentation.
+		///
+		/// Throws a NotImplementedException if not supported by the platform.
+
+	int getSegmentSize() const;
+		/// Returns the value of the UDP_SEGMENT socket option,
+		/// or 0 if not supported by the platform.
+
+	void setReceiveOffload(bool flag);
+		/// Sets the value of the UDP_GRO socket option, which allows
+		/// the kernel to coalesce datagrams received from the same
+		/// sender (generic receive offload). If enabled, datagrams must
+		/// be received with receiveSegments().
+		///
+		/// Throws a NotImplementedException if not supported by the platform.
+
+	bool getReceiveOffload() const;
+		/// Returns the value of the UDP_GRO socket option,
+		/// or false if not supported by the platform.
+
 	void setBroadcast(bool flag);
 		/// Sets the value of the SO_BROADCAST socket option.
 		///
@@ -292,6 +374,30 @@ protected:
 //
 // inlines
 //
+inline void DatagramSocket::setSegmentSize(int size)
+{
+	impl()->setSegmentSize(size);
+}
+
+
+inline int DatagramSocket::getSegmentSize() const
+{
+	return impl()->getSegmentSize();
+}
+
+
+inline void DatagramSocket::setReceiveOffload(bool flag)
+{
+	impl()->setReceiveOffload(flag);
+}
+
+
+inline bool DatagramSocket::getReceiveOffload() const
+{
+	return impl()->getReceiveOffload();
+}
+
+
 inline void DatagramSocket::setBroadcast(bool flag)
 {
 	impl()->setBroadcast(flag);
@@ -29,18 +29,91 @@ namespace Net {
 
 class Net_API HTTPBufferAllocator
 	/// A BufferAllocator for HTTP streams.
+	///
+	/// Buffers are taken from one of three size classes (4, 16
+	/// and 64 KB); a request is served from the smallest class
+	/// that fits. Larger buffers are allocated directly.
+	///
+	/// Each thread keeps a small cache of free buffers per size
+	/// class, so that allocating and releasing buffers (e.g., when
+	/// setting up keep-alive connections) normally does not need
+	/// any locking. Buffers that do not fit into the thread's cache
+	/// are returned to a global pool of limited capacity, or freed
+	/// if the pool is full. When a thread terminates, its cached
+	/// buffers are returned to the global pool.
+	///
+	/// The buffer size used by HTTPSession and the HTTP streams,
+	/// the pool and cache capacities can be configured. This should
+	/// be done at startup, before any HTTP sessions are created.
 {
 public:
+	struct Statistics
+		/// Allocation statistics for a size class.
+	{
+		Poco::UInt64 allocations = 0;
+			/// Number of buffers allocated.
+		Poco::UInt64 cacheHits = 0;
+			/// Number of allocations served from a thread's cache.
+		Poco::UInt64 poolHits = 0;
+			/// Number of allocations served from the global pool.
+		Poco::UInt64 misses = 0;
+			/// Number of allocations that required new memory.
+		int pooled = 0;
+			/// Number of free buffers currently in the global pool.
+	};
+
 	static char* allocate(std::streamsize size);
+		/// Allocates a buffer of at least the given size.
+
 	static void deallocate(char* ptr, std::streamsize size);
+		/// Releases a buffer obtained from allocate().
+		/// The given size must be the same as the one
+		/// passed to allocate().
+
+	static void setBufferSize(std::streamsize size);
+		/// Sets the size of the buffers used by HTTPSession
+		/// and the HTTP streams. Defaults to BUFFER_SIZE.
+
+	static std::streamsize getBufferSize();
+		/// Returns the size of the buffers used by HTTPSession
+		/// and the HTTP streams.
+
+	static void setPoolCapacity(std::streamsize size, int capacity);
+		/// Sets the maximum number of free buffers kept in
+		/// the global pool for the size class of the given
+		/// buffer size.
+
+	static int getPoolCapacity(std::streamsize size);
+		/// Returns the maximum number of free buffers kept in
+		/// the global pool for the size class of the given
+		/// buffer size.
+
+	static void setThreadCacheCapacity(int capacity);
+		/// Sets the maximum number of free buffers each thread
+		/// keeps per size class. Must not be greater than
+		/// MAX_THREAD_CACHE_CAPACITY. A capacity of 0 disables
+		/// the thread caches.
+
+	static int getThreadCacheCapacity();
+		/// Returns the maximum number of free buffers each
+		/// thread keeps per size class.
+
+	static Statistics statistics(std::streamsize size);
+		/// Returns the statistics for the size class of the
+		/// given buffer size.
+
+	static void resetStatistics();
+		/// Resets all allocation counters.
 
 	enum
 	{
-		BUFFER_SIZE = 4096
+		BUFFER_SIZE = 4096,
+		SMALL_BUFFER_SIZE = 4096,
+		MEDIUM_BUFFER_SIZE = 16384,
+		LARGE_BUFFER_SIZE = 65536,
+		DEFAULT_THREAD_CACHE_CAPACITY = 8,
+		MAX_THREAD_CACHE_CAPACITY = 32
 	};
-
-private:
-	static Poco::MemoryPool _pool;
 };
 
 
@@ -0,0 +1,216 @@
+//
+// HTTPClientSessionPool.h
+//
+// Library: Net
+// Package: HTTPClient
+// Module:  HTTPClientSessionPool
+//
+// Definition of the HTTPClientSessionPool class.
+//
+// Copyright (c) 2005-2023, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef Net_HTTPClientSessionPool_INCLUDED
+#define Net_HTTPClientSessionPool_INCLUDED
+
+
+#include "Poco/Net/Net.h"
+#include "Poco/Net/HTTPClientSession.h"
+#include "Poco/SharedPtr.h"
+#include "Poco/Timespan.h"
+#include "Poco/Timestamp.h"
+#include "Poco/URI.h"
+#include <condition_variable>
+#include <mutex>
+#include <vector>
+#include <map>
+
+
+namespace Poco {
+namespace Net {
+
+
+class HTTPSessionFactory;
+
+
+class Net_API HTTPClientSessionPool
+	/// A pool of persistent (keep-alive) HTTPClientSession objects.
+	///
+	/// Sessions are pooled by scheme, host, port and proxy.
+	/// A session obtained with get() must be given back to the
+	/// pool with put() once the response has been read completely,
+	/// or with discard() if the session cannot be reused (e.g.,
+	/// because the response body has not been read or an error
+	/// occurred).
+	///
+	/// Idle sessions are closed after the idle timeout expires.
+	/// Before an idle session is handed out, its socket is checked;
+	/// sessions whose connection has been closed by the server
+	/// (or which have unexpected data pending) are discarded.
+	///
+	/// The number of sessions (idle and in use) per host is limited.
+	/// If the limit has been reached, get() waits for a session to
+	/// become available.
+	///
+	/// New sessions are created using a HTTPSessionFactory, so that
+	/// all protocols registered with it (e.g., "https") can be pooled.
+	/// Sessions for "http" are created directly if the factory does not
+	/// support it.
+	///
+	/// The pool can be used with HTTPStreamFactory to give
+	/// URIStreamOpener users connection reuse.
+{
+public:
+	using Ptr = Poco::SharedPtr<HTTPClientSessionPool>;
+
+	enum
+	{
+		DEFAULT_MAX_SESSIONS_PER_HOST = 8,
+		DEFAULT_IDLE_TIMEOUT = 8,  /// seconds
+		DEFAULT_WAIT_TIMEOUT = 30  /// seconds
+	};
+
+	HTTPClientSessionPool();
+		/// Creates a HTTPClientSessionPool using the default HTTPSessionFactory.
+
+	explicit HTTPClientSessionPool(HTTPSessionFactory& factory, int maxSessionsPerHost = DEFAULT_MAX_SESSIONS_PER_HOST, const Poco::Timespan& idleTimeout = Poco::Timespan(DEFAULT_IDLE_TIMEOUT, 0));
+		/// Creates a HTTPClientSessionPool using the given HTTPSessionFactory,
+		/// which must outlive the pool.
+
+	~HTTPClientSessionPool();
+		/// Destroys the HTTPClientSessionPool and closes all idle sessions.
+		///
+		/// All sessions must have been given back to the pool.
+
+	HTTPClientSession* get(const Poco::URI& uri);
+		/// Returns a session for the given URI, using the
+		/// proxy configuration of the HTTPSessionFactory.
+		///
+		/// Returns an idle session if one is available, otherwise
+		/// creates a new session. If the maximum number of sessions
+		/// for the host has been reached, waits up to the wait
+		/// timeout for a session to become available and throws a
+		/// Poco::TimeoutException if none becomes available.
+
+	HTTPClientSession* get(const Poco::URI& uri, const HTTPClientSession::ProxyConfig& proxyConfig);
+		/// Returns a session for the given URI, using the given
+		/// proxy configuration. See get(const Poco::URI&).
+
+	void put(HTTPClientSession* pSession);
+		/// Gives a session obtained from get() back to the pool.
+		///
+		/// The session is kept for reuse if it is connected, uses
+		/// keep-alive and has not encountered a network error.
+		/// Otherwise, it is deleted.
+
+	void discard(HTTPClientSession* pSession);
+		/// Deletes a session obtained from get() without
+		/// keeping it for reuse.
+
+	void purge();
+		/// Closes all idle sessions whose idle timeout has expired.
+
+	void clear();
+		/// Closes all idle sessions.
+
+	void setMaxSessionsPerHost(int maxSessions);
+		/// Sets the maximum number of sessions (idle and in use)
+		/// per scheme, host, port and proxy.
+
+	int getMaxSessionsPerHost() const;
+		/// Returns the maximum number of sessions per
+		/// scheme, host, port and proxy.
+
+	void setIdleTimeout(const Poco::Timespan& timeout);
+		/// Sets the time after which idle sessions are closed.
+		/// Also used as the keep-alive timeout of new sessions.
+
+	Poco::Timespan getIdleTimeout() const;
+		/// Returns the time after which idle sessions are closed.
+
+	void setWaitTimeout(const Poco::Timespan& timeout);
+		/// Sets the maximum time get() waits for a session
+		/// if the maximum number of sessions has been reached.
+
+	Poco::Timespan getWaitTimeout() const;
+		/// Returns the maximum time get() waits for a session.
+
+	int idle() const;
+		/// Returns the number of idle sessions in the pool.
+
+	int used() const;
+		/// Returns the number of sessions currently in use.
+
+protected:
+	HTTPClientSession* createSession(const Poco::URI& uri, const HTTPClientSession::ProxyConfig& proxyConfig);
+		/// Creates a new session for the given URI.
+
+	bool isReusable(HTTPClientSession* pSession) const;
+		/// Returns true if the given idle session can be reused.
+
+	static std::string sessionKey(const Poco::URI& uri, const HTTPClientSession::ProxyConfig& proxyConfig);
+		/// Returns the key identifying sessions that can be used
+		/// interchangeably.
+
+private:
+	struct IdleSession
+	{
+		HTTPClientSession* pSession;
+		Poco::Timestamp since;
+	};
+
+	struct Host
+	{
+		std::vector<IdleSession> idle;
+		int used = 0;
+		int waiting = 0; /// Number of threads waiting in get(). A Host is not erased while this is > 0.
+	};
+
+	using HostMap = std::map<std::string, Host>;
+	using SessionMap = std::map<HTTPClientSession*, std::string>;
+
+	HTTPClientSessionPool(const HTTPClientSessionPool&);
+	HTTPClientSessionPool& operator = (const HTTPClientSessionPool&);
+
+	HTTPClientSession* release(HTTPClientSession* pSession, bool reuse);
+
+	HTTPSessionFactory& _factory;
+	int _maxSessionsPerHost;
+	Poco::Timespan _idleTimeout;
+	Poco::Timespan _waitTimeout;
+	HostMap _hosts;
+	SessionMap _sessions;
+	mutable std::mutex _mutex;
+	std::condition_variable _available;
+};
+
+
+//
+// inlines
+//
+inline int HTTPClientSessionPool::getMaxSessionsPerHost() const
+{
+	return _maxSessionsPerHost;
+}
+
+
+inline Poco::Timespan HTTPClientSessionPool::getIdleTimeout() const
+{
+	return _idleTimeout;
+}
+
+
+inline Poco::Timespan HTTPClientSessionPool::getWaitTimeout() const
+{
+	return _waitTimeout;
+}
+
+
+} } // namespace Poco::Net
+
+
+#endif // Net_HTTPClientSessionPool_INCLUDED
@@ -20,6 +20,7 @@
 
 #include "Poco/Net/Net.h"
 #include "Poco/Net/HTTPResponse.h"
+#include "Poco/Net/HTTPClientSessionPool.h"
 #include "Poco/UnbufferedStreamBuf.h"
 
 
@@ -75,10 +76,17 @@ class Net_API HTTPResponseStream: public HTTPResponseIOS, public std::istream
 public:
 	HTTPResponseStream(std::istream& istr, HTTPClientSession* pSession);
 
+	HTTPResponseStream(std::istream& istr, HTTPClientSession* pSession, HTTPClientSessionPool::Ptr pSessionPool);
+		/// Creates a HTTPResponseStream for a session obtained from
+		/// the given pool (which may be null). When the stream is
+		/// destroyed, the session is given back to the pool if the
+		/// response has been read completely, and discarded otherwise.
+
 	~HTTPResponseStream();
 
 private:
 	HTTPClientSession* _pSession;
+	HTTPClientSessionPool::Ptr _pSessionPool;
 };
 
 
@@ -43,6 +43,7 @@ public:
 		///   - keepAlive:            true
 		///   - maxKeepAliveRequests: 0
 		///   - keepAliveTimeout:     10 seconds
+		///   - pipelining:           false
 
 	void setServerName(const std::string& serverName);
 		/// Sets the name and port (name:port) that the server uses to identify itself.
@@ -95,6 +96,19 @@ public:
 		/// during a persistent connection, or 0 if
 		/// unlimited connections are allowed.
 
+	void setPipelining(bool pipelining);
+		/// Enables (pipelining == true) or disables (pipelining == false)
+		/// batching of responses to pipelined requests.
+		///
+		/// If enabled, and further requests have already been received
+		/// on a persistent connection, the response to a request is
+		/// not sent immediately, but together with the responses to the
+		/// following requests, using a single (vectored) write.
+
+	bool getPipelining() const;
+		/// Returns true iff batching of responses to pipelined
+		/// requests is enabled.
+
 protected:
 	virtual ~HTTPServerParams();
 		/// Destroys the HTTPServerParams.
@@ -106,6 +120,7 @@ private:
 	bool           _keepAlive;
 	int            _maxKeepAliveRequests;
 	Poco::Timespan _keepAliveTimeout;
+	bool           _pipelining;
 };
 
 
@@ -148,6 +163,12 @@ inline const Poco::Timespan& HTTPServerParams::getKeepAliveTimeout() const
 }
 
 
+inline bool HTTPServerParams::getPipelining() const
+{
+	return _pipelining;
+}
+
+
 } } // namespace Poco::Net
 
 
@@ -73,6 +73,16 @@ public:
 		/// Throws a FileNotFoundException if the file
 		/// cannot be found, or an OpenFileException if
 		/// the file cannot be opened.
+		///
+		/// If the request contains a Range header specifying
+		/// a single byte range (and no If-Range header that does
+		/// not match the file's modification date), only the requested
+		/// part of the file is sent with status 206 (Partial Content),
+		/// or status 416 (Range Not Satisfiable) if the range lies
+		/// outside the file.
+		///
+		/// On Linux, the file content is sent with sendfile(2),
+		/// without copying it to user space.
 
 	void sendBuffer(const void* pBuffer, std::size_t length);
 		/// Sends the response header to the client, followed
@@ -109,6 +119,16 @@ public:
 protected:
 	void attachRequest(HTTPServerRequestImpl* pRequest);
 
+	static bool parseRange(const std::string& range, Poco::UInt64 length, Poco::UInt64& first, Poco::UInt64& last);
+		/// Parses the value of a Range header specifying a single
+		/// byte range for an entity of the given length.
+		///
+		/// Returns false if the header cannot be parsed or specifies
+		/// multiple ranges, in which case the header must be ignored.
+		/// Otherwise, returns true and stores the positions of the first
+		/// and last byte of the range in first and last. If the range
+		/// cannot be satisfied, first will be greater than last.
+
 private:
 	HTTPServerSession& _session;
 	HTTPServerRequestImpl* _pRequest;
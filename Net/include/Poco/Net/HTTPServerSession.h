@@ -45,6 +45,11 @@ public:
 	bool hasMoreRequests();
 		/// Returns true if there are requests available.
 
+	bool hasBufferedRequests() const;
+		/// Returns true if data following the current request
+		/// (typically, further pipelined requests) has already
+		/// been received and is waiting in the session's buffer.
+
 	bool canKeepAlive() const;
 		/// Returns true if the session can be kept alive.
 
@@ -70,6 +75,12 @@ inline bool HTTPServerSession::canKeepAlive() const
 }
 
 
+inline bool HTTPServerSession::hasBufferedRequests() const
+{
+	return buffered() > 0;
+}
+
+
 } } // namespace Poco::Net
 
 
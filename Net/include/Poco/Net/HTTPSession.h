@@ -26,6 +26,8 @@
 #include "Poco/Any.h"
 #include "Poco/Buffer.h"
 #include <ios>
+#include <vector>
+#include <string>
 
 
 namespace Poco {
@@ -83,6 +85,26 @@ public:
 	bool connected() const;
 		/// Returns true if the underlying socket is connected.
 
+	void setOutputBuffering(bool enable);
+		/// Enables or disables output buffering.
+		///
+		/// If enabled, data written to the session is collected
+		/// (up to MAX_OUTPUT_BUFFER_SIZE bytes) and sent with a single
+		/// (vectored) write by flushOutput(). Buffered output is also
+		/// sent before the session reads from or detaches its socket.
+		///
+		/// This is used by HTTPServerConnection to coalesce the
+		/// responses to pipelined requests.
+
+	bool getOutputBuffering() const;
+		/// Returns true if output buffering is enabled.
+
+	void flushOutput();
+		/// Sends all buffered output.
+
+	std::size_t outputBuffered() const;
+		/// Returns the number of bytes of buffered output.
+
 	virtual void abort();
 		/// Aborts a session in progress by shutting down
 		/// and closing the underlying socket.
@@ -110,7 +132,8 @@ public:
 
 	enum
 	{
-		HTTP_PORT = 80
+		HTTP_PORT = 80,
+		MAX_OUTPUT_BUFFER_SIZE = 65536
 	};
 
 	StreamSocket detachSocket();
@@ -181,6 +204,14 @@ protected:
 		/// Reads more data from the socket if there are
 		/// no bytes left in the buffer.
 
+	int readLine(char* buffer, std::streamsize length);
+		/// Reads up to length bytes, stopping after the first
+		/// line feed character, which is included in the result.
+		/// Reads more data from the socket as necessary.
+		///
+		/// Returns the number of bytes read, which is 0 only
+		/// at the end of the stream.
+
 	virtual int read(char* buffer, std::streamsize length);
 		/// Reads up to length bytes.
 		///
@@ -191,6 +222,12 @@ protected:
 	virtual int write(const char* buffer, std::streamsize length);
 		/// Writes data to the socket.
 
+	std::streamsize sendFile(FileInputStream& fileInputStream, std::streamoff offset, std::streamsize count);
+		/// Sends count bytes of the given file, starting at offset,
+		/// directly through the socket (see StreamSocket::sendFile()).
+		///
+		/// Returns the number of bytes sent.
+
 	int receive(char* buffer, int length);
 		/// Reads up to length bytes.
 
@@ -231,10 +268,24 @@ private:
 	HTTPSession(const HTTPSession&);
 	HTTPSession& operator = (const HTTPSession&);
 
+	void bufferOutput(const char* buffer, std::size_t length);
+	void sendOutput(const char* buffer, std::size_t length);
+	void resetOutput();
+
+	enum
+	{
+		OUTPUT_CHUNK_SIZE = 16384
+	};
+
 	StreamSocket     _socket;
 	char*            _pBuffer;
 	char*            _pCurrent;
 	char*            _pEnd;
+	std::streamsize  _bufferSize;
+	bool             _outputBuffering;
+	std::vector<std::string> _outputChunks;
+	std::size_t      _outputChunkCount;
+	std::size_t      _outputBuffered;
 	bool             _keepAlive;
 	Poco::Timespan   _connectionTimeout;
 	Poco::Timespan   _receiveTimeout;
@@ -248,6 +299,7 @@ private:
 	friend class HTTPHeaderStreamBuf;
 	friend class HTTPFixedLengthStreamBuf;
 	friend class HTTPChunkedStreamBuf;
+	friend class HTTPServerResponseImpl;
 };
 
 
@@ -302,6 +354,18 @@ inline Poco::Timespan HTTPSession::getReceiveTimeout() const
 }
 
 
+inline bool HTTPSession::getOutputBuffering() const
+{
+	return _outputBuffering;
+}
+
+
+inline std::size_t HTTPSession::outputBuffered() const
+{
+	return _outputBuffered;
+}
+
+
 inline StreamSocket& HTTPSession::socket()
 {
 	return _socket;
@@ -20,6 +20,7 @@
 
 #include "Poco/Net/Net.h"
 #include "Poco/Net/HTTPSession.h"
+#include "Poco/Net/HTTPClientSessionPool.h"
 #include "Poco/URIStreamFactory.h"
 
 
@@ -47,6 +48,13 @@ public:
 		/// will be authorized against the proxy using Basic authentication
 		/// with the given proxyUsername and proxyPassword.
 
+	explicit HTTPStreamFactory(HTTPClientSessionPool::Ptr pSessionPool);
+		/// Creates the HTTPStreamFactory.
+		///
+		/// HTTP connections are taken from the given session pool,
+		/// and are given back to it once the stream returned by
+		/// open() has been read completely and is deleted.
+
 	virtual ~HTTPStreamFactory();
 		/// Destroys the HTTPStreamFactory.
 
@@ -65,10 +73,22 @@ public:
 		/// The offending URI can then be obtained via the message()
 		/// method of UnsupportedRedirectException.
 
+	void setSessionPool(HTTPClientSessionPool::Ptr pSessionPool);
+		/// Sets the session pool used for HTTP connections.
+		/// If null, a new session is created for every stream.
+
+	HTTPClientSessionPool::Ptr getSessionPool() const;
+		/// Returns the session pool used for HTTP connections,
+		/// which may be null.
+
 	static void registerFactory();
 		/// Registers the HTTPStreamFactory with the
 		/// default URIStreamOpener instance.
 
+	static void registerFactory(HTTPClientSessionPool::Ptr pSessionPool);
+		/// Registers a HTTPStreamFactory using the given session
+		/// pool with the default URIStreamOpener instance.
+
 	static void unregisterFactory();
 		/// Unregisters the HTTPStreamFactory with the
 		/// default URIStreamOpener instance.
@@ -79,13 +99,25 @@ private:
 		MAX_REDIRECTS = 10
 	};
 
+	void discardSession(HTTPClientSession* pSession);
+
 	std::string  _proxyHost;
 	Poco::UInt16 _proxyPort;
 	std::string  _proxyUsername;
 	std::string  _proxyPassword;
+	HTTPClientSessionPool::Ptr _pSessionPool;
 };
 
 
+//
+// inlines
+//
+inline HTTPClientSessionPool::Ptr HTTPStreamFactory::getSessionPool() const
+{
+	return _pSessionPool;
+}
+
+
 } } // namespace Poco::Net
 
 
@@ -52,6 +52,10 @@ public:
 	HostEntry(const std::string& name, const IPAddress& addr);
 #endif
 
+	HostEntry(const std::string& name, const AddressList& addresses, const AliasList& aliases = AliasList());
+		/// Creates the HostEntry from the given canonical host name,
+		/// addresses and alias names.
+
 	HostEntry(const HostEntry& entry);
 		/// Creates the HostEntry by copying another one.
 
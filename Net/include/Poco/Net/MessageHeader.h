@@ -20,6 +20,7 @@
 
 #include "Poco/Net/Net.h"
 #include "Poco/Net/NameValueCollection.h"
+#include "Poco/Buffer.h"
 #include <ostream>
 #include <istream>
 #include <vector>
@@ -84,6 +85,12 @@ public:
 		/// Some basic sanity checking of the input stream is
 		/// performed.
 		///
+		/// Header lines are extracted with std::istream::getline(),
+		/// which standard libraries implement by scanning the stream
+		/// buffer in bulk, and are then split into name and value
+		/// using SSE2/AVX2 instructions where available. RFC 2047
+		/// decoding is only performed on values containing "=?".
+		///
 		/// Throws a MessageException if the input stream is
 		/// malformed.
 
@@ -176,9 +183,24 @@ private:
 	{
 		DFL_NAME_LENGTH_LIMIT  = 256,
 		DFL_VALUE_LENGTH_LIMIT = 8192,
-		DFL_FIELD_LIMIT = 100
+		DFL_FIELD_LIMIT = 100,
+		MAX_LINE_SLACK = 64,
+		LINE_BUFFER_SIZE = 1024
 	};
 
+	static std::size_t readLine(std::istream& istr, Poco::Buffer<char>& line, std::size_t maxLength);
+		/// Reads a line, up to but excluding the terminating LF,
+		/// into the given buffer, growing it (up to maxLength) as
+		/// necessary. Returns the length of the line.
+
+	static const char* scanValue(const char* it, const char* end, bool& encoded);
+		/// Returns a pointer to the first CR in the given range, or end.
+		/// Sets encoded to true if an RFC 2047 "=?" sequence has been found.
+
+	static const char* findFirstOf(const char* it, const char* end, char c1, char c2);
+		/// Returns a pointer to the first occurrence of c1 or c2
+		/// in the given range, or end if there is none.
+
 	int _fieldLimit;
 	int _nameLengthLimit;
 	int _valueLengthLimit;
@@ -47,11 +47,11 @@ public:
 	MultiSocketPoller(typename UDPHandlerImpl<S>::List& handlers, const UDPServerParams& serverParams):
 		_address(serverParams.address()),
 		_timeout(serverParams.timeout()),
-		_reader(handlers)
+		_reader(handlers, 0, serverParams.batchSize(), serverParams.receiveOffload())
 		/// Creates the MutiSocketPoller.
 	{
 		poco_assert (_address.port() > 0 && _address.host().toString() != "0.0.0.0");
-		addSockets(serverParams.numberOfSockets());
+		addSockets(serverParams.numberOfSockets(), serverParams.receiveOffload());
 	}
 
 	~MultiSocketPoller()
@@ -106,11 +106,12 @@ public:
 	}
 
 private:
-	void addSockets(int nSockets)
+	void addSockets(int nSockets, bool receiveOffload = false)
 	{
 		for (int i = 0; i < nSockets; ++i)
 		{
 			DatagramSocket ds; ds.bind(_address, true, true);
+			if (receiveOffload) ds.setReceiveOffload(true);
 			_pollSet.add(ds, PollSet::POLL_READ | PollSet::POLL_ERROR);
 		}
 	}
@@ -21,6 +21,7 @@
 #include "Poco/Net/Net.h"
 #include "Poco/String.h"
 #include "Poco/ListMap.h"
+#include <vector>
 #include <cstddef>
 
 
@@ -36,6 +37,11 @@ class Net_API NameValueCollection
 	///
 	/// There can be more than one name-value pair with the
 	/// same name.
+	///
+	/// Name-value pairs are kept in insertion order (with pairs
+	/// having the same name grouped together) in a vector.
+	/// A case-insensitive hash of each name is stored alongside,
+	/// so that lookups compare names only if their hashes match.
 {
 public:
 	using HeaderMap = Poco::ListMap<std::string, std::string>;
@@ -113,7 +119,19 @@ public:
 		/// Removes all name-value pairs and their values.
 
 private:
-	HeaderMap _map;
+	using Container = std::vector<HeaderMap::ValueType>;
+	using HashVector = std::vector<Poco::UInt32>;
+
+	static Poco::UInt32 hash(const std::string& name);
+		/// Returns a case-insensitive hash of the given name.
+
+	std::size_t findIndex(const std::string& name, Poco::UInt32 hash) const;
+		/// Returns the index of the first name-value pair with
+		/// the given name and hash, or the size of the collection
+		/// if there is none.
+
+	Container _entries;
+	HashVector _hashes;
 };
 
 
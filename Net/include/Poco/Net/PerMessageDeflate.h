@@ -0,0 +1,216 @@
+//
+// PerMessageDeflate.h
+//
+// Library: Net
+// Package: WebSocket
+// Module:  PerMessageDeflate
+//
+// Definition of the PerMessageDeflate class.
+//
+// Copyright (c) 2005-2023, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef Net_PerMessageDeflate_INCLUDED
+#define Net_PerMessageDeflate_INCLUDED
+
+
+#include "Poco/Net/Net.h"
+#include "Poco/Buffer.h"
+#if defined(POCO_UNBUNDLED)
+#include <zlib.h>
+#else
+#include "Poco/zlib.h"
+#endif
+#include <string>
+
+
+namespace Poco {
+namespace Net {
+
+
+class Net_API PerMessageDeflate
+	/// This class implements the permessage-deflate WebSocket
+	/// extension defined in RFC 7692, which compresses the
+	/// payload of WebSocket data messages using DEFLATE.
+	///
+	/// The extension is enabled by passing a Config to the
+	/// WebSocket constructor. A client offers the extension in
+	/// the opening handshake, and a server accepts the first
+	/// acceptable offer. Once the extension has been negotiated,
+	/// the WebSocket compresses text and binary messages sent,
+	/// and transparently decompresses compressed messages received.
+	/// Control frames are never compressed.
+	///
+	/// The memory used by the compressor and decompressor of
+	/// a connection is dominated by the LZ77 window sizes and
+	/// the memory level of the compressor. It can be limited
+	/// with Config::maxMemory. The size of decompressed messages
+	/// is limited by the maximum payload size of the WebSocket
+	/// (see WebSocket::setMaxPayloadSize()).
+{
+public:
+	enum
+	{
+		MIN_WINDOW_BITS = 9,
+			/// The smallest window supported by the compressor
+			/// (zlib does not support a 256 byte window).
+		MAX_WINDOW_BITS = 15
+	};
+
+	struct Net_API Config
+		/// Configuration of the permessage-deflate extension.
+	{
+		Config();
+			/// Creates a Config with default settings: a 32K window
+			/// for both directions, context takeover enabled, and
+			/// default compression level.
+
+		bool serverNoContextTakeover;
+			/// If true, the server compresses every message
+			/// independently of previous messages.
+
+		bool clientNoContextTakeover;
+			/// If true, the client compresses every message
+			/// independently of previous messages.
+
+		int serverMaxWindowBits;
+			/// Base-2 logarithm of the server's LZ77 window size (9 - 15).
+
+		int clientMaxWindowBits;
+			/// Base-2 logarithm of the client's LZ77 window size (9 - 15).
+
+		int compressionLevel;
+			/// The zlib compression level (0 - 9), or -1 for
+			/// the default level.
+
+		int memLevel;
+			/// The zlib memory level of the compressor (1 - 9).
+
+		int minMessageSize;
+			/// Messages sent in a single frame that are smaller
+			/// than this are sent uncompressed.
+
+		std::size_t maxMemory;
+			/// Upper limit for the memory used by the compressor
+			/// and decompressor of a connection, or 0 for no limit.
+			///
+			/// Window sizes and memory level are reduced as necessary
+			/// to stay within the limit. If the peer's window cannot be
+			/// reduced enough, the extension is not negotiated.
+	};
+
+	struct Net_API Parameters
+		/// The negotiated extension parameters.
+	{
+		Parameters();
+			/// Creates Parameters for a 32K window and
+			/// context takeover in both directions.
+
+		bool serverNoContextTakeover;
+		bool clientNoContextTakeover;
+		int serverMaxWindowBits;
+		int clientMaxWindowBits;
+	};
+
+	PerMessageDeflate(const Parameters& params, const Config& config, bool server);
+		/// Creates a PerMessageDeflate for the server or client
+		/// end of a connection, using the negotiated parameters.
+
+	~PerMessageDeflate();
+		/// Destroys the PerMessageDeflate.
+
+	void compress(const char* data, std::size_t length, bool fin, Poco::Buffer<char>& out);
+		/// Compresses the payload of a frame and stores the compressed
+		/// payload in out, replacing its previous content.
+		///
+		/// fin must be true for the final frame of a message.
+
+	void decompress(const char* data, std::size_t length, bool fin, Poco::Buffer<char>& out, std::size_t maxLength);
+		/// Decompresses the payload of a frame and appends the
+		/// decompressed payload to out.
+		///
+		/// fin must be true for the final frame of a message.
+		///
+		/// Throws a WebSocketException (WS_ERR_PAYLOAD_TOO_BIG) if the
+		/// size of out would exceed maxLength, or a WebSocketException
+		/// (WS_ERR_COMPRESSION) if the payload cannot be decompressed.
+
+	const Parameters& parameters() const;
+		/// Returns the negotiated parameters.
+
+	int minMessageSize() const;
+		/// Returns the size of the smallest single-frame
+		/// message that will be compressed.
+
+	std::size_t memoryUsage() const;
+		/// Returns the approximate memory used by the
+		/// compressor and decompressor.
+
+	static std::string offer(const Config& config);
+		/// Returns the value of the Sec-WebSocket-Extensions header
+		/// containing a client's extension negotiation offer.
+
+	static bool accept(const std::string& offers, const Config& config, Parameters& params, std::string& response);
+		/// Selects the first acceptable permessage-deflate offer from the
+		/// given value of a Sec-WebSocket-Extensions request header.
+		///
+		/// If an offer is acceptable, stores the negotiated parameters
+		/// in params, the value of the Sec-WebSocket-Extensions response
+		/// header in response, and returns true. Otherwise, returns false.
+
+	static void confirm(const std::string& response, const Config& config, Parameters& params);
+		/// Validates the value of a Sec-WebSocket-Extensions header
+		/// received in a handshake response to an offer created
+		/// with offer(), and stores the negotiated parameters in params.
+		///
+		/// Throws a WebSocketException (WS_ERR_HANDSHAKE_EXTENSION) if the
+		/// response is not a valid permessage-deflate response.
+
+	static const std::string EXTENSION_NAME;
+		/// The extension name ("permessage-deflate").
+
+protected:
+	static int offeredServerWindowBits(const Config& config);
+	static std::size_t deflateMemory(int windowBits, int memLevel);
+	static std::size_t inflateMemory(int windowBits);
+	static bool parseWindowBits(const std::string& value, int& windowBits);
+
+private:
+	PerMessageDeflate(const PerMessageDeflate&);
+	PerMessageDeflate& operator = (const PerMessageDeflate&);
+
+	Parameters _params;
+	int _minMessageSize;
+	bool _deflateReset;
+	bool _inflateReset;
+	int _deflateWindowBits;
+	int _deflateMemLevel;
+	int _inflateWindowBits;
+	z_stream _deflate;
+	z_stream _inflate;
+};
+
+
+//
+// inlines
+//
+inline const PerMessageDeflate::Parameters& PerMessageDeflate::parameters() const
+{
+	return _params;
+}
+
+
+inline int PerMessageDeflate::minMessageSize() const
+{
+	return _minMessageSize;
+}
+
+
+} } // namespace Poco::Net
+
+
+#endif // Net_PerMessageDeflate_INCLUDED
@@ -20,6 +20,7 @@
 
 #include "Poco/Net/Socket.h"
 #include <map>
+#include <vector>
 
 
 namespace Poco {
@@ -44,7 +45,32 @@ public:
 		POLL_ERROR = Socket::SELECT_ERROR
 	};
 
+	enum Option
+		/// Options that can be OR'd to the mode given to add()
+		/// and update(). Options are only supported by the epoll
+		/// implementation and are ignored otherwise.
+	{
+		POLL_EDGE      = 0x100,
+			/// Edge-triggered notification (EPOLLET). The socket is only
+			/// reported when its state changes, so the caller must drain it
+			/// (read or write until the operation would block) before the
+			/// next notification can be expected.
+
+		POLL_ONESHOT   = 0x200,
+			/// One-shot notification (EPOLLONESHOT). After the socket has
+			/// been reported once, it is disabled until rearm() is called.
+
+		POLL_EXCLUSIVE = 0x400
+			/// Exclusive wake-up (EPOLLEXCLUSIVE), intended for listening
+			/// sockets shared by multiple PollSet instances (e.g., multiple
+			/// reactors accepting on the same socket): only one of the
+			/// waiting PollSets is woken up for a new event, which avoids
+			/// the thundering herd. Cannot be combined with POLL_ONESHOT.
+	};
+
 	using SocketModeMap = std::map<Poco::Net::Socket, int>;
+	using SocketMode = std::pair<Poco::Net::Socket, int>;
+	using SocketModeList = std::vector<SocketMode>;
 
 	PollSet();
 		/// Creates an empty PollSet.
@@ -68,6 +94,9 @@ public:
 		/// equivalent to this:
 		///
 		/// ps.update(ss, PollSet::POLL_READ | PollSet::POLL_WRITE);
+		///
+		/// Mode can also contain a combination of Option flags, which are
+		/// cumulative as well.
 
 	void remove(const Poco::Net::Socket& socket);
 		/// Removes the given socket from the set.
@@ -86,6 +115,17 @@ public:
 		/// ps.update(ss, PollSet::POLL_WRITE);
 		///
 		/// shall result in the socket being monitored for write only.
+		///
+		/// Mode can also contain a combination of Option flags; prior
+		/// options are overwritten as well.
+
+	void rearm(const Poco::Net::Socket& socket);
+		/// Re-enables polling for a socket that has been added
+		/// with the POLL_ONESHOT option and has since been reported
+		/// by poll(), using its current mode.
+		///
+		/// Does nothing if the socket is not in the set, or was
+		/// not added with the POLL_ONESHOT option.
 
 	bool has(const Socket& socket) const;
 		/// Returns true if socket is registered for polling.
@@ -102,6 +142,21 @@ public:
 		/// Returns a PollMap containing the sockets that have had
 		/// their state changed.
 
+	int poll(const Poco::Timespan& timeout, SocketModeList& result);
+		/// Waits until the state of at least one of the PollSet's sockets
+		/// changes accordingly to its mode, or the timeout expires.
+		///
+		/// The given result list is cleared (its capacity is retained)
+		/// and filled with the sockets that have had their state changed,
+		/// together with the OR'd combination of the modes that are ready.
+		/// Every socket appears at most once in the list.
+		///
+		/// Returns the number of entries in the result list.
+		///
+		/// This is the preferred variant for event loops: if the same list
+		/// is passed to consecutive calls, polling does not allocate memory
+		/// once the list has grown to the number of ready sockets.
+
 	int count() const;
 		/// Returns the number of sockets monitored.
 
@@ -378,6 +378,27 @@ inline int SocketBufVecSize(const SocketBufVec& sbv)
 	return static_cast<int>(sz);
 }
 
+
+struct SocketMsg
+	/// A single datagram for batched datagram I/O
+	/// (see SocketImpl::receiveBatch() and SocketImpl::sendBatch()).
+{
+	void* buffer;
+		/// The datagram payload.
+	int capacity;
+		/// The size of buffer. When sending, the payload length.
+	struct sockaddr* pAddress;
+		/// The peer address. When receiving, may be null
+		/// if the address is not needed.
+	poco_socklen_t addressLength;
+		/// The size of pAddress. When receiving, updated
+		/// with the actual length of the peer address.
+	int length;
+		/// The number of bytes received or sent.
+};
+
+typedef std::vector<SocketMsg> SocketMsgVec;
+
 struct AddressFamily
 	/// AddressFamily::Family replaces the previously used IPAddress::Family
 	/// enumeration and is now used for IPAddress::Family and SocketAddress::Family.
@@ -27,6 +27,11 @@
 
 
 namespace Poco {
+
+
+class FileInputStream;
+
+
 namespace Net {
 
 
@@ -182,6 +187,21 @@ public:
 		///
 		/// Always returns zero for platforms where not implemented.
 
+	virtual std::streamsize sendFile(FileInputStream& fileInputStream, std::streamoff offset = 0, std::streamsize count = 0);
+		/// Sends count bytes of the file opened by fileInputStream,
+		/// starting at the given offset, through the socket.
+		/// If count is 0, the file is sent up to its end.
+		///
+		/// On Linux, the file is sent with sendfile(2), without
+		/// copying its content to user space. On other platforms,
+		/// and for secure sockets, the file content is read into
+		/// a buffer and sent with sendBytes().
+		///
+		/// Returns the number of bytes sent, which may be less
+		/// than count if the socket is non-blocking or the end of
+		/// the file has been reached. The read position of
+		/// fileInputStream is unspecified after the call.
+
 	virtual int receiveBytes(void* buffer, int length, int flags = 0);
 		/// Receives data from the socket and stores it
 		/// in buffer. Up to length bytes are received.
@@ -255,6 +275,58 @@ public:
 		///
 		/// Returns the number of bytes received.
 
+	virtual int receiveBatch(SocketMsgVec& messages, int flags = 0);
+		/// Receives up to messages.size() datagrams with a single
+		/// system call where supported (recvmmsg() on Linux).
+		/// For every message received, the payload is stored in
+		/// buffer, and length and the sender's address are updated.
+		///
+		/// Blocks (subject to the receive timeout) until at least one
+		/// datagram is available, then receives all further datagrams
+		/// that are available without blocking.
+		///
+		/// Returns the number of messages received, which may
+		/// be less than messages.size(). On non-blocking sockets,
+		/// returns -1 if no datagram is available.
+		///
+		/// On platforms without recvmmsg(), falls back to
+		/// receiving datagrams one at a time.
+
+	virtual int sendBatch(SocketMsgVec& messages, int flags = 0);
+		/// Sends the given datagrams with a single system call
+		/// where supported (sendmmsg() on Linux), each to its
+		/// own address. The length of every message sent is updated
+		/// with the number of bytes sent.
+		///
+		/// Returns the number of messages sent, which may
+		/// be less than messages.size().
+		///
+		/// On platforms without sendmmsg(), falls back to
+		/// sending datagrams one at a time.
+
+	virtual int sendSegments(const void* buffer, int length, int segmentSize, const SocketAddress& address, int flags = 0);
+		/// Sends the contents of the given buffer to the given address
+		/// as a sequence of datagrams of segmentSize bytes each (the last
+		/// one may be shorter).
+		///
+		/// On Linux, UDP generic segmentation offload (UDP_SEGMENT) is
+		/// used to pass up to 64 datagrams to the kernel with a single
+		/// system call. Elsewhere, the datagrams are sent one at a time.
+		///
+		/// Returns the number of bytes sent.
+
+	virtual int receiveSegments(void* buffer, int length, struct sockaddr** ppSA, poco_socklen_t** ppSALen, int& segmentSize, int flags = 0);
+		/// Receives data from the socket and stores it in buffer,
+		/// and the native address of the sender in ppSA and ppSALen.
+		///
+		/// If UDP receive offload is enabled (see setReceiveOffload()),
+		/// the kernel may coalesce several datagrams from the same sender
+		/// into buffer. In this case, segmentSize receives the size of the
+		/// individual datagrams (the last one may be shorter). Otherwise,
+		/// segmentSize is set to the number of bytes received.
+		///
+		/// Returns the number of bytes received.
+
 	virtual void sendUrgent(unsigned char data);
 		/// Sends one byte of urgent data through
 		/// the socket.
@@ -428,6 +500,30 @@ public:
 	bool getBroadcast();
 		/// Returns the value of the SO_BROADCAST socket option.
 
+	void setSegmentSize(int size);
+		/// Sets the value of the UDP_SEGMENT socket option, which
+		/// makes the kernel split datagrams larger than size into
+		/// datagrams of size bytes. A size of 0 disables segmentation.
+		///
+		/// Throws a NotImplementedException if UDP segmentation
+		/// offload is not supported by the platform.
+
+	int getSegmentSize();
+		/// Returns the value of the UDP_SEGMENT socket option,
+		/// or 0 if not supported by the platform.
+
+	void setReceiveOffload(bool flag);
+		/// Sets the value of the UDP_GRO socket option, which
+		/// allows the kernel to coalesce received datagrams.
+		/// Coalesced datagrams must be received with receiveSegments().
+		///
+		/// Throws a NotImplementedException if UDP receive
+		/// offload is not supported by the platform.
+
+	bool getReceiveOffload();
+		/// Returns the value of the UDP_GRO socket option,
+		/// or false if not supported by the platform.
+
 	virtual void setBlocking(bool flag);
 		/// Sets the socket in blocking mode if flag is true,
 		/// disables blocking mode if flag is false.
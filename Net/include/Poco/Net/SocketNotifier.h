@@ -24,6 +24,7 @@
 #include "Poco/NotificationCenter.h"
 #include "Poco/Observer.h"
 #include <set>
+#include <atomic>
 
 
 namespace Poco {
@@ -64,6 +65,14 @@ public:
 	std::size_t countObservers() const;
 		/// Returns the number of subscribers;
 
+	void addPollOptions(int options);
+		/// Adds the given PollSet::Option flags to the
+		/// socket's poll options.
+
+	int pollOptions() const;
+		/// Returns the PollSet::Option flags the socket
+		/// is registered with.
+
 protected:
 	~SocketNotifier();
 		/// Destroys the SocketNotifier.
@@ -77,6 +86,7 @@ private:
 	Poco::NotificationCenter _nc;
 	Socket                   _socket;
 	MutexType                _mutex;
+	std::atomic<int>         _pollOptions;
 };
 
 
@@ -108,6 +118,18 @@ inline std::size_t SocketNotifier::countObservers() const
 }
 
 
+inline void SocketNotifier::addPollOptions(int options)
+{
+	_pollOptions |= options;
+}
+
+
+inline int SocketNotifier::pollOptions() const
+{
+	return _pollOptions;
+}
+
+
 } } // namespace Poco::Net
 
 
@@ -49,12 +49,22 @@ namespace Net {
 
 class Socket;
 class Worker;
+class IOUring;
 
 
 class Net_API SocketProactor final: public Poco::Runnable
 	/// This class implements the proactor pattern.
 	/// It may also contain a simple work executor (enabled by default),
 	/// which executes submitted workload.
+	///
+	/// By default, I/O completion is emulated on top of PollSet: the
+	/// proactor waits for socket readiness and then performs the I/O.
+	/// If Poco is built with io_uring support (POCO_ENABLE_IO_URING CMake
+	/// option, Linux only) and the running kernel supports it, the
+	/// receive and send operations are submitted directly to the kernel
+	/// instead; all operations queued during one loop iteration are
+	/// submitted with a single system call. If io_uring is not available
+	/// at runtime, the proactor transparently falls back to PollSet.
 {
 public:
 	using Buffer = std::vector<std::uint8_t>;
@@ -200,6 +210,22 @@ public:
 	bool ioCompletionInProgress() const;
 		/// Returns true if there are not executed handlers from last IO..
 
+	bool hasIOUring() const;
+		/// Returns true if this proactor submits I/O through io_uring.
+
+	void registerBuffers(const std::vector<Buffer*>& buffers);
+		/// Registers the given buffers with the kernel, replacing any
+		/// previously registered ones. Subsequent stream socket receives
+		/// into one of the buffers avoid the per-operation buffer mapping
+		/// in the kernel.
+		///
+		/// Registered buffers must not be resized or destroyed until they
+		/// are unregistered (by registering an empty list) or the proactor
+		/// is destroyed. This function should be called while no I/O is
+		/// in progress.
+		///
+		/// Does nothing if io_uring is not in use.
+
 private:
 	void onShutdown();
 		/// Called when the SocketProactor is about to terminate.
@@ -226,6 +252,7 @@ private:
 		SocketAddress* _pAddr = nullptr;
 		Callback _onCompletion = nullptr;
 		bool _owner = false;
+		bool _submitted = false;
 	};
 
 	class IONotification: public Notification
@@ -288,7 +315,9 @@ private:
 			/// Stops the I/O completion execution.
 		{
 			_activity.stop();
-			_nq.wakeUpAll();
+			// unlike wakeUpAll(), a queued notification is not lost
+			// if the thread is not waiting yet
+			_nq.enqueueNotification(new Notification);
 		}
 
 		void wait()
@@ -318,14 +347,14 @@ private:
 		bool runOne()
 			/// Runs the next I/O completion handler in the queue.
 		{
-			IONotification* pNf = dynamic_cast<IONotification*>(_nq.waitDequeueNotification());
+			Notification::Ptr pNf(_nq.waitDequeueNotification());
 			if (_activity.isStopped()) return false;
-			if (pNf)
+			IONotification* pIONf = dynamic_cast<IONotification*>(pNf.get());
+			if (pIONf)
 			{
 				try
 				{
-					pNf->call();
-					pNf->release();
+					pIONf->call();
 					return true;
 				}
 				catch (Exception& exc)
@@ -439,6 +468,18 @@ private:
 
 	Worker& worker();
 
+	int pollIOUring();
+		/// Submits the pending I/O operations to io_uring, waits for
+		/// completions up to the timeout and dispatches them.
+		/// Returns the number of completed handlers.
+
+	void submitIOUring(poco_socket_t sockfd, bool write);
+		/// Schedules the first handler in the socket read or
+		/// write queue for submission to io_uring.
+
+	void wakeUpIOUring();
+		/// Interrupts a pollIOUring() call waiting for completions.
+
 	std::atomic<bool> _isRunning;
 	std::atomic<bool> _isStopped;
 	std::atomic<bool> _stop;
@@ -454,7 +495,10 @@ private:
 	MutexType     _readMutex;
 
 	std::unique_ptr<Worker> _pWorker;
+	std::unique_ptr<IOUring> _pIOUring;
+	std::vector<std::pair<poco_socket_t, bool>> _pendingIO;
 	friend class Worker;
+	friend class IOUring;
 };
 
 //
@@ -496,6 +540,12 @@ inline bool SocketProactor::isRunning() const
 }
 
 
+inline bool SocketProactor::hasIOUring() const
+{
+	return _pIOUring != nullptr;
+}
+
+
 } } // namespace Poco::Net
 
 
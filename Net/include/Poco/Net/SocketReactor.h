@@ -83,6 +83,22 @@ class Net_API SocketReactor: public Poco::Runnable
 	/// becomes writable. The ErrorNotification will be dispatched if
 	/// there is an error condition on a socket.
 	///
+	/// By default, sockets are polled level-triggered, i.e. the
+	/// ReadableNotification is dispatched on every iteration as long
+	/// as the socket has data available. When registering an event handler,
+	/// the PollSet::Option flags can be given to change that (epoll only):
+	///
+	///   - PollSet::POLL_EDGE: edge-triggered; after a ReadableNotification
+	///     has been dispatched, the reactor keeps dispatching it for as long as
+	///     the handler consumes data and data is still available, so handlers
+	///     do not have to drain the socket themselves.
+	///   - PollSet::POLL_ONESHOT: the socket is disabled after each event
+	///     and re-armed by the reactor once the notifications for the event
+	///     have been dispatched.
+	///   - PollSet::POLL_EXCLUSIVE: for listening sockets shared by multiple
+	///     reactors (see ParallelSocketAcceptor), only one of the reactors
+	///     is woken up for a new connection.
+	///
 	/// Timeout/sleep strategy operates as follows:
 	///
 	/// If the poll timeout expires and no event has occurred, a
@@ -208,9 +224,13 @@ public:
 	const Poco::Timespan& getTimeout() const;
 		/// Returns the timeout.
 
-	void addEventHandler(const Socket& socket, const Poco::AbstractObserver& observer);
+	void addEventHandler(const Socket& socket, const Poco::AbstractObserver& observer, int pollOptions = 0);
 		/// Registers an event handler with the SocketReactor.
 		///
+		/// The optional pollOptions (a combination of PollSet::Option
+		/// flags) are added to the options the socket is polled with;
+		/// they apply to all handlers registered for the socket.
+		///
 		/// Usage:
 		///     Poco::Observer<MyEventHandler, SocketNotification> obs(*this, &MyEventHandler::handleMyEvent);
 		///     reactor.addEventHandler(obs);
@@ -263,7 +283,10 @@ private:
 
 	bool hasSocketHandlers();
 	void dispatch(NotifierPtr& pNotifier, SocketNotification* pNotification);
+	void dispatchEvents(const Socket& socket, int mode);
+	void drain(NotifierPtr& pNotifier, const Socket& socket);
 	NotifierPtr getNotifier(const Socket& socket, bool makeNew = false);
+	int pollMode(NotifierPtr& pNotifier);
 
 	void sleep();
 
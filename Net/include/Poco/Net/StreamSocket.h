@@ -198,6 +198,19 @@ public:
 		/// The flags parameter can be used to pass system-defined flags
 		/// for send() like MSG_OOB.
 
+	std::streamsize sendFile(FileInputStream& fileInputStream, std::streamoff offset = 0, std::streamsize count = 0);
+		/// Sends count bytes of the file opened by fileInputStream,
+		/// starting at the given offset, through the socket.
+		/// If count is 0, the file is sent up to its end.
+		///
+		/// On Linux, the file is sent with sendfile(2), without
+		/// copying its content to user space. On other platforms,
+		/// and for secure sockets, the file is sent through a buffer.
+		///
+		/// Returns the number of bytes sent, which may be less
+		/// than count if the socket is non-blocking or the end of
+		/// the file has been reached.
+
 	int receiveBytes(void* buffer, int length, int flags = 0);
 		/// Receives data from the socket and stores it
 		/// in buffer. Up to length bytes are received.
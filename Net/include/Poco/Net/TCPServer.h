@@ -27,7 +27,10 @@
 #include "Poco/Runnable.h"
 #include "Poco/Thread.h"
 #include "Poco/ThreadPool.h"
+#include "Poco/WorkStealingExecutor.h"
 #include <atomic>
+#include <memory>
+#include <vector>
 
 
 namespace Poco {
@@ -106,6 +109,17 @@ class Net_API TCPServer: public Poco::Runnable
 	/// After calling stop(), no new connections will be accepted and
 	/// all queued connections will be discarded.
 	/// Already served connections, however, will continue being served.
+	///
+	/// If the TCPServer is created with a port number or socket address,
+	/// and TCPServerParams::setShards() has been called with a value
+	/// greater than 1, the server opens multiple listening sockets
+	/// bound to the same address with SO_REUSEPORT (sharded mode).
+	/// The kernel then distributes incoming connections among the
+	/// shards. Each shard has its own accept thread, TCPServerDispatcher
+	/// and thread pool, so shards do not contend for a common
+	/// connection queue. Optionally, the threads of each shard can
+	/// be pinned to a CPU core (see TCPServerParams::setShardAffinity()).
+	/// The statistics functions return totals over all shards.
 {
 public:
 	TCPServer(TCPServerConnectionFactory::Ptr pFactory, Poco::UInt16 portNumber = 0, TCPServerParams::Ptr pParams = 0);
@@ -120,7 +134,23 @@ public:
 		/// If no TCPServerParams object is given, the server's TCPServerDispatcher
 		/// creates its own one.
 		///
-		/// New threads are taken from the default thread pool.
+		/// New threads are taken from the default thread pool,
+		/// unless the server runs in sharded mode.
+
+	TCPServer(TCPServerConnectionFactory::Ptr pFactory, const SocketAddress& address, TCPServerParams::Ptr pParams = 0);
+		/// Creates the TCPServer, with ServerSocket(s) listening on the given
+		/// address.
+		///
+		/// The server takes ownership of the TCPServerConnectionFactory
+		/// and deletes it when it's no longer needed.
+		///
+		/// The server also takes ownership of the TCPServerParams object.
+		/// If no TCPServerParams object is given, the server's TCPServerDispatcher
+		/// creates its own one.
+		///
+		/// If the number of shards specified in pParams is greater than 1,
+		/// the server runs in sharded mode and every shard uses its own thread
+		/// pool. Otherwise, new threads are taken from the default thread pool.
 
 	TCPServer(TCPServerConnectionFactory::Ptr pFactory, const ServerSocket& socket, TCPServerParams::Ptr pParams = 0);
 		/// Creates the TCPServer, using the given ServerSocket.
@@ -146,6 +176,21 @@ public:
 		///
 		/// New threads are taken from the given thread pool.
 
+	TCPServer(TCPServerConnectionFactory::Ptr pFactory, Poco::WorkStealingExecutor& executor, const ServerSocket& socket, TCPServerParams::Ptr pParams = 0);
+		/// Creates the TCPServer, using the given ServerSocket.
+		///
+		/// The server takes ownership of the TCPServerConnectionFactory
+		/// and deletes it when it's no longer needed.
+		///
+		/// The server also takes ownership of the TCPServerParams object.
+		/// If no TCPServerParams object is given, the server's TCPServerDispatcher
+		/// creates its own one.
+		///
+		/// Connections are handled by the worker threads of the given
+		/// executor. If no maximum number of threads is given in
+		/// pParams, up to executor.threads() connections are handled
+		/// concurrently.
+
 	virtual ~TCPServer();
 		/// Destroys the TCPServer and its TCPServerConnectionFactory.
 
@@ -190,8 +235,32 @@ public:
 	int refusedConnections() const;
 		/// Returns the number of refused connections.
 
+	int shards() const;
+		/// Returns the number of shards (listening sockets) the
+		/// server uses. Returns 1 if the server does not run in
+		/// sharded mode.
+
+	int currentThreads(int shard) const;
+		/// Returns the number of currently used connection threads
+		/// of the given shard.
+
+	int totalConnections(int shard) const;
+		/// Returns the total number of connections handled by
+		/// the given shard.
+
+	int currentConnections(int shard) const;
+		/// Returns the number of connections currently handled by
+		/// the given shard.
+
+	int queuedConnections(int shard) const;
+		/// Returns the number of connections queued in the given shard.
+
+	int refusedConnections(int shard) const;
+		/// Returns the number of connections refused by the given shard.
+
 	const ServerSocket& socket() const;
-		/// Returns the underlying server socket.
+		/// Returns the underlying server socket (of the first shard,
+		/// if the server runs in sharded mode).
 
 	Poco::UInt16 port() const;
 		/// Returns the port the server socket listens on.
@@ -220,15 +289,37 @@ protected:
 		/// Returns a thread name for the server thread.
 
 private:
+	struct Shard
+	{
+		~Shard();
+
+		ServerSocket socket;
+		std::unique_ptr<Poco::ThreadPool> pThreadPool;
+		TCPServerDispatcher* pDispatcher = nullptr;
+		std::unique_ptr<Poco::Thread> pThread;
+		int cpu = -1;
+	};
+
 	TCPServer();
 	TCPServer(const TCPServer&);
 	TCPServer& operator = (const TCPServer&);
 
+	void acceptLoop(ServerSocket& socket, TCPServerDispatcher& dispatcher, int cpu);
+	void createShards(TCPServerConnectionFactory::Ptr pFactory, const TCPServerParams::Ptr& pParams);
+	const TCPServerDispatcher& dispatcher(int shard) const;
+
+	static ServerSocket createSocket(const SocketAddress& address, const TCPServerParams::Ptr& pParams);
+	static TCPServerParams::Ptr shardParams(const TCPServerParams::Ptr& pParams, int shard);
+	static int shardCPU(const TCPServerParams::Ptr& pParams, int shard);
+
 	ServerSocket _socket;
 	TCPServerDispatcher* _pDispatcher;
 	TCPServerConnectionFilter::Ptr _pConnectionFilter;
 	Poco::Thread _thread;
 	std::atomic<bool> _stopped;
+	std::unique_ptr<Poco::ThreadPool> _pThreadPool;
+	std::vector<std::unique_ptr<Shard>> _shards;
+	int _cpu;
 };
 
 
@@ -247,6 +338,12 @@ inline Poco::UInt16 TCPServer::port() const
 }
 
 
+inline int TCPServer::shards() const
+{
+	return static_cast<int>(_shards.size()) + 1;
+}
+
+
 inline TCPServerConnectionFilter::Ptr TCPServer::getConnectionFilter() const
 {
 	return _pConnectionFilter;
@@ -25,6 +25,7 @@
 #include "Poco/Runnable.h"
 #include "Poco/NotificationQueue.h"
 #include "Poco/ThreadPool.h"
+#include "Poco/WorkStealingExecutor.h"
 #include "Poco/Mutex.h"
 #include <atomic>
 
@@ -45,6 +46,14 @@ public:
 		/// If no TCPServerParams object is supplied, the TCPServerDispatcher
 		/// creates one.
 
+	TCPServerDispatcher(TCPServerConnectionFactory::Ptr pFactory, Poco::WorkStealingExecutor& executor, TCPServerParams::Ptr pParams);
+		/// Creates the TCPServerDispatcher, running connections
+		/// on the given WorkStealingExecutor.
+		///
+		/// The dispatcher takes ownership of the TCPServerParams object.
+		/// If no TCPServerParams object is supplied, the TCPServerDispatcher
+		/// creates one.
+
 	void duplicate();
 		/// Increments the object's reference count.
 
@@ -128,6 +137,7 @@ private:
 	std::atomic<int> _rc;
 	TCPServerParams::Ptr _pParams;
 	std::atomic<int>  _currentThreads;
+	std::atomic<int>  _tasks;
 	std::atomic<int>  _totalConnections;
 	std::atomic<int>  _currentConnections;
 	std::atomic<int>  _maxConcurrentConnections;
@@ -135,7 +145,8 @@ private:
 	std::atomic<bool> _stopped;
 	Poco::NotificationQueue         _queue;
 	TCPServerConnectionFactory::Ptr _pConnectionFactory;
-	Poco::ThreadPool&               _threadPool;
+	Poco::ThreadPool*               _pThreadPool;
+	Poco::WorkStealingExecutor*     _pExecutor;
 	mutable std::mutex              _mutex;
 };
 
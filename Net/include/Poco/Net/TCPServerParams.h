@@ -45,6 +45,9 @@ public:
 		///   - threadIdleTime:       10 seconds
 		///   - maxThreads:           0
 		///   - maxQueued:            64
+		///   - shards:               1
+		///   - shardAffinity:        false
+		///   - threadAffinity:       -1
 
 	void setThreadIdleTime(const Poco::Timespan& idleTime);
 		/// Sets the maximum idle time for a thread before
@@ -92,6 +95,42 @@ public:
 		/// Returns the priority of TCP server threads
 		/// created by TCPServer.
 
+	void setShards(int count);
+		/// Sets the number of listening sockets (shards) opened by
+		/// a TCPServer created with a port number or socket address.
+		///
+		/// If greater than 1, the TCPServer binds count sockets to the
+		/// same address using SO_REUSEPORT, so that the kernel distributes
+		/// incoming connections among them. Every shard has its own accept
+		/// thread, TCPServerDispatcher and thread pool (of maxThreads
+		/// threads), so no lock is shared between the shards.
+		///
+		/// Must be greater than 0. The default is 1.
+
+	int getShards() const;
+		/// Returns the number of listening sockets (shards).
+
+	void setShardAffinity(bool pin);
+		/// If true, the accept and connection threads of every shard
+		/// are pinned to a single CPU core (shard number modulo number
+		/// of cores). Only applicable if shards is greater than 1.
+		///
+		/// The default is false.
+
+	bool getShardAffinity() const;
+		/// Returns true if shard threads are pinned to CPU cores.
+
+	void setThreadAffinity(int cpu);
+		/// Sets the CPU core the connection threads of the
+		/// TCPServerDispatcher are pinned to. If negative,
+		/// threads are not pinned.
+		///
+		/// The default is -1.
+
+	int getThreadAffinity() const;
+		/// Returns the CPU core the connection threads are pinned to,
+		/// or -1 if they are not pinned.
+
 protected:
 	virtual ~TCPServerParams();
 		/// Destroys the TCPServerParams.
@@ -101,6 +140,9 @@ private:
 	int _maxThreads;
 	int _maxQueued;
 	Poco::Thread::Priority _threadPriority;
+	int _shards;
+	bool _shardAffinity;
+	int _threadAffinity;
 };
 
 
@@ -131,6 +173,24 @@ inline Poco::Thread::Priority TCPServerParams::getThreadPriority() const
 }
 
 
+inline int TCPServerParams::getShards() const
+{
+	return _shards;
+}
+
+
+inline bool TCPServerParams::getShardAffinity() const
+{
+	return _shardAffinity;
+}
+
+
+inline int TCPServerParams::getThreadAffinity() const
+{
+	return _threadAffinity;
+}
+
+
 } } // namespace Poco::Net
 
 
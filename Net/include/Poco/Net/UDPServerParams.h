@@ -31,12 +31,20 @@ class Net_API UDPServerParams
 	/// A class encapsulating UDP server parameters.
 {
 public:
+	enum
+	{
+		DEFAULT_BATCH_SIZE = 32
+			/// Default maximum number of datagrams read per wake-up.
+	};
+
 	UDPServerParams(const Poco::Net::SocketAddress& sa,
 		int nSockets = 10,
 		Poco::Timespan timeout = 250000,
 		std::size_t handlerBufListSize = 1000,
 		bool notifySender = false,
-		int  backlogThreshold = 10);
+		int  backlogThreshold = 10,
+		std::size_t batchSize = DEFAULT_BATCH_SIZE,
+		bool receiveOffload = false);
 		/// Creates UDPServerParams.
 
 	~UDPServerParams();
@@ -64,6 +72,17 @@ public:
 		/// reports backlogs back to the client. Only meaningful
 		/// if notifySender() is true.
 
+	std::size_t batchSize() const;
+		/// Returns the maximum number of datagrams read from
+		/// a socket with a single system call (see
+		/// DatagramSocket::receiveBatch()) when it becomes readable.
+
+	bool receiveOffload() const;
+		/// Returns true if UDP generic receive offload is enabled
+		/// on the server sockets (see DatagramSocket::setReceiveOffload()).
+		/// Coalesced datagrams are split into individual messages before
+		/// they are passed to the handlers.
+
 private:
 	UDPServerParams();
 
@@ -73,6 +92,8 @@ private:
 	std::size_t              _handlerBufListSize;
 	bool                     _notifySender;
 	int                      _backlogThreshold;
+	std::size_t              _batchSize;
+	bool                     _receiveOffload;
 };
 
 
@@ -116,6 +137,18 @@ inline int UDPServerParams::backlogThreshold() const
 }
 
 
+inline std::size_t UDPServerParams::batchSize() const
+{
+	return _batchSize;
+}
+
+
+inline bool UDPServerParams::receiveOffload() const
+{
+	return _receiveOffload;
+}
+
+
 } } // namespace Poco::Net
 
 
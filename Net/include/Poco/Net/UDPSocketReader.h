@@ -20,6 +20,8 @@
 
 #include "Poco/Net/Net.h"
 #include "Poco/Net/DatagramSocket.h"
+#include "Poco/Buffer.h"
+#include <cstring>
 
 
 namespace Poco {
@@ -70,22 +72,39 @@ private:
 	};
 
 public:
-	UDPSocketReader(typename UDPHandlerImpl<S>::List& handlers, int backlogThreshold = 0):
+	UDPSocketReader(typename UDPHandlerImpl<S>::List& handlers, int backlogThreshold = 0, std::size_t batchSize = UDPServerParams::DEFAULT_BATCH_SIZE, bool receiveOffload = false):
 		_handlers(handlers),
 		_handler(_handlers.begin()),
-		_backlogThreshold(backlogThreshold)
+		_backlogThreshold(backlogThreshold),
+		_buffers(batchSize),
+		_messages(batchSize),
+		_receiveOffload(receiveOffload),
+		_segments(receiveOffload ? SEGMENT_BUFFER_SIZE : 0)
 		/// Creates the UDPSocketReader.
+		///
+		/// Up to batchSize datagrams are read from a socket
+		/// with a single system call on every call to read().
+		/// If receiveOffload is true, the sockets passed to read()
+		/// must have UDP receive offload enabled, and datagrams
+		/// coalesced by the kernel are split before being passed
+		/// to the handler.
 	{
 		poco_assert(_handler != _handlers.end());
+		poco_assert(batchSize > 0);
 	}
 
 	UDPSocketReader(typename UDPHandlerImpl<S>::List& handlers, const UDPServerParams& serverParams):
 		_handlers(handlers),
 		_handler(_handlers.begin()),
-		_backlogThreshold(serverParams.backlogThreshold())
+		_backlogThreshold(serverParams.backlogThreshold()),
+		_buffers(serverParams.batchSize()),
+		_messages(serverParams.batchSize()),
+		_receiveOffload(serverParams.receiveOffload()),
+		_segments(serverParams.receiveOffload() ? SEGMENT_BUFFER_SIZE : 0)
 		/// Creates the UDPSocketReader.
 	{
 		poco_assert(_handler != _handlers.end());
+		poco_assert(!_buffers.empty());
 	}
 
 	~UDPSocketReader()
@@ -94,59 +113,67 @@ public:
 	}
 
 	void read(DatagramSocket& sock)
-		/// Reads data from the socket and passes it to the next handler.
-		/// Errors are also passed to the handler. If object is configured
-		/// for replying to sender and data or error backlog threshold is
-		/// exceeded, sender is notified of the current backlog size.
+		/// Reads all available data (up to the batch size) from the socket
+		/// and passes it to the next handler. Errors are also passed to the
+		/// handler. If object is configured for replying to sender and data
+		/// or error backlog threshold is exceeded, sender is notified of the
+		/// current backlog size.
 	{
+		if (_receiveOffload)
+		{
+			readSegments(sock);
+			return;
+		}
+
 		typedef typename UDPHandlerImpl<S>::MsgSizeT RT;
-		char* p = 0;
-		struct sockaddr* pSA = 0;
-		poco_socklen_t* pAL = 0;
 		poco_socket_t sockfd = sock.impl()->sockfd();
+		std::size_t count = 0;
+		std::size_t used = 0;
 		nextHandler();
 		try
 		{
-			p = handler().next(sockfd);
-			if (p)
+			count = handler().next(sockfd, &_buffers[0], _buffers.size());
+			if (count == 0) return;
+			Poco::UInt16 off = handler().offset();
+			_messages.resize(count);
+			for (std::size_t i = 0; i < count; ++i)
 			{
-				Poco::UInt16 off = handler().offset();
-				poco_socklen_t* pAL = reinterpret_cast<poco_socklen_t*>(p + sizeof(RT));
-				*pAL = SocketAddress::MAX_ADDRESS_LENGTH;
-				struct sockaddr* pSA = reinterpret_cast<struct sockaddr*>(p + sizeof(RT) + sizeof(poco_socklen_t));
-				RT ret = sock.receiveFrom(p + off, S - off - 1, &pSA, &pAL);
-				if (ret < 0)
-				{
-					AtomicCounter::ValueType errors = setError(sock.impl()->sockfd(), p, Error::getMessage(Error::last()));
-					if (_backlogThreshold > 0 && errors > _backlogThreshold && errors != _errorBacklog[sockfd])
-					{
-						Poco::Int32 err = static_cast<Poco::Int32>(errors);
-						sock.sendTo(&err, sizeof(Poco::Int32), SocketAddress(pSA, *pAL));
-						_errorBacklog[sockfd] = errors;
-					}
-					return;
-				}
-				AtomicCounter::ValueType data = handler().setData(p, ret);
-				p[off + ret] = 0; // for ascii convenience, zero-terminate
-				if (_backlogThreshold > 0 && data > _backlogThreshold && data != _dataBacklog[sockfd])
+				SocketMsg& msg = _messages[i];
+				msg.buffer = _buffers[i] + off;
+				msg.capacity = static_cast<int>(S - off - 1);
+				msg.pAddress = reinterpret_cast<struct sockaddr*>(_buffers[i] + sizeof(RT) + sizeof(poco_socklen_t));
+				msg.addressLength = SocketAddress::MAX_ADDRESS_LENGTH;
+				msg.length = 0;
+			}
+			int ret = sock.receiveBatch(_messages);
+			if (ret < 0)
+			{
+				++used;
+				AtomicCounter::ValueType errors = setError(sockfd, _buffers[0], Error::getMessage(Error::last()));
+				for (std::size_t i = used; i < count; ++i) handler().setIdle(_buffers[i]);
+				if (_backlogThreshold > 0 && errors > _backlogThreshold && errors != _errorBacklog[sockfd])
 				{
-					Poco::Int32 d = static_cast<Poco::Int32>(data);
-					sock.sendTo(&d, sizeof(Poco::Int32), SocketAddress(pSA, *pAL));
-					_dataBacklog[sockfd] = data;
+					Poco::Int32 err = static_cast<Poco::Int32>(errors);
+					sock.sendTo(&err, sizeof(Poco::Int32), SocketAddress(_messages[0].pAddress, _messages[0].addressLength));
+					_errorBacklog[sockfd] = errors;
 				}
+				return;
+			}
+			for (; used < static_cast<std::size_t>(ret); ++used)
+			{
+				char* p = _buffers[used];
+				const SocketMsg& msg = _messages[used];
+				*reinterpret_cast<poco_socklen_t*>(p + sizeof(RT)) = msg.addressLength;
+				AtomicCounter::ValueType data = handler().setData(p, msg.length);
+				p[off + msg.length] = 0; // for ascii convenience, zero-terminate
+				notifyDataBacklog(sock, data, msg.pAddress, msg.addressLength);
 			}
-			else return;
 		}
 		catch (Poco::Exception& exc)
 		{
-			AtomicCounter::ValueType errors = setError(sock.impl()->sockfd(), p, exc.displayText());
-			if (_backlogThreshold > 0 && errors > _backlogThreshold && errors != _errorBacklog[sockfd] && pSA && pAL)
-			{
-				Poco::Int32 err = static_cast<Poco::Int32>(errors);
-				sock.sendTo(&err, sizeof(Poco::Int32), SocketAddress(pSA, *pAL));
-				_errorBacklog[sockfd] = errors;
-			}
+			if (used < count) setError(sockfd, _buffers[used++], exc.displayText());
 		}
+		for (std::size_t i = used; i < count; ++i) handler().setIdle(_buffers[i]);
 		handler().notify();
 	}
 
@@ -189,6 +216,89 @@ public:
 	}
 
 private:
+	enum
+	{
+		SEGMENT_BUFFER_SIZE = 65536
+			/// Size of the buffer for datagrams coalesced by the kernel.
+	};
+
+	void readSegments(DatagramSocket& sock)
+		/// Receives a (possibly coalesced) datagram from a socket with
+		/// receive offload enabled, and passes every segment to the
+		/// next handler as a separate message.
+	{
+		typedef typename UDPHandlerImpl<S>::MsgSizeT RT;
+		poco_socket_t sockfd = sock.impl()->sockfd();
+		sockaddr_storage address;
+		struct sockaddr* pSA = reinterpret_cast<struct sockaddr*>(&address);
+		poco_socklen_t addressLength = sizeof(address);
+		poco_socklen_t* pAL = &addressLength;
+		int segmentSize = 0;
+		nextHandler();
+		int ret;
+		try
+		{
+			ret = sock.receiveSegments(_segments.begin(), static_cast<int>(_segments.size()), &pSA, &pAL, segmentSize);
+		}
+		catch (Poco::Exception& exc)
+		{
+			setError(sockfd, 0, exc.displayText());
+			handler().notify();
+			return;
+		}
+		if (ret < 0)
+		{
+			setError(sockfd, 0, Error::getMessage(Error::last()));
+			return;
+		}
+
+		Poco::UInt16 off = handler().offset();
+		const int capacity = static_cast<int>(S - off - 1);
+		const char* pData = _segments.begin();
+		int remaining = ret;
+		std::size_t segments = (ret > 0 && segmentSize > 0) ? (ret + segmentSize - 1)/segmentSize : 1;
+		while (segments > 0)
+		{
+			std::size_t count = handler().next(sockfd, &_buffers[0], std::min(segments, _buffers.size()));
+			if (count == 0) break; // handler is busy, drop the rest
+			for (std::size_t i = 0; i < count; ++i)
+			{
+				char* p = _buffers[i];
+				int length = std::min(remaining, segmentSize);
+				int n = std::min(length, capacity);
+				*reinterpret_cast<poco_socklen_t*>(p + sizeof(RT)) = addressLength;
+				std::memcpy(p + sizeof(RT) + sizeof(poco_socklen_t), pSA, addressLength);
+				std::memcpy(p + off, pData, n);
+				p[off + n] = 0; // for ascii convenience, zero-terminate
+				AtomicCounter::ValueType data = handler().setData(p, n);
+				pData += length;
+				remaining -= length;
+				try
+				{
+					notifyDataBacklog(sock, data, pSA, addressLength);
+				}
+				catch (Poco::Exception&)
+				{
+				}
+			}
+			segments -= count;
+		}
+		handler().notify();
+	}
+
+	void notifyDataBacklog(DatagramSocket& sock, AtomicCounter::ValueType data, const struct sockaddr* pSA, poco_socklen_t addressLength)
+		/// Notifies the sender of the data backlog size if the
+		/// backlog threshold is exceeded.
+	{
+		poco_socket_t sockfd = sock.impl()->sockfd();
+		if (_backlogThreshold > 0 && data > _backlogThreshold && data != _dataBacklog[sockfd])
+		{
+			Poco::Int32 d = static_cast<Poco::Int32>(data);
+			sock.sendTo(&d, sizeof(Poco::Int32), SocketAddress(pSA, addressLength));
+			_dataBacklog[sockfd] = data;
+		}
+	}
+
 	void nextHandler()
 		/// Re-points the handler iterator to the next handler in
 		/// round-robin fashion.
@@ -208,11 +318,15 @@ private:
 	typedef typename UDPHandlerImpl<S>::List::iterator HandlerIterator;
 	typedef std::map<poco_socket_t, Counter>           CounterMap;
 
-	HandlerList&    _handlers;
-	HandlerIterator _handler;
-	CounterMap      _dataBacklog;
-	CounterMap      _errorBacklog;
-	int             _backlogThreshold;
+	HandlerList&       _handlers;
+	HandlerIterator    _handler;
+	CounterMap         _dataBacklog;
+	CounterMap         _errorBacklog;
+	int                _backlogThreshold;
+	std::vector<char*> _buffers;
+	SocketMsgVec       _messages;
+	bool               _receiveOffload;
+	Poco::Buffer<char> _segments;
 };
 
 
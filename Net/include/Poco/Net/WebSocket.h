@@ -21,6 +21,7 @@
 #include "Poco/Net/Net.h"
 #include "Poco/Net/StreamSocket.h"
 #include "Poco/Net/HTTPCredentials.h"
+#include "Poco/Net/PerMessageDeflate.h"
 #include "Poco/Buffer.h"
 
 
@@ -122,10 +123,14 @@ public:
 			/// No Sec-WebSocket-Accept header or wrong value.
 		WS_ERR_UNAUTHORIZED                   = 6,
 			/// The server rejected the username or password for authentication.
+		WS_ERR_HANDSHAKE_EXTENSION            = 7,
+			/// Invalid Sec-WebSocket-Extensions header in handshake response.
 		WS_ERR_PAYLOAD_TOO_BIG                = 10,
 			/// Payload too big for supplied buffer.
-		WS_ERR_INCOMPLETE_FRAME               = 11
+		WS_ERR_INCOMPLETE_FRAME               = 11,
 			/// Incomplete frame received.
+		WS_ERR_COMPRESSION                    = 12
+			/// Compressed payload cannot be decompressed.
 	};
 
 	WebSocket(HTTPServerRequest& request, HTTPServerResponse& response);
@@ -139,6 +144,14 @@ public:
 		/// Throws an exception if the request is not a proper WebSocket
 		/// upgrade request.
 
+	WebSocket(HTTPServerRequest& request, HTTPServerResponse& response, const PerMessageDeflate::Config& compression);
+		/// Creates a server-side WebSocket from within a
+		/// HTTPRequestHandler, like WebSocket(HTTPServerRequest&, HTTPServerResponse&).
+		///
+		/// If the client offers the permessage-deflate extension,
+		/// and the offer is acceptable, the extension is enabled,
+		/// using the given configuration.
+
 	WebSocket(HTTPClientSession& cs, HTTPRequest& request, HTTPResponse& response);
 		/// Creates a client-side WebSocket, using the given
 		/// HTTPClientSession and HTTPRequest for the initial handshake
@@ -172,6 +185,15 @@ public:
 		/// The HTTPClientSession session object must no longer be used after setting
 		/// up the WebSocket.
 
+	WebSocket(HTTPClientSession& cs, HTTPRequest& request, HTTPResponse& response, const PerMessageDeflate::Config& compression);
+		/// Creates a client-side WebSocket, like
+		/// WebSocket(HTTPClientSession&, HTTPRequest&, HTTPResponse&),
+		/// offering the permessage-deflate extension with the given
+		/// configuration.
+		///
+		/// Whether the server has accepted the extension can be
+		/// determined with compressionEnabled().
+
 	WebSocket(const Socket& socket);
 		/// Creates a WebSocket from another Socket, which must be a WebSocket,
 		/// otherwise a Poco::InvalidArgumentException will be thrown.
@@ -319,6 +341,15 @@ public:
 		/// Returns WS_SERVER if the WebSocket is a server-side
 		/// WebSocket, or WS_CLIENT otherwise.
 
+	bool compressionEnabled() const;
+		/// Returns true if the permessage-deflate extension
+		/// has been negotiated for the WebSocket.
+		///
+		/// If so, text and binary messages are compressed when sent
+		/// and decompressed when received. The flags returned by
+		/// receiveFrame() never contain FRAME_FLAG_RSV1 for
+		/// compressed messages.
+
 	void setMaxPayloadSize(int maxPayloadSize);
 		/// Sets the maximum payload size for receiveFrame().
 		///
@@ -333,9 +364,9 @@ public:
 		/// The WebSocket protocol version supported (13).
 
 protected:
-	static WebSocketImpl* accept(HTTPServerRequest& request, HTTPServerResponse& response);
-	static WebSocketImpl* connect(HTTPClientSession& cs, HTTPRequest& request, HTTPResponse& response, HTTPCredentials& credentials);
-	static WebSocketImpl* completeHandshake(HTTPClientSession& cs, HTTPResponse& response, const std::string& key);
+	static WebSocketImpl* accept(HTTPServerRequest& request, HTTPServerResponse& response, const PerMessageDeflate::Config* pCompression = 0);
+	static WebSocketImpl* connect(HTTPClientSession& cs, HTTPRequest& request, HTTPResponse& response, HTTPCredentials& credentials, const PerMessageDeflate::Config* pCompression = 0);
+	static WebSocketImpl* completeHandshake(HTTPClientSession& cs, HTTPResponse& response, const std::string& key, const PerMessageDeflate::Config* pCompression = 0);
 	static std::string computeAccept(const std::string& key);
 	static std::string createKey();
 
@@ -19,9 +19,11 @@
 
 
 #include "Poco/Net/StreamSocketImpl.h"
+#include "Poco/Net/PerMessageDeflate.h"
 #include "Poco/Buffer.h"
 #include "Poco/Random.h"
 #include "Poco/Buffer.h"
+#include <memory>
 
 
 namespace Poco {
@@ -89,15 +91,35 @@ public:
 		///
 		/// The default is std::numeric_limits<int>::max().
 
+	void enableCompression(PerMessageDeflate* pDeflate);
+		/// Enables the permessage-deflate extension, using
+		/// the given PerMessageDeflate, which is taken over
+		/// by the WebSocketImpl.
+
+	bool compressionEnabled() const;
+		/// Returns true if the permessage-deflate extension is enabled.
+
+	static void maskPayload(char* dest, const char* src, std::size_t length, const char mask[4]);
+		/// XORs length bytes of src with the given 4-byte masking key,
+		/// as described in RFC 6455, section 5.3, and stores the
+		/// result in dest. src and dest may be the same buffer.
+
 protected:
 	enum
 	{
 		FRAME_FLAG_MASK   = 0x80,
-		MAX_HEADER_LENGTH = 14
+		MAX_HEADER_LENGTH = 14,
+		VECTORED_SEND_THRESHOLD = 1024
+			/// Unmasked payloads of at least this size are sent
+			/// together with the frame header using a vectored
+			/// write instead of being copied into a frame buffer.
 	};
 
+	void sendFrame(const char* payload, int length, int flags);
 	int receiveHeader(char mask[4], bool& useMask);
 	int receivePayload(char *buffer, int payloadLength, char mask[4], bool useMask);
+	bool compressedFrame();
+	void receiveCompressedPayload(Poco::Buffer<char>& buffer, int payloadLength, char mask[4], bool useMask, std::size_t maxLength);
 	int receiveNBytes(void* buffer, int bytes);
 	int receiveSomeBytes(char* buffer, int bytes);
 	virtual ~WebSocketImpl();
@@ -112,6 +134,12 @@ private:
 	int _frameFlags;
 	bool _mustMaskPayload;
 	Poco::Random _rnd;
+	std::unique_ptr<PerMessageDeflate> _pDeflate;
+	bool _deflating;
+	bool _inflating;
+	Poco::Buffer<char> _deflateBuffer;
+	Poco::Buffer<char> _inflateBuffer;
+	Poco::Buffer<char> _payloadBuffer;
 };
 
 
@@ -136,6 +164,12 @@ inline int WebSocketImpl::getMaxPayloadSize() const
 }
 
 
+inline bool WebSocketImpl::compressionEnabled() const
+{
+	return _pDeflate.get() != 0;
+}
+
+
 } } // namespace Poco::Net
 
 
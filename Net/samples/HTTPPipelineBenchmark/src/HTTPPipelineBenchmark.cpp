@@ -0,0 +1,231 @@
+//
+// HTTPPipelineBenchmark.cpp
+//
+// This sample measures the throughput of HTTPServer under pipelined
+// load, similar to wrk with a pipelining script. A local server is
+// started with response batching (HTTPServerParams::setPipelining())
+// disabled and enabled, and a number of client connections send
+// batches of pipelined GET requests to it.
+//
+// Usage: HTTPPipelineBenchmark [<connections> [<depth> [<seconds>]]]
+//
+// Copyright (c) 2005-2023, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "Poco/Net/HTTPServer.h"
+#include "Poco/Net/HTTPServerParams.h"
+#include "Poco/Net/HTTPRequestHandler.h"
+#include "Poco/Net/HTTPRequestHandlerFactory.h"
+#include "Poco/Net/HTTPServerRequest.h"
+#include "Poco/Net/HTTPServerResponse.h"
+#include "Poco/Net/ServerSocket.h"
+#include "Poco/Net/StreamSocket.h"
+#include "Poco/Net/SocketAddress.h"
+#include "Poco/ThreadPool.h"
+#include "Poco/Stopwatch.h"
+#include "Poco/Exception.h"
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <cstring>
+#include <cstdlib>
+
+
+using Poco::Net::HTTPServer;
+using Poco::Net::HTTPServerParams;
+using Poco::Net::HTTPRequestHandler;
+using Poco::Net::HTTPRequestHandlerFactory;
+using Poco::Net::HTTPServerRequest;
+using Poco::Net::HTTPServerResponse;
+using Poco::Net::ServerSocket;
+using Poco::Net::StreamSocket;
+using Poco::Net::SocketAddress;
+using Poco::Stopwatch;
+
+
+namespace
+{
+	class HelloRequestHandler: public HTTPRequestHandler
+	{
+	public:
+		void handleRequest(HTTPServerRequest& /*request*/, HTTPServerResponse& response)
+		{
+			static const std::string body("Hello, world!\n");
+			response.setContentType("text/plain");
+			response.setContentLength(static_cast<std::streamsize>(body.size()));
+			response.send() << body;
+		}
+	};
+
+	class HelloRequestHandlerFactory: public HTTPRequestHandlerFactory
+	{
+	public:
+		HTTPRequestHandler* createRequestHandler(const HTTPServerRequest&)
+		{
+			return new HelloRequestHandler;
+		}
+	};
+
+	class PipelineClient
+		/// Sends batches of pipelined requests over a single connection
+		/// and waits for all responses of a batch before sending the next one.
+	{
+	public:
+		PipelineClient(const SocketAddress& address, int depth):
+			_socket(address),
+			_depth(depth),
+			_buffer(65536)
+		{
+			static const std::string request(
+				"GET /hello HTTP/1.1\r\n"
+				"Host: localhost\r\n"
+				"User-Agent: HTTPPipelineBenchmark\r\n"
+				"Accept: */*\r\n"
+				"\r\n");
+			for (int i = 0; i < depth; ++i) _batch += request;
+		}
+
+		int runBatch()
+			/// Sends one batch of requests and returns the number of
+			/// responses received.
+		{
+			const char* p = _batch.data();
+			std::size_t remaining = _batch.size();
+			while (remaining > 0)
+			{
+				int n = _socket.sendBytes(p, static_cast<int>(remaining));
+				if (n <= 0) return 0;
+				p += n;
+				remaining -= n;
+			}
+			int responses = 0;
+			while (responses < _depth)
+			{
+				if (!parseResponse())
+				{
+					if (!fill()) return responses;
+				}
+				else ++responses;
+			}
+			return responses;
+		}
+
+	private:
+		bool fill()
+		{
+			if (_begin > 0)
+			{
+				_pending.erase(0, _begin);
+				_begin = 0;
+			}
+			int n = _socket.receiveBytes(&_buffer[0], static_cast<int>(_buffer.size()));
+			if (n <= 0) return false;
+			_pending.append(&_buffer[0], n);
+			return true;
+		}
+
+		bool parseResponse()
+			/// Consumes one complete response from the pending data.
+		{
+			std::size_t end = _pending.find("\r\n\r\n", _begin);
+			if (end == std::string::npos) return false;
+			std::size_t length = 0;
+			std::size_t pos = _pending.find("Content-Length: ", _begin);
+			if (pos != std::string::npos && pos < end)
+				length = std::strtoul(_pending.c_str() + pos + 16, 0, 10);
+			end += 4;
+			if (_pending.size() < end + length) return false;
+			_begin = end + length;
+			return true;
+		}
+
+		StreamSocket _socket;
+		int _depth;
+		std::string _batch;
+		std::vector<char> _buffer;
+		std::string _pending;
+		std::size_t _begin = 0;
+	};
+
+	double run(bool pipelining, int connections, int depth, int seconds)
+		/// Returns the number of requests per second.
+	{
+		HTTPServerParams::Ptr pParams = new HTTPServerParams;
+		pParams->setKeepAlive(true);
+		pParams->setMaxKeepAliveRequests(0);
+		pParams->setMaxThreads(connections);
+		pParams->setMaxQueued(connections);
+		pParams->setPipelining(pipelining);
+
+		ServerSocket serverSocket(SocketAddress("127.0.0.1", 0));
+		Poco::ThreadPool pool(connections, connections);
+		HTTPServer server(new HelloRequestHandlerFactory, pool, serverSocket, pParams);
+		server.start();
+
+		SocketAddress address("127.0.0.1", serverSocket.address().port());
+		std::atomic<bool> stop(false);
+		std::atomic<long> total(0);
+		std::vector<std::thread> clients;
+		Stopwatch sw;
+		sw.start();
+		for (int i = 0; i < connections; ++i)
+		{
+			clients.emplace_back([&]()
+			{
+				try
+				{
+					PipelineClient client(address, depth);
+					long count = 0;
+					while (!stop)
+					{
+						int n = client.runBatch();
+						count += n;
+						if (n < depth) break;
+					}
+					total += count;
+				}
+				catch (Poco::Exception& exc)
+				{
+					std::cerr << exc.displayText() << std::endl;
+				}
+			});
+		}
+		std::this_thread::sleep_for(std::chrono::seconds(seconds));
+		stop = true;
+		for (auto& t: clients) t.join();
+		sw.stop();
+		server.stopAll(true);
+
+		return total/(sw.elapsed()/1000000.0);
+	}
+}
+
+
+int main(int argc, char** argv)
+{
+	int connections = argc > 1 ? std::atoi(argv[1]) : 4;
+	int depth       = argc > 2 ? std::atoi(argv[2]) : 16;
+	int seconds     = argc > 3 ? std::atoi(argv[3]) : 5;
+	if (connections < 1 || depth < 1 || seconds < 1)
+	{
+		std::cerr << "usage: " << argv[0] << " [<connections> [<depth> [<seconds>]]]" << std::endl;
+		return 1;
+	}
+
+	std::cout << connections << " connections, pipeline depth " << depth << ", " << seconds << " seconds:" << std::endl;
+	const bool modes[] = {false, true};
+	for (bool pipelining: modes)
+	{
+		double rps = run(pipelining, connections, depth, seconds);
+		std::cout << std::setw(32) << std::left << (pipelining ? "  response batching" : "  one send per response")
+			<< std::setw(12) << std::right << static_cast<long>(rps) << " requests/s" << std::endl;
+	}
+	return 0;
+}
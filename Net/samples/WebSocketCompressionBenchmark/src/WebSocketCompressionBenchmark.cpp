@@ -0,0 +1,157 @@
+//
+// WebSocketCompressionBenchmark.cpp
+//
+// This sample measures the bandwidth savings and the CPU cost of the
+// WebSocket permessage-deflate extension (PerMessageDeflate) for
+// typical JSON messages, for different compression settings.
+//
+// Usage: WebSocketCompressionBenchmark [<messages>]
+//
+// Copyright (c) 2005-2023, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "Poco/Net/PerMessageDeflate.h"
+#include "Poco/Buffer.h"
+#include "Poco/Stopwatch.h"
+#include "Poco/Random.h"
+#include "Poco/NumberFormatter.h"
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <cstdlib>
+
+
+using Poco::Net::PerMessageDeflate;
+using Poco::Buffer;
+using Poco::Stopwatch;
+using Poco::NumberFormatter;
+
+
+namespace
+{
+	std::string makeQuote(Poco::Random& rnd)
+		/// A market data update of about 200 bytes.
+	{
+		static const char* symbols[] = {"AAPL", "MSFT", "GOOG", "AMZN", "META", "NVDA", "TSLA", "NFLX"};
+		std::string json("{\"type\":\"quote\",\"symbol\":\"");
+		json += symbols[rnd.next(8)];
+		json += "\",\"bid\":";
+		json += NumberFormatter::format(100 + rnd.nextDouble()*50, 2);
+		json += ",\"ask\":";
+		json += NumberFormatter::format(150 + rnd.nextDouble()*50, 2);
+		json += ",\"bidSize\":";
+		json += NumberFormatter::format(rnd.next(10000));
+		json += ",\"askSize\":";
+		json += NumberFormatter::format(rnd.next(10000));
+		json += ",\"exchange\":\"XNAS\",\"timestamp\":\"2023-10-11T14:32:";
+		json += NumberFormatter::format0(rnd.next(60), 2);
+		json += ".";
+		json += NumberFormatter::format0(rnd.next(1000000), 6);
+		json += "Z\"}";
+		return json;
+	}
+
+	std::string makeSnapshot(Poco::Random& rnd, int quotes)
+		/// An array of quotes.
+	{
+		std::string json("{\"type\":\"snapshot\",\"quotes\":[");
+		for (int i = 0; i < quotes; i++)
+		{
+			if (i > 0) json += ',';
+			json += makeQuote(rnd);
+		}
+		json += "]}";
+		return json;
+	}
+
+	void run(const std::string& label, const std::vector<std::string>& messages, const PerMessageDeflate::Config& config)
+	{
+		PerMessageDeflate::Parameters params;
+		params.serverNoContextTakeover = config.serverNoContextTakeover;
+		params.serverMaxWindowBits = config.serverMaxWindowBits;
+		PerMessageDeflate sender(params, config, true);
+		PerMessageDeflate receiver(params, config, false);
+
+		Buffer<char> compressed(0);
+		Buffer<char> decompressed(0);
+		Poco::UInt64 original = 0;
+		Poco::UInt64 sent = 0;
+		Stopwatch compressTime;
+		Stopwatch decompressTime;
+		for (const auto& message: messages)
+		{
+			compressTime.start();
+			sender.compress(message.data(), message.size(), true, compressed);
+			compressTime.stop();
+			decompressed.resize(0);
+			decompressTime.start();
+			receiver.decompress(compressed.begin(), compressed.size(), true, decompressed, message.size());
+			decompressTime.stop();
+			if (decompressed.size() != message.size())
+			{
+				std::cerr << "decompressed message does not match" << std::endl;
+				std::exit(1);
+			}
+			original += message.size();
+			sent += compressed.size();
+		}
+		double mb = original/(1024.0*1024.0);
+		std::cout << std::setw(36) << std::left << label
+			<< std::setw(8) << std::right << std::fixed << std::setprecision(1) << 100.0*sent/original << " %"
+			<< std::setw(10) << mb/(compressTime.elapsed()/1000000.0) << " MB/s"
+			<< std::setw(10) << mb/(decompressTime.elapsed()/1000000.0) << " MB/s"
+			<< std::setw(8) << sender.memoryUsage()/1024 << " KB" << std::endl;
+	}
+
+	void runAll(const std::string& title, const std::vector<std::string>& messages)
+	{
+		std::cout << title << ":" << std::endl;
+		std::cout << std::setw(36) << std::left << "  settings"
+			<< std::setw(10) << std::right << "size"
+			<< std::setw(15) << "compress"
+			<< std::setw(15) << "decompress"
+			<< std::setw(11) << "memory" << std::endl;
+
+		PerMessageDeflate::Config config;
+		for (int level: {1, 6, 9})
+		{
+			config.compressionLevel = level;
+			run("  level " + NumberFormatter::format(level) + ", 32K window", messages, config);
+		}
+		config.compressionLevel = 1;
+		config.serverMaxWindowBits = 10;
+		config.memLevel = 4;
+		run("  level 1, 1K window, memLevel 4", messages, config);
+		config = PerMessageDeflate::Config();
+		config.compressionLevel = 1;
+		config.serverNoContextTakeover = true;
+		run("  level 1, no context takeover", messages, config);
+	}
+}
+
+
+int main(int argc, char** argv)
+{
+	int count = argc > 1 ? std::atoi(argv[1]) : 20000;
+	if (count < 1)
+	{
+		std::cerr << "usage: " << argv[0] << " [<messages>]" << std::endl;
+		return 1;
+	}
+
+	Poco::Random rnd;
+	std::vector<std::string> quotes;
+	for (int i = 0; i < count; i++) quotes.push_back(makeQuote(rnd));
+	runAll(NumberFormatter::format(count) + " quotes, ~200 bytes", quotes);
+
+	std::vector<std::string> snapshots;
+	for (int i = 0; i < count/50 + 1; i++) snapshots.push_back(makeSnapshot(rnd, 100));
+	runAll(NumberFormatter::format(snapshots.size()) + " snapshots, ~20 KB", snapshots);
+
+	return 0;
+}
@@ -18,12 +18,20 @@
 #include "Poco/Environment.h"
 #include "Poco/NumberFormatter.h"
 #include "Poco/RWLock.h"
+#include "Poco/ActiveMethod.h"
+#include "Poco/ThreadPool.h"
+#include "Poco/SingletonHolder.h"
+#include "Poco/FileStream.h"
+#include "Poco/StringTokenizer.h"
+#include "Poco/String.h"
 #include "Poco/TextIterator.h"
 #include "Poco/TextConverter.h"
 #include "Poco/UTF8Encoding.h"
 #include "Poco/UTF32Encoding.h"
 #include "Poco/Unicode.h"
 #include <cstring>
+#include <map>
+#include <mutex>
 
 
 #if defined(POCO_HAVE_LIBRESOLV)
@@ -61,12 +69,106 @@ static Poco::RWLock resolverLock;
 #endif
 
 
-HostEntry DNS::hostByName(const std::string& hostname, unsigned
+namespace
+{
+	typedef std::map<std::string, HostEntry> HostsMap;
+
+	std::mutex dnsMutex;
+	DNSCache::Ptr pDNSCache;
+	Poco::SharedPtr<HostsMap> pHostsMap;
+	bool hostsExclusive = false;
+
+	DNSCache::Ptr dnsCache()
+	{
+		std::lock_guard<std::mutex> lock(dnsMutex);
+		return pDNSCache;
+	}
+
+	class AsyncResolver;
+
+	class AsyncResolverStarter
+		/// Starts asynchronous lookups in the thread pool of the DNS class.
+	{
+	public:
+		static void start(AsyncResolver* /*pOwner*/, Poco::ActiveRunnableBase::Ptr pRunnable)
+		{
+			static Poco::SingletonHolder<Poco::ThreadPool> sh;
+			sh.get()->start(*pRunnable);
+			pRunnable->duplicate(); // The runnable will release itself.
+		}
+	};
+
+	class AsyncResolver
+	{
+	public:
+		AsyncResolver():
+			resolve(this, &AsyncResolver::resolveImpl)
+		{
+		}
+
+		Poco::ActiveMethod<HostEntry, std::string, AsyncResolver, AsyncResolverStarter> resolve;
+
+	private:
+		HostEntry resolveImpl(const std::string& address)
+		{
+			return DNS::resolve(address);
+		}
+	};
+
+	Poco::SingletonHolder<AsyncResolver> asyncResolver;
+}
+
+
+HostEntry DNS::hostByName(const std::string& hostname, unsigned hintFlags)
+{
+	DNSCache::Ptr pCache = dnsCache();
+	if (!pCache) return hostByNameImpl(hostname, hintFlags);
+
+	std::string key = Poco::toLower(hostname);
+	key += '#';
+	NumberFormatter::append(key, hintFlags);
+
+	HostEntry entry;
+	if (pCache->get(key, entry)) return entry;
+	try
+	{
+		entry = hostByNameImpl(hostname, hintFlags);
+	}
+	catch (HostNotFoundException& exc)
+	{
+		pCache->addNegative(key, exc);
+		throw;
+	}
+	catch (NoAddressFoundException& exc)
+	{
+		pCache->addNegative(key, exc);
+		throw;
+	}
+	pCache->add(key, entry);
+	return entry;
+}
+
+
+HostEntry DNS::hostByNameImpl(const std::string& hostname, unsigned
 #ifdef POCO_HAVE_ADDRINFO
 						  hintFlags
 #endif
 						 )
 {
+	Poco::SharedPtr<HostsMap> pHosts;
+	bool exclusive = false;
+	{
+		std::lock_guard<std::mutex> lock(dnsMutex);
+		pHosts = pHostsMap;
+		exclusive = hostsExclusive;
+	}
+	if (pHosts)
+	{
+		HostsMap::const_iterator it = pHosts->find(Poco::toLower(hostname));
+		if (it != pHosts->end()) return it->second;
+		if (exclusive) throw HostNotFoundException(hostname);
+	}
+
 #if defined(POCO_HAVE_LIBRESOLV)
 	Poco::ScopedReadRWLock readLock(resolverLock);
 #endif
@@ -179,6 +281,102 @@ HostEntry DNS::resolve(const std::string& address)
 }
 
 
+Poco::ActiveResult<HostEntry> DNS::resolveAsync(const std::string& address)
+{
+	return asyncResolver.get()->resolve(address);
+}
+
+
+void DNS::enableCache(std::size_t maxSize, const Poco::Timespan& ttl, const Poco::Timespan& negativeTTL)
+{
+	DNSCache::Ptr pCache = new DNSCache(maxSize, ttl, negativeTTL);
+
+	std::lock_guard<std::mutex> lock(dnsMutex);
+	pDNSCache = pCache;
+}
+
+
+void DNS::disableCache()
+{
+	std::lock_guard<std::mutex> lock(dnsMutex);
+	pDNSCache = 0;
+}
+
+
+bool DNS::cacheEnabled()
+{
+	return !dnsCache().isNull();
+}
+
+
+void DNS::flushCache()
+{
+	DNSCache::Ptr pCache = dnsCache();
+	if (pCache) pCache->clear();
+}
+
+
+DNSCache::Statistics DNS::cacheStatistics()
+{
+	DNSCache::Ptr pCache = dnsCache();
+	if (pCache) return pCache->statistics();
+
+	DNSCache::Statistics stats = {0, 0, 0, 0};
+	return stats;
+}
+
+
+void DNS::setHostsFile(const std::string& path, bool exclusive)
+{
+	Poco::SharedPtr<HostsMap> pHosts;
+	if (!path.empty())
+	{
+		struct Record
+		{
+			std::string name;
+			HostEntry::AddressList addresses;
+			HostEntry::AliasList aliases;
+		};
+		std::map<std::string, Record> records;
+
+		Poco::FileInputStream istr(path);
+		std::string line;
+		while (std::getline(istr, line))
+		{
+			std::string::size_type pos = line.find('#');
+			if (pos != std::string::npos) line.resize(pos);
+			Poco::StringTokenizer tok(line, " \t\r", Poco::StringTokenizer::TOK_IGNORE_EMPTY | Poco::StringTokenizer::TOK_TRIM);
+			IPAddress address;
+			if (tok.count() < 2 || !IPAddress::tryParse(tok[0], address)) continue;
+
+			for (std::size_t i = 1; i < tok.count(); i++)
+			{
+				Record& record = records[Poco::toLower(tok[i])];
+				if (record.name.empty()) record.name = tok[1];
+				record.addresses.push_back(address);
+				for (std::size_t j = 1; j < tok.count(); j++)
+				{
+					if (tok[j] != record.name) record.aliases.push_back(tok[j]);
+				}
+			}
+		}
+
+		pHosts = new HostsMap;
+		for (const auto& r: records)
+		{
+			pHosts->insert(HostsMap::value_type(r.first, HostEntry(r.second.name, r.second.addresses, r.second.aliases)));
+		}
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(dnsMutex);
+		pHostsMap = pHosts;
+		hostsExclusive = exclusive && pHosts;
+	}
+	flushCache();
+}
+
+
 IPAddress DNS::resolveOne(const std::string& address)
 {
 	const HostEntry& entry = resolve(address);
@@ -198,9 +396,12 @@ HostEntry DNS::thisHost()
 void DNS::reload()
 {
 #if defined(POCO_HAVE_LIBRESOLV)
-	Poco::ScopedWriteRWLock writeLock(resolverLock);
-	res_init();
+	{
+		Poco::ScopedWriteRWLock writeLock(resolverLock);
+		res_init();
+	}
 #endif
+	flushCache();
 }
 
 
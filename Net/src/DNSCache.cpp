@@ -0,0 +1,103 @@
+//
+// DNSCache.cpp
+//
+// Library: Net
+// Package: NetCore
+// Module:  DNSCache
+//
+// Copyright (c) 2005-2023, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "Poco/Net/DNSCache.h"
+
+
+namespace Poco {
+namespace Net {
+
+
+DNSCache::DNSCache(std::size_t maxSize, const Poco::Timespan& ttl, const Poco::Timespan& negativeTTL):
+	_maxSize(maxSize),
+	_ttl(ttl),
+	_negativeTTL(negativeTTL),
+	_cache(maxSize),
+	_hits(0),
+	_negativeHits(0),
+	_misses(0)
+{
+}
+
+
+DNSCache::~DNSCache()
+{
+}
+
+
+bool DNSCache::get(const std::string& key, HostEntry& entry)
+{
+	Poco::SharedPtr<Entry> pEntry = _cache.get(key);
+	if (!pEntry)
+	{
+		++_misses;
+		return false;
+	}
+	if (pEntry->pError)
+	{
+		++_negativeHits;
+		pEntry->pError->rethrow();
+	}
+	++_hits;
+	entry = pEntry->hostEntry;
+	return true;
+}
+
+
+void DNSCache::add(const std::string& key, const HostEntry& entry)
+{
+	if (_ttl.totalMicroseconds() <= 0) return;
+
+	Entry cached;
+	cached.hostEntry = entry;
+	cached.expires += _ttl;
+	_cache.add(key, cached);
+}
+
+
+void DNSCache::addNegative(const std::string& key, const Poco::Exception& exc)
+{
+	if (_negativeTTL.totalMicroseconds() <= 0) return;
+
+	Entry cached;
+	cached.pError = exc.clone();
+	cached.expires += _negativeTTL;
+	_cache.add(key, cached);
+}
+
+
+void DNSCache::remove(const std::string& key)
+{
+	_cache.remove(key);
+}
+
+
+void DNSCache::clear()
+{
+	_cache.clear();
+}
+
+
+DNSCache::Statistics DNSCache::statistics() const
+{
+	Statistics stats;
+	stats.hits = _hits;
+	stats.negativeHits = _negativeHits;
+	stats.misses = _misses;
+	stats.size = _cache.size();
+	return stats;
+}
+
+
+} } // namespace Poco::Net
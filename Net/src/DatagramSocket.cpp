@@ -199,6 +199,45 @@ int DatagramSocket::receiveFrom(SocketBufVec& buffers, SocketAddress& address, i
 }
 
 
+int DatagramSocket::receiveBatch(SocketMsgVec& messages, int flags)
+{
+	return impl()->receiveBatch(messages, flags);
+}
+
+
+int DatagramSocket::sendBatch(SocketMsgVec& messages, int flags)
+{
+	return impl()->sendBatch(messages, flags);
+}
+
+
+int DatagramSocket::sendSegments(const void* buffer, int length, int segmentSize, const SocketAddress& address, int flags)
+{
+	return impl()->sendSegments(buffer, length, segmentSize, address, flags);
+}
+
+
+int DatagramSocket::receiveSegments(void* buffer, int length, SocketAddress& address, int& segmentSize, int flags)
+{
+	sockaddr_storage abuffer;
+	struct sockaddr* pSA = reinterpret_cast<struct sockaddr*>(&abuffer);
+	poco_socklen_t saLen = sizeof(abuffer);
+	poco_socklen_t* pSALen = &saLen;
+	int rc = impl()->receiveSegments(buffer, length, &pSA, &pSALen, segmentSize, flags);
+	if (rc >= 0)
+	{
+		address = SocketAddress(pSA, saLen);
+	}
+	return rc;
+}
+
+
+int DatagramSocket::receiveSegments(void* buffer, int length, struct sockaddr** ppSA, poco_socklen_t** ppSALen, int& segmentSize, int flags)
+{
+	return impl()->receiveSegments(buffer, length, ppSA, ppSALen, segmentSize, flags);
+}
+
+
 int DatagramSocket::receiveFrom(SocketBufVec& buffers, struct sockaddr** ppSA, poco_socklen_t** ppSALen, int flags)
 {
 	return impl()->receiveFrom(buffers, ppSA, ppSALen, flags);
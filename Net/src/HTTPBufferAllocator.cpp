@@ -13,31 +13,266 @@
 
 
 #include "Poco/Net/HTTPBufferAllocator.h"
-
-
-using Poco::MemoryPool;
+#include "Poco/Exception.h"
+#include <atomic>
+#include <mutex>
+#include <vector>
 
 
 namespace Poco {
 namespace Net {
 
 
-MemoryPool HTTPBufferAllocator::_pool(HTTPBufferAllocator::BUFFER_SIZE, 16);
+namespace
+{
+	enum
+	{
+		SIZE_CLASSES = 3
+	};
+
+	struct SizeClass
+	{
+		SizeClass(std::streamsize bufferSize, int poolCapacity):
+			size(bufferSize),
+			capacity(poolCapacity)
+		{
+		}
+
+		const std::streamsize size;
+		std::atomic<int> capacity;
+		std::mutex mutex;
+		std::vector<char*> pool;
+		std::atomic<Poco::UInt64> allocations{0};
+		std::atomic<Poco::UInt64> cacheHits{0};
+		std::atomic<Poco::UInt64> poolHits{0};
+		std::atomic<Poco::UInt64> misses{0};
+	};
+
+	SizeClass* sizeClasses()
+		/// The size classes are never destroyed, as threads
+		/// ending during program termination still release their
+		/// cached buffers to the pools.
+	{
+		static SizeClass* pSizeClasses = new SizeClass[SIZE_CLASSES]
+		{
+			{HTTPBufferAllocator::SMALL_BUFFER_SIZE, 1024},
+			{HTTPBufferAllocator::MEDIUM_BUFFER_SIZE, 256},
+			{HTTPBufferAllocator::LARGE_BUFFER_SIZE, 64}
+		};
+		return pSizeClasses;
+	}
+
+	std::atomic<std::streamsize> bufferSize(HTTPBufferAllocator::BUFFER_SIZE);
+	std::atomic<int> threadCacheCapacity(HTTPBufferAllocator::DEFAULT_THREAD_CACHE_CAPACITY);
+
+	int sizeClassIndex(std::streamsize size)
+	{
+		for (int i = 0; i < SIZE_CLASSES; ++i)
+		{
+			if (size <= sizeClasses()[i].size) return i;
+		}
+		return -1;
+	}
+
+	void releaseToPool(SizeClass& sc, char* ptr)
+	{
+		{
+			std::lock_guard<std::mutex> lock(sc.mutex);
+			if (static_cast<int>(sc.pool.size()) < sc.capacity.load(std::memory_order_relaxed))
+			{
+				sc.pool.push_back(ptr);
+				return;
+			}
+		}
+		delete [] ptr;
+	}
+
+	struct ThreadCache
+		/// Trivially destructible, so that buffers released after the
+		/// ThreadCacheGuard has been destroyed (e.g., by static objects
+		/// during program termination) can still be handled safely.
+	{
+		char* buffers[SIZE_CLASSES][HTTPBufferAllocator::MAX_THREAD_CACHE_CAPACITY];
+		int count[SIZE_CLASSES];
+		int state;
+	};
+
+	enum ThreadCacheState
+	{
+		CACHE_UNINITIALIZED = 0,
+		CACHE_ACTIVE,
+		CACHE_DESTROYED
+	};
+
+	thread_local ThreadCache threadCache;
+
+	struct ThreadCacheGuard
+	{
+		ThreadCacheGuard()
+		{
+			threadCache.state = CACHE_ACTIVE;
+		}
+
+		~ThreadCacheGuard()
+		{
+			threadCache.state = CACHE_DESTROYED;
+			for (int i = 0; i < SIZE_CLASSES; ++i)
+			{
+				while (threadCache.count[i] > 0)
+				{
+					releaseToPool(sizeClasses()[i], threadCache.buffers[i][--threadCache.count[i]]);
+				}
+			}
+		}
+	};
+
+	thread_local ThreadCacheGuard threadCacheGuard;
+
+	inline bool threadCacheActive()
+	{
+		if (threadCache.state == CACHE_UNINITIALIZED)
+		{
+			// the guard's constructor marks the cache active and
+			// its destructor flushes the cache when the thread ends
+			static_cast<void>(&threadCacheGuard);
+		}
+		return threadCache.state == CACHE_ACTIVE;
+	}
+}
 
 
 char* HTTPBufferAllocator::allocate(std::streamsize size)
 {
-	poco_assert_dbg (size == BUFFER_SIZE);
+	int index = sizeClassIndex(size);
+	if (index < 0) return new char[static_cast<std::size_t>(size)];
 
-	return reinterpret_cast<char*>(_pool.get());
+	SizeClass& sc = sizeClasses()[index];
+	sc.allocations.fetch_add(1, std::memory_order_relaxed);
+	if (threadCacheActive() && threadCache.count[index] > 0)
+	{
+		sc.cacheHits.fetch_add(1, std::memory_order_relaxed);
+		return threadCache.buffers[index][--threadCache.count[index]];
+	}
+	{
+		std::lock_guard<std::mutex> lock(sc.mutex);
+		if (!sc.pool.empty())
+		{
+			char* ptr = sc.pool.back();
+			sc.pool.pop_back();
+			sc.poolHits.fetch_add(1, std::memory_order_relaxed);
+			return ptr;
+		}
+	}
+	sc.misses.fetch_add(1, std::memory_order_relaxed);
+	return new char[static_cast<std::size_t>(sc.size)];
 }
 
 
 void HTTPBufferAllocator::deallocate(char* ptr, std::streamsize size)
 {
-	poco_assert_dbg (size == BUFFER_SIZE);
+	int index = sizeClassIndex(size);
+	if (index < 0)
+	{
+		delete [] ptr;
+		return;
+	}
+
+	if (threadCacheActive() && threadCache.count[index] < threadCacheCapacity.load(std::memory_order_relaxed))
+	{
+		threadCache.buffers[index][threadCache.count[index]++] = ptr;
+	}
+	else releaseToPool(sizeClasses()[index], ptr);
+}
+
+
+void HTTPBufferAllocator::setBufferSize(std::streamsize size)
+{
+	poco_assert (size > 0);
+
+	bufferSize = size;
+}
+
+
+std::streamsize HTTPBufferAllocator::getBufferSize()
+{
+	return bufferSize.load(std::memory_order_relaxed);
+}
 
-	_pool.release(ptr);
+
+void HTTPBufferAllocator::setPoolCapacity(std::streamsize size, int capacity)
+{
+	poco_assert (capacity >= 0);
+
+	int index = sizeClassIndex(size);
+	if (index < 0) throw Poco::InvalidArgumentException("No size class for buffer size");
+
+	SizeClass& sc = sizeClasses()[index];
+	std::vector<char*> excess;
+	{
+		std::lock_guard<std::mutex> lock(sc.mutex);
+		sc.capacity = capacity;
+		while (static_cast<int>(sc.pool.size()) > capacity)
+		{
+			excess.push_back(sc.pool.back());
+			sc.pool.pop_back();
+		}
+	}
+	for (auto p: excess) delete [] p;
+}
+
+
+int HTTPBufferAllocator::getPoolCapacity(std::streamsize size)
+{
+	int index = sizeClassIndex(size);
+	if (index < 0) throw Poco::InvalidArgumentException("No size class for buffer size");
+
+	return sizeClasses()[index].capacity;
+}
+
+
+void HTTPBufferAllocator::setThreadCacheCapacity(int capacity)
+{
+	poco_assert (capacity >= 0 && capacity <= MAX_THREAD_CACHE_CAPACITY);
+
+	threadCacheCapacity = capacity;
+}
+
+
+int HTTPBufferAllocator::getThreadCacheCapacity()
+{
+	return threadCacheCapacity;
+}
+
+
+HTTPBufferAllocator::Statistics HTTPBufferAllocator::statistics(std::streamsize size)
+{
+	int index = sizeClassIndex(size);
+	if (index < 0) throw Poco::InvalidArgumentException("No size class for buffer size");
+
+	SizeClass& sc = sizeClasses()[index];
+	Statistics stats;
+	stats.allocations = sc.allocations.load(std::memory_order_relaxed);
+	stats.cacheHits   = sc.cacheHits.load(std::memory_order_relaxed);
+	stats.poolHits    = sc.poolHits.load(std::memory_order_relaxed);
+	stats.misses      = sc.misses.load(std::memory_order_relaxed);
+	{
+		std::lock_guard<std::mutex> lock(sc.mutex);
+		stats.pooled = static_cast<int>(sc.pool.size());
+	}
+	return stats;
+}
+
+
+void HTTPBufferAllocator::resetStatistics()
+{
+	for (int i = 0; i < SIZE_CLASSES; ++i)
+	{
+		SizeClass& sc = sizeClasses()[i];
+		sc.allocations = 0;
+		sc.cacheHits   = 0;
+		sc.poolHits    = 0;
+		sc.misses      = 0;
+	}
 }
 
 
@@ -0,0 +1,306 @@
+//
+// HTTPClientSessionPool.cpp
+//
+// Library: Net
+// Package: HTTPClient
+// Module:  HTTPClientSessionPool
+//
+// Copyright (c) 2005-2023, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "Poco/Net/HTTPClientSessionPool.h"
+#include "Poco/Net/HTTPSessionFactory.h"
+#include "Poco/Net/HTTPSession.h"
+#include "Poco/NumberFormatter.h"
+#include "Poco/Exception.h"
+#include "Poco/String.h"
+#include <chrono>
+
+
+namespace Poco {
+namespace Net {
+
+
+HTTPClientSessionPool::HTTPClientSessionPool():
+	_factory(HTTPSessionFactory::defaultFactory()),
+	_maxSessionsPerHost(DEFAULT_MAX_SESSIONS_PER_HOST),
+	_idleTimeout(DEFAULT_IDLE_TIMEOUT, 0),
+	_waitTimeout(DEFAULT_WAIT_TIMEOUT, 0)
+{
+}
+
+
+HTTPClientSessionPool::HTTPClientSessionPool(HTTPSessionFactory& factory, int maxSessionsPerHost, const Poco::Timespan& idleTimeout):
+	_factory(factory),
+	_maxSessionsPerHost(maxSessionsPerHost),
+	_idleTimeout(idleTimeout),
+	_waitTimeout(DEFAULT_WAIT_TIMEOUT, 0)
+{
+	poco_assert (maxSessionsPerHost > 0);
+}
+
+
+HTTPClientSessionPool::~HTTPClientSessionPool()
+{
+	try
+	{
+		poco_assert_dbg (_sessions.empty());
+
+		clear();
+	}
+	catch (...)
+	{
+		poco_unexpected();
+	}
+}
+
+
+HTTPClientSession* HTTPClientSessionPool::get(const Poco::URI& uri)
+{
+	return get(uri, _factory.getProxyConfig());
+}
+
+
+HTTPClientSession* HTTPClientSessionPool::get(const Poco::URI& uri, const HTTPClientSession::ProxyConfig& proxyConfig)
+{
+	const std::string key = sessionKey(uri, proxyConfig);
+	std::vector<HTTPClientSession*> stale;
+	HTTPClientSession* pSession = 0;
+	{
+		std::unique_lock<std::mutex> lock(_mutex);
+
+		Host& host = _hosts[key];
+		const auto deadline = std::chrono::steady_clock::now() + std::chrono::microseconds(_waitTimeout.totalMicroseconds());
+		for (;;)
+		{
+			// most recently used sessions first, as they
+			// are the least likely to have been closed
+			while (!pSession && !host.idle.empty())
+			{
+				IdleSession idle = host.idle.back();
+				host.idle.pop_back();
+				if (idle.since.isElapsed(_idleTimeout.totalMicroseconds()) || !isReusable(idle.pSession))
+					stale.push_back(idle.pSession);
+				else
+					pSession = idle.pSession;
+			}
+			if (pSession || host.used < _maxSessionsPerHost) break;
+			++host.waiting;
+			const std::cv_status status = _available.wait_until(lock, deadline);
+			--host.waiting;
+			if (status == std::cv_status::timeout && host.idle.empty() && host.used >= _maxSessionsPerHost)
+			{
+				lock.unlock();
+				for (auto p: stale) delete p;
+				throw Poco::TimeoutException("No HTTP session available for", key);
+			}
+		}
+		++host.used;
+		if (pSession) _sessions[pSession] = key;
+	}
+	for (auto p: stale) delete p;
+	if (pSession) return pSession;
+
+	try
+	{
+		pSession = createSession(uri, proxyConfig);
+	}
+	catch (...)
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		--_hosts[key].used;
+		_available.notify_all();
+		throw;
+	}
+
+	std::lock_guard<std::mutex> lock(_mutex);
+	_sessions[pSession] = key;
+	return pSession;
+}
+
+
+void HTTPClientSessionPool::put(HTTPClientSession* pSession)
+{
+	delete release(pSession, true);
+}
+
+
+void HTTPClientSessionPool::discard(HTTPClientSession* pSession)
+{
+	delete release(pSession, false);
+}
+
+
+HTTPClientSession* HTTPClientSessionPool::release(HTTPClientSession* pSession, bool reuse)
+{
+	poco_check_ptr (pSession);
+
+	reuse = reuse && pSession->connected() && pSession->getKeepAlive() && !pSession->networkException();
+
+	std::lock_guard<std::mutex> lock(_mutex);
+
+	SessionMap::iterator it = _sessions.find(pSession);
+	if (it == _sessions.end()) throw Poco::InvalidArgumentException("HTTPClientSession does not belong to pool");
+
+	Host& host = _hosts[it->second];
+	_sessions.erase(it);
+	--host.used;
+	_available.notify_all();
+	if (reuse)
+	{
+		IdleSession idle;
+		idle.pSession = pSession;
+		host.idle.push_back(idle);
+		return 0;
+	}
+	return pSession;
+}
+
+
+void HTTPClientSessionPool::purge()
+{
+	std::vector<HTTPClientSession*> stale;
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+
+		for (HostMap::iterator it = _hosts.begin(); it != _hosts.end();)
+		{
+			std::vector<IdleSession>& idle = it->second.idle;
+			std::size_t n = 0;
+			for (std::size_t i = 0; i < idle.size(); ++i)
+			{
+				if (idle[i].since.isElapsed(_idleTimeout.totalMicroseconds()))
+					stale.push_back(idle[i].pSession);
+				else
+					idle[n++] = idle[i];
+			}
+			idle.resize(n);
+			if (idle.empty() && it->second.used == 0 && it->second.waiting == 0)
+				it = _hosts.erase(it);
+			else
+				++it;
+		}
+	}
+	for (auto p: stale) delete p;
+}
+
+
+void HTTPClientSessionPool::clear()
+{
+	std::vector<HTTPClientSession*> idle;
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+
+		for (HostMap::iterator it = _hosts.begin(); it != _hosts.end();)
+		{
+			for (const auto& s: it->second.idle) idle.push_back(s.pSession);
+			it->second.idle.clear();
+			if (it->second.used == 0 && it->second.waiting == 0)
+				it = _hosts.erase(it);
+			else
+				++it;
+		}
+	}
+	for (auto p: idle) delete p;
+}
+
+
+void HTTPClientSessionPool::setMaxSessionsPerHost(int maxSessions)
+{
+	poco_assert (maxSessions > 0);
+
+	std::lock_guard<std::mutex> lock(_mutex);
+	_maxSessionsPerHost = maxSessions;
+	_available.notify_all();
+}
+
+
+void HTTPClientSessionPool::setIdleTimeout(const Poco::Timespan& timeout)
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	_idleTimeout = timeout;
+}
+
+
+void HTTPClientSessionPool::setWaitTimeout(const Poco::Timespan& timeout)
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	_waitTimeout = timeout;
+}
+
+
+int HTTPClientSessionPool::idle() const
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+
+	std::size_t n = 0;
+	for (const auto& p: _hosts) n += p.second.idle.size();
+	return static_cast<int>(n);
+}
+
+
+int HTTPClientSessionPool::used() const
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+
+	return static_cast<int>(_sessions.size());
+}
+
+
+HTTPClientSession* HTTPClientSessionPool::createSession(const Poco::URI& uri, const HTTPClientSession::ProxyConfig& proxyConfig)
+{
+	HTTPClientSession* pSession;
+	if (_factory.supportsProtocol(uri.getScheme()))
+		pSession = _factory.createClientSession(uri);
+	else if (uri.getScheme() == "http")
+		pSession = new HTTPClientSession(uri.getHost(), uri.getPort());
+	else
+		throw Poco::UnknownURISchemeException(uri.getScheme());
+
+	if (!proxyConfig.host.empty()) pSession->setProxyConfig(proxyConfig);
+	pSession->setKeepAlive(true);
+	pSession->setKeepAliveTimeout(_idleTimeout);
+	return pSession;
+}
+
+
+bool HTTPClientSessionPool::isReusable(HTTPClientSession* pSession) const
+{
+	try
+	{
+		// a keep-alive connection must not become readable while idle;
+		// if it does, the server has closed it or sent garbage.
+		return pSession->connected() && !pSession->socket().poll(Poco::Timespan(0), Socket::SELECT_READ | Socket::SELECT_ERROR);
+	}
+	catch (Poco::Exception&)
+	{
+		return false;
+	}
+}
+
+
+std::string HTTPClientSessionPool::sessionKey(const Poco::URI& uri, const HTTPClientSession::ProxyConfig& proxyConfig)
+{
+	std::string key(Poco::toLower(uri.getScheme()));
+	key += "://";
+	key += Poco::toLower(uri.getHost());
+	key += ':';
+	Poco::NumberFormatter::append(key, uri.getPort());
+	if (!proxyConfig.host.empty())
+	{
+		key += ";proxy=";
+		key += Poco::toLower(proxyConfig.host);
+		key += ':';
+		Poco::NumberFormatter::append(key, proxyConfig.port);
+		key += ';';
+		key += proxyConfig.username;
+	}
+	return key;
+}
+
+
+} } // namespace Poco::Net
@@ -26,7 +26,7 @@ namespace Net {
 
 
 HTTPHeaderStreamBuf::HTTPHeaderStreamBuf(HTTPSession& session, openmode mode):
-	HTTPBasicStreamBuf(HTTPBufferAllocator::BUFFER_SIZE, mode),
+	HTTPBasicStreamBuf(HTTPBufferAllocator::getBufferSize(), mode),
 	_session(session),
 	_end(false)
 {
@@ -41,22 +41,10 @@ HTTPHeaderStreamBuf::~HTTPHeaderStreamBuf()
 int HTTPHeaderStreamBuf::readFromDevice(char* buffer, std::streamsize length)
 {
 	// read line-by-line; an empty line denotes the end of the headers.
-	static const int eof = std::char_traits<char>::eof();
-
 	if (_end) return 0;
 
-	int n = 0;
-	int ch = _session.get();
-	while (ch != eof && ch != '\n' && n < length - 1)
-	{
-		*buffer++ = (char) ch; ++n;
-		ch = _session.get();
-	}
-	if (ch != eof)
-	{
-		*buffer++ = (char) ch; ++n;
-		if (n == 2) _end = true;
-	}
+	int n = _session.readLine(buffer, length);
+	if (n == 2 && buffer[1] == '\n') _end = true;
 	return n;
 }
 
@@ -56,9 +56,32 @@ HTTPResponseStream::HTTPResponseStream(std::istream& istr, HTTPClientSession* pS
 }
 
 
+HTTPResponseStream::HTTPResponseStream(std::istream& istr, HTTPClientSession* pSession, HTTPClientSessionPool::Ptr pSessionPool):
+	HTTPResponseIOS(istr),
+	std::istream(&_buf),
+	_pSession(pSession),
+	_pSessionPool(pSessionPool)
+{
+}
+
+
 HTTPResponseStream::~HTTPResponseStream()
 {
-	delete _pSession;
+	if (_pSessionPool)
+	{
+		try
+		{
+			if (eof() && !bad())
+				_pSessionPool->put(_pSession);
+			else
+				_pSessionPool->discard(_pSession);
+		}
+		catch (...)
+		{
+			poco_unexpected();
+		}
+	}
+	else delete _pSession;
 }
 
 
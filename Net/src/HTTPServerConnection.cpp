@@ -68,6 +68,12 @@ void HTTPServerConnection::run()
 				HTTPServerResponseImpl response(session);
 				HTTPServerRequestImpl request(response, session, _pParams);
 
+				// Only buffer the response if further requests have already
+				// been received, so that it can be sent together with theirs.
+				// Otherwise, any previously buffered responses are sent and
+				// this response is written through.
+				session.setOutputBuffering(_pParams->getPipelining() && session.hasBufferedRequests());
+
 				Poco::Timestamp now;
 				response.setDate(now);
 				response.setVersion(request.getVersion());
@@ -122,6 +128,14 @@ void HTTPServerConnection::run()
 			else throw;
 		}
 	}
+	try
+	{
+		session.flushOutput();
+	}
+	catch (Poco::Exception&)
+	{
+		// the peer has closed or reset the connection
+	}
 }
 
 
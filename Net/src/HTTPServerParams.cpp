@@ -23,7 +23,8 @@ HTTPServerParams::HTTPServerParams():
 	_timeout(60000000),
 	_keepAlive(true),
 	_maxKeepAliveRequests(0),
-	_keepAliveTimeout(15000000)
+	_keepAliveTimeout(15000000),
+	_pipelining(false)
 {
 }
 
@@ -70,4 +71,10 @@ void HTTPServerParams::setMaxKeepAliveRequests(int maxKeepAliveRequests)
 }
 
 
+void HTTPServerParams::setPipelining(bool pipelining)
+{
+	_pipelining = pipelining;
+}
+
+
 } } // namespace Poco::Net
@@ -28,11 +28,14 @@
 #include "Poco/FileStream.h"
 #include "Poco/DateTimeFormatter.h"
 #include "Poco/DateTimeFormat.h"
+#include "Poco/NumberParser.h"
+#include "Poco/String.h"
 
 
 using Poco::File;
 using Poco::Timestamp;
 using Poco::NumberFormatter;
+using Poco::NumberParser;
 using Poco::StreamCopier;
 using Poco::OpenFileException;
 using Poco::DateTimeFormatter;
@@ -112,11 +115,47 @@ void HTTPServerResponseImpl::sendFile(const std::string& path, const std::string
 	File f(path);
 	Timestamp dateTime    = f.getLastModified();
 	File::FileSize length = f.getSize();
-	set("Last-Modified", DateTimeFormatter::format(dateTime, DateTimeFormat::HTTP_FORMAT));
+	std::string lastModified = DateTimeFormatter::format(dateTime, DateTimeFormat::HTTP_FORMAT);
+	set("Last-Modified", lastModified);
+	set("Accept-Ranges", "bytes");
+
+	Poco::UInt64 first = 0;
+	Poco::UInt64 last  = length > 0 ? length - 1 : 0;
+	bool partial = false;
+	if (_pRequest && getStatus() == HTTPResponse::HTTP_OK && _pRequest->has("Range") &&
+		(!_pRequest->has("If-Range") || _pRequest->get("If-Range") == lastModified) &&
+		parseRange(_pRequest->get("Range"), length, first, last))
+	{
+		if (first <= last)
+		{
+			partial = true;
+			setStatusAndReason(HTTPResponse::HTTP_PARTIAL_CONTENT);
+			std::string contentRange("bytes ");
+			NumberFormatter::append(contentRange, first);
+			contentRange += '-';
+			NumberFormatter::append(contentRange, last);
+			contentRange += '/';
+			NumberFormatter::append(contentRange, static_cast<Poco::UInt64>(length));
+			set("Content-Range", contentRange);
+		}
+		else
+		{
+			setStatusAndReason(HTTPResponse::HTTP_REQUESTED_RANGE_NOT_SATISFIABLE);
+			std::string contentRange("bytes */");
+			NumberFormatter::append(contentRange, static_cast<Poco::UInt64>(length));
+			set("Content-Range", contentRange);
+			setContentLength(0);
+			setChunkedTransferEncoding(false);
+			_pStream = new HTTPHeaderOutputStream(_session);
+			write(*_pStream);
+			return;
+		}
+	}
+	Poco::UInt64 count = partial ? last - first + 1 : static_cast<Poco::UInt64>(length);
 #if defined(POCO_HAVE_INT64)
-	setContentLength64(length);
+	setContentLength64(count);
 #else
-	setContentLength(static_cast<int>(length));
+	setContentLength(static_cast<int>(count));
 #endif
 	setContentType(mediaType);
 	setChunkedTransferEncoding(false);
@@ -126,9 +165,18 @@ void HTTPServerResponseImpl::sendFile(const std::string& path, const std::string
 	{
 		_pStream = new HTTPHeaderOutputStream(_session);
 		write(*_pStream);
-		if (_pRequest && _pRequest->getMethod() != HTTPRequest::HTTP_HEAD)
+		if (_pRequest && _pRequest->getMethod() != HTTPRequest::HTTP_HEAD && count > 0)
 		{
-			StreamCopier::copyStream(istr, *_pStream);
+			_pStream->flush();
+			std::streamoff offset = static_cast<std::streamoff>(first);
+			std::streamsize remaining = static_cast<std::streamsize>(count);
+			while (remaining > 0)
+			{
+				std::streamsize n = _session.sendFile(istr, offset, remaining);
+				if (n <= 0) break;
+				offset += n;
+				remaining -= n;
+			}
 		}
 	}
 	else throw OpenFileException(path);
@@ -166,6 +214,56 @@ void HTTPServerResponseImpl::redirect(const std::string& uri, HTTPStatus status)
 }
 
 
+bool HTTPServerResponseImpl::parseRange(const std::string& range, Poco::UInt64 length, Poco::UInt64& first, Poco::UInt64& last)
+{
+	static const std::string BYTES_UNIT("bytes=");
+
+	if (range.compare(0, BYTES_UNIT.size(), BYTES_UNIT) != 0) return false;
+	std::string spec = Poco::trim(range.substr(BYTES_UNIT.size()));
+	if (spec.find(',') != std::string::npos) return false;
+	std::string::size_type pos = spec.find('-');
+	if (pos == std::string::npos) return false;
+
+	std::string firstStr = Poco::trim(spec.substr(0, pos));
+	std::string lastStr  = Poco::trim(spec.substr(pos + 1));
+	if (firstStr.empty())
+	{
+		// suffix range: last n bytes
+		Poco::UInt64 suffix;
+		if (!NumberParser::tryParseUnsigned64(lastStr, suffix)) return false;
+		if (suffix == 0 || length == 0)
+		{
+			first = 1;
+			last  = 0;
+		}
+		else
+		{
+			first = suffix < length ? length - suffix : 0;
+			last  = length - 1;
+		}
+		return true;
+	}
+
+	if (!NumberParser::tryParseUnsigned64(firstStr, first)) return false;
+	if (lastStr.empty())
+	{
+		last = length - 1;
+	}
+	else
+	{
+		if (!NumberParser::tryParseUnsigned64(lastStr, last)) return false;
+		if (last < first) return false;
+		if (last >= length) last = length - 1;
+	}
+	if (first >= length)
+	{
+		first = 1;
+		last  = 0;
+	}
+	return true;
+}
+
+
 void HTTPServerResponseImpl::requireAuthentication(const std::string& realm)
 {
 	poco_assert (!_pStream);
@@ -49,7 +49,10 @@ bool HTTPServerSession::hasMoreRequests()
 	{
 		if (_maxKeepAliveRequests > 0)
 			--_maxKeepAliveRequests;
-		return buffered() > 0 || socket().poll(_keepAliveTimeout, Socket::SELECT_READ);
+		if (buffered() > 0) return true;
+		// send any batched responses before waiting for the next request
+		flushOutput();
+		return socket().poll(_keepAliveTimeout, Socket::SELECT_READ);
 	}
 	else return false;
 }
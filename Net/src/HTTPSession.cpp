@@ -29,6 +29,10 @@ HTTPSession::HTTPSession():
 	_pBuffer(0),
 	_pCurrent(0),
 	_pEnd(0),
+	_bufferSize(0),
+	_outputBuffering(false),
+	_outputChunkCount(0),
+	_outputBuffered(0),
 	_keepAlive(false),
 	_connectionTimeout(HTTP_DEFAULT_CONNECTION_TIMEOUT),
 	_receiveTimeout(HTTP_DEFAULT_TIMEOUT),
@@ -43,6 +47,10 @@ HTTPSession::HTTPSession(const StreamSocket& socket):
 	_pBuffer(0),
 	_pCurrent(0),
 	_pEnd(0),
+	_bufferSize(0),
+	_outputBuffering(false),
+	_outputChunkCount(0),
+	_outputBuffered(0),
 	_keepAlive(false),
 	_connectionTimeout(HTTP_DEFAULT_CONNECTION_TIMEOUT),
 	_receiveTimeout(HTTP_DEFAULT_TIMEOUT),
@@ -57,6 +65,10 @@ HTTPSession::HTTPSession(const StreamSocket& socket, bool keepAlive):
 	_pBuffer(0),
 	_pCurrent(0),
 	_pEnd(0),
+	_bufferSize(0),
+	_outputBuffering(false),
+	_outputChunkCount(0),
+	_outputBuffered(0),
 	_keepAlive(keepAlive),
 	_connectionTimeout(HTTP_DEFAULT_CONNECTION_TIMEOUT),
 	_receiveTimeout(HTTP_DEFAULT_TIMEOUT),
@@ -70,7 +82,7 @@ HTTPSession::~HTTPSession()
 {
 	try
 	{
-		if (_pBuffer) HTTPBufferAllocator::deallocate(_pBuffer, HTTPBufferAllocator::BUFFER_SIZE);
+		if (_pBuffer) HTTPBufferAllocator::deallocate(_pBuffer, _bufferSize);
 	}
 	catch (...)
 	{
@@ -131,6 +143,29 @@ int HTTPSession::peek()
 }
 
 
+int HTTPSession::readLine(char* buffer, std::streamsize length)
+{
+	int n = 0;
+	while (n < length)
+	{
+		if (_pCurrent == _pEnd)
+		{
+			refill();
+			if (_pCurrent == _pEnd) break;
+		}
+		std::size_t avail = static_cast<std::size_t>(_pEnd - _pCurrent);
+		if (avail > static_cast<std::size_t>(length - n)) avail = static_cast<std::size_t>(length - n);
+		const char* pLF = static_cast<const char*>(std::memchr(_pCurrent, '\n', avail));
+		if (pLF) avail = static_cast<std::size_t>(pLF - _pCurrent) + 1;
+		std::memcpy(buffer + n, _pCurrent, avail);
+		_pCurrent += avail;
+		n += static_cast<int>(avail);
+		if (pLF) break;
+	}
+	return n;
+}
+
+
 int HTTPSession::read(char* buffer, std::streamsize length)
 {
 	if (_pCurrent < _pEnd)
@@ -147,6 +182,15 @@ int HTTPSession::read(char* buffer, std::streamsize length)
 
 int HTTPSession::write(const char* buffer, std::streamsize length)
 {
+	if (_outputBuffering)
+	{
+		if (_outputBuffered + length > MAX_OUTPUT_BUFFER_SIZE) flushOutput();
+		if (length < MAX_OUTPUT_BUFFER_SIZE)
+		{
+			bufferOutput(buffer, static_cast<std::size_t>(length));
+			return static_cast<int>(length);
+		}
+	}
 	try
 	{
 		return _socket.sendBytes(buffer, (int) length);
@@ -159,8 +203,25 @@ int HTTPSession::write(const char* buffer, std::streamsize length)
 }
 
 
+std::streamsize HTTPSession::sendFile(FileInputStream& fileInputStream, std::streamoff offset, std::streamsize count)
+{
+	flushOutput();
+	try
+	{
+		return _socket.sendFile(fileInputStream, offset, count);
+	}
+	catch (Poco::Exception& exc)
+	{
+		setException(exc);
+		throw;
+	}
+}
+
+
 int HTTPSession::receive(char* buffer, int length)
 {
+	// the peer may wait for buffered responses before sending more data
+	flushOutput();
 	try
 	{
 		return _socket.receiveBytes(buffer, length);
@@ -177,14 +238,107 @@ void HTTPSession::refill()
 {
 	if (!_pBuffer)
 	{
-		_pBuffer = HTTPBufferAllocator::allocate(HTTPBufferAllocator::BUFFER_SIZE);
+		_bufferSize = HTTPBufferAllocator::getBufferSize();
+		_pBuffer = HTTPBufferAllocator::allocate(_bufferSize);
 	}
 	_pCurrent = _pEnd = _pBuffer;
-	int n = receive(_pBuffer, HTTPBufferAllocator::BUFFER_SIZE);
+	int n = receive(_pBuffer, static_cast<int>(_bufferSize));
 	_pEnd += n;
 }
 
 
+void HTTPSession::setOutputBuffering(bool enable)
+{
+	if (!enable) flushOutput();
+	_outputBuffering = enable;
+}
+
+
+void HTTPSession::flushOutput()
+{
+	if (_outputBuffered == 0) return;
+
+	try
+	{
+		// secure sockets do not support vectored writes
+		std::size_t sent = 0;
+		if (_outputChunkCount > 1 && !_socket.secure())
+		{
+			SocketBufVec buffers(_outputChunkCount);
+			for (std::size_t i = 0; i < _outputChunkCount; ++i)
+			{
+				buffers[i] = Socket::makeBuffer(&_outputChunks[i][0], _outputChunks[i].size());
+			}
+			int n = _socket.sendBytes(buffers);
+			if (n > 0) sent = static_cast<std::size_t>(n);
+		}
+		// send whatever has not been sent with a single write
+		if (sent < _outputBuffered)
+		{
+			for (std::size_t i = 0; i < _outputChunkCount; ++i)
+			{
+				const std::string& chunk = _outputChunks[i];
+				if (sent >= chunk.size())
+				{
+					sent -= chunk.size();
+				}
+				else
+				{
+					sendOutput(chunk.data() + sent, chunk.size() - sent);
+					sent = 0;
+				}
+			}
+		}
+	}
+	catch (Poco::Exception& exc)
+	{
+		resetOutput();
+		setException(exc);
+		throw;
+	}
+	resetOutput();
+}
+
+
+void HTTPSession::bufferOutput(const char* buffer, std::size_t length)
+{
+	if (_outputChunkCount == 0 || _outputChunks[_outputChunkCount - 1].size() + length > OUTPUT_CHUNK_SIZE)
+	{
+		if (_outputChunkCount == _outputChunks.size())
+		{
+			_outputChunks.emplace_back();
+			_outputChunks.back().reserve(OUTPUT_CHUNK_SIZE);
+		}
+		++_outputChunkCount;
+	}
+	_outputChunks[_outputChunkCount - 1].append(buffer, length);
+	_outputBuffered += length;
+}
+
+
+void HTTPSession::sendOutput(const char* buffer, std::size_t length)
+{
+	while (length > 0)
+	{
+		int n = _socket.sendBytes(buffer, static_cast<int>(length));
+		if (n <= 0) throw Poco::IOException("Failed to send buffered output");
+		buffer += n;
+		length -= static_cast<std::size_t>(n);
+	}
+}
+
+
+void HTTPSession::resetOutput()
+{
+	for (std::size_t i = 0; i < _outputChunkCount; ++i)
+	{
+		_outputChunks[i].clear();
+	}
+	_outputChunkCount = 0;
+	_outputBuffered = 0;
+}
+
+
 bool HTTPSession::connected() const
 {
 	return _socket.impl()->initialized();
@@ -239,6 +393,7 @@ void HTTPSession::clearException()
 
 StreamSocket HTTPSession::detachSocket()
 {
+	flushOutput();
 	StreamSocket oldSocket(_socket);
 	StreamSocket newSocket;
 	_socket = newSocket;
@@ -60,11 +60,24 @@ HTTPStreamFactory::HTTPStreamFactory(const std::string& proxyHost, Poco::UInt16
 }
 
 
+HTTPStreamFactory::HTTPStreamFactory(HTTPClientSessionPool::Ptr pSessionPool):
+	_proxyPort(HTTPSession::HTTP_PORT),
+	_pSessionPool(pSessionPool)
+{
+}
+
+
 HTTPStreamFactory::~HTTPStreamFactory()
 {
 }
 
 
+void HTTPStreamFactory::setSessionPool(HTTPClientSessionPool::Ptr pSessionPool)
+{
+	_pSessionPool = pSessionPool;
+}
+
+
 std::istream* HTTPStreamFactory::open(const URI& uri)
 {
 	poco_assert (uri.getScheme() == "http");
@@ -84,22 +97,38 @@ std::istream* HTTPStreamFactory::open(const URI& uri)
 		{
 			if (!pSession)
 			{
-				pSession = new HTTPClientSession(resolvedURI.getHost(), resolvedURI.getPort());
-
+				HTTPClientSession::ProxyConfig proxyConfig(HTTPClientSession::getGlobalProxyConfig());
 				if (proxyUri.empty())
 				{
 					if (!_proxyHost.empty())
 					{
-						pSession->setProxy(_proxyHost, _proxyPort);
-						pSession->setProxyCredentials(_proxyUsername, _proxyPassword);
+						proxyConfig.host = _proxyHost;
+						proxyConfig.port = _proxyPort;
+						proxyConfig.username = _proxyUsername;
+						proxyConfig.password = _proxyPassword;
 					}
 				}
 				else
 				{
-					pSession->setProxy(proxyUri.getHost(), proxyUri.getPort());
+					proxyConfig.host = proxyUri.getHost();
+					proxyConfig.port = proxyUri.getPort();
 					if (!_proxyUsername.empty())
 					{
-						pSession->setProxyCredentials(_proxyUsername, _proxyPassword);
+						proxyConfig.username = _proxyUsername;
+						proxyConfig.password = _proxyPassword;
+					}
+				}
+				if (_pSessionPool)
+				{
+					pSession = _pSessionPool->get(resolvedURI, proxyConfig);
+				}
+				else
+				{
+					pSession = new HTTPClientSession(resolvedURI.getHost(), resolvedURI.getPort());
+					if (!proxyConfig.host.empty())
+					{
+						pSession->setProxy(proxyConfig.host, proxyConfig.port);
+						pSession->setProxyCredentials(proxyConfig.username, proxyConfig.password);
 					}
 				}
 			}
@@ -138,7 +167,7 @@ std::istream* HTTPStreamFactory::open(const URI& uri)
 			}
 			else if (res.getStatus() == HTTPResponse::HTTP_OK)
 			{
-				return new HTTPResponseStream(rs, pSession);
+				return new HTTPResponseStream(rs, pSession, _pSessionPool);
 			}
 			else if (res.getStatus() == HTTPResponse::HTTP_USE_PROXY && !retry)
 			{
@@ -148,7 +177,7 @@ std::istream* HTTPStreamFactory::open(const URI& uri)
 				// single request via the proxy. 305 responses MUST only be generated by origin servers.
 				// only use for one single request!
 				proxyUri.resolve(res.get("Location"));
-				delete pSession;
+				discardSession(pSession);
 				pSession = 0;
 				retry = true; // only allow useproxy once
 			}
@@ -166,18 +195,33 @@ std::istream* HTTPStreamFactory::open(const URI& uri)
 	}
 	catch (...)
 	{
-		delete pSession;
+		discardSession(pSession);
 		throw;
 	}
 }
 
 
+void HTTPStreamFactory::discardSession(HTTPClientSession* pSession)
+{
+	if (pSession && _pSessionPool)
+		_pSessionPool->discard(pSession);
+	else
+		delete pSession;
+}
+
+
 void HTTPStreamFactory::registerFactory()
 {
 	URIStreamOpener::defaultOpener().registerStreamFactory("http", new HTTPStreamFactory);
 }
 
 
+void HTTPStreamFactory::registerFactory(HTTPClientSessionPool::Ptr pSessionPool)
+{
+	URIStreamOpener::defaultOpener().registerStreamFactory("http", new HTTPStreamFactory(pSessionPool));
+}
+
+
 void HTTPStreamFactory::unregisterFactory()
 {
 	URIStreamOpener::defaultOpener().unregisterStreamFactory("http");
@@ -103,6 +103,16 @@ HostEntry::HostEntry(const std::string& name, const IPAddress& addr):
 #endif // POCO_VXWORKS
 
 
+HostEntry::HostEntry(const std::string& name, const AddressList& addresses, const AliasList& aliases):
+	_name(name),
+	_aliases(aliases),
+	_addresses(addresses)
+{
+	removeDuplicates(_aliases);
+	removeDuplicates(_addresses);
+}
+
+
 HostEntry::HostEntry(const HostEntry& entry):
 	_name(entry._name),
 	_aliases(entry._aliases),
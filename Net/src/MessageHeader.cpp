@@ -21,12 +21,39 @@
 #include "Poco/Base64Decoder.h"
 #include "Poco/UTF8Encoding.h"
 #include <sstream>
+#include <algorithm>
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define POCO_MESSAGEHEADER_AVX2
+#endif
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define POCO_MESSAGEHEADER_SSE2
+#endif
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
 
 
 namespace Poco {
 namespace Net {
 
 
+namespace
+{
+	inline unsigned firstBitSet(unsigned mask)
+	{
+#if defined(_MSC_VER)
+		unsigned long index;
+		_BitScanForward(&index, mask);
+		return static_cast<unsigned>(index);
+#else
+		return static_cast<unsigned>(__builtin_ctz(mask));
+#endif
+	}
+}
+
+
 MessageHeader::MessageHeader():
 	_fieldLimit(DFL_FIELD_LIMIT),
 	_nameLengthLimit(DFL_NAME_LENGTH_LIMIT),
@@ -72,44 +99,122 @@ void MessageHeader::read(std::istream& istr)
 	static const int eof = std::char_traits<char>::eof();
 	std::streambuf& buf = *istr.rdbuf();
 
+	// field name, colon, leading white space, field value and CR
+	const std::size_t maxLineLength = static_cast<std::size_t>(_nameLengthLimit) + static_cast<std::size_t>(_valueLengthLimit) + MAX_LINE_SLACK;
+	Poco::Buffer<char> line(std::min<std::size_t>(maxLineLength + 1, LINE_BUFFER_SIZE));
 	std::string name;
 	std::string value;
-	name.reserve(32);
-	value.reserve(64);
-	int ch = buf.sbumpc();
 	int fields = 0;
+	int ch = buf.sgetc();
 	while (ch != eof && ch != '\r' && ch != '\n')
 	{
 		if (_fieldLimit > 0 && fields == _fieldLimit)
 			throw MessageException("Too many header fields");
-		name.clear();
-		value.clear();
-		while (ch != eof && ch != ':' && ch != '\n' && name.length() < _nameLengthLimit) { name += ch; ch = buf.sbumpc(); }
-		if (ch == '\n') { ch = buf.sbumpc(); continue; } // ignore invalid header lines
-		if (ch != ':') throw MessageException("Field name too long/no colon found");
-		if (ch != eof) ch = buf.sbumpc(); // ':'
-		while (ch != eof && Poco::Ascii::isSpace(ch) && ch != '\r' && ch != '\n') ch = buf.sbumpc();
-		while (ch != eof && ch != '\r' && ch != '\n' && value.length() < _valueLengthLimit) { value += ch; ch = buf.sbumpc(); }
-		if (ch == '\r') ch = buf.sbumpc();
-		if (ch == '\n')
-			ch = buf.sbumpc();
-		else if (ch != eof)
+		std::size_t length = readLine(istr, line, maxLineLength);
+		const char* begin = line.begin();
+		const char* end   = begin + length;
+		const char* it    = findFirstOf(begin, end, ':', ':');
+		if (it == end)
+		{
+			if (length > static_cast<std::size_t>(_nameLengthLimit) || istr.eof())
+				throw MessageException("Field name too long/no colon found");
+			ch = buf.sgetc();
+			continue; // ignore invalid header lines
+		}
+		if (it - begin > _nameLengthLimit) throw MessageException("Field name too long/no colon found");
+		name.assign(begin, it);
+		++it; // ':'
+		while (it != end && Poco::Ascii::isSpace(*it) && *it != '\r') ++it;
+		bool encoded = false;
+		const char* valueEnd = scanValue(it, end, encoded);
+		if ((valueEnd != end && valueEnd + 1 != end) || valueEnd - it > _valueLengthLimit)
 			throw MessageException("Field value too long/no CRLF found");
+		value.assign(it, valueEnd);
+		ch = buf.sgetc();
 		while (ch == ' ' || ch == '\t') // folding
 		{
-			while (ch != eof && ch != '\r' && ch != '\n' && value.length() < _valueLengthLimit) { value += ch; ch = buf.sbumpc(); }
-			if (ch == '\r') ch = buf.sbumpc();
-			if (ch == '\n')
-				ch = buf.sbumpc();
-			else if (ch != eof)
+			length   = readLine(istr, line, maxLineLength);
+			begin    = line.begin();
+			end      = begin + length;
+			valueEnd = scanValue(begin, end, encoded);
+			if ((valueEnd != end && valueEnd + 1 != end) || value.length() + (valueEnd - begin) > static_cast<std::size_t>(_valueLengthLimit))
 				throw MessageException("Folded field value too long/no CRLF found");
+			value.append(begin, valueEnd);
+			ch = buf.sgetc();
 		}
 		Poco::trimRightInPlace(value);
-		add(name, decodeWord(value));
+		if (encoded)
+			add(name, decodeWord(value));
+		else
+			add(name, value);
 		++fields;
 	}
-	if (istr.good() && ch != eof)
-		istr.putback(ch);
+	if (istr.eof()) istr.clear(istr.rdstate() & ~std::ios::eofbit);
+}
+
+
+std::size_t MessageHeader::readLine(std::istream& istr, Poco::Buffer<char>& line, std::size_t maxLength)
+{
+	std::size_t length = 0;
+	for (;;)
+	{
+		istr.getline(line.begin() + length, static_cast<std::streamsize>(line.size() - length));
+		std::size_t n = static_cast<std::size_t>(istr.gcount());
+		if (istr.eof())
+		{
+			return length + n;
+		}
+		else if (istr.fail())
+		{
+			// line does not fit into buffer
+			length += n;
+			if (line.size() > maxLength) throw MessageException("Header field too long/no CRLF found");
+			istr.clear();
+			line.resize(std::min(2*line.size(), maxLength + 1), true);
+		}
+		else return length + n - 1; // do not count the extracted '\n'
+	}
+}
+
+
+const char* MessageHeader::scanValue(const char* it, const char* end, bool& encoded)
+{
+	for (;;)
+	{
+		it = findFirstOf(it, end, '\r', '=');
+		if (it == end || *it == '\r') return it;
+		if (it + 1 != end && *(it + 1) == '?') encoded = true;
+		++it;
+	}
+}
+
+
+const char* MessageHeader::findFirstOf(const char* it, const char* end, char c1, char c2)
+{
+#if defined(POCO_MESSAGEHEADER_AVX2)
+	const __m256i v1 = _mm256_set1_epi8(c1);
+	const __m256i v2 = _mm256_set1_epi8(c2);
+	while (end - it >= 32)
+	{
+		__m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(it));
+		unsigned mask = static_cast<unsigned>(_mm256_movemask_epi8(_mm256_or_si256(_mm256_cmpeq_epi8(chunk, v1), _mm256_cmpeq_epi8(chunk, v2))));
+		if (mask) return it + firstBitSet(mask);
+		it += 32;
+	}
+#endif
+#if defined(POCO_MESSAGEHEADER_SSE2)
+	const __m128i w1 = _mm_set1_epi8(c1);
+	const __m128i w2 = _mm_set1_epi8(c2);
+	while (end - it >= 16)
+	{
+		__m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(it));
+		unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(chunk, w1), _mm_cmpeq_epi8(chunk, w2))));
+		if (mask) return it + firstBitSet(mask);
+		it += 16;
+	}
+#endif
+	while (it != end && *it != c1 && *it != c2) ++it;
+	return it;
 }
 
 
@@ -30,13 +30,15 @@ NameValueCollection::NameValueCollection()
 
 
 NameValueCollection::NameValueCollection(const NameValueCollection& nvc):
-	_map(nvc._map)
+	_entries(nvc._entries),
+	_hashes(nvc._hashes)
 {
 }
 
 
 NameValueCollection::NameValueCollection(NameValueCollection&& nvc) noexcept:
-	_map(std::move(nvc._map))
+	_entries(std::move(nvc._entries)),
+	_hashes(std::move(nvc._hashes))
 {
 }
 
@@ -57,7 +59,8 @@ NameValueCollection& NameValueCollection::operator = (const NameValueCollection&
 
 NameValueCollection& NameValueCollection::operator = (NameValueCollection&& nvc) noexcept
 {
-	_map = std::move(nvc._map);
+	_entries = std::move(nvc._entries);
+	_hashes = std::move(nvc._hashes);
 
 	return *this;
 }
@@ -65,15 +68,16 @@ NameValueCollection& NameValueCollection::operator = (NameValueCollection&& nvc)
 
 void NameValueCollection::swap(NameValueCollection& nvc) noexcept
 {
-	std::swap(_map, nvc._map);
+	std::swap(_entries, nvc._entries);
+	std::swap(_hashes, nvc._hashes);
 }
 
 
 const std::string& NameValueCollection::operator [] (const std::string& name) const
 {
-	ConstIterator it = _map.find(name);
-	if (it != _map.end())
-		return it->second;
+	std::size_t i = findIndex(name, hash(name));
+	if (i < _entries.size())
+		return _entries[i].second;
 	else
 		throw NotFoundException(name);
 }
@@ -81,25 +85,45 @@ const std::string& NameValueCollection::operator [] (const std::string& name) co
 
 void NameValueCollection::set(const std::string& name, const std::string& value)
 {
-	Iterator it = _map.find(name);
-	if (it != _map.end())
-		it->second = value;
+	Poco::UInt32 h = hash(name);
+	std::size_t i = findIndex(name, h);
+	if (i < _entries.size())
+	{
+		_entries[i].second = value;
+	}
 	else
-		_map.insert(HeaderMap::ValueType(name, value));
+	{
+		_entries.emplace_back(name, value);
+		_hashes.push_back(h);
+	}
 }
 
 
 void NameValueCollection::add(const std::string& name, const std::string& value)
 {
-	_map.insert(HeaderMap::ValueType(name, value));
+	Poco::UInt32 h = hash(name);
+	std::size_t i = findIndex(name, h);
+	if (i < _entries.size())
+	{
+		// keep pairs with the same name together
+		std::size_t n = _entries.size();
+		while (i < n && _hashes[i] == h && Poco::icompare(_entries[i].first, name) == 0) ++i;
+		_entries.insert(_entries.begin() + i, HeaderMap::ValueType(name, value));
+		_hashes.insert(_hashes.begin() + i, h);
+	}
+	else
+	{
+		_entries.emplace_back(name, value);
+		_hashes.push_back(h);
+	}
 }
 
 
 const std::string& NameValueCollection::get(const std::string& name) const
 {
-	ConstIterator it = _map.find(name);
-	if (it != _map.end())
-		return it->second;
+	std::size_t i = findIndex(name, hash(name));
+	if (i < _entries.size())
+		return _entries[i].second;
 	else
 		throw NotFoundException(name);
 }
@@ -107,9 +131,9 @@ const std::string& NameValueCollection::get(const std::string& name) const
 
 const std::string& NameValueCollection::get(const std::string& name, const std::string& defaultValue) const
 {
-	ConstIterator it = _map.find(name);
-	if (it != _map.end())
-		return it->second;
+	std::size_t i = findIndex(name, hash(name));
+	if (i < _entries.size())
+		return _entries[i].second;
 	else
 		return defaultValue;
 }
@@ -117,49 +141,94 @@ const std::string& NameValueCollection::get(const std::string& name, const std::
 
 bool NameValueCollection::has(const std::string& name) const
 {
-	return _map.find(name) != _map.end();
+	return findIndex(name, hash(name)) < _entries.size();
 }
 
 
 NameValueCollection::ConstIterator NameValueCollection::find(const std::string& name) const
 {
-	return _map.find(name);
+	return _entries.begin() + findIndex(name, hash(name));
 }
 
 
 NameValueCollection::ConstIterator NameValueCollection::begin() const
 {
-	return _map.begin();
+	return _entries.begin();
 }
 
 
 NameValueCollection::ConstIterator NameValueCollection::end() const
 {
-	return _map.end();
+	return _entries.end();
 }
 
 
 bool NameValueCollection::empty() const
 {
-	return _map.empty();
+	return _entries.empty();
 }
 
 
 std::size_t NameValueCollection::size() const
 {
-	return _map.size();
+	return _entries.size();
 }
 
 
 void NameValueCollection::erase(const std::string& name)
 {
-	_map.erase(name);
+	Poco::UInt32 h = hash(name);
+	std::size_t i = findIndex(name, h);
+	std::size_t n = i;
+	while (i < _entries.size())
+	{
+		if (_hashes[i] != h || Poco::icompare(_entries[i].first, name) != 0)
+		{
+			if (n != i)
+			{
+				_entries[n] = std::move(_entries[i]);
+				_hashes[n] = _hashes[i];
+			}
+			++n;
+		}
+		++i;
+	}
+	_entries.resize(n);
+	_hashes.resize(n);
 }
 
 
 void NameValueCollection::clear()
 {
-	_map.clear();
+	_entries.clear();
+	_hashes.clear();
+}
+
+
+Poco::UInt32 NameValueCollection::hash(const std::string& name)
+{
+	// FNV-1a over the name with ASCII letters folded to lower case.
+	// Folding maps some non-letters onto each other as well, which
+	// only causes a (harmless) false positive before the comparison.
+	Poco::UInt32 h = 2166136261U;
+	for (std::string::const_iterator it = name.begin(); it != name.end(); ++it)
+	{
+		h ^= static_cast<unsigned char>(*it) | 0x20;
+		h *= 16777619U;
+	}
+	return h;
+}
+
+
+std::size_t NameValueCollection::findIndex(const std::string& name, Poco::UInt32 hash) const
+{
+	const std::size_t n = _hashes.size();
+	for (std::size_t i = 0; i < n; ++i)
+	{
+		if (_hashes[i] == hash && _entries[i].first.size() == name.size() && Poco::icompare(_entries[i].first, name) == 0)
+			return i;
+	}
+	return n;
 }
 
 
@@ -0,0 +1,409 @@
+//
+// PerMessageDeflate.cpp
+//
+// Library: Net
+// Package: WebSocket
+// Module:  PerMessageDeflate
+//
+// Copyright (c) 2005-2023, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "Poco/Net/PerMessageDeflate.h"
+#include "Poco/Net/WebSocket.h"
+#include "Poco/Net/NetException.h"
+#include "Poco/Net/MessageHeader.h"
+#include "Poco/Net/NameValueCollection.h"
+#include "Poco/NumberFormatter.h"
+#include "Poco/NumberParser.h"
+#include "Poco/Exception.h"
+#include "Poco/String.h"
+#include <vector>
+#include <cstring>
+
+
+namespace Poco {
+namespace Net {
+
+
+namespace
+{
+	const char DEFLATE_TRAILER[] = {'\x00', '\x00', '\xff', '\xff'};
+
+	enum ExtensionParameter
+	{
+		SERVER_NO_CONTEXT_TAKEOVER = 1,
+		CLIENT_NO_CONTEXT_TAKEOVER = 2,
+		SERVER_MAX_WINDOW_BITS     = 4,
+		CLIENT_MAX_WINDOW_BITS     = 8
+	};
+
+	int parameterId(const std::string& name)
+	{
+		if (Poco::icompare(name, "server_no_context_takeover") == 0) return SERVER_NO_CONTEXT_TAKEOVER;
+		if (Poco::icompare(name, "client_no_context_takeover") == 0) return CLIENT_NO_CONTEXT_TAKEOVER;
+		if (Poco::icompare(name, "server_max_window_bits") == 0) return SERVER_MAX_WINDOW_BITS;
+		if (Poco::icompare(name, "client_max_window_bits") == 0) return CLIENT_MAX_WINDOW_BITS;
+		return 0;
+	}
+
+	void appendWindowBits(std::string& str, const char* name, int windowBits)
+	{
+		str += "; ";
+		str += name;
+		str += '=';
+		Poco::NumberFormatter::append(str, windowBits);
+	}
+}
+
+
+const std::string PerMessageDeflate::EXTENSION_NAME("permessage-deflate");
+
+
+PerMessageDeflate::Config::Config():
+	serverNoContextTakeover(false),
+	clientNoContextTakeover(false),
+	serverMaxWindowBits(MAX_WINDOW_BITS),
+	clientMaxWindowBits(MAX_WINDOW_BITS),
+	compressionLevel(Z_DEFAULT_COMPRESSION),
+	memLevel(8),
+	minMessageSize(0),
+	maxMemory(0)
+{
+}
+
+
+PerMessageDeflate::Parameters::Parameters():
+	serverNoContextTakeover(false),
+	clientNoContextTakeover(false),
+	serverMaxWindowBits(MAX_WINDOW_BITS),
+	clientMaxWindowBits(MAX_WINDOW_BITS)
+{
+}
+
+
+PerMessageDeflate::PerMessageDeflate(const Parameters& params, const Config& config, bool server):
+	_params(params),
+	_minMessageSize(config.minMessageSize),
+	_deflateReset(server ? params.serverNoContextTakeover : params.clientNoContextTakeover),
+	_inflateReset(server ? params.clientNoContextTakeover : params.serverNoContextTakeover),
+	_deflateWindowBits(server ? params.serverMaxWindowBits : params.clientMaxWindowBits),
+	_deflateMemLevel(config.memLevel),
+	_inflateWindowBits(server ? params.clientMaxWindowBits : params.serverMaxWindowBits)
+{
+	// our own compressor may always use a smaller window than negotiated
+	int ownWindowBits = server ? config.serverMaxWindowBits : config.clientMaxWindowBits;
+	if (ownWindowBits < _deflateWindowBits) _deflateWindowBits = ownWindowBits;
+	if (_deflateWindowBits < MIN_WINDOW_BITS) _deflateWindowBits = MIN_WINDOW_BITS;
+	if (_deflateWindowBits > MAX_WINDOW_BITS) _deflateWindowBits = MAX_WINDOW_BITS;
+	if (_inflateWindowBits < MIN_WINDOW_BITS) _inflateWindowBits = MIN_WINDOW_BITS;
+	if (_inflateWindowBits > MAX_WINDOW_BITS) _inflateWindowBits = MAX_WINDOW_BITS;
+	if (_deflateMemLevel < 1) _deflateMemLevel = 1;
+	if (_deflateMemLevel > MAX_MEM_LEVEL) _deflateMemLevel = MAX_MEM_LEVEL;
+
+	if (config.maxMemory > 0)
+	{
+		while (memoryUsage() > config.maxMemory && (_deflateWindowBits > MIN_WINDOW_BITS || _deflateMemLevel > 1))
+		{
+			if (_deflateWindowBits > MIN_WINDOW_BITS && _deflateWindowBits + 2 >= _deflateMemLevel + 9)
+				--_deflateWindowBits;
+			else
+				--_deflateMemLevel;
+		}
+	}
+
+	std::memset(&_deflate, 0, sizeof(_deflate));
+	std::memset(&_inflate, 0, sizeof(_inflate));
+	int rc = deflateInit2(&_deflate, config.compressionLevel, Z_DEFLATED, -_deflateWindowBits, _deflateMemLevel, Z_DEFAULT_STRATEGY);
+	if (rc != Z_OK) throw Poco::IOException(zError(rc));
+	rc = inflateInit2(&_inflate, -_inflateWindowBits);
+	if (rc != Z_OK)
+	{
+		deflateEnd(&_deflate);
+		throw Poco::IOException(zError(rc));
+	}
+}
+
+
+PerMessageDeflate::~PerMessageDeflate()
+{
+	deflateEnd(&_deflate);
+	inflateEnd(&_inflate);
+}
+
+
+void PerMessageDeflate::compress(const char* data, std::size_t length, bool fin, Poco::Buffer<char>& out)
+{
+	std::size_t produced = 0;
+	std::size_t capacity = length + length/8 + 64;
+	if (out.capacity() < capacity) out.setCapacity(capacity, false);
+	out.resize(out.capacity(), false);
+
+	_deflate.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data));
+	_deflate.avail_in = static_cast<uInt>(length);
+	do
+	{
+		if (produced == out.size()) out.resize(2*out.size(), true);
+		_deflate.next_out = reinterpret_cast<Bytef*>(out.begin() + produced);
+		_deflate.avail_out = static_cast<uInt>(out.size() - produced);
+		int rc = deflate(&_deflate, Z_SYNC_FLUSH);
+		if (rc != Z_OK && rc != Z_BUF_ERROR) throw Poco::IOException(zError(rc));
+		produced = out.size() - _deflate.avail_out;
+	}
+	while (_deflate.avail_out == 0);
+
+	if (fin)
+	{
+		// the trailing empty stored block of the final
+		// flush is not transmitted (RFC 7692, 7.2.1)
+		if (produced >= 4 && std::memcmp(out.begin() + produced - 4, DEFLATE_TRAILER, 4) == 0)
+			produced -= 4;
+		if (produced == 0)
+			out[produced++] = 0;
+		if (_deflateReset) deflateReset(&_deflate);
+	}
+	out.resize(produced, true);
+}
+
+
+void PerMessageDeflate::decompress(const char* data, std::size_t length, bool fin, Poco::Buffer<char>& out, std::size_t maxLength)
+{
+	std::size_t size = out.size();
+	std::size_t increment = 2*length + 1024;
+	for (int pass = fin ? 2 : 1; pass > 0; --pass)
+	{
+		if (pass == 1 && fin)
+		{
+			data = DEFLATE_TRAILER;
+			length = sizeof(DEFLATE_TRAILER);
+		}
+		_inflate.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data));
+		_inflate.avail_in = static_cast<uInt>(length);
+		for (;;)
+		{
+			if (size == out.size())
+			{
+				if (size > maxLength) throw WebSocketException("Payload too big", WebSocket::WS_ERR_PAYLOAD_TOO_BIG);
+				std::size_t newSize = size + increment;
+				if (newSize > maxLength + 1) newSize = maxLength + 1;
+				out.resize(newSize, true);
+				increment *= 2;
+			}
+			_inflate.next_out = reinterpret_cast<Bytef*>(out.begin() + size);
+			_inflate.avail_out = static_cast<uInt>(out.size() - size);
+			int rc = inflate(&_inflate, Z_SYNC_FLUSH);
+			size = out.size() - _inflate.avail_out;
+			if (rc == Z_STREAM_END)
+			{
+				// the peer has finished the stream with a final block;
+				// any further data starts a new stream.
+				inflateReset(&_inflate);
+			}
+			else if (rc != Z_OK && rc != Z_BUF_ERROR)
+			{
+				out.resize(size, true);
+				throw WebSocketException("Invalid compressed payload received", WebSocket::WS_ERR_COMPRESSION);
+			}
+			if (size > maxLength) throw WebSocketException("Payload too big", WebSocket::WS_ERR_PAYLOAD_TOO_BIG);
+			if (_inflate.avail_in == 0 && _inflate.avail_out > 0) break;
+		}
+	}
+	out.resize(size, true);
+	if (fin && _inflateReset) inflateReset(&_inflate);
+}
+
+
+std::size_t PerMessageDeflate::memoryUsage() const
+{
+	return deflateMemory(_deflateWindowBits, _deflateMemLevel) + inflateMemory(_inflateWindowBits);
+}
+
+
+std::string PerMessageDeflate::offer(const Config& config)
+{
+	std::string result(EXTENSION_NAME);
+	if (config.serverNoContextTakeover)
+		result += "; server_no_context_takeover";
+	if (config.clientNoContextTakeover)
+		result += "; client_no_context_takeover";
+	int serverWindowBits = offeredServerWindowBits(config);
+	if (serverWindowBits < MAX_WINDOW_BITS)
+		appendWindowBits(result, "server_max_window_bits", serverWindowBits);
+	if (config.clientMaxWindowBits < MAX_WINDOW_BITS)
+		appendWindowBits(result, "client_max_window_bits", config.clientMaxWindowBits);
+	else
+		result += "; client_max_window_bits";
+	return result;
+}
+
+
+bool PerMessageDeflate::accept(const std::string& offers, const Config& config, Parameters& params, std::string& response)
+{
+	std::vector<std::string> elements;
+	MessageHeader::splitElements(offers, elements);
+	for (const auto& element: elements)
+	{
+		std::string name;
+		NameValueCollection offer;
+		MessageHeader::splitParameters(element, name, offer);
+		if (Poco::icompare(name, EXTENSION_NAME) != 0) continue;
+
+		Parameters p;
+		p.serverMaxWindowBits = config.serverMaxWindowBits;
+		int clientWindowBits = MAX_WINDOW_BITS;
+		int present = 0;
+		bool valid = true;
+		for (NameValueCollection::ConstIterator it = offer.begin(); valid && it != offer.end(); ++it)
+		{
+			int id = parameterId(it->first);
+			valid = id != 0 && (present & id) == 0;
+			present |= id;
+			switch (id)
+			{
+			case SERVER_NO_CONTEXT_TAKEOVER:
+			case CLIENT_NO_CONTEXT_TAKEOVER:
+				valid = valid && it->second.empty();
+				break;
+			case SERVER_MAX_WINDOW_BITS:
+				valid = valid && parseWindowBits(it->second, p.serverMaxWindowBits);
+				break;
+			case CLIENT_MAX_WINDOW_BITS:
+				valid = valid && (it->second.empty() || parseWindowBits(it->second, clientWindowBits));
+				break;
+			}
+		}
+		// we cannot compress with a 256 byte window
+		if (!valid || p.serverMaxWindowBits < MIN_WINDOW_BITS) continue;
+
+		if (p.serverMaxWindowBits > config.serverMaxWindowBits)
+			p.serverMaxWindowBits = config.serverMaxWindowBits;
+		p.serverNoContextTakeover = (present & SERVER_NO_CONTEXT_TAKEOVER) != 0 || config.serverNoContextTakeover;
+		p.clientNoContextTakeover = (present & CLIENT_NO_CONTEXT_TAKEOVER) != 0 || config.clientNoContextTakeover;
+
+		// the client's window can only be limited if the client
+		// has offered the client_max_window_bits parameter.
+		if (present & CLIENT_MAX_WINDOW_BITS)
+		{
+			p.clientMaxWindowBits = clientWindowBits < config.clientMaxWindowBits ? clientWindowBits : config.clientMaxWindowBits;
+			if (p.clientMaxWindowBits < MIN_WINDOW_BITS) p.clientMaxWindowBits = MIN_WINDOW_BITS;
+		}
+		if (config.maxMemory > 0)
+		{
+			if (present & CLIENT_MAX_WINDOW_BITS)
+			{
+				while (p.clientMaxWindowBits > MIN_WINDOW_BITS && deflateMemory(MIN_WINDOW_BITS, 1) + inflateMemory(p.clientMaxWindowBits) > config.maxMemory)
+					--p.clientMaxWindowBits;
+			}
+			if (deflateMemory(MIN_WINDOW_BITS, 1) + inflateMemory(p.clientMaxWindowBits) > config.maxMemory) continue;
+		}
+
+		response = EXTENSION_NAME;
+		if (present & SERVER_NO_CONTEXT_TAKEOVER)
+			response += "; server_no_context_takeover";
+		if (p.clientNoContextTakeover)
+			response += "; client_no_context_takeover";
+		if (present & SERVER_MAX_WINDOW_BITS)
+			appendWindowBits(response, "server_max_window_bits", p.serverMaxWindowBits);
+		if ((present & CLIENT_MAX_WINDOW_BITS) && p.clientMaxWindowBits < clientWindowBits)
+			appendWindowBits(response, "client_max_window_bits", p.clientMaxWindowBits);
+		params = p;
+		return true;
+	}
+	return false;
+}
+
+
+void PerMessageDeflate::confirm(const std::string& response, const Config& config, Parameters& params)
+{
+	std::vector<std::string> elements;
+	MessageHeader::splitElements(response, elements);
+	if (elements.size() != 1)
+		throw WebSocketException("Unexpected extensions in handshake response", response, WebSocket::WS_ERR_HANDSHAKE_EXTENSION);
+
+	std::string name;
+	NameValueCollection parameters;
+	MessageHeader::splitParameters(elements[0], name, parameters);
+	if (Poco::icompare(name, EXTENSION_NAME) != 0)
+		throw WebSocketException("Unexpected extension in handshake response", name, WebSocket::WS_ERR_HANDSHAKE_EXTENSION);
+
+	const int serverWindowBits = offeredServerWindowBits(config);
+	Parameters p;
+	p.clientMaxWindowBits = config.clientMaxWindowBits;
+	int present = 0;
+	for (NameValueCollection::ConstIterator it = parameters.begin(); it != parameters.end(); ++it)
+	{
+		int id = parameterId(it->first);
+		bool valid = id != 0 && (present & id) == 0;
+		present |= id;
+		int windowBits = MAX_WINDOW_BITS;
+		switch (id)
+		{
+		case SERVER_NO_CONTEXT_TAKEOVER:
+			valid = valid && it->second.empty();
+			p.serverNoContextTakeover = true;
+			break;
+		case CLIENT_NO_CONTEXT_TAKEOVER:
+			valid = valid && it->second.empty();
+			p.clientNoContextTakeover = true;
+			break;
+		case SERVER_MAX_WINDOW_BITS:
+			valid = valid && parseWindowBits(it->second, windowBits) && windowBits <= serverWindowBits;
+			p.serverMaxWindowBits = windowBits;
+			break;
+		case CLIENT_MAX_WINDOW_BITS:
+			valid = valid && parseWindowBits(it->second, windowBits) && windowBits >= MIN_WINDOW_BITS;
+			if (windowBits < p.clientMaxWindowBits) p.clientMaxWindowBits = windowBits;
+			break;
+		}
+		if (!valid)
+			throw WebSocketException("Invalid permessage-deflate parameter in handshake response", it->first, WebSocket::WS_ERR_HANDSHAKE_EXTENSION);
+	}
+	if (serverWindowBits < MAX_WINDOW_BITS && (present & SERVER_MAX_WINDOW_BITS) == 0)
+		throw WebSocketException("Missing server_max_window_bits in handshake response", WebSocket::WS_ERR_HANDSHAKE_EXTENSION);
+	if (config.clientNoContextTakeover)
+		p.clientNoContextTakeover = true;
+	params = p;
+}
+
+
+int PerMessageDeflate::offeredServerWindowBits(const Config& config)
+{
+	// our decompressor's window is limited by the server's window
+	int windowBits = config.serverMaxWindowBits;
+	if (config.maxMemory > 0)
+	{
+		while (windowBits > MIN_WINDOW_BITS && deflateMemory(MIN_WINDOW_BITS, 1) + inflateMemory(windowBits) > config.maxMemory)
+			--windowBits;
+	}
+	return windowBits;
+}
+
+
+std::size_t PerMessageDeflate::deflateMemory(int windowBits, int memLevel)
+{
+	// see zconf.h
+	return (std::size_t(1) << (windowBits + 2)) + (std::size_t(1) << (memLevel + 9));
+}
+
+
+std::size_t PerMessageDeflate::inflateMemory(int windowBits)
+{
+	// see zconf.h
+	return (std::size_t(1) << windowBits) + 7*1024;
+}
+
+
+bool PerMessageDeflate::parseWindowBits(const std::string& value, int& windowBits)
+{
+	int bits;
+	if (value.empty() || value.size() > 2 || !Poco::NumberParser::tryParse(value, bits)) return false;
+	if (bits < 8 || bits > MAX_WINDOW_BITS) return false;
+	windowBits = bits;
+	return true;
+}
+
+
+} } // namespace Poco::Net
@@ -15,6 +15,7 @@
 #include "Poco/Net/PollSet.h"
 #include "Poco/Net/SocketImpl.h"
 #include "Poco/Mutex.h"
+#include "Poco/Exception.h"
 #include <set>
 
 
@@ -65,7 +66,7 @@ class PollSetImpl
 public:
 	using Mutex = std::mutex;
 	using ScopedLock = std::lock_guard<Mutex>;
-	using SocketMode = std::pair<Socket, int>;
+	using SocketMode = PollSet::SocketMode;
 	using SocketMap = std::map<void*, SocketMode>;
 
 	PollSetImpl(): _events(1024),
@@ -97,19 +98,50 @@ public:
 
 	void add(const Socket& socket, int mode)
 	{
-		int newMode = getNewMode(socket.impl(), mode);
-		int err = addImpl(socket, newMode);
+		SocketImpl* sockImpl = socket.impl();
+		int fd = static_cast<int>(sockImpl->sockfd());
+		ScopedLock lock(_mutex);
+		auto res = _socketMap.insert(SocketMap::value_type(sockImpl, SocketMode(socket, 0)));
+		SocketMode& sm = res.first->second;
+		int newMode = sm.second | mode;
+		checkOptions(newMode);
+		int err = ctlFD(fd, newMode, res.second, sm);
 		if (err)
 		{
-			if (errno == EEXIST) update(socket, newMode);
-			else SocketImpl::error();
+			int lastErr = SocketImpl::lastError();
+			if (res.second) _socketMap.erase(res.first);
+			SocketImpl::error(lastErr);
 		}
+		sm.second = newMode;
 	}
 
 	void update(const Socket& socket, int mode)
 	{
-		int err = updateImpl(socket, mode);
-		if (err) SocketImpl::error();
+		SocketImpl* sockImpl = socket.impl();
+		int fd = static_cast<int>(sockImpl->sockfd());
+		checkOptions(mode);
+		ScopedLock lock(_mutex);
+		auto res = _socketMap.insert(SocketMap::value_type(sockImpl, SocketMode(socket, 0)));
+		SocketMode& sm = res.first->second;
+		int err = ctlFD(fd, mode, res.second, sm);
+		if (err)
+		{
+			int lastErr = SocketImpl::lastError();
+			if (res.second) _socketMap.erase(res.first);
+			SocketImpl::error(lastErr);
+		}
+		sm.second = mode;
+	}
+
+	void rearm(const Socket& socket)
+	{
+		SocketImpl* sockImpl = socket.impl();
+		ScopedLock lock(_mutex);
+		auto it = _socketMap.find(sockImpl);
+		if (it == _socketMap.end() || !(it->second.second & PollSet::POLL_ONESHOT)) return;
+		int err = addFD(static_cast<int>(sockImpl->sockfd()), it->second.second, EPOLL_CTL_MOD, &it->second);
+		// the socket may have been closed or concurrently removed
+		if (err && errno != ENOENT && errno != EBADF) SocketImpl::error();
 	}
 
 	void remove(const Socket& socket)
@@ -163,56 +195,46 @@ public:
 		addFD(_eventfd, PollSet::POLL_READ, EPOLL_CTL_ADD);
 	}
 
-	PollSet::SocketModeMap poll(const Poco::Timespan& timeout)
+	int poll(const Poco::Timespan& timeout, PollSet::SocketModeList& result)
 	{
-		PollSet::SocketModeMap result;
+		result.clear();
 		Poco::Timespan remainingTime(timeout);
 		int rc;
 
 		ScopedLock lock(_mutex);
-		do
+		while (true)
 		{
 			Poco::Timestamp start;
 			rc = epoll_wait(_epollfd, &_events[0],
 				static_cast<int>(_events.size()), static_cast<int>(remainingTime.totalMilliseconds()));
-			if (rc == 0) return result;
-
-			// if we are hitting the events limit, resize it; even without resizing, the subseqent
-			// calls would round-robin through the remaining ready sockets, but it's better to give
-			// the call enough room once we start hitting the boundary
-			if (rc >= _events.size()) _events.resize(_events.size()*2);
-			else if (rc < 0)
-			{
-				// if interrupted and there's still time left, keep waiting
-				if (SocketImpl::lastError() == POCO_EINTR)
-				{
-					Poco::Timestamp end;
-					Poco::Timespan waited = end - start;
-					if (waited < remainingTime)
-					{
-						remainingTime -= waited;
-						continue;
-					}
-				}
-				else SocketImpl::error();
-			}
+			if (rc >= 0) break;
+
+			// if interrupted and there's still time left, keep waiting
+			if (SocketImpl::lastError() != POCO_EINTR) SocketImpl::error();
+			Poco::Timestamp end;
+			Poco::Timespan waited = end - start;
+			if (waited >= remainingTime) return 0;
+			remainingTime -= waited;
 		}
-		while (false);
+		if (rc == 0) return 0;
 
+		result.reserve(rc);
 		for (int i = 0; i < rc; i++)
 		{
-			if (_events[i].data.ptr) // skip eventfd
+			// data.ptr points directly to the SocketMap entry, which is
+			// guaranteed to be alive, as it can only be erased while holding
+			// the mutex; null identifies the eventfd
+			SocketMode* pSocketMode = static_cast<SocketMode*>(_events[i].data.ptr);
+			if (pSocketMode)
 			{
-				SocketMap::iterator it = _socketMap.find(_events[i].data.ptr);
-				if (it != _socketMap.end())
-				{
-					if (_events[i].events & EPOLLIN)
-						result[it->second.first] |= PollSet::POLL_READ;
-					if (_events[i].events & EPOLLOUT)
-						result[it->second.first] |= PollSet::POLL_WRITE;
-					if (_events[i].events & EPOLLERR)
-						result[it->second.first] |= PollSet::POLL_ERROR;
-				}
+				int mode = 0;
+				if (_events[i].events & EPOLLIN)
+					mode |= PollSet::POLL_READ;
+				if (_events[i].events & EPOLLOUT)
+					mode |= PollSet::POLL_WRITE;
+				if (_events[i].events & EPOLLERR)
+					mode |= PollSet::POLL_ERROR;
+				if (mode) result.emplace_back(pSocketMode->first, mode);
 			}
 			else if (_events[i].events & EPOLLIN) // eventfd signaled
 			{
@@ -225,7 +247,13 @@ public:
 #endif
 			}
 		}
-		return result;
+
+		// if we are hitting the events limit, resize it; even without resizing, the subseqent
+		// calls would round-robin through the remaining ready sockets, but it's better to give
+		// the call enough room once we start hitting the boundary
+		if (rc >= static_cast<int>(_events.size())) _events.resize(_events.size()*2);
+
+		return static_cast<int>(result.size());
 	}
 
 	void wakeUp()
@@ -248,37 +276,27 @@ public:
 	}
 
 private:
-	int getNewMode(SocketImpl* sockImpl, int mode)
+	static void checkOptions(int mode)
 	{
-		ScopedLock lock(_mutex);
-		auto it = _socketMap.find(sockImpl);
-		if (it != _socketMap.end())
-			mode |= it->second.second;
-		return mode;
+		if ((mode & PollSet::POLL_EXCLUSIVE) && (mode & PollSet::POLL_ONESHOT))
+			throw Poco::InvalidArgumentException("PollSet: POLL_EXCLUSIVE cannot be combined with POLL_ONESHOT");
 	}
 
-	void socketMapUpdate(const Socket& socket, int mode)
+	int ctlFD(int fd, int mode, bool isNew, SocketMode& sm)
+		/// Registers a new socket, or modifies the registration of an
+		/// existing one. EPOLLEXCLUSIVE can only be given to EPOLL_CTL_ADD,
+		/// so exclusive sockets are re-registered instead of modified.
 	{
-		SocketImpl* sockImpl = socket.impl();
-		ScopedLock lock(_mutex);
-		_socketMap[sockImpl] = {socket, mode};
-	}
-
-	int updateImpl(const Socket& socket, int mode)
-	{
-		SocketImpl* sockImpl = socket.impl();
-		int ret = addFD(static_cast<int>(sockImpl->sockfd()), mode, EPOLL_CTL_MOD, sockImpl);
-		if (ret == 0) socketMapUpdate(socket, mode);
-		return ret;
-	}
-
-	int addImpl(const Socket& socket, int mode)
-	{
-		SocketImpl* sockImpl = socket.impl();
-		int newMode = getNewMode(sockImpl, mode);
-		int ret = addFD(static_cast<int>(sockImpl->sockfd()), newMode, EPOLL_CTL_ADD, sockImpl);
-		if (ret == 0) socketMapUpdate(socket, newMode);
-		return ret;
+		if (!isNew && ((mode | sm.second) & PollSet::POLL_EXCLUSIVE))
+		{
+			struct epoll_event ev{};
+			epoll_ctl(_epollfd, EPOLL_CTL_DEL, fd, &ev);
+			return addFD(fd, mode, EPOLL_CTL_ADD, &sm);
+		}
+		int err = addFD(fd, mode, isNew ? EPOLL_CTL_ADD : EPOLL_CTL_MOD, &sm);
+		if (err && isNew && errno == EEXIST)
+			err = addFD(fd, mode, EPOLL_CTL_MOD, &sm);
+		return err;
 	}
 
 	int addFD(int fd, int mode, int op, void* ptr = 0)
@@ -291,6 +309,18 @@ private:
 			ev.events |= EPOLLOUT;
 		if (mode & PollSet::POLL_ERROR)
 			ev.events |= EPOLLERR;
+#ifdef EPOLLET
+		if (mode & PollSet::POLL_EDGE)
+			ev.events |= EPOLLET;
+#endif
+#ifdef EPOLLONESHOT
+		if (mode & PollSet::POLL_ONESHOT)
+			ev.events |= EPOLLONESHOT;
+#endif
+#ifdef EPOLLEXCLUSIVE
+		if ((mode & PollSet::POLL_EXCLUSIVE) && op == EPOLL_CTL_ADD)
+			ev.events |= EPOLLEXCLUSIVE;
+#endif
 		ev.data.ptr = ptr;
 		return epoll_ctl(_epollfd, op, fd, &ev);
 	}
@@ -398,6 +428,10 @@ public:
 		}
 	}
 
+	void rearm(const Socket&)
+	{
+	}
+
 	void clear()
 	{
 		std::lock_guard<std::mutex> lock(_mutex);
@@ -408,9 +442,9 @@ public:
 		_pollfds.reserve(1);
 	}
 
-	PollSet::SocketModeMap poll(const Poco::Timespan& timeout)
+	int poll(const Poco::Timespan& timeout, PollSet::SocketModeList& result)
 	{
-		PollSet::SocketModeMap result;
+		result.clear();
 		{
 			std::lock_guard<std::mutex> lock(_mutex);
 
@@ -440,7 +474,7 @@ public:
 			_addMap.clear();
 		}
 
-		if (_pollfds.empty()) return result;
+		if (_pollfds.empty()) return 0;
 
 		Poco::Timespan remainingTime(timeout);
 		int rc;
@@ -474,22 +508,25 @@ public:
 			{
 				for (auto it = _pollfds.begin() + 1; it != _pollfds.end(); ++it)
 				{
+					if (!it->revents) continue;
 					std::map<poco_socket_t, Socket>::const_iterator its = _socketMap.find(it->fd);
 					if (its != _socketMap.end())
 					{
+						int mode = 0;
 						if (it->revents & POLLIN)
-							result[its->second] |= PollSet::POLL_READ;
+							mode |= PollSet::POLL_READ;
 						if (it->revents & POLLOUT)
-							result[its->second] |= PollSet::POLL_WRITE;
+							mode |= PollSet::POLL_WRITE;
 						if (it->revents & POLLERR || (it->revents & POLLHUP))
-							result[its->second] |= PollSet::POLL_ERROR;
+							mode |= PollSet::POLL_ERROR;
+						if (mode) result.emplace_back(its->second, mode);
 					}
 					it->revents = 0;
 				}
 			}
 		}
 
-		return result;
+		return static_cast<int>(result.size());
 	}
 
 	void wakeUp()
@@ -563,14 +600,19 @@ public:
 		_map[socket] = mode;
 	}
 
+	void rearm(const Socket&)
+	{
+	}
+
 	void clear()
 	{
 		std::lock_guard<std::mutex> lock(_mutex);
 		_map.clear();
 	}
 
-	PollSet::SocketModeMap poll(const Poco::Timespan& timeout)
+	int poll(const Poco::Timespan& timeout, PollSet::SocketModeList& result)
 	{
+		result.clear();
 		fd_set fdRead;
 		fd_set fdWrite;
 		fd_set fdExcept;
@@ -606,8 +648,7 @@ public:
 			}
 		}
 
-		PollSet::SocketModeMap result;
-		if (nfd == 0) return result;
+		if (nfd == 0) return 0;
 
 		Poco::Timespan remainingTime(timeout);
 		int rc;
@@ -639,23 +680,25 @@ public:
 				poco_socket_t fd = it->first.impl()->sockfd();
 				if (fd != POCO_INVALID_SOCKET)
 				{
+					int mode = 0;
 					if (FD_ISSET(fd, &fdRead))
 					{
-						result[it->first] |= PollSet::POLL_READ;
+						mode |= PollSet::POLL_READ;
 					}
 					if (FD_ISSET(fd, &fdWrite))
 					{
-						result[it->first] |= PollSet::POLL_WRITE;
+						mode |= PollSet::POLL_WRITE;
 					}
 					if (FD_ISSET(fd, &fdExcept))
 					{
-						result[it->first] |= PollSet::POLL_ERROR;
+						mode |= PollSet::POLL_ERROR;
 					}
+					if (mode) result.emplace_back(it->first, mode);
 				}
 			}
 		}
 
-		return result;
+		return static_cast<int>(result.size());
 	}
 
 	void wakeUp()
@@ -708,6 +751,12 @@ void PollSet::update(const Socket& socket, int mode)
 }
 
 
+void PollSet::rearm(const Socket& socket)
+{
+	_pImpl->rearm(socket);
+}
+
+
 bool PollSet::has(const Socket& socket) const
 {
 	return _pImpl->has(socket);
@@ -728,7 +777,17 @@ void PollSet::clear()
 
 PollSet::SocketModeMap PollSet::poll(const Poco::Timespan& timeout)
 {
-	return _pImpl->poll(timeout);
+	SocketModeList sl;
+	_pImpl->poll(timeout, sl);
+	SocketModeMap result;
+	for (const auto& sm: sl) result[sm.first] |= sm.second;
+	return result;
+}
+
+
+int PollSet::poll(const Poco::Timespan& timeout, SocketModeList& result)
+{
+	return _pImpl->poll(timeout, result);
 }
 
 
@@ -17,6 +17,8 @@
 #include "Poco/Net/StreamSocketImpl.h"
 #include "Poco/NumberFormatter.h"
 #include "Poco/Timestamp.h"
+#include "Poco/FileStream.h"
+#include <algorithm>
 #include <string.h> // FD_SET needs memset on some platforms, so we can't use <cstring>
 
 
@@ -34,6 +36,28 @@
 #endif
 
 
+#if POCO_OS == POCO_OS_LINUX || POCO_OS == POCO_OS_ANDROID
+#include <sys/sendfile.h>
+#endif
+
+
+#if POCO_OS == POCO_OS_LINUX && defined(MSG_WAITFORONE)
+#define POCO_HAVE_MMSG 1
+#endif
+
+
+#if POCO_OS == POCO_OS_LINUX
+#include <netinet/udp.h>
+#ifndef UDP_SEGMENT
+#define UDP_SEGMENT 103
+#endif
+#ifndef UDP_GRO
+#define UDP_GRO 104
+#endif
+#define POCO_HAVE_UDP_OFFLOAD 1
+#endif
+
+
 #if defined(sun) || defined(__sun) || defined(__sun__)
 #include <unistd.h>
 #include <stropts.h>
@@ -370,6 +394,62 @@ int SocketImpl::sendBytes(const SocketBufVec& buffers, int flags)
 }
 
 
+std::streamsize SocketImpl::sendFile(FileInputStream& fileInputStream, std::streamoff offset, std::streamsize count)
+{
+	if (count == 0)
+	{
+		Poco::UInt64 size = fileInputStream.size();
+		if (static_cast<Poco::UInt64>(offset) >= size) return 0;
+		count = static_cast<std::streamsize>(size - offset);
+	}
+
+	std::streamsize sent = 0;
+#if POCO_OS == POCO_OS_LINUX || POCO_OS == POCO_OS_ANDROID
+	if (!secure())
+	{
+		checkBrokenTimeout(SELECT_WRITE);
+
+		off_t off = static_cast<off_t>(offset);
+		while (sent < count)
+		{
+			if (_sockfd == POCO_INVALID_SOCKET) throw InvalidSocketException();
+			ssize_t rc = ::sendfile(_sockfd, fileInputStream.nativeHandle(), &off, static_cast<std::size_t>(count - sent));
+			if (rc < 0)
+			{
+				int err = lastError();
+				if (err == POCO_EINTR && _blocking) continue;
+				if (err == POCO_EAGAIN && !_blocking) break;
+				error(err);
+			}
+			else if (rc == 0) break;
+			sent += rc;
+		}
+		return sent;
+	}
+#endif
+
+	const std::streamsize BUFFER_SIZE = 65536;
+	Poco::Buffer<char> buffer(static_cast<std::size_t>(std::min(count, BUFFER_SIZE)));
+	fileInputStream.clear();
+	fileInputStream.seekg(offset, std::ios::beg);
+	while (sent < count)
+	{
+		fileInputStream.read(buffer.begin(), std::min(count - sent, static_cast<std::streamsize>(buffer.size())));
+		std::streamsize n = fileInputStream.gcount();
+		if (n <= 0) break;
+		std::streamsize pos = 0;
+		while (pos < n)
+		{
+			int rc = sendBytes(buffer.begin() + pos, static_cast<int>(n - pos));
+			if (rc <= 0) return sent + pos;
+			pos += rc;
+		}
+		sent += n;
+	}
+	return sent;
+}
+
+
 int SocketImpl::receiveBytes(void* buffer, int length, int flags)
 {
 	checkBrokenTimeout(SELECT_READ);
@@ -605,6 +685,269 @@ int SocketImpl::receiveFrom(SocketBufVec& buffers, struct sockaddr** pSA, poco_s
 }
 
 
+int SocketImpl::receiveBatch(SocketMsgVec& messages, int flags)
+{
+	if (messages.empty()) return 0;
+	checkBrokenTimeout(SELECT_READ);
+	int received = 0;
+#if defined(POCO_HAVE_MMSG)
+	const std::size_t CHUNK_SIZE = 64;
+	struct mmsghdr hdrs[CHUNK_SIZE];
+	struct iovec iovs[CHUNK_SIZE];
+	while (received < static_cast<int>(messages.size()))
+	{
+		std::size_t n = std::min(messages.size() - received, CHUNK_SIZE);
+		for (std::size_t i = 0; i < n; ++i)
+		{
+			SocketMsg& msg = messages[received + i];
+			iovs[i].iov_base = msg.buffer;
+			iovs[i].iov_len = msg.capacity;
+			memset(&hdrs[i], 0, sizeof(hdrs[i]));
+			hdrs[i].msg_hdr.msg_name = msg.pAddress;
+			hdrs[i].msg_hdr.msg_namelen = msg.pAddress ? msg.addressLength : 0;
+			hdrs[i].msg_hdr.msg_iov = &iovs[i];
+			hdrs[i].msg_hdr.msg_iovlen = 1;
+		}
+		// only the first chunk may block, and only until the first datagram arrives
+		int chunkFlags = flags | (received == 0 ? MSG_WAITFORONE : MSG_DONTWAIT);
+		int rc;
+		do
+		{
+			if (_sockfd == POCO_INVALID_SOCKET) throw InvalidSocketException();
+			rc = ::recvmmsg(_sockfd, hdrs, static_cast<unsigned>(n), chunkFlags, 0);
+		}
+		while (_blocking && rc < 0 && lastError() == POCO_EINTR);
+		if (rc < 0)
+		{
+			if (received > 0) break;
+			int err = lastError();
+			if (err == POCO_EAGAIN && !_blocking)
+				;
+			else if (err == POCO_EAGAIN || err == POCO_ETIMEDOUT)
+				throw TimeoutException(err);
+			else
+				error(err);
+			return rc;
+		}
+		for (int i = 0; i < rc; ++i)
+		{
+			SocketMsg& msg = messages[received + i];
+			msg.length = static_cast<int>(hdrs[i].msg_len);
+			if (msg.pAddress) msg.addressLength = hdrs[i].msg_hdr.msg_namelen;
+		}
+		received += rc;
+		if (rc < static_cast<int>(n)) break;
+	}
+#else
+	for (auto& msg: messages)
+	{
+		if (received > 0 && !poll(Poco::Timespan(0), SELECT_READ)) break;
+		struct sockaddr* pSA = msg.pAddress;
+		poco_socklen_t* pSALen = msg.pAddress ? &msg.addressLength : 0;
+		int rc = receiveFrom(msg.buffer, msg.capacity, &pSA, &pSALen, flags);
+		if (rc < 0) return received > 0 ? received : rc;
+		msg.length = rc;
+		++received;
+	}
+#endif
+	return received;
+}
+
+
+int SocketImpl::sendBatch(SocketMsgVec& messages, int flags)
+{
+	if (messages.empty()) return 0;
+	if (_sockfd == POCO_INVALID_SOCKET)
+	{
+		poco_check_ptr (messages[0].pAddress);
+		init(messages[0].pAddress->sa_family);
+	}
+	int sent = 0;
+#if defined(POCO_HAVE_MMSG)
+	const std::size_t CHUNK_SIZE = 64;
+	struct mmsghdr hdrs[CHUNK_SIZE];
+	struct iovec iovs[CHUNK_SIZE];
+	while (sent < static_cast<int>(messages.size()))
+	{
+		std::size_t n = std::min(messages.size() - sent, CHUNK_SIZE);
+		for (std::size_t i = 0; i < n; ++i)
+		{
+			SocketMsg& msg = messages[sent + i];
+			iovs[i].iov_base = msg.buffer;
+			iovs[i].iov_len = msg.capacity;
+			memset(&hdrs[i], 0, sizeof(hdrs[i]));
+			hdrs[i].msg_hdr.msg_name = msg.pAddress;
+			hdrs[i].msg_hdr.msg_namelen = msg.pAddress ? msg.addressLength : 0;
+			hdrs[i].msg_hdr.msg_iov = &iovs[i];
+			hdrs[i].msg_hdr.msg_iovlen = 1;
+		}
+		int rc;
+		do
+		{
+			rc = ::sendmmsg(_sockfd, hdrs, static_cast<unsigned>(n), flags);
+		}
+		while (_blocking && rc < 0 && lastError() == POCO_EINTR);
+		if (rc < 0)
+		{
+			if (sent > 0) break;
+			int err = lastError();
+			if (err == POCO_EAGAIN && !_blocking) return rc;
+			error(err);
+		}
+		for (int i = 0; i < rc; ++i)
+		{
+			messages[sent + i].length = static_cast<int>(hdrs[i].msg_len);
+		}
+		sent += rc;
+		if (rc < static_cast<int>(n)) break;
+	}
+#else
+	for (auto& msg: messages)
+	{
+		int rc;
+		do
+		{
+			rc = ::sendto(_sockfd, reinterpret_cast<const char*>(msg.buffer), msg.capacity, flags, msg.pAddress, msg.addressLength);
+		}
+		while (_blocking && rc < 0 && lastError() == POCO_EINTR);
+		if (rc < 0)
+		{
+			if (sent > 0) break;
+			int err = lastError();
+			if (err == POCO_EAGAIN && !_blocking) return rc;
+			error(err);
+		}
+		msg.length = rc;
+		++sent;
+	}
+#endif
+	return sent;
+}
+
+
+int SocketImpl::sendSegments(const void* buffer, int length, int segmentSize, const SocketAddress& address, int flags)
+{
+	poco_assert (segmentSize > 0);
+
+	if (_sockfd == POCO_INVALID_SOCKET) init(address.af());
+	const char* p = reinterpret_cast<const char*>(buffer);
+	int sent = 0;
+#if defined(POCO_HAVE_UDP_OFFLOAD)
+	// the kernel accepts at most 64 segments, and no more
+	// than the maximum UDP payload per system call
+	const int MAX_SEGMENTS = 64;
+	const int MAX_PAYLOAD = 65507;
+	const int chunkSize = std::max(1, std::min(MAX_SEGMENTS, MAX_PAYLOAD/segmentSize))*segmentSize;
+	do
+	{
+		int n = std::min(length - sent, chunkSize);
+		struct iovec iov;
+		iov.iov_base = const_cast<char*>(p + sent);
+		iov.iov_len = n;
+		struct msghdr msgHdr;
+		memset(&msgHdr, 0, sizeof(msgHdr));
+		msgHdr.msg_name = const_cast<struct sockaddr*>(address.addr());
+		msgHdr.msg_namelen = address.length();
+		msgHdr.msg_iov = &iov;
+		msgHdr.msg_iovlen = 1;
+		char control[CMSG_SPACE(sizeof(Poco::UInt16))];
+		if (n > segmentSize)
+		{
+			memset(control, 0, sizeof(control));
+			msgHdr.msg_control = control;
+			msgHdr.msg_controllen = sizeof(control);
+			struct cmsghdr* pCmsg = CMSG_FIRSTHDR(&msgHdr);
+			pCmsg->cmsg_level = IPPROTO_UDP;
+			pCmsg->cmsg_type = UDP_SEGMENT;
+			pCmsg->cmsg_len = CMSG_LEN(sizeof(Poco::UInt16));
+			Poco::UInt16 gsoSize = static_cast<Poco::UInt16>(segmentSize);
+			memcpy(CMSG_DATA(pCmsg), &gsoSize, sizeof(gsoSize));
+		}
+		int rc;
+		do
+		{
+			rc = ::sendmsg(_sockfd, &msgHdr, flags);
+		}
+		while (_blocking && rc < 0 && lastError() == POCO_EINTR);
+		if (rc < 0)
+		{
+			if (sent > 0) break;
+			int err = lastError();
+			if (err == POCO_EAGAIN && !_blocking) return rc;
+			error(err);
+		}
+		sent += rc;
+	}
+	while (sent < length);
+#else
+	do
+	{
+		int n = std::min(length - sent, segmentSize);
+		int rc = sendTo(p + sent, n, address, flags);
+		if (rc < 0) return sent > 0 ? sent : rc;
+		sent += rc;
+	}
+	while (sent < length);
+#endif
+	return sent;
+}
+
+
+int SocketImpl::receiveSegments(void* buffer, int length, struct sockaddr** ppSA, poco_socklen_t** ppSALen, int& segmentSize, int flags)
+{
+#if defined(POCO_HAVE_UDP_OFFLOAD)
+	checkBrokenTimeout(SELECT_READ);
+	struct iovec iov;
+	iov.iov_base = buffer;
+	iov.iov_len = length;
+	struct msghdr msgHdr;
+	char control[CMSG_SPACE(sizeof(int))];
+	int rc;
+	do
+	{
+		if (_sockfd == POCO_INVALID_SOCKET) throw InvalidSocketException();
+		memset(&msgHdr, 0, sizeof(msgHdr));
+		msgHdr.msg_name = *ppSA;
+		msgHdr.msg_namelen = *ppSALen ? **ppSALen : 0;
+		msgHdr.msg_iov = &iov;
+		msgHdr.msg_iovlen = 1;
+		msgHdr.msg_control = control;
+		msgHdr.msg_controllen = sizeof(control);
+		rc = ::recvmsg(_sockfd, &msgHdr, flags);
+	}
+	while (_blocking && rc < 0 && lastError() == POCO_EINTR);
+	if (rc < 0)
+	{
+		int err = lastError();
+		if (err == POCO_EAGAIN && !_blocking)
+			;
+		else if (err == POCO_EAGAIN || err == POCO_ETIMEDOUT)
+			throw TimeoutException(err);
+		else
+			error(err);
+		return rc;
+	}
+	if (*ppSALen) **ppSALen = msgHdr.msg_namelen;
+	segmentSize = rc;
+	for (struct cmsghdr* pCmsg = CMSG_FIRSTHDR(&msgHdr); pCmsg; pCmsg = CMSG_NXTHDR(&msgHdr, pCmsg))
+	{
+		if (pCmsg->cmsg_level == IPPROTO_UDP && pCmsg->cmsg_type == UDP_GRO)
+		{
+			int gsoSize;
+			memcpy(&gsoSize, CMSG_DATA(pCmsg), sizeof(gsoSize));
+			if (gsoSize > 0) segmentSize = gsoSize;
+			break;
+		}
+	}
+	return rc;
+#else
+	int rc = receiveFrom(buffer, length, ppSA, ppSALen, flags);
+	segmentSize = rc;
+	return rc;
+#endif
+}
+
+
 void SocketImpl::sendUrgent(unsigned char data)
 {
 	if (_sockfd == POCO_INVALID_SOCKET) throw InvalidSocketException();
@@ -1136,6 +1479,51 @@ bool SocketImpl::getBroadcast()
 }
 
 
+void SocketImpl::setSegmentSize(int size)
+{
+#if defined(POCO_HAVE_UDP_OFFLOAD)
+	setOption(IPPROTO_UDP, UDP_SEGMENT, size);
+#else
+	throw Poco::NotImplementedException("UDP segmentation offload not supported");
+#endif
+}
+
+
+int SocketImpl::getSegmentSize()
+{
+#if defined(POCO_HAVE_UDP_OFFLOAD)
+	int value(0);
+	getOption(IPPROTO_UDP, UDP_SEGMENT, value);
+	return value;
+#else
+	return 0;
+#endif
+}
+
+
+void SocketImpl::setReceiveOffload(bool flag)
+{
+#if defined(POCO_HAVE_UDP_OFFLOAD)
+	int value = flag ? 1 : 0;
+	setOption(IPPROTO_UDP, UDP_GRO, value);
+#else
+	throw Poco::NotImplementedException("UDP receive offload not supported");
+#endif
+}
+
+
+bool SocketImpl::getReceiveOffload()
+{
+#if defined(POCO_HAVE_UDP_OFFLOAD)
+	int value(0);
+	getOption(IPPROTO_UDP, UDP_GRO, value);
+	return value != 0;
+#else
+	return false;
+#endif
+}
+
+
 void SocketImpl::setBlocking(bool flag)
 {
 #if !defined(POCO_OS_FAMILY_UNIX)
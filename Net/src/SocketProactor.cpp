@@ -15,6 +15,8 @@
 #include "Poco/Net/SocketProactor.h"
 #include "Poco/Net/DatagramSocket.h"
 #include "Poco/Net/DatagramSocketImpl.h"
+#include "Poco/Net/NetException.h"
+#include "Poco/Error.h"
 #include "Poco/Thread.h"
 #include "Poco/Exception.h"
 #ifdef POCO_OS_FAMILY_WINDOWS
@@ -23,6 +25,17 @@
 #endif // max
 #endif // POCO_OS_FAMILY_WINDOWS
 #include <limits>
+#if defined(POCO_HAVE_IO_URING)
+#include <linux/io_uring.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <poll.h>
+#include <unistd.h>
+#include <cstring>
+#include <algorithm>
+#include <mutex>
+#endif // POCO_HAVE_IO_URING
 
 
 using Poco::Exception;
@@ -221,6 +234,462 @@ private:
 };
 
 
+//
+// IOUring
+//
+
+#if defined(POCO_HAVE_IO_URING)
+
+class IOUring
+	/// IOUring is a minimal wrapper around the Linux io_uring
+	/// submission and completion queues, used by SocketProactor
+	/// to submit socket I/O directly to the kernel.
+	///
+	/// All ring operations, except schedule() and wakeUp(), must
+	/// be called from the proactor thread.
+	///
+	/// An eventfd is read through the ring at all times, so that
+	/// other threads can interrupt a wait for completions by
+	/// writing to it.
+{
+public:
+	using Handler = SocketProactor::Handler;
+	using Buffer = SocketProactor::Buffer;
+
+	struct Op
+		/// Op holds the kernel-visible state of a single
+		/// submitted operation until its completion.
+	{
+		Handler*         pHandler = nullptr;
+		poco_socket_t    sockfd = POCO_INVALID_SOCKET;
+		bool             write = false;
+		std::size_t      size = 0;
+		struct msghdr    msg;
+		struct iovec     iov;
+		sockaddr_storage addr;
+	};
+
+	using PendingList = std::vector<std::pair<poco_socket_t, bool>>;
+
+	static IOUring* create(unsigned entries = DEFAULT_ENTRIES)
+		/// Creates the IOUring. Returns nullptr if io_uring is not
+		/// supported by the kernel (or forbidden by seccomp policy).
+	{
+		std::unique_ptr<IOUring> pRing(new IOUring);
+		if (!pRing->setup(entries)) return nullptr;
+		return pRing.release();
+	}
+
+	~IOUring()
+	{
+		cancelAll();
+		if (_sqes != MAP_FAILED) munmap(_sqes, _sqesSize);
+		if (_cqPtr != MAP_FAILED && _cqPtr != _sqPtr) munmap(_cqPtr, _cqSize);
+		if (_sqPtr != MAP_FAILED) munmap(_sqPtr, _sqSize);
+		if (_fd >= 0) ::close(_fd);
+		if (_eventFd >= 0) ::close(_eventFd);
+	}
+
+	void schedule(poco_socket_t sockfd, bool write)
+		/// Schedules the socket read or write queue for submission
+		/// on the next pollIOUring() call. Thread-safe.
+	{
+		std::lock_guard<std::mutex> lock(_pendingMutex);
+		_pending.emplace_back(sockfd, write);
+	}
+
+	void wakeUp()
+		/// Interrupts a submit() call waiting for completions.
+		/// Thread-safe.
+	{
+		if (_eventFd >= 0) eventfd_write(_eventFd, 1);
+	}
+
+	void takePending(PendingList& pending)
+	{
+		pending.clear();
+		std::lock_guard<std::mutex> lock(_pendingMutex);
+		std::swap(pending, _pending);
+	}
+
+	Op* acquire(Handler* pHandler, poco_socket_t sockfd, bool write)
+	{
+		Op* pOp = nullptr;
+		if (_freeOps.empty())
+		{
+			_ops.emplace_back(new Op);
+			pOp = _ops.back().get();
+		}
+		else
+		{
+			pOp = _freeOps.back();
+			_freeOps.pop_back();
+		}
+		pOp->pHandler = pHandler;
+		pOp->sockfd = sockfd;
+		pOp->write = write;
+		pOp->size = pHandler->_pBuf ? pHandler->_pBuf->size() : 0;
+		return pOp;
+	}
+
+	void release(Op* pOp)
+	{
+		pOp->pHandler = nullptr;
+		_freeOps.push_back(pOp);
+	}
+
+	void prepare(Op* pOp, bool pollFirst = false)
+		/// Prepares the submission queue entry for the operation.
+		/// If pollFirst is true, the operation is linked to a poll
+		/// request, so that it is only issued once the socket is ready;
+		/// this is used to retry sends that completed with EAGAIN.
+		/// Receives are always linked to a poll request.
+		///
+		/// A receive buffer that is not registered is enlarged to
+		/// MAX_RECEIVE_SIZE, so that no datagram is truncated, and
+		/// trimmed to the number of bytes received on completion.
+	{
+		Handler* pHandler = pOp->pHandler;
+		Buffer* pBuf = pHandler->_pBuf;
+		poco_check_ptr (pBuf);
+		int index = -1;
+		if (!pOp->write)
+		{
+			index = fixedIndex(pBuf->data(), pBuf->size());
+			if (index < 0 && pBuf->size() < MAX_RECEIVE_SIZE) pBuf->resize(MAX_RECEIVE_SIZE);
+			pollFirst = true;
+		}
+		reserve(pollFirst ? 2 : 1);
+
+		if (pollFirst)
+		{
+			struct io_uring_sqe* pSQE = nextSQE();
+			pSQE->opcode = IORING_OP_POLL_ADD;
+			pSQE->fd = pOp->sockfd;
+			pSQE->poll32_events = pOp->write ? POLLOUT : POLLIN;
+			pSQE->flags = IOSQE_IO_LINK;
+			pSQE->user_data = 0;
+		}
+
+		struct io_uring_sqe* pSQE = nextSQE();
+		pSQE->fd = pOp->sockfd;
+		pSQE->user_data = reinterpret_cast<__u64>(pOp);
+		if (pHandler->_pAddr)
+		{
+			std::memset(&pOp->msg, 0, sizeof(pOp->msg));
+			pOp->iov.iov_base = pBuf->data();
+			pOp->iov.iov_len = pBuf->size();
+			pOp->msg.msg_iov = &pOp->iov;
+			pOp->msg.msg_iovlen = 1;
+			if (pOp->write)
+			{
+				pOp->msg.msg_name = const_cast<struct sockaddr*>(pHandler->_pAddr->addr());
+				pOp->msg.msg_namelen = pHandler->_pAddr->length();
+				pSQE->opcode = IORING_OP_SENDMSG;
+				pSQE->msg_flags = MSG_NOSIGNAL;
+			}
+			else
+			{
+				pOp->msg.msg_name = &pOp->addr;
+				pOp->msg.msg_namelen = sizeof(pOp->addr);
+				pSQE->opcode = IORING_OP_RECVMSG;
+			}
+			pSQE->addr = reinterpret_cast<__u64>(&pOp->msg);
+			pSQE->len = 1;
+		}
+		else
+		{
+			if (index >= 0)
+			{
+				pSQE->opcode = IORING_OP_READ_FIXED;
+				pSQE->buf_index = static_cast<__u16>(index);
+			}
+			else
+			{
+				pSQE->opcode = pOp->write ? IORING_OP_SEND : IORING_OP_RECV;
+				if (pOp->write) pSQE->msg_flags = MSG_NOSIGNAL;
+			}
+			pSQE->addr = reinterpret_cast<__u64>(pBuf->data());
+			pSQE->len = static_cast<__u32>(pBuf->size());
+		}
+	}
+
+	void submit(long timeoutMs)
+		/// Submits all prepared entries and waits up to timeoutMs
+		/// milliseconds for at least one operation to complete,
+		/// or for wakeUp() to be called.
+	{
+		if (!_wakeUpArmed) armWakeUp();
+		waitFor(flush(), timeoutMs);
+	}
+
+	template <typename F>
+	int complete(F onCompletion)
+		/// Calls onCompletion(pOp, result) for every available completion
+		/// queue entry. Returns the number of entries consumed.
+		/// Entries of linked poll requests and of the
+		/// wake-up eventfd are skipped.
+	{
+		int count = 0;
+		unsigned head = *_cqHead;
+		while (head != __atomic_load_n(_cqTail, __ATOMIC_ACQUIRE))
+		{
+			struct io_uring_cqe* pCQE = &_cqes[head & _cqMask];
+			__u64 userData = pCQE->user_data;
+			int res = pCQE->res;
+			__atomic_store_n(_cqHead, ++head, __ATOMIC_RELEASE);
+			--_inFlight;
+			++count;
+			if (userData == WAKE_UP_DATA) _wakeUpArmed = false;
+			else if (userData) onCompletion(reinterpret_cast<Op*>(userData), res);
+		}
+		return count;
+	}
+
+	void registerBuffers(const std::vector<Buffer*>& buffers)
+	{
+		if (!_fixed.empty())
+		{
+			syscall(__NR_io_uring_register, _fd, IORING_UNREGISTER_BUFFERS, nullptr, 0);
+			_fixed.clear();
+		}
+		if (buffers.empty()) return;
+
+		std::vector<struct iovec> iovs;
+		iovs.reserve(buffers.size());
+		for (auto pBuf: buffers)
+		{
+			poco_check_ptr (pBuf);
+			if (pBuf->empty())
+				throw Poco::InvalidArgumentException("SocketProactor::registerBuffers(): empty buffer");
+			struct iovec iov;
+			iov.iov_base = pBuf->data();
+			iov.iov_len = pBuf->size();
+			iovs.push_back(iov);
+		}
+		if (syscall(__NR_io_uring_register, _fd, IORING_REGISTER_BUFFERS, iovs.data(), static_cast<unsigned>(iovs.size())) < 0)
+		{
+			int err = errno;
+			throw NetException("SocketProactor::registerBuffers()", Error::getMessage(err), err);
+		}
+		_fixed = std::move(iovs);
+	}
+
+private:
+	enum
+	{
+		DEFAULT_ENTRIES = 256,
+		CANCEL_WAIT_MS = 100
+	};
+
+	static const __u64 WAKE_UP_DATA = 1;
+		/// user_data of the eventfd read; never a valid Op pointer.
+
+	static const std::size_t MAX_RECEIVE_SIZE = 65536;
+		/// Size of a receive buffer; large enough for any datagram.
+
+	IOUring() = default;
+
+	bool setup(unsigned entries)
+	{
+		struct io_uring_params params;
+		std::memset(&params, 0, sizeof(params));
+		_fd = static_cast<int>(syscall(__NR_io_uring_setup, entries, &params));
+		if (_fd < 0) return false;
+		// timed waits require IORING_FEAT_EXT_ARG (Linux 5.11)
+		if (!(params.features & IORING_FEAT_EXT_ARG)) return false;
+		_eventFd = eventfd(0, EFD_CLOEXEC);
+		if (_eventFd < 0) return false;
+
+		_sqSize = params.sq_off.array + params.sq_entries*sizeof(unsigned);
+		_cqSize = params.cq_off.cqes + params.cq_entries*sizeof(struct io_uring_cqe);
+		bool singleMap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+		if (singleMap) _sqSize = _cqSize = std::max(_sqSize, _cqSize);
+
+		_sqPtr = mmap(nullptr, _sqSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, _fd, IORING_OFF_SQ_RING);
+		if (_sqPtr == MAP_FAILED) return false;
+		if (singleMap) _cqPtr = _sqPtr;
+		else
+		{
+			_cqPtr = mmap(nullptr, _cqSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, _fd, IORING_OFF_CQ_RING);
+			if (_cqPtr == MAP_FAILED) return false;
+		}
+		_sqesSize = params.sq_entries*sizeof(struct io_uring_sqe);
+		_sqes = static_cast<struct io_uring_sqe*>(mmap(nullptr, _sqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, _fd, IORING_OFF_SQES));
+		if (_sqes == MAP_FAILED) return false;
+
+		char* sq = static_cast<char*>(_sqPtr);
+		_sqHead = reinterpret_cast<unsigned*>(sq + params.sq_off.head);
+		_sqTail = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+		_sqMask = *reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+		_sqEntries = *reinterpret_cast<unsigned*>(sq + params.sq_off.ring_entries);
+		_sqArray = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+		_sqLocalTail = *_sqTail;
+		_sqSubmitted = _sqLocalTail;
+
+		char* cq = static_cast<char*>(_cqPtr);
+		_cqHead = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+		_cqTail = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+		_cqMask = *reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+		_cqes = reinterpret_cast<struct io_uring_cqe*>(cq + params.cq_off.cqes);
+		return true;
+	}
+
+	int enter(unsigned toSubmit, unsigned minComplete, unsigned flags, struct io_uring_getevents_arg* pArg)
+	{
+		int rc = static_cast<int>(syscall(__NR_io_uring_enter, _fd, toSubmit, minComplete, flags, pArg, pArg ? sizeof(*pArg) : 0));
+		if (rc < 0)
+		{
+			int err = errno;
+			if (err != ETIME && err != EINTR && err != EBUSY && err != EAGAIN)
+				throw NetException("io_uring_enter", Error::getMessage(err), err);
+		}
+		return rc;
+	}
+
+	void waitFor(unsigned toSubmit, long timeoutMs)
+		/// Submits toSubmit entries and waits up to timeoutMs
+		/// milliseconds for at least one completion.
+	{
+		struct __kernel_timespec ts;
+		ts.tv_sec = timeoutMs/1000;
+		ts.tv_nsec = (timeoutMs % 1000)*1000000;
+		struct io_uring_getevents_arg arg;
+		std::memset(&arg, 0, sizeof(arg));
+		arg.ts = reinterpret_cast<__u64>(&ts);
+		enter(toSubmit, 1, IORING_ENTER_GETEVENTS | IORING_ENTER_EXT_ARG, &arg);
+	}
+
+	unsigned flush()
+		/// Publishes the prepared entries to the kernel and
+		/// returns their number.
+	{
+		unsigned toSubmit = _sqLocalTail - _sqSubmitted;
+		if (toSubmit)
+		{
+			__atomic_store_n(_sqTail, _sqLocalTail, __ATOMIC_RELEASE);
+			_sqSubmitted = _sqLocalTail;
+			_inFlight += toSubmit;
+		}
+		return toSubmit;
+	}
+
+	void reserve(unsigned count)
+		/// Makes sure there is room for count entries in the
+		/// submission queue, submitting the prepared ones if needed.
+	{
+		if (_sqLocalTail - __atomic_load_n(_sqHead, __ATOMIC_ACQUIRE) + count > _sqEntries)
+		{
+			unsigned toSubmit = flush();
+			if (toSubmit) enter(toSubmit, 0, 0, nullptr);
+		}
+	}
+
+	void armWakeUp()
+		/// Prepares a read of the wake-up eventfd.
+	{
+		reserve(1);
+		struct io_uring_sqe* pSQE = nextSQE();
+		pSQE->opcode = IORING_OP_READ;
+		pSQE->fd = _eventFd;
+		pSQE->addr = reinterpret_cast<__u64>(&_wakeUpCount);
+		pSQE->len = sizeof(_wakeUpCount);
+		pSQE->user_data = WAKE_UP_DATA;
+		_wakeUpArmed = true;
+	}
+
+	struct io_uring_sqe* nextSQE()
+	{
+		unsigned index = _sqLocalTail & _sqMask;
+		struct io_uring_sqe* pSQE = &_sqes[index];
+		std::memset(pSQE, 0, sizeof(*pSQE));
+		_sqArray[index] = index;
+		++_sqLocalTail;
+		return pSQE;
+	}
+
+	int fixedIndex(const void* pData, std::size_t size) const
+	{
+		const char* p = static_cast<const char*>(pData);
+		for (std::size_t i = 0; i < _fixed.size(); ++i)
+		{
+			const char* pBase = static_cast<const char*>(_fixed[i].iov_base);
+			if (p >= pBase && p + size <= pBase + _fixed[i].iov_len)
+				return static_cast<int>(i);
+		}
+		return -1;
+	}
+
+	void cancelAll()
+		/// Cancels all operations in flight and waits (for a limited
+		/// time) for their completion, so that the kernel no longer
+		/// accesses the buffers and Op entries when the ring is gone.
+	{
+		if (_fd < 0 || _sqes == MAP_FAILED) return;
+		flush();
+		if (_inFlight == 0) return;
+		// complete the eventfd read, if armed
+		wakeUp();
+#if defined(IORING_ASYNC_CANCEL_ANY)
+		struct io_uring_sqe* pSQE = nextSQE();
+		pSQE->opcode = IORING_OP_ASYNC_CANCEL;
+		pSQE->fd = -1;
+		pSQE->cancel_flags = IORING_ASYNC_CANCEL_ANY;
+		pSQE->user_data = 0;
+#endif
+		int retries = 10;
+		try
+		{
+			while (_inFlight > 0 && retries-- > 0)
+			{
+				waitFor(flush(), CANCEL_WAIT_MS);
+				complete([](Op*, int) {});
+			}
+		}
+		catch (...)
+		{
+		}
+	}
+
+	int                   _fd = -1;
+	int                   _eventFd = -1;
+	eventfd_t             _wakeUpCount = 0;
+	bool                  _wakeUpArmed = false;
+	void*                 _sqPtr = MAP_FAILED;
+	void*                 _cqPtr = MAP_FAILED;
+	struct io_uring_sqe*  _sqes = static_cast<struct io_uring_sqe*>(MAP_FAILED);
+	std::size_t           _sqSize = 0;
+	std::size_t           _cqSize = 0;
+	std::size_t           _sqesSize = 0;
+	unsigned*             _sqHead = nullptr;
+	unsigned*             _sqTail = nullptr;
+	unsigned*             _sqArray = nullptr;
+	unsigned              _sqMask = 0;
+	unsigned              _sqEntries = 0;
+	unsigned              _sqLocalTail = 0;
+	unsigned              _sqSubmitted = 0;
+	unsigned*             _cqHead = nullptr;
+	unsigned*             _cqTail = nullptr;
+	unsigned              _cqMask = 0;
+	struct io_uring_cqe*  _cqes = nullptr;
+	unsigned              _inFlight = 0;
+	std::vector<std::unique_ptr<Op>> _ops;
+	std::vector<Op*>      _freeOps;
+	std::vector<struct iovec> _fixed;
+	PendingList           _pending;
+	std::mutex            _pendingMutex;
+};
+
+#else
+
+class IOUring
+	/// Placeholder for platforms without io_uring support.
+{
+};
+
+#endif // POCO_HAVE_IO_URING
+
+
 //
 // SocketProactor
 //
@@ -239,6 +708,9 @@ SocketProactor::SocketProactor(bool worker):
 	_ioCompletion(_maxTimeout),
 	_pWorker(worker ? new Worker : nullptr)
 {
+#if defined(POCO_HAVE_IO_URING)
+	_pIOUring.reset(IOUring::create());
+#endif
 }
 
 
@@ -252,6 +724,9 @@ SocketProactor::SocketProactor(const Poco::Timespan& timeout, bool worker):
 	_ioCompletion(_maxTimeout),
 	_pWorker(worker ? new Worker : nullptr)
 {
+#if defined(POCO_HAVE_IO_URING)
+	_pIOUring.reset(IOUring::create());
+#endif
 }
 
 
@@ -259,6 +734,7 @@ SocketProactor::~SocketProactor()
 {
 	_ioCompletion.stop();
 	wait();
+	_pIOUring.reset();
 	for (auto& pS : _writeHandlers)
 	{
 		for (auto& pH : pS.second)
@@ -290,7 +766,9 @@ int SocketProactor::poll(int* pHandled)
 {
 	int handled = 0;
 	int worked = 0;
-	PollSet::SocketModeMap sm = _pollSet.poll(_timeout);
+	PollSet::SocketModeMap sm;
+	if (_pIOUring) handled = pollIOUring();
+	else sm = _pollSet.poll(_timeout);
 	if (sm.size() > 0)
 	{
 		auto it = sm.begin();
@@ -338,7 +816,9 @@ void SocketProactor::addReceiveFrom(Socket sock, Buffer& buf, Poco::Net::SocketA
 	pHandler->_onCompletion = std::move(onCompletion);
 
 	std::lock_guard<std::recursive_mutex> l(_readMutex);
-	_readHandlers[sock.impl()->sockfd()].push_back(std::move(pHandler));
+	IOHandlerList& handlers = _readHandlers[sock.impl()->sockfd()];
+	handlers.push_back(std::move(pHandler));
+	if (_pIOUring && handlers.size() == 1) submitIOUring(sock.impl()->sockfd(), false);
 }
 
 
@@ -394,8 +874,13 @@ void SocketProactor::addReceive(Socket sock, Buffer& buf, Callback&& onCompletio
 	pHandler->_onCompletion = std::move(onCompletion);
 
 	std::lock_guard<std::recursive_mutex> l(_readMutex);
-	_readHandlers[sock.impl()->sockfd()].push_back(std::move(pHandler));
-	if (!has(sock)) addSocket(sock, PollSet::POLL_READ);
+	IOHandlerList& handlers = _readHandlers[sock.impl()->sockfd()];
+	handlers.push_back(std::move(pHandler));
+	if (_pIOUring)
+	{
+		if (handlers.size() == 1) submitIOUring(sock.impl()->sockfd(), false);
+	}
+	else if (!has(sock)) addSocket(sock, PollSet::POLL_READ);
 }
 
 
@@ -444,8 +929,13 @@ void SocketProactor::addSend(Socket sock, Buffer* pMessage, SocketAddress* pAddr
 	pHandler->_owner = own;
 
 	std::lock_guard<std::recursive_mutex> l(_writeMutex);
-	_writeHandlers[sock.impl()->sockfd()].push_back(std::move(pHandler));
-	if (!has(sock)) addSocket(sock, PollSet::POLL_WRITE);
+	IOHandlerList& handlers = _writeHandlers[sock.impl()->sockfd()];
+	handlers.push_back(std::move(pHandler));
+	if (_pIOUring)
+	{
+		if (handlers.size() == 1) submitIOUring(sock.impl()->sockfd(), true);
+	}
+	else if (!has(sock)) addSocket(sock, PollSet::POLL_WRITE);
 }
 
 
@@ -619,6 +1109,123 @@ void SocketProactor::receive(SocketImpl& sock, IOHandlerIt& it, int available)
 }
 
 
+#if defined(POCO_HAVE_IO_URING)
+
+
+void SocketProactor::submitIOUring(poco_socket_t sockfd, bool write)
+{
+	_pIOUring->schedule(sockfd, write);
+	// the proactor thread may be waiting for completions or sleeping
+	wakeUp();
+}
+
+
+void SocketProactor::wakeUpIOUring()
+{
+	_pIOUring->wakeUp();
+}
+
+
+int SocketProactor::pollIOUring()
+{
+	IOUring& ring = *_pIOUring;
+	ring.takePending(_pendingIO);
+	for (const auto& p: _pendingIO)
+	{
+		MutexType& mutex = p.second ? _writeMutex : _readMutex;
+		SubscriberMap& subscribers = p.second ? _writeHandlers : _readHandlers;
+		ScopedLock lock(mutex);
+		auto hIt = subscribers.find(p.first);
+		if (hIt != subscribers.end() && !hIt->second.empty() && !hIt->second.front()->_submitted)
+		{
+			Handler* pHandler = hIt->second.front().get();
+			pHandler->_submitted = true;
+			ring.prepare(ring.acquire(pHandler, p.first, p.second));
+		}
+	}
+
+	ring.submit(_timeout);
+
+	int handled = 0;
+	ring.complete([&](IOUring::Op* pOp, int res)
+	{
+		MutexType& mutex = pOp->write ? _writeMutex : _readMutex;
+		SubscriberMap& subscribers = pOp->write ? _writeHandlers : _readHandlers;
+		ScopedLock lock(mutex);
+		auto hIt = subscribers.find(pOp->sockfd);
+		if (hIt != subscribers.end() && !hIt->second.empty() && hIt->second.front().get() == pOp->pHandler)
+		{
+			if (res == -EAGAIN || res == -EINTR)
+			{
+				// non-blocking socket not ready yet; retry once it is
+				ring.prepare(pOp, true);
+				return;
+			}
+			IOHandlerList& handlers = hIt->second;
+			Handler* pHandler = pOp->pHandler;
+			if (!pOp->write)
+			{
+				// trim an enlarged buffer to the data received
+				Buffer* pBuf = pHandler->_pBuf;
+				if (pBuf->size() > pOp->size)
+					pBuf->resize(std::max(pOp->size, static_cast<std::size_t>(res > 0 ? res : 0)));
+			}
+			if (!pOp->write && pHandler->_pAddr && res >= 0)
+			{
+				*pHandler->_pAddr = SocketAddress(reinterpret_cast<const struct sockaddr*>(&pOp->addr),
+					static_cast<poco_socklen_t>(pOp->msg.msg_namelen));
+			}
+			enqueueIONotification(std::move(pHandler->_onCompletion), res > 0 ? res : 0, res < 0 ? -res : 0);
+			auto it = handlers.begin();
+			deleteHandler(handlers, it);
+			++handled;
+			if (!handlers.empty())
+			{
+				pHandler = handlers.front().get();
+				pHandler->_submitted = true;
+				ring.prepare(ring.acquire(pHandler, pOp->sockfd, pOp->write));
+			}
+		}
+		ring.release(pOp);
+	});
+	if (handled) _ioCompletion.wakeUp();
+	return handled;
+}
+
+
+void SocketProactor::registerBuffers(const std::vector<Buffer*>& buffers)
+{
+	if (_pIOUring) _pIOUring->registerBuffers(buffers);
+}
+
+
+#else
+
+
+void SocketProactor::submitIOUring(poco_socket_t, bool)
+{
+}
+
+
+void SocketProactor::wakeUpIOUring()
+{
+}
+
+
+int SocketProactor::pollIOUring()
+{
+	return 0;
+}
+
+
+void SocketProactor::registerBuffers(const std::vector<Buffer*>&)
+{
+}
+
+
+#endif // POCO_HAVE_IO_URING
+
+
 int SocketProactor::doWork(bool handleOne, bool expiredOnly)
 {
 	return worker().doWork(handleOne, expiredOnly);
@@ -700,6 +1307,7 @@ void SocketProactor::stop()
 
 void SocketProactor::wakeUp()
 {
+	if (_pIOUring) wakeUpIOUring();
 	if (_pThread) _pThread->wakeUp();
 }
 
@@ -779,7 +1387,8 @@ bool SocketProactor::ioCompletionInProgress() const
 
 void SocketProactor::onShutdown()
 {
-	_pollSet.wakeUp();
+	if (_pIOUring) wakeUpIOUring();
+	else _pollSet.wakeUp();
 	_ioCompletion.stop();
 	_ioCompletion.wait();
 }
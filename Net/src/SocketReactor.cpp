@@ -78,30 +78,19 @@ void SocketReactor::run()
 	}
 	Poco::Stopwatch sw;
 	if (_params.throttle) sw.start();
-	PollSet::SocketModeMap sm;
+	PollSet::SocketModeList sm;
 	while (!_stop)
 	{
 		try
 		{
 			if (hasSocketHandlers())
 			{
-				sm = _pollSet.poll(_params.pollTimeout);
+				_pollSet.poll(_params.pollTimeout, sm);
 				for (const auto& s : sm)
 				{
 					try
 					{
-						if (s.second & PollSet::POLL_READ)
-						{
-							dispatch(s.first, _pReadableNotification);
-						}
-						if (s.second & PollSet::POLL_WRITE)
-						{
-							dispatch(s.first, _pWritableNotification);
-						}
-						if (s.second & PollSet::POLL_ERROR)
-						{
-							dispatch(s.first, _pErrorNotification);
-						}
+						dispatchEvents(s.first, s.second);
 					}
 					catch (Exception& exc)
 					{
@@ -119,7 +108,7 @@ void SocketReactor::run()
 						ErrorHandler::handle();
 					}
 				}
-				if (0 == sm.size())
+				if (sm.empty())
 				{
 					onTimeout();
 					if (_params.throttle && _params.pollTimeout == 0)
@@ -151,6 +140,48 @@ void SocketReactor::run()
 }
 
 
+void SocketReactor::dispatchEvents(const Socket& socket, int mode)
+{
+	NotifierPtr pNotifier = getNotifier(socket);
+	if (!pNotifier) return;
+	int options = pNotifier->pollOptions();
+	if (mode & PollSet::POLL_READ)
+	{
+		dispatch(pNotifier, _pReadableNotification);
+		if (options & PollSet::POLL_EDGE) drain(pNotifier, socket);
+	}
+	if (mode & PollSet::POLL_WRITE)
+	{
+		dispatch(pNotifier, _pWritableNotification);
+	}
+	if (mode & PollSet::POLL_ERROR)
+	{
+		dispatch(pNotifier, _pErrorNotification);
+	}
+	if (options & PollSet::POLL_ONESHOT) _pollSet.rearm(socket);
+}
+
+
+void SocketReactor::drain(NotifierPtr& pNotifier, const Socket& socket)
+{
+	// an edge-triggered socket is not reported again while data
+	// (or the end of stream) is still pending, so keep notifying
+	// as long as the socket is readable and the handler makes progress
+	SocketImpl* pImpl = socket.impl();
+	int available = pImpl->available();
+	while (pImpl->sockfd() != POCO_INVALID_SOCKET &&
+		pNotifier->accepts(_pReadableNotification) &&
+		pImpl->poll(Poco::Timespan(0), SocketImpl::SELECT_READ))
+	{
+		dispatch(pNotifier, _pReadableNotification);
+		if (pImpl->sockfd() == POCO_INVALID_SOCKET) break;
+		int remaining = pImpl->available();
+		if (remaining > 0 ? remaining >= available : available == 0) break;
+		available = remaining;
+	}
+}
+
+
 void SocketReactor::sleep()
 {
 	if (_params.sleep < _params.sleepLimit) ++_params.sleep;
@@ -189,17 +220,25 @@ bool SocketReactor::hasSocketHandlers()
 }
 
 
-void SocketReactor::addEventHandler(const Socket& socket, const Poco::AbstractObserver& observer)
+void SocketReactor::addEventHandler(const Socket& socket, const Poco::AbstractObserver& observer, int pollOptions)
 {
 	NotifierPtr pNotifier = getNotifier(socket, true);
 
 	if (!pNotifier->hasObserver(observer)) pNotifier->addObserver(this, observer);
+	pNotifier->addPollOptions(pollOptions);
+
+	int mode = pollMode(pNotifier);
+	if (mode) _pollSet.add(socket, mode | pNotifier->pollOptions());
+}
 
+
+int SocketReactor::pollMode(NotifierPtr& pNotifier)
+{
 	int mode = 0;
 	if (pNotifier->accepts(_pReadableNotification)) mode |= PollSet::POLL_READ;
 	if (pNotifier->accepts(_pWritableNotification)) mode |= PollSet::POLL_WRITE;
 	if (pNotifier->accepts(_pErrorNotification))    mode |= PollSet::POLL_ERROR;
-	if (mode) _pollSet.add(socket, mode);
+	return mode;
 }
 
 
@@ -246,11 +285,7 @@ void SocketReactor::removeEventHandler(const Socket& socket, const Poco::Abstrac
 
 		if (pNotifier->countObservers() > 0 && socket.impl()->sockfd() > 0)
 		{
-			int mode = 0;
-			if (pNotifier->accepts(_pReadableNotification)) mode |= PollSet::POLL_READ;
-			if (pNotifier->accepts(_pWritableNotification)) mode |= PollSet::POLL_WRITE;
-			if (pNotifier->accepts(_pErrorNotification))    mode |= PollSet::POLL_ERROR;
-			_pollSet.update(socket, mode);
+			_pollSet.update(socket, pollMode(pNotifier) | pNotifier->pollOptions());
 		}
 	}
 }
@@ -169,6 +169,12 @@ int StreamSocket::sendBytes(const SocketBufVec& buffers, int flags)
 }
 
 
+std::streamsize StreamSocket::sendFile(FileInputStream& fileInputStream, std::streamoff offset, std::streamsize count)
+{
+	return impl()->sendFile(fileInputStream, offset, count);
+}
+
+
 int StreamSocket::sendBytes(FIFOBuffer& fifoBuf)
 {
 	ScopedLock<std::recursive_mutex> l(fifoBuf.mutex());
@@ -19,6 +19,7 @@
 #include "Poco/Timespan.h"
 #include "Poco/Exception.h"
 #include "Poco/ErrorHandler.h"
+#include "Poco/Environment.h"
 
 
 using Poco::ErrorHandler;
@@ -44,25 +45,40 @@ TCPServerConnectionFilter::~TCPServerConnectionFilter()
 
 
 TCPServer::TCPServer(TCPServerConnectionFactory::Ptr pFactory, Poco::UInt16 portNumber, TCPServerParams::Ptr pParams):
-	_socket(ServerSocket(portNumber)),
+	TCPServer(pFactory, SocketAddress(portNumber), pParams)
+{
+}
+
+
+TCPServer::TCPServer(TCPServerConnectionFactory::Ptr pFactory, const SocketAddress& address, TCPServerParams::Ptr pParams):
+	_socket(createSocket(address, pParams)),
+	_pDispatcher(nullptr),
 	_thread(threadName(_socket)),
-	_stopped(true)
+	_stopped(true),
+	_cpu(shardCPU(pParams, 0))
 {
-	Poco::ThreadPool& pool = Poco::ThreadPool::defaultPool();
-	if (pParams)
+	if (pParams && pParams->getShards() > 1)
 	{
-		int toAdd = pParams->getMaxThreads() - pool.capacity();
-		if (toAdd > 0) pool.addCapacity(toAdd);
+		createShards(pFactory, pParams);
+	}
+	else
+	{
+		Poco::ThreadPool& pool = Poco::ThreadPool::defaultPool();
+		if (pParams)
+		{
+			int toAdd = pParams->getMaxThreads() - pool.capacity();
+			if (toAdd > 0) pool.addCapacity(toAdd);
+		}
+		_pDispatcher = new TCPServerDispatcher(pFactory, pool, pParams);
 	}
-	_pDispatcher = new TCPServerDispatcher(pFactory, pool, pParams);
-
 }
 
 
 TCPServer::TCPServer(TCPServerConnectionFactory::Ptr pFactory, const ServerSocket& socket, TCPServerParams::Ptr pParams):
 	_socket(socket),
 	_thread(threadName(socket)),
-	_stopped(true)
+	_stopped(true),
+	_cpu(-1)
 {
 	Poco::ThreadPool& pool = Poco::ThreadPool::defaultPool();
 	if (pParams)
@@ -78,7 +94,18 @@ TCPServer::TCPServer(TCPServerConnectionFactory::Ptr pFactory, Poco::ThreadPool&
 	_socket(socket),
 	_pDispatcher(new TCPServerDispatcher(pFactory, threadPool, pParams)),
 	_thread(threadName(socket)),
-	_stopped(true)
+	_stopped(true),
+	_cpu(-1)
+{
+}
+
+
+TCPServer::TCPServer(TCPServerConnectionFactory::Ptr pFactory, Poco::WorkStealingExecutor& executor, const ServerSocket& socket, TCPServerParams::Ptr pParams):
+	_socket(socket),
+	_pDispatcher(new TCPServerDispatcher(pFactory, executor, pParams)),
+	_thread(threadName(socket)),
+	_stopped(true),
+	_cpu(-1)
 {
 }
 
@@ -89,6 +116,7 @@ TCPServer::~TCPServer()
 	{
 		stop();
 		_pDispatcher->release();
+		_shards.clear();
 	}
 	catch (...)
 	{
@@ -97,6 +125,12 @@ TCPServer::~TCPServer()
 }
 
 
+TCPServer::Shard::~Shard()
+{
+	if (pDispatcher) pDispatcher->release();
+}
+
+
 const TCPServerParams& TCPServer::params() const
 {
 	return _pDispatcher->params();
@@ -109,6 +143,14 @@ void TCPServer::start()
 
 	_stopped = false;
 	_thread.start(*this);
+	for (auto& pShard: _shards)
+	{
+		Shard* pS = pShard.get();
+		pS->pThread->startFunc([this, pS]()
+		{
+			acceptLoop(pS->socket, *pS->pDispatcher, pS->cpu);
+		});
+	}
 }
 
 
@@ -118,23 +160,43 @@ void TCPServer::stop()
 	{
 		_stopped = true;
 		_thread.join();
+		for (auto& pShard: _shards)
+		{
+			pShard->pThread->join();
+		}
 		_pDispatcher->stop();
+		for (auto& pShard: _shards)
+		{
+			pShard->pDispatcher->stop();
+		}
 	}
 }
 
 
 void TCPServer::run()
 {
+	acceptLoop(_socket, *_pDispatcher, _cpu);
+}
+
+
+void TCPServer::acceptLoop(ServerSocket& socket, TCPServerDispatcher& dispatcher, int cpu)
+{
+	if (cpu >= 0)
+	{
+		Poco::Thread* pThread = Poco::Thread::current();
+		if (pThread) pThread->setAffinity(cpu);
+	}
+
 	while (!_stopped)
 	{
 		Poco::Timespan timeout(250000);
 		try
 		{
-			if (_socket.poll(timeout, Socket::SELECT_READ))
+			if (socket.poll(timeout, Socket::SELECT_READ))
 			{
 				try
 				{
-					StreamSocket ss = _socket.acceptConnection();
+					StreamSocket ss = socket.acceptConnection();
 
 					if (!_pConnectionFilter || _pConnectionFilter->accept(ss))
 					{
@@ -145,7 +207,7 @@ void TCPServer::run()
 						{
 							ss.setNoDelay(true);
 						}
-						_pDispatcher->enqueue(ss);
+						dispatcher.enqueue(ss);
 					}
 				}
 				catch (Poco::Exception& exc)
@@ -175,43 +237,108 @@ void TCPServer::run()
 
 int TCPServer::currentThreads() const
 {
-	return _pDispatcher->currentThreads();
+	int n = _pDispatcher->currentThreads();
+	for (const auto& pShard: _shards)
+	{
+		n += pShard->pDispatcher->currentThreads();
+	}
+	return n;
 }
 
 
 int TCPServer::maxThreads() const
 {
-	return _pDispatcher->maxThreads();
+	int n = _pDispatcher->maxThreads();
+	for (const auto& pShard: _shards)
+	{
+		n += pShard->pDispatcher->maxThreads();
+	}
+	return n;
 }
 
 
 int TCPServer::totalConnections() const
 {
-	return _pDispatcher->totalConnections();
+	int n = _pDispatcher->totalConnections();
+	for (const auto& pShard: _shards)
+	{
+		n += pShard->pDispatcher->totalConnections();
+	}
+	return n;
 }
 
 
 int TCPServer::currentConnections() const
 {
-	return _pDispatcher->currentConnections();
+	int n = _pDispatcher->currentConnections();
+	for (const auto& pShard: _shards)
+	{
+		n += pShard->pDispatcher->currentConnections();
+	}
+	return n;
 }
 
 
 int TCPServer::maxConcurrentConnections() const
 {
-	return _pDispatcher->maxConcurrentConnections();
+	int n = _pDispatcher->maxConcurrentConnections();
+	for (const auto& pShard: _shards)
+	{
+		n += pShard->pDispatcher->maxConcurrentConnections();
+	}
+	return n;
 }
 
 
 int TCPServer::queuedConnections() const
 {
-	return _pDispatcher->queuedConnections();
+	int n = _pDispatcher->queuedConnections();
+	for (const auto& pShard: _shards)
+	{
+		n += pShard->pDispatcher->queuedConnections();
+	}
+	return n;
 }
 
 
 int TCPServer::refusedConnections() const
 {
-	return _pDispatcher->refusedConnections();
+	int n = _pDispatcher->refusedConnections();
+	for (const auto& pShard: _shards)
+	{
+		n += pShard->pDispatcher->refusedConnections();
+	}
+	return n;
+}
+
+
+int TCPServer::currentThreads(int shard) const
+{
+	return dispatcher(shard).currentThreads();
+}
+
+
+int TCPServer::totalConnections(int shard) const
+{
+	return dispatcher(shard).totalConnections();
+}
+
+
+int TCPServer::currentConnections(int shard) const
+{
+	return dispatcher(shard).currentConnections();
+}
+
+
+int TCPServer::queuedConnections(int shard) const
+{
+	return dispatcher(shard).queuedConnections();
+}
+
+
+int TCPServer::refusedConnections(int shard) const
+{
+	return dispatcher(shard).refusedConnections();
 }
 
 
@@ -240,4 +367,75 @@ std::string TCPServer::threadName(const ServerSocket& socket)
 }
 
 
+const TCPServerDispatcher& TCPServer::dispatcher(int shard) const
+{
+	poco_assert (shard >= 0 && shard < shards());
+
+	if (shard == 0)
+		return *_pDispatcher;
+	else
+		return *_shards[shard - 1]->pDispatcher;
+}
+
+
+void TCPServer::createShards(TCPServerConnectionFactory::Ptr pFactory, const TCPServerParams::Ptr& pParams)
+{
+	int maxThreads = pParams->getMaxThreads() > 0 ? pParams->getMaxThreads() : 16;
+	SocketAddress address = _socket.address();
+	for (int i = 1; i < pParams->getShards(); i++)
+	{
+		std::unique_ptr<Shard> pShard(new Shard);
+		pShard->socket = createSocket(address, pParams);
+		pShard->pThreadPool.reset(new Poco::ThreadPool(2, maxThreads));
+		pShard->pDispatcher = new TCPServerDispatcher(pFactory, *pShard->pThreadPool, shardParams(pParams, i));
+		pShard->pThread.reset(new Poco::Thread(threadName(pShard->socket)));
+		pShard->cpu = shardCPU(pParams, i);
+		_shards.push_back(std::move(pShard));
+	}
+	_pThreadPool.reset(new Poco::ThreadPool(2, maxThreads));
+	_pDispatcher = new TCPServerDispatcher(pFactory, *_pThreadPool, shardParams(pParams, 0));
+}
+
+
+ServerSocket TCPServer::createSocket(const SocketAddress& address, const TCPServerParams::Ptr& pParams)
+{
+	if (pParams && pParams->getShards() > 1)
+	{
+		ServerSocket socket;
+		socket.bind(address, true, true);
+		socket.listen();
+		return socket;
+	}
+	else return ServerSocket(address);
+}
+
+
+TCPServerParams::Ptr TCPServer::shardParams(const TCPServerParams::Ptr& pParams, int shard)
+{
+	TCPServerParams::Ptr pShardParams = new TCPServerParams;
+	pShardParams->setThreadIdleTime(pParams->getThreadIdleTime());
+	if (pParams->getMaxThreads() > 0)
+		pShardParams->setMaxThreads(pParams->getMaxThreads());
+	pShardParams->setMaxQueued(pParams->getMaxQueued());
+	pShardParams->setThreadPriority(pParams->getThreadPriority());
+	pShardParams->setShards(pParams->getShards());
+	pShardParams->setShardAffinity(pParams->getShardAffinity());
+	pShardParams->setThreadAffinity(pParams->getThreadAffinity());
+	int cpu = shardCPU(pParams, shard);
+	if (cpu >= 0) pShardParams->setThreadAffinity(cpu);
+	return pShardParams;
+}
+
+
+int TCPServer::shardCPU(const TCPServerParams::Ptr& pParams, int shard)
+{
+	if (pParams && pParams->getShards() > 1 && pParams->getShardAffinity())
+	{
+		int cpus = static_cast<int>(Poco::Environment::processorCount());
+		return cpus > 0 ? shard % cpus : -1;
+	}
+	else return -1;
+}
+
+
 } } // namespace Poco::Net
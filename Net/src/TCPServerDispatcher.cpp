@@ -59,13 +59,15 @@ TCPServerDispatcher::TCPServerDispatcher(TCPServerConnectionFactory::Ptr pFactor
 	_rc(1),
 	_pParams(pParams),
 	_currentThreads(0),
+	_tasks(0),
 	_totalConnections(0),
 	_currentConnections(0),
 	_maxConcurrentConnections(0),
 	_refusedConnections(0),
 	_stopped(false),
 	_pConnectionFactory(pFactory),
-	_threadPool(threadPool)
+	_pThreadPool(&threadPool),
+	_pExecutor(0)
 {
 	poco_check_ptr (pFactory);
 
@@ -77,6 +79,30 @@ TCPServerDispatcher::TCPServerDispatcher(TCPServerConnectionFactory::Ptr pFactor
 }
 
 
+TCPServerDispatcher::TCPServerDispatcher(TCPServerConnectionFactory::Ptr pFactory, Poco::WorkStealingExecutor& executor, TCPServerParams::Ptr pParams):
+	_rc(1),
+	_pParams(pParams),
+	_currentThreads(0),
+	_tasks(0),
+	_totalConnections(0),
+	_currentConnections(0),
+	_maxConcurrentConnections(0),
+	_refusedConnections(0),
+	_stopped(false),
+	_pConnectionFactory(pFactory),
+	_pThreadPool(0),
+	_pExecutor(&executor)
+{
+	poco_check_ptr (pFactory);
+
+	if (!_pParams)
+		_pParams = new TCPServerParams;
+
+	if (_pParams->getMaxThreads() == 0)
+		_pParams->setMaxThreads(executor.threads());
+}
+
+
 TCPServerDispatcher::~TCPServerDispatcher()
 {
 }
@@ -100,6 +126,12 @@ void TCPServerDispatcher::run()
 
 	int idleTime = (int) _pParams->getThreadIdleTime().totalMilliseconds();
 
+	if (_pParams->getThreadAffinity() >= 0)
+	{
+		Poco::Thread* pThread = Poco::Thread::current();
+		if (pThread) pThread->setAffinity(_pParams->getThreadAffinity());
+	}
+
 	for (;;)
 	{
 		{
@@ -126,6 +158,7 @@ void TCPServerDispatcher::run()
 		}
 		if (_stopped || (_currentThreads > 1 && _queue.empty())) break;
 	}
+	--_tasks;
 }
 
 
@@ -144,19 +177,26 @@ void TCPServerDispatcher::enqueue(const StreamSocket& socket)
 		_queue.enqueueNotification(new TCPConnectionNotification(socket));
 		if (!_queue.hasIdleThreads() && _currentThreads < _pParams->getMaxThreads())
 		{
+			// Ensure this object lives at least until run() starts
+			// Small chance of leaking if threadpool is stopped before this
+			// work runs, but better than a dangling pointer and crash!
+			++_rc;
+			++_tasks;
+			++_currentThreads;
 			try
 			{
-				_threadPool.startWithPriority(_pParams->getThreadPriority(), *this, threadName);
-				++_currentThreads;
-				// Ensure this object lives at least until run() starts
-				// Small chance of leaking if threadpool is stopped before this
-				// work runs, but better than a dangling pointer and crash!
-				++_rc;
+				if (_pExecutor)
+					_pExecutor->start(*this);
+				else
+					_pThreadPool->startWithPriority(_pParams->getThreadPriority(), *this, threadName);
 			}
 			catch (Poco::Exception&)
 			{
 				// no problem here, connection is already queued
 				// and a new thread might be available later.
+				--_currentThreads;
+				--_tasks;
+				--_rc;
 			}
 		}
 	}
@@ -172,7 +212,11 @@ void TCPServerDispatcher::stop()
 	FastMutex::ScopedLock lock(_mutex);
 	_stopped = true;
 	_queue.clear();
-	for (int i = 0; i < _threadPool.allocated(); i++)
+	// _currentThreads does not include tasks that are about to exit
+	// after becoming idle, so every task started in enqueue() and
+	// not yet returned from run() gets a StopNotification
+	int threads = _pExecutor ? _tasks.load() : _pThreadPool->allocated();
+	for (int i = 0; i < threads; i++)
 	{
 		_queue.enqueueNotification(new StopNotification);
 	}
@@ -188,7 +232,7 @@ int TCPServerDispatcher::maxThreads() const
 {
 	std::lock_guard<std::mutex> lock(_mutex);
 
-	return _threadPool.capacity();
+	return _pExecutor ? _pExecutor->threads() : _pThreadPool->capacity();
 }
 
 
@@ -23,7 +23,10 @@ TCPServerParams::TCPServerParams():
 	_threadIdleTime(10000000),
 	_maxThreads(0),
 	_maxQueued(64),
-	_threadPriority(Poco::Thread::PRIO_NORMAL)
+	_threadPriority(Poco::Thread::PRIO_NORMAL),
+	_shards(1),
+	_shardAffinity(false),
+	_threadAffinity(-1)
 {
 }
 
@@ -61,4 +64,24 @@ void TCPServerParams::setThreadPriority(Poco::Thread::Priority prio)
 }
 
 
+void TCPServerParams::setShards(int count)
+{
+	poco_assert (count > 0);
+
+	_shards = count;
+}
+
+
+void TCPServerParams::setShardAffinity(bool pin)
+{
+	_shardAffinity = pin;
+}
+
+
+void TCPServerParams::setThreadAffinity(int cpu)
+{
+	_threadAffinity = cpu;
+}
+
+
 } } // namespace Poco::Net
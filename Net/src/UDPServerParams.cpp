@@ -24,13 +24,18 @@ UDPServerParams::UDPServerParams(const Poco::Net::SocketAddress& sa,
 	Poco::Timespan timeout,
 	std::size_t handlerBufListSize,
 	bool notifySender,
-	int  backlogThreshold): _sa(sa),
+	int  backlogThreshold,
+	std::size_t batchSize,
+	bool receiveOffload): _sa(sa),
 		_nSockets(nSockets),
 		_timeout(timeout),
 		_handlerBufListSize(handlerBufListSize),
 		_notifySender(notifySender),
-		_backlogThreshold(backlogThreshold)
+		_backlogThreshold(backlogThreshold),
+		_batchSize(batchSize),
+		_receiveOffload(receiveOffload)
 {
+	poco_assert (batchSize > 0);
 }
 
 
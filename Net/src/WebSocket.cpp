@@ -45,6 +45,12 @@ WebSocket::WebSocket(HTTPServerRequest& request, HTTPServerResponse& response):
 }
 
 
+WebSocket::WebSocket(HTTPServerRequest& request, HTTPServerResponse& response, const PerMessageDeflate::Config& compression):
+	StreamSocket(accept(request, response, &compression))
+{
+}
+
+
 WebSocket::WebSocket(HTTPClientSession& cs, HTTPRequest& request, HTTPResponse& response):
 	StreamSocket(connect(cs, request, response, _defaultCreds))
 {
@@ -57,6 +63,12 @@ WebSocket::WebSocket(HTTPClientSession& cs, HTTPRequest& request, HTTPResponse&
 }
 
 
+WebSocket::WebSocket(HTTPClientSession& cs, HTTPRequest& request, HTTPResponse& response, const PerMessageDeflate::Config& compression):
+	StreamSocket(connect(cs, request, response, _defaultCreds, &compression))
+{
+}
+
+
 WebSocket::WebSocket(const Socket& socket):
 	StreamSocket(socket)
 {
@@ -178,6 +190,12 @@ WebSocket::Mode WebSocket::mode() const
 }
 
 
+bool WebSocket::compressionEnabled() const
+{
+	return static_cast<WebSocketImpl*>(impl())->compressionEnabled();
+}
+
+
 void WebSocket::setMaxPayloadSize(int maxPayloadSize)
 {
 	static_cast<WebSocketImpl*>(impl())->setMaxPayloadSize(maxPayloadSize);
@@ -190,7 +208,7 @@ int WebSocket::getMaxPayloadSize() const
 }
 
 
-WebSocketImpl* WebSocket::accept(HTTPServerRequest& request, HTTPServerResponse& response)
+WebSocketImpl* WebSocket::accept(HTTPServerRequest& request, HTTPServerResponse& response, const PerMessageDeflate::Config* pCompression)
 {
 	if (request.hasToken("Connection", "upgrade") && icompare(request.get("Upgrade", ""), "websocket") == 0)
 	{
@@ -205,17 +223,38 @@ WebSocketImpl* WebSocket::accept(HTTPServerRequest& request, HTTPServerResponse&
 		response.set("Upgrade", "websocket");
 		response.set("Connection", "Upgrade");
 		response.set("Sec-WebSocket-Accept", computeAccept(key));
+		PerMessageDeflate::Parameters params;
+		bool compress = false;
+		if (pCompression && request.has("Sec-WebSocket-Extensions"))
+		{
+			std::string extensions;
+			compress = PerMessageDeflate::accept(request.get("Sec-WebSocket-Extensions"), *pCompression, params, extensions);
+			if (compress) response.set("Sec-WebSocket-Extensions", extensions);
+		}
 		response.setContentLength(HTTPResponse::UNKNOWN_CONTENT_LENGTH);
 		response.send().flush();
 
 		HTTPServerRequestImpl& requestImpl = static_cast<HTTPServerRequestImpl&>(request);
-		return new WebSocketImpl(static_cast<StreamSocketImpl*>(requestImpl.detachSocket().impl()), requestImpl.session(), false);
+		WebSocketImpl* pImpl = new WebSocketImpl(static_cast<StreamSocketImpl*>(requestImpl.detachSocket().impl()), requestImpl.session(), false);
+		if (compress)
+		{
+			try
+			{
+				pImpl->enableCompression(new PerMessageDeflate(params, *pCompression, true));
+			}
+			catch (...)
+			{
+				pImpl->release();
+				throw;
+			}
+		}
+		return pImpl;
 	}
 	else throw WebSocketException("No WebSocket handshake", WS_ERR_NO_HANDSHAKE);
 }
 
 
-WebSocketImpl* WebSocket::connect(HTTPClientSession& cs, HTTPRequest& request, HTTPResponse& response, HTTPCredentials& credentials)
+WebSocketImpl* WebSocket::connect(HTTPClientSession& cs, HTTPRequest& request, HTTPResponse& response, HTTPCredentials& credentials, const PerMessageDeflate::Config* pCompression)
 {
 	if (!cs.getProxyHost().empty() && !cs.secure())
 	{
@@ -226,13 +265,15 @@ WebSocketImpl* WebSocket::connect(HTTPClientSession& cs, HTTPRequest& request, H
 	request.set("Upgrade", "websocket");
 	request.set("Sec-WebSocket-Version", WEBSOCKET_VERSION);
 	request.set("Sec-WebSocket-Key", key);
+	if (pCompression)
+		request.set("Sec-WebSocket-Extensions", PerMessageDeflate::offer(*pCompression));
 	request.setChunkedTransferEncoding(false);
 	cs.setKeepAlive(true);
 	cs.sendRequest(request);
 	std::istream& istr = cs.receiveResponse(response);
 	if (response.getStatus() == HTTPResponse::HTTP_SWITCHING_PROTOCOLS)
 	{
-		return completeHandshake(cs, response, key);
+		return completeHandshake(cs, response, key, pCompression);
 	}
 	else if (response.getStatus() == HTTPResponse::HTTP_UNAUTHORIZED)
 	{
@@ -250,7 +291,7 @@ WebSocketImpl* WebSocket::connect(HTTPClientSession& cs, HTTPRequest& request, H
 			cs.receiveResponse(response);
 			if (response.getStatus() == HTTPResponse::HTTP_SWITCHING_PROTOCOLS)
 			{
-				return completeHandshake(cs, response, key);
+				return completeHandshake(cs, response, key, pCompression);
 			}
 			else if (response.getStatus() == HTTPResponse::HTTP_UNAUTHORIZED)
 			{
@@ -270,7 +311,7 @@ WebSocketImpl* WebSocket::connect(HTTPClientSession& cs, HTTPRequest& request, H
 }
 
 
-WebSocketImpl* WebSocket::completeHandshake(HTTPClientSession& cs, HTTPResponse& response, const std::string& key)
+WebSocketImpl* WebSocket::completeHandshake(HTTPClientSession& cs, HTTPResponse& response, const std::string& key, const PerMessageDeflate::Config* pCompression)
 {
 	std::string connection = response.get("Connection", "");
 	if (Poco::icompare(connection, "Upgrade") != 0)
@@ -281,7 +322,27 @@ WebSocketImpl* WebSocket::completeHandshake(HTTPClientSession& cs, HTTPResponse&
 	std::string accept = response.get("Sec-WebSocket-Accept", "");
 	if (accept != computeAccept(key))
 		throw WebSocketException("Invalid or missing Sec-WebSocket-Accept header in handshake response", WS_ERR_HANDSHAKE_ACCEPT);
-	return new WebSocketImpl(static_cast<StreamSocketImpl*>(cs.detachSocket().impl()), cs, true);
+	PerMessageDeflate::Parameters params;
+	bool compress = false;
+	if (pCompression && response.has("Sec-WebSocket-Extensions"))
+	{
+		PerMessageDeflate::confirm(response.get("Sec-WebSocket-Extensions"), *pCompression, params);
+		compress = true;
+	}
+	WebSocketImpl* pImpl = new WebSocketImpl(static_cast<StreamSocketImpl*>(cs.detachSocket().impl()), cs, true);
+	if (compress)
+	{
+		try
+		{
+			pImpl->enableCompression(new PerMessageDeflate(params, *pCompression, false));
+		}
+		catch (...)
+		{
+			pImpl->release();
+			throw;
+		}
+	}
+	return pImpl;
 }
 
 
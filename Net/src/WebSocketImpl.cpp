@@ -17,12 +17,20 @@
 #include "Poco/Net/WebSocket.h"
 #include "Poco/Net/HTTPSession.h"
 #include "Poco/Buffer.h"
-#include "Poco/BinaryWriter.h"
 #include "Poco/BinaryReader.h"
 #include "Poco/MemoryStream.h"
 #include "Poco/Format.h"
+#include "Poco/ByteOrder.h"
 #include <limits>
 #include <cstring>
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define POCO_WEBSOCKET_AVX2
+#endif
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define POCO_WEBSOCKET_SSE2
+#endif
 
 
 namespace Poco {
@@ -36,7 +44,12 @@ WebSocketImpl::WebSocketImpl(StreamSocketImpl* pStreamSocketImpl, HTTPSession& s
 	_buffer(0),
 	_bufferOffset(0),
 	_frameFlags(0),
-	_mustMaskPayload(mustMaskPayload)
+	_mustMaskPayload(mustMaskPayload),
+	_deflating(false),
+	_inflating(false),
+	_deflateBuffer(0),
+	_inflateBuffer(0),
+	_payloadBuffer(0)
 {
 	poco_check_ptr(pStreamSocketImpl);
 	_pStreamSocketImpl->duplicate();
@@ -60,13 +73,36 @@ WebSocketImpl::~WebSocketImpl()
 
 int WebSocketImpl::sendBytes(const void* buffer, int length, int flags)
 {
-	Poco::Buffer<char> frame(length + MAX_HEADER_LENGTH);
-	Poco::MemoryOutputStream ostr(frame.begin(), frame.size());
-	Poco::BinaryWriter writer(ostr, Poco::BinaryWriter::NETWORK_BYTE_ORDER);
-
 	if (flags == 0) flags = WebSocket::FRAME_BINARY;
 	flags &= 0xff;
-	writer << static_cast<Poco::UInt8>(flags);
+
+	if (_pDeflate)
+	{
+		const int opcode = flags & WebSocket::FRAME_OP_BITMASK;
+		const bool fin = (flags & WebSocket::FRAME_FLAG_FIN) != 0;
+		if (opcode == WebSocket::FRAME_OP_TEXT || opcode == WebSocket::FRAME_OP_BINARY)
+		{
+			_deflating = !fin || length >= _pDeflate->minMessageSize();
+			if (_deflating) flags |= WebSocket::FRAME_FLAG_RSV1;
+		}
+		if (_deflating && (opcode == WebSocket::FRAME_OP_TEXT || opcode == WebSocket::FRAME_OP_BINARY || opcode == WebSocket::FRAME_OP_CONT))
+		{
+			_pDeflate->compress(reinterpret_cast<const char*>(buffer), length, fin, _deflateBuffer);
+			if (fin) _deflating = false;
+			sendFrame(_deflateBuffer.begin(), static_cast<int>(_deflateBuffer.size()), flags);
+			return length;
+		}
+	}
+	sendFrame(reinterpret_cast<const char*>(buffer), length, flags);
+	return length;
+}
+
+
+void WebSocketImpl::sendFrame(const char* payload, int length, int flags)
+{
+	char header[MAX_HEADER_LENGTH];
+	int headerLength = 0;
+	header[headerLength++] = static_cast<char>(flags);
 	Poco::UInt8 lengthByte(0);
 	if (_mustMaskPayload)
 	{
@@ -75,36 +111,98 @@ int WebSocketImpl::sendBytes(const void* buffer, int length, int flags)
 	if (length < 126)
 	{
 		lengthByte |= static_cast<Poco::UInt8>(length);
-		writer << lengthByte;
+		header[headerLength++] = static_cast<char>(lengthByte);
 	}
 	else if (length < 65536)
 	{
 		lengthByte |= 126;
-		writer << lengthByte << static_cast<Poco::UInt16>(length);
+		header[headerLength++] = static_cast<char>(lengthByte);
+		Poco::UInt16 l = Poco::ByteOrder::toNetwork(static_cast<Poco::UInt16>(length));
+		std::memcpy(header + headerLength, &l, sizeof(l));
+		headerLength += sizeof(l);
 	}
 	else
 	{
 		lengthByte |= 127;
-		writer << lengthByte << static_cast<Poco::UInt64>(length);
+		header[headerLength++] = static_cast<char>(lengthByte);
+		Poco::UInt64 l = Poco::ByteOrder::toNetwork(static_cast<Poco::UInt64>(length));
+		std::memcpy(header + headerLength, &l, sizeof(l));
+		headerLength += sizeof(l);
 	}
+
 	if (_mustMaskPayload)
 	{
 		const Poco::UInt32 mask = _rnd.next();
-		const char* m = reinterpret_cast<const char*>(&mask);
-		const char* b = reinterpret_cast<const char*>(buffer);
-		writer.writeRaw(m, 4);
-		char* p = frame.begin() + ostr.charsWritten();
-		for (int i = 0; i < length; i++)
+		std::memcpy(header + headerLength, &mask, 4);
+		headerLength += 4;
+		Poco::Buffer<char> frame(length + headerLength);
+		std::memcpy(frame.begin(), header, headerLength);
+		maskPayload(frame.begin() + headerLength, payload, length, header + headerLength - 4);
+		_pStreamSocketImpl->sendBytes(frame.begin(), length + headerLength);
+	}
+	else if (length >= VECTORED_SEND_THRESHOLD && !_pStreamSocketImpl->secure() && _pStreamSocketImpl->getBlocking())
+	{
+		// send header and payload with a single writev() to avoid
+		// copying the payload into a frame buffer
+		SocketBufVec buffers(2);
+		buffers[0] = Socket::makeBuffer(header, headerLength);
+		buffers[1] = Socket::makeBuffer(const_cast<char*>(payload), length);
+		int sent = static_cast<SocketImpl*>(_pStreamSocketImpl)->sendBytes(buffers);
+		if (sent < headerLength)
+		{
+			_pStreamSocketImpl->sendBytes(header + sent, headerLength - sent);
+			sent = headerLength;
+		}
+		if (sent - headerLength < length)
 		{
-			p[i] = b[i] ^ m[i % 4];
+			_pStreamSocketImpl->sendBytes(payload + sent - headerLength, length - (sent - headerLength));
 		}
 	}
 	else
 	{
-		std::memcpy(frame.begin() + ostr.charsWritten(), buffer, length);
+		Poco::Buffer<char> frame(length + headerLength);
+		std::memcpy(frame.begin(), header, headerLength);
+		std::memcpy(frame.begin() + headerLength, payload, length);
+		_pStreamSocketImpl->sendBytes(frame.begin(), length + headerLength);
+	}
+}
+
+
+void WebSocketImpl::maskPayload(char* dest, const char* src, std::size_t length, const char mask[4])
+{
+	std::size_t i = 0;
+	Poco::UInt32 mask32;
+	std::memcpy(&mask32, mask, 4);
+#if defined(POCO_WEBSOCKET_AVX2)
+	const __m256i mask256 = _mm256_set1_epi32(static_cast<int>(mask32));
+	for (; i + 32 <= length; i += 32)
+	{
+		__m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(dest + i), _mm256_xor_si256(v, mask256));
+	}
+#endif
+#if defined(POCO_WEBSOCKET_SSE2)
+	const __m128i mask128 = _mm_set1_epi32(static_cast<int>(mask32));
+	for (; i + 16 <= length; i += 16)
+	{
+		__m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(dest + i), _mm_xor_si128(v, mask128));
+	}
+#endif
+	// all block sizes are multiples of 4, so the
+	// mask stays aligned with the payload offset
+	const Poco::UInt64 mask64 = (static_cast<Poco::UInt64>(mask32) << 32) | mask32;
+	for (; i + 8 <= length; i += 8)
+	{
+		Poco::UInt64 v;
+		std::memcpy(&v, src + i, 8);
+		v ^= mask64;
+		std::memcpy(dest + i, &v, 8);
+	}
+	for (; i < length; i++)
+	{
+		dest[i] = src[i] ^ mask[i % 4];
 	}
-	_pStreamSocketImpl->sendBytes(frame.begin(), length + static_cast<int>(ostr.charsWritten()));
-	return length;
 }
 
 
@@ -174,6 +272,12 @@ int WebSocketImpl::receiveHeader(char mask[4], bool& useMask)
 }
 
 
+void WebSocketImpl::enableCompression(PerMessageDeflate* pDeflate)
+{
+	_pDeflate.reset(pDeflate);
+}
+
+
 void WebSocketImpl::setMaxPayloadSize(int maxPayloadSize)
 {
 	poco_assert (maxPayloadSize > 0);
@@ -189,21 +293,52 @@ int WebSocketImpl::receivePayload(char *buffer, int payloadLength, char mask[4],
 
 	if (useMask)
 	{
-		for (int i = 0; i < received; i++)
-		{
-			buffer[i] ^= mask[i % 4];
-		}
+		maskPayload(buffer, buffer, received, mask);
 	}
 	return received;
 }
 
 
+bool WebSocketImpl::compressedFrame()
+{
+	if (!_pDeflate || _frameFlags == 0) return false;
+
+	const int opcode = _frameFlags & WebSocket::FRAME_OP_BITMASK;
+	if (opcode == WebSocket::FRAME_OP_TEXT || opcode == WebSocket::FRAME_OP_BINARY)
+	{
+		_inflating = (_frameFlags & WebSocket::FRAME_FLAG_RSV1) != 0;
+		_frameFlags &= ~WebSocket::FRAME_FLAG_RSV1;
+	}
+	else if (opcode != WebSocket::FRAME_OP_CONT)
+	{
+		return false;
+	}
+	return _inflating;
+}
+
+
+void WebSocketImpl::receiveCompressedPayload(Poco::Buffer<char>& buffer, int payloadLength, char mask[4], bool useMask, std::size_t maxLength)
+{
+	_payloadBuffer.resize(payloadLength, false);
+	if (payloadLength > 0)
+		receivePayload(_payloadBuffer.begin(), payloadLength, mask, useMask);
+	_pDeflate->decompress(_payloadBuffer.begin(), _payloadBuffer.size(), (_frameFlags & WebSocket::FRAME_FLAG_FIN) != 0, buffer, maxLength);
+}
+
+
 int WebSocketImpl::receiveBytes(void* buffer, int length, int)
 {
 	char mask[4];
 	bool useMask;
 	_frameFlags = 0;
 	int payloadLength = receiveHeader(mask, useMask);
+	if (compressedFrame())
+	{
+		_inflateBuffer.resize(0, false);
+		receiveCompressedPayload(_inflateBuffer, payloadLength, mask, useMask, length < _maxPayloadSize ? length : _maxPayloadSize);
+		std::memcpy(buffer, _inflateBuffer.begin(), _inflateBuffer.size());
+		return static_cast<int>(_inflateBuffer.size());
+	}
 	if (payloadLength <= 0)
 		return payloadLength;
 	if (payloadLength > length)
@@ -218,9 +353,14 @@ int WebSocketImpl::receiveBytes(Poco::Buffer<char>& buffer, int, const Poco::Tim
 	bool useMask;
 	_frameFlags = 0;
 	int payloadLength = receiveHeader(mask, useMask);
+	std::size_t oldSize = buffer.size();
+	if (compressedFrame())
+	{
+		receiveCompressedPayload(buffer, payloadLength, mask, useMask, oldSize + _maxPayloadSize);
+		return static_cast<int>(buffer.size() - oldSize);
+	}
 	if (payloadLength <= 0)
 		return payloadLength;
-	std::size_t oldSize = buffer.size();
 	buffer.resize(oldSize + payloadLength);
 	return receivePayload(buffer.begin() + oldSize, payloadLength, mask, useMask);
 }
@@ -14,6 +14,10 @@
 #include "Poco/Net/DNS.h"
 #include "Poco/Net/HostEntry.h"
 #include "Poco/Net/NetException.h"
+#include "Poco/Net/SocketAddress.h"
+#include "Poco/TemporaryFile.h"
+#include "Poco/FileStream.h"
+#include "Poco/Thread.h"
 
 
 using Poco::Net::DNS;
@@ -23,6 +27,45 @@ using Poco::Net::InvalidAddressException;
 using Poco::Net::HostNotFoundException;
 using Poco::Net::ServiceNotFoundException;
 using Poco::Net::NoAddressFoundException;
+using Poco::Net::DNSCache;
+using Poco::TemporaryFile;
+using Poco::Timespan;
+
+
+namespace
+{
+	void writeHosts(const std::string& path, const std::string& hosts)
+	{
+		Poco::FileOutputStream ostr(path);
+		ostr << hosts;
+	}
+
+	class HostsFileScope
+		/// Makes DNS use a temporary hosts file exclusively,
+		/// and restores the defaults when destroyed.
+	{
+	public:
+		HostsFileScope(const std::string& hosts)
+		{
+			writeHosts(_file.path(), hosts);
+			DNS::setHostsFile(_file.path(), true);
+		}
+
+		~HostsFileScope()
+		{
+			DNS::setHostsFile("");
+			DNS::disableCache();
+		}
+
+		const std::string& path() const
+		{
+			return _file.path();
+		}
+
+	private:
+		TemporaryFile _file;
+	};
+}
 
 
 DNSTest::DNSTest(const std::string& name): CppUnit::TestCase(name)
@@ -190,6 +233,147 @@ void DNSTest::testDecodeIDN()
 }
 
 
+void DNSTest::testHostsFile()
+{
+	HostsFileScope hosts(
+		"# test hosts\n"
+		"10.1.1.1\tweb.poco.test web\n"
+		"10.1.1.2 web.poco.test\n"
+		"10.1.1.3  DB.poco.test db # database\n"
+		"invalid line\n");
+
+	HostEntry he = DNS::hostByName("web.poco.test");
+	assertTrue (he.name() == "web.poco.test");
+	assertTrue (he.addresses().size() == 2);
+	assertTrue (he.addresses()[0].toString() == "10.1.1.1");
+	assertTrue (he.addresses()[1].toString() == "10.1.1.2");
+
+	he = DNS::resolve("web");
+	assertTrue (he.name() == "web.poco.test");
+	assertTrue (he.addresses().size() == 1);
+
+	he = DNS::hostByName("db.poco.test");
+	assertTrue (he.name() == "DB.poco.test");
+	assertTrue (he.aliases().size() == 1);
+	assertTrue (he.aliases()[0] == "db");
+	assertTrue (DNS::resolveOne("db").toString() == "10.1.1.3");
+
+	Poco::Net::SocketAddress sa("db.poco.test", 8080);
+	assertTrue (sa.toString() == "10.1.1.3:8080");
+
+	try
+	{
+		DNS::hostByName("nohost.poco.test");
+		fail("host not found - must throw");
+	}
+	catch (HostNotFoundException&)
+	{
+	}
+}
+
+
+void DNSTest::testCache()
+{
+	HostsFileScope hosts("10.1.1.1 cached.poco.test\n");
+
+	DNS::enableCache(16, Timespan(60, 0), Timespan(5, 0));
+	assertTrue (DNS::cacheEnabled());
+	assertTrue (DNS::resolveOne("cached.poco.test").toString() == "10.1.1.1");
+	assertTrue (DNS::resolveOne("CACHED.poco.test").toString() == "10.1.1.1");
+
+	DNSCache::Statistics stats = DNS::cacheStatistics();
+	assertTrue (stats.misses == 1);
+	assertTrue (stats.hits == 1);
+	assertTrue (stats.size == 1);
+
+	DNS::flushCache();
+	assertTrue (DNS::cacheStatistics().size == 0);
+
+	writeHosts(hosts.path(), "10.1.1.2 cached.poco.test\n");
+	DNS::setHostsFile(hosts.path(), true);
+	assertTrue (DNS::resolveOne("cached.poco.test").toString() == "10.1.1.2");
+
+	DNS::disableCache();
+	assertTrue (!DNS::cacheEnabled());
+
+	// entries expire after the TTL
+	DNSCache cache(16, Timespan(0, 100000));
+	cache.add("name", HostEntry("name", HostEntry::AddressList(1, IPAddress("10.1.1.4"))));
+	HostEntry entry;
+	assertTrue (cache.get("name", entry));
+	assertTrue (entry.addresses()[0].toString() == "10.1.1.4");
+	Poco::Thread::sleep(200);
+	assertTrue (!cache.get("name", entry));
+}
+
+
+void DNSTest::testNegativeCache()
+{
+	HostsFileScope hosts("10.1.1.1 known.poco.test\n");
+
+	DNS::enableCache(16, Timespan(60, 0), Timespan(60, 0));
+	for (int i = 0; i < 3; i++)
+	{
+		try
+		{
+			DNS::hostByName("unknown.poco.test");
+			fail("host not found - must throw");
+		}
+		catch (HostNotFoundException&)
+		{
+		}
+	}
+	DNSCache::Statistics stats = DNS::cacheStatistics();
+	assertTrue (stats.misses == 1);
+	assertTrue (stats.negativeHits == 2);
+
+	// a negative TTL of zero disables negative caching
+	DNS::enableCache(16, Timespan(60, 0), Timespan(0, 0));
+	for (int i = 0; i < 2; i++)
+	{
+		try
+		{
+			DNS::hostByName("unknown.poco.test");
+			fail("host not found - must throw");
+		}
+		catch (HostNotFoundException&)
+		{
+		}
+	}
+	stats = DNS::cacheStatistics();
+	assertTrue (stats.misses == 2);
+	assertTrue (stats.negativeHits == 0);
+
+	// the least recently used entries are evicted
+	DNSCache cache(2);
+	HostEntry::AddressList addresses(1, IPAddress("10.1.1.1"));
+	cache.add("a", HostEntry("a", addresses));
+	cache.add("b", HostEntry("b", addresses));
+	HostEntry entry;
+	assertTrue (cache.get("a", entry));
+	cache.add("c", HostEntry("c", addresses));
+	assertTrue (cache.get("a", entry));
+	assertTrue (!cache.get("b", entry));
+	assertTrue (cache.get("c", entry));
+}
+
+
+void DNSTest::testResolveAsync()
+{
+	HostsFileScope hosts("10.1.1.1 async.poco.test\n");
+
+	Poco::ActiveResult<HostEntry> result1 = DNS::resolveAsync("async.poco.test");
+	Poco::ActiveResult<HostEntry> result2 = DNS::resolveAsync("unknown.poco.test");
+	result1.wait();
+	assertTrue (!result1.failed());
+	assertTrue (result1.data().addresses()[0].toString() == "10.1.1.1");
+
+	result2.wait();
+	assertTrue (result2.failed());
+	assertTrue (dynamic_cast<const HostNotFoundException*>(result2.exception()) != 0);
+}
+
+
 void DNSTest::setUp()
 {
 }
@@ -209,6 +393,10 @@ CppUnit::Test* DNSTest::suite()
 	CppUnit_addTest(pSuite, DNSTest, testResolve);
 	CppUnit_addTest(pSuite, DNSTest, testEncodeIDN);
 	CppUnit_addTest(pSuite, DNSTest, testDecodeIDN);
+	CppUnit_addTest(pSuite, DNSTest, testHostsFile);
+	CppUnit_addTest(pSuite, DNSTest, testCache);
+	CppUnit_addTest(pSuite, DNSTest, testNegativeCache);
+	CppUnit_addTest(pSuite, DNSTest, testResolveAsync);
 
 	return pSuite;
 }
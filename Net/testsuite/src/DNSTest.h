@@ -29,6 +29,10 @@ public:
 	void testResolve();
 	void testEncodeIDN();
 	void testDecodeIDN();
+	void testHostsFile();
+	void testCache();
+	void testNegativeCache();
+	void testResolveAsync();
 
 	void setUp();
 	void tearDown();
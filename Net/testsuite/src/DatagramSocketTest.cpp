@@ -19,6 +19,8 @@
 #include "Poco/Buffer.h"
 #include "Poco/Stopwatch.h"
 #include "Poco/Thread.h"
+#include <algorithm>
+#include <iostream>
 #include <cstring>
 
 
@@ -26,6 +28,8 @@ using Poco::Net::Socket;
 using Poco::Net::DatagramSocket;
 using Poco::Net::SocketAddress;
 using Poco::Net::IPAddress;
+using Poco::Net::SocketMsg;
+using Poco::Net::SocketMsgVec;
 #ifdef POCO_NET_HAS_INTERFACE
 	using Poco::Net::NetworkInterface;
 #endif
@@ -158,6 +162,136 @@ void DatagramSocketTest::testSendToReceiveFrom()
 }
 
 
+void DatagramSocketTest::testSendReceiveBatch()
+{
+	DatagramSocket receiver(SocketAddress("127.0.0.1", 0), false);
+	receiver.setReceiveTimeout(Timespan(5, 0));
+	DatagramSocket sender(SocketAddress("127.0.0.1", 0), false);
+	SocketAddress target = receiver.address();
+
+	const int count = 20;
+	std::vector<std::string> payloads;
+	for (int i = 0; i < count; ++i) payloads.push_back(std::string(i + 1, static_cast<char>('a' + i)));
+	SocketMsgVec out(count);
+	for (int i = 0; i < count; ++i)
+	{
+		out[i].buffer = const_cast<char*>(payloads[i].data());
+		out[i].capacity = static_cast<int>(payloads[i].size());
+		out[i].pAddress = const_cast<struct sockaddr*>(target.addr());
+		out[i].addressLength = target.length();
+		out[i].length = 0;
+	}
+	int sent = 0;
+	while (sent < count)
+	{
+		SocketMsgVec rest(out.begin() + sent, out.end());
+		int n = sender.sendBatch(rest);
+		assertTrue (n > 0);
+		for (int i = 0; i < n; ++i) assertTrue (rest[i].length == rest[i].capacity);
+		sent += n;
+	}
+
+	std::vector<Buffer<char> > buffers;
+	for (int i = 0; i < count; ++i) buffers.emplace_back(256);
+	int received = 0;
+	while (received < count)
+	{
+		SocketMsgVec in(count - received);
+		char addrBuf[count][SocketAddress::MAX_ADDRESS_LENGTH];
+		for (std::size_t i = 0; i < in.size(); ++i)
+		{
+			in[i].buffer = buffers[received + i].begin();
+			in[i].capacity = static_cast<int>(buffers[received + i].size());
+			in[i].pAddress = reinterpret_cast<struct sockaddr*>(addrBuf[i]);
+			in[i].addressLength = SocketAddress::MAX_ADDRESS_LENGTH;
+			in[i].length = 0;
+		}
+		int n = receiver.receiveBatch(in);
+		assertTrue (n > 0);
+		for (int i = 0; i < n; ++i)
+		{
+			assertTrue (std::string(buffers[received + i].begin(), in[i].length) == payloads[received + i]);
+			SocketAddress from(in[i].pAddress, in[i].addressLength);
+			assertTrue (from == sender.address());
+		}
+		received += n;
+	}
+	sender.close();
+	receiver.close();
+}
+
+
+void DatagramSocketTest::testSegmentationOffload()
+{
+	DatagramSocket receiver(SocketAddress("127.0.0.1", 0), false);
+	receiver.setReceiveTimeout(Timespan(5, 0));
+	try
+	{
+		receiver.setReceiveOffload(true);
+	}
+	catch (Poco::NotImplementedException&)
+	{
+		std::cerr << "UDP offload not supported, test skipped" << std::endl;
+		return;
+	}
+	catch (Poco::IOException&)
+	{
+		std::cerr << "UDP offload not supported by kernel, test skipped" << std::endl;
+		return;
+	}
+	assertTrue (receiver.getReceiveOffload());
+
+	const int segmentSize = 1000;
+	const int segments = 40;
+	std::string data;
+	for (int i = 0; i < segments; ++i) data.append(segmentSize - (i == segments - 1 ? 500 : 0), static_cast<char>('A' + i));
+
+	DatagramSocket sender(SocketAddress("127.0.0.1", 0), false);
+	int n = sender.sendSegments(data.data(), static_cast<int>(data.size()), segmentSize, receiver.address());
+	assertTrue (n == static_cast<int>(data.size()));
+
+	Buffer<char> buffer(65536);
+	std::string received;
+	int datagrams = 0;
+	while (received.size() < data.size())
+	{
+		SocketAddress sa;
+		int segment = 0;
+		n = receiver.receiveSegments(buffer.begin(), static_cast<int>(buffer.size()), sa, segment);
+		assertTrue (n > 0);
+		assertTrue (sa == sender.address());
+		assertTrue (segment == segmentSize || (n == segment && n <= segmentSize));
+		// every segment is a separate datagram
+		for (int off = 0; off < n; off += segment)
+		{
+			const char* p = buffer.begin() + off;
+			int len = std::min(segment, n - off);
+			assertTrue (std::string(len, *p) == std::string(p, len));
+			++datagrams;
+		}
+		received.append(buffer.begin(), n);
+	}
+	assertTrue (received == data);
+	assertTrue (datagrams == segments);
+
+	// without receive offload, every segment arrives as a separate datagram
+	receiver.setReceiveOffload(false);
+	n = sender.sendSegments(data.data(), 3*segmentSize, segmentSize, receiver.address());
+	assertTrue (n == 3*segmentSize);
+	for (int i = 0; i < 3; ++i)
+	{
+		SocketAddress sa;
+		int segment = 0;
+		n = receiver.receiveSegments(buffer.begin(), static_cast<int>(buffer.size()), sa, segment);
+		assertTrue (n == segmentSize);
+		assertTrue (segment == segmentSize);
+	}
+
+	sender.close();
+	receiver.close();
+}
+
+
 void DatagramSocketTest::testUnbound()
 {
 	UDPEchoServer echoServer;
@@ -823,6 +957,8 @@ CppUnit::Test* DatagramSocketTest::suite()
 	CppUnit_addTest(pSuite, DatagramSocketTest, testEchoBuffer);
 	CppUnit_addTest(pSuite, DatagramSocketTest, testReceiveFromAvailable);
 	CppUnit_addTest(pSuite, DatagramSocketTest, testSendToReceiveFrom);
+	CppUnit_addTest(pSuite, DatagramSocketTest, testSendReceiveBatch);
+	CppUnit_addTest(pSuite, DatagramSocketTest, testSegmentationOffload);
 	CppUnit_addTest(pSuite, DatagramSocketTest, testUnbound);
 	CppUnit_addTest(pSuite, DatagramSocketTest, testReuseAddressPortWildcard);
 	CppUnit_addTest(pSuite, DatagramSocketTest, testReuseAddressPortSpecific);
@@ -30,6 +30,8 @@ public:
 	void testEchoBuffer();
 	void testReceiveFromAvailable();
 	void testSendToReceiveFrom();
+	void testSendReceiveBatch();
+	void testSegmentationOffload();
 	void testUnbound();
 	void testReuseAddressPortWildcard();
 	void testReuseAddressPortSpecific();
@@ -0,0 +1,161 @@
+//
+// HTTPBufferAllocatorTest.cpp
+//
+// Copyright (c) 2005-2023, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "HTTPBufferAllocatorTest.h"
+#include "CppUnit/TestCaller.h"
+#include "CppUnit/TestSuite.h"
+#include "Poco/Net/HTTPBufferAllocator.h"
+#include "Poco/Thread.h"
+#include <cstring>
+
+
+using Poco::Net::HTTPBufferAllocator;
+using Poco::Thread;
+
+
+HTTPBufferAllocatorTest::HTTPBufferAllocatorTest(const std::string& name): CppUnit::TestCase(name)
+{
+}
+
+
+HTTPBufferAllocatorTest::~HTTPBufferAllocatorTest()
+{
+}
+
+
+void HTTPBufferAllocatorTest::testSizeClasses()
+{
+	HTTPBufferAllocator::resetStatistics();
+
+	char* pSmall = HTTPBufferAllocator::allocate(100);
+	std::memset(pSmall, 'x', HTTPBufferAllocator::SMALL_BUFFER_SIZE);
+	char* pMedium = HTTPBufferAllocator::allocate(10000);
+	std::memset(pMedium, 'x', HTTPBufferAllocator::MEDIUM_BUFFER_SIZE);
+	char* pLarge = HTTPBufferAllocator::allocate(HTTPBufferAllocator::LARGE_BUFFER_SIZE);
+	std::memset(pLarge, 'x', HTTPBufferAllocator::LARGE_BUFFER_SIZE);
+	char* pHuge = HTTPBufferAllocator::allocate(100000);
+	std::memset(pHuge, 'x', 100000);
+
+	assertTrue (HTTPBufferAllocator::statistics(HTTPBufferAllocator::SMALL_BUFFER_SIZE).allocations == 1);
+	assertTrue (HTTPBufferAllocator::statistics(HTTPBufferAllocator::MEDIUM_BUFFER_SIZE).allocations == 1);
+	assertTrue (HTTPBufferAllocator::statistics(HTTPBufferAllocator::LARGE_BUFFER_SIZE).allocations == 1);
+
+	HTTPBufferAllocator::deallocate(pSmall, 100);
+	HTTPBufferAllocator::deallocate(pMedium, 10000);
+	HTTPBufferAllocator::deallocate(pLarge, HTTPBufferAllocator::LARGE_BUFFER_SIZE);
+	HTTPBufferAllocator::deallocate(pHuge, 100000);
+
+	try
+	{
+		HTTPBufferAllocator::statistics(100000);
+		fail("no size class - must throw");
+	}
+	catch (Poco::InvalidArgumentException&)
+	{
+	}
+}
+
+
+void HTTPBufferAllocatorTest::testThreadCache()
+{
+	HTTPBufferAllocator::setThreadCacheCapacity(HTTPBufferAllocator::DEFAULT_THREAD_CACHE_CAPACITY);
+	char* p1 = HTTPBufferAllocator::allocate(HTTPBufferAllocator::BUFFER_SIZE);
+	HTTPBufferAllocator::deallocate(p1, HTTPBufferAllocator::BUFFER_SIZE);
+	HTTPBufferAllocator::resetStatistics();
+
+	char* p2 = HTTPBufferAllocator::allocate(HTTPBufferAllocator::BUFFER_SIZE);
+	assertTrue (p2 == p1);
+	HTTPBufferAllocator::Statistics stats = HTTPBufferAllocator::statistics(HTTPBufferAllocator::BUFFER_SIZE);
+	assertTrue (stats.allocations == 1);
+	assertTrue (stats.cacheHits == 1);
+	assertTrue (stats.poolHits == 0);
+	assertTrue (stats.misses == 0);
+	HTTPBufferAllocator::deallocate(p2, HTTPBufferAllocator::BUFFER_SIZE);
+}
+
+
+void HTTPBufferAllocatorTest::testPool()
+{
+	HTTPBufferAllocator::setThreadCacheCapacity(0);
+	HTTPBufferAllocator::setPoolCapacity(HTTPBufferAllocator::MEDIUM_BUFFER_SIZE, 0);
+	HTTPBufferAllocator::setPoolCapacity(HTTPBufferAllocator::MEDIUM_BUFFER_SIZE, 1);
+	assertTrue (HTTPBufferAllocator::getPoolCapacity(HTTPBufferAllocator::MEDIUM_BUFFER_SIZE) == 1);
+	HTTPBufferAllocator::resetStatistics();
+
+	char* p1 = HTTPBufferAllocator::allocate(HTTPBufferAllocator::MEDIUM_BUFFER_SIZE);
+	char* p2 = HTTPBufferAllocator::allocate(HTTPBufferAllocator::MEDIUM_BUFFER_SIZE);
+	HTTPBufferAllocator::deallocate(p1, HTTPBufferAllocator::MEDIUM_BUFFER_SIZE);
+	HTTPBufferAllocator::deallocate(p2, HTTPBufferAllocator::MEDIUM_BUFFER_SIZE);
+
+	HTTPBufferAllocator::Statistics stats = HTTPBufferAllocator::statistics(HTTPBufferAllocator::MEDIUM_BUFFER_SIZE);
+	// buffers still cached by this thread are used before the pool
+	assertTrue (stats.cacheHits + stats.misses == 2);
+	assertTrue (stats.pooled == 1);
+
+	char* p3 = HTTPBufferAllocator::allocate(HTTPBufferAllocator::MEDIUM_BUFFER_SIZE);
+	assertTrue (p3 == p1);
+	stats = HTTPBufferAllocator::statistics(HTTPBufferAllocator::MEDIUM_BUFFER_SIZE);
+	assertTrue (stats.allocations == 3);
+	assertTrue (stats.poolHits == 1);
+	assertTrue (stats.pooled == 0);
+	HTTPBufferAllocator::deallocate(p3, HTTPBufferAllocator::MEDIUM_BUFFER_SIZE);
+}
+
+
+namespace
+{
+	void allocateAndRelease()
+	{
+		char* p = HTTPBufferAllocator::allocate(HTTPBufferAllocator::LARGE_BUFFER_SIZE);
+		HTTPBufferAllocator::deallocate(p, HTTPBufferAllocator::LARGE_BUFFER_SIZE);
+	}
+}
+
+
+void HTTPBufferAllocatorTest::testThreadExit()
+{
+	HTTPBufferAllocator::setThreadCacheCapacity(HTTPBufferAllocator::DEFAULT_THREAD_CACHE_CAPACITY);
+	HTTPBufferAllocator::setPoolCapacity(HTTPBufferAllocator::LARGE_BUFFER_SIZE, 0);
+	HTTPBufferAllocator::setPoolCapacity(HTTPBufferAllocator::LARGE_BUFFER_SIZE, 4);
+
+	Thread thread;
+	thread.startFunc(&allocateAndRelease);
+	thread.join();
+
+	// buffer cached by the thread has been returned to the pool
+	assertTrue (HTTPBufferAllocator::statistics(HTTPBufferAllocator::LARGE_BUFFER_SIZE).pooled == 1);
+}
+
+
+void HTTPBufferAllocatorTest::setUp()
+{
+}
+
+
+void HTTPBufferAllocatorTest::tearDown()
+{
+	HTTPBufferAllocator::setThreadCacheCapacity(HTTPBufferAllocator::DEFAULT_THREAD_CACHE_CAPACITY);
+	HTTPBufferAllocator::setPoolCapacity(HTTPBufferAllocator::SMALL_BUFFER_SIZE, 1024);
+	HTTPBufferAllocator::setPoolCapacity(HTTPBufferAllocator::MEDIUM_BUFFER_SIZE, 256);
+	HTTPBufferAllocator::setPoolCapacity(HTTPBufferAllocator::LARGE_BUFFER_SIZE, 64);
+}
+
+
+CppUnit::Test* HTTPBufferAllocatorTest::suite()
+{
+	CppUnit::TestSuite* pSuite = new CppUnit::TestSuite("HTTPBufferAllocatorTest");
+
+	CppUnit_addTest(pSuite, HTTPBufferAllocatorTest, testSizeClasses);
+	CppUnit_addTest(pSuite, HTTPBufferAllocatorTest, testThreadCache);
+	CppUnit_addTest(pSuite, HTTPBufferAllocatorTest, testPool);
+	CppUnit_addTest(pSuite, HTTPBufferAllocatorTest, testThreadExit);
+
+	return pSuite;
+}
@@ -0,0 +1,41 @@
+//
+// HTTPBufferAllocatorTest.h
+//
+// Definition of the HTTPBufferAllocatorTest class.
+//
+// Copyright (c) 2005-2023, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef HTTPBufferAllocatorTest_INCLUDED
+#define HTTPBufferAllocatorTest_INCLUDED
+
+
+#include "Poco/Net/Net.h"
+#include "CppUnit/TestCase.h"
+
+
+class HTTPBufferAllocatorTest: public CppUnit::TestCase
+{
+public:
+	HTTPBufferAllocatorTest(const std::string& name);
+	~HTTPBufferAllocatorTest();
+
+	void testSizeClasses();
+	void testThreadCache();
+	void testPool();
+	void testThreadExit();
+
+	void setUp();
+	void tearDown();
+
+	static CppUnit::Test* suite();
+
+private:
+};
+
+
+#endif // HTTPBufferAllocatorTest_INCLUDED
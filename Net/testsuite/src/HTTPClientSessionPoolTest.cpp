@@ -0,0 +1,290 @@
+//
+// HTTPClientSessionPoolTest.cpp
+//
+// Copyright (c) 2005-2023, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "HTTPClientSessionPoolTest.h"
+#include "CppUnit/TestCaller.h"
+#include "CppUnit/TestSuite.h"
+#include "Poco/Net/HTTPClientSessionPool.h"
+#include "Poco/Net/HTTPSessionFactory.h"
+#include "Poco/Net/HTTPStreamFactory.h"
+#include "Poco/Net/HTTPServer.h"
+#include "Poco/Net/HTTPServerParams.h"
+#include "Poco/Net/HTTPRequestHandler.h"
+#include "Poco/Net/HTTPRequestHandlerFactory.h"
+#include "Poco/Net/HTTPServerRequest.h"
+#include "Poco/Net/HTTPServerResponse.h"
+#include "Poco/Net/HTTPRequest.h"
+#include "Poco/Net/HTTPResponse.h"
+#include "Poco/Net/ServerSocket.h"
+#include "Poco/StreamCopier.h"
+#include "Poco/Exception.h"
+#include "Poco/Thread.h"
+#include "Poco/URI.h"
+#include <sstream>
+#include <memory>
+
+
+using Poco::Net::HTTPClientSessionPool;
+using Poco::Net::HTTPClientSession;
+using Poco::Net::HTTPSessionFactory;
+using Poco::Net::HTTPStreamFactory;
+using Poco::Net::HTTPServer;
+using Poco::Net::HTTPServerParams;
+using Poco::Net::HTTPRequestHandler;
+using Poco::Net::HTTPRequestHandlerFactory;
+using Poco::Net::HTTPServerRequest;
+using Poco::Net::HTTPServerResponse;
+using Poco::Net::HTTPRequest;
+using Poco::Net::HTTPResponse;
+using Poco::Net::HTTPMessage;
+using Poco::Net::ServerSocket;
+using Poco::StreamCopier;
+using Poco::URI;
+
+
+namespace
+{
+	const std::string BODY("Hello, world!");
+
+	class HelloRequestHandler: public HTTPRequestHandler
+	{
+	public:
+		void handleRequest(HTTPServerRequest& /*request*/, HTTPServerResponse& response)
+		{
+			response.setContentType("text/plain");
+			response.setContentLength(static_cast<int>(BODY.size()));
+			response.send() << BODY;
+		}
+	};
+
+	class RequestHandlerFactory: public HTTPRequestHandlerFactory
+	{
+	public:
+		HTTPRequestHandler* createRequestHandler(const HTTPServerRequest& /*request*/)
+		{
+			return new HelloRequestHandler;
+		}
+	};
+
+	HTTPServerParams* serverParams(const Poco::Timespan& keepAliveTimeout = Poco::Timespan(10, 0))
+	{
+		HTTPServerParams* pParams = new HTTPServerParams;
+		pParams->setKeepAlive(true);
+		pParams->setMaxKeepAliveRequests(100);
+		pParams->setKeepAliveTimeout(keepAliveTimeout);
+		return pParams;
+	}
+
+	std::string doRequest(HTTPClientSession& session)
+	{
+		HTTPRequest request(HTTPRequest::HTTP_GET, "/hello", HTTPMessage::HTTP_1_1);
+		session.sendRequest(request);
+		HTTPResponse response;
+		std::istream& rs = session.receiveResponse(response);
+		std::ostringstream ostr;
+		StreamCopier::copyStream(rs, ostr);
+		return ostr.str();
+	}
+}
+
+
+HTTPClientSessionPoolTest::HTTPClientSessionPoolTest(const std::string& name): CppUnit::TestCase(name)
+{
+}
+
+
+HTTPClientSessionPoolTest::~HTTPClientSessionPoolTest()
+{
+}
+
+
+void HTTPClientSessionPoolTest::testReuse()
+{
+	ServerSocket svs(0);
+	HTTPServer srv(new RequestHandlerFactory, svs, serverParams());
+	srv.start();
+
+	HTTPSessionFactory factory;
+	HTTPClientSessionPool pool(factory);
+	URI uri("http://127.0.0.1/hello");
+	uri.setPort(svs.address().port());
+
+	HTTPClientSession* pFirst = 0;
+	for (int i = 0; i < 3; ++i)
+	{
+		HTTPClientSession* pSession = pool.get(uri);
+		assertTrue (pool.used() == 1);
+		assertTrue (pool.idle() == 0);
+		if (i == 0)
+			pFirst = pSession;
+		else
+			assertTrue (pSession == pFirst);
+		assertTrue (doRequest(*pSession) == BODY);
+		pool.put(pSession);
+		assertTrue (pool.used() == 0);
+		assertTrue (pool.idle() == 1);
+	}
+	assertTrue (srv.totalConnections() == 1);
+
+	// different host key
+	URI uri2("http://localhost/hello");
+	uri2.setPort(svs.address().port());
+	HTTPClientSession* pSession = pool.get(uri2);
+	assertTrue (pSession != pFirst);
+	assertTrue (doRequest(*pSession) == BODY);
+	pool.put(pSession);
+	assertTrue (pool.idle() == 2);
+
+	pool.clear();
+	assertTrue (pool.idle() == 0);
+}
+
+
+void HTTPClientSessionPoolTest::testMaxSessions()
+{
+	ServerSocket svs(0);
+	HTTPServer srv(new RequestHandlerFactory, svs, serverParams());
+	srv.start();
+
+	HTTPSessionFactory factory;
+	HTTPClientSessionPool pool(factory, 1);
+	pool.setWaitTimeout(Poco::Timespan(0, 100000));
+	URI uri("http://127.0.0.1/hello");
+	uri.setPort(svs.address().port());
+
+	HTTPClientSession* pSession = pool.get(uri);
+	try
+	{
+		pool.get(uri);
+		fail("no session available - must throw");
+	}
+	catch (Poco::TimeoutException&)
+	{
+	}
+
+	assertTrue (doRequest(*pSession) == BODY);
+	pool.put(pSession);
+	pSession = pool.get(uri);
+	assertTrue (doRequest(*pSession) == BODY);
+	pool.put(pSession);
+}
+
+
+void HTTPClientSessionPoolTest::testStaleSession()
+{
+	ServerSocket svs(0);
+	HTTPServer srv(new RequestHandlerFactory, svs, serverParams(Poco::Timespan(0, 200000)));
+	srv.start();
+
+	HTTPSessionFactory factory;
+	HTTPClientSessionPool pool(factory);
+	URI uri("http://127.0.0.1/hello");
+	uri.setPort(svs.address().port());
+
+	HTTPClientSession* pSession = pool.get(uri);
+	assertTrue (doRequest(*pSession) == BODY);
+	pool.put(pSession);
+
+	// server closes the idle connection
+	Poco::Thread::sleep(1000);
+
+	pSession = pool.get(uri);
+	assertTrue (doRequest(*pSession) == BODY);
+	pool.put(pSession);
+	assertTrue (srv.totalConnections() == 2);
+
+	pool.setIdleTimeout(Poco::Timespan(0, 1000));
+	Poco::Thread::sleep(100);
+	pool.purge();
+	assertTrue (pool.idle() == 0);
+}
+
+
+void HTTPClientSessionPoolTest::testDiscard()
+{
+	ServerSocket svs(0);
+	HTTPServer srv(new RequestHandlerFactory, svs, serverParams());
+	srv.start();
+
+	HTTPSessionFactory factory;
+	HTTPClientSessionPool pool(factory);
+	URI uri("http://127.0.0.1/hello");
+	uri.setPort(svs.address().port());
+
+	HTTPClientSession* pSession = pool.get(uri);
+	assertTrue (doRequest(*pSession) == BODY);
+	pool.discard(pSession);
+	assertTrue (pool.used() == 0);
+	assertTrue (pool.idle() == 0);
+
+	HTTPClientSession session;
+	try
+	{
+		pool.put(&session);
+		fail("session not from pool - must throw");
+	}
+	catch (Poco::InvalidArgumentException&)
+	{
+	}
+}
+
+
+void HTTPClientSessionPoolTest::testStreamFactory()
+{
+	ServerSocket svs(0);
+	HTTPServer srv(new RequestHandlerFactory, svs, serverParams());
+	srv.start();
+
+	HTTPClientSessionPool::Ptr pPool = new HTTPClientSessionPool;
+	HTTPStreamFactory factory(pPool);
+	URI uri("http://127.0.0.1/hello");
+	uri.setPort(svs.address().port());
+
+	for (int i = 0; i < 3; ++i)
+	{
+		std::unique_ptr<std::istream> pStr(factory.open(uri));
+		std::ostringstream ostr;
+		StreamCopier::copyStream(*pStr.get(), ostr);
+		assertTrue (ostr.str() == BODY);
+	}
+	assertTrue (pPool->idle() == 1);
+	assertTrue (srv.totalConnections() == 1);
+
+	// stream not read completely - session must not be reused
+	{
+		std::unique_ptr<std::istream> pStr(factory.open(uri));
+	}
+	assertTrue (pPool->idle() == 0);
+	assertTrue (pPool->used() == 0);
+}
+
+
+void HTTPClientSessionPoolTest::setUp()
+{
+}
+
+
+void HTTPClientSessionPoolTest::tearDown()
+{
+}
+
+
+CppUnit::Test* HTTPClientSessionPoolTest::suite()
+{
+	CppUnit::TestSuite* pSuite = new CppUnit::TestSuite("HTTPClientSessionPoolTest");
+
+	CppUnit_addTest(pSuite, HTTPClientSessionPoolTest, testReuse);
+	CppUnit_addTest(pSuite, HTTPClientSessionPoolTest, testMaxSessions);
+	CppUnit_addTest(pSuite, HTTPClientSessionPoolTest, testStaleSession);
+	CppUnit_addTest(pSuite, HTTPClientSessionPoolTest, testDiscard);
+	CppUnit_addTest(pSuite, HTTPClientSessionPoolTest, testStreamFactory);
+
+	return pSuite;
+}
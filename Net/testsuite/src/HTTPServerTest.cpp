@@ -23,7 +23,10 @@
 #include "Poco/Net/HTTPServerResponse.h"
 #include "Poco/Net/HTTPServerSession.h"
 #include "Poco/Net/ServerSocket.h"
+#include "Poco/Net/StreamSocket.h"
 #include "Poco/StreamCopier.h"
+#include "Poco/FileStream.h"
+#include "Poco/TemporaryFile.h"
 #include <sstream>
 
 
@@ -39,11 +42,19 @@ using Poco::Net::HTTPResponse;
 using Poco::Net::HTTPServerResponse;
 using Poco::Net::HTTPMessage;
 using Poco::Net::ServerSocket;
+using Poco::Net::StreamSocket;
+using Poco::Net::SocketAddress;
 using Poco::StreamCopier;
 
 
 namespace
 {
+	std::string fileRequestPath()
+	{
+		static Poco::TemporaryFile tempFile;
+		return tempFile.path();
+	}
+
 	class EchoBodyRequestHandler: public HTTPRequestHandler
 	{
 	public:
@@ -106,6 +117,15 @@ namespace
 		}
 	};
 
+	class FileRequestHandler: public HTTPRequestHandler
+	{
+	public:
+		void handleRequest(HTTPServerRequest& /*request*/, HTTPServerResponse& response)
+		{
+			response.sendFile(fileRequestPath(), "text/plain");
+		}
+	};
+
 	class TrailerRequestHandler: public HTTPRequestHandler
 	{
 	public:
@@ -138,6 +158,8 @@ namespace
 				return new BufferRequestHandler;
 			else if (request.getURI() == "/trailer")
 				return new TrailerRequestHandler;
+			else if (request.getURI() == "/file")
+				return new FileRequestHandler;
 			else
 				return 0;
 		}
@@ -535,6 +557,72 @@ void HTTPServerTest::testBuffer()
 }
 
 
+void HTTPServerTest::testSendFile()
+{
+	std::string data;
+	for (int i = 0; i < 10000; i++) data += "0123456789";
+	{
+		Poco::FileOutputStream ostr(fileRequestPath());
+		ostr << data;
+	}
+
+	ServerSocket svs(0);
+	HTTPServerParams* pParams = new HTTPServerParams;
+	HTTPServer srv(new RequestHandlerFactory, svs, pParams);
+	srv.start();
+
+	HTTPClientSession cs("127.0.0.1", svs.address().port());
+	cs.setKeepAlive(true);
+	HTTPRequest request("GET", "/file", HTTPMessage::HTTP_1_1);
+	cs.sendRequest(request);
+	HTTPResponse response;
+	std::string rbody;
+	StreamCopier::copyToString(cs.receiveResponse(response), rbody);
+	assertTrue (response.getStatus() == HTTPResponse::HTTP_OK);
+	assertTrue (response.getContentLength() == static_cast<std::streamsize>(data.size()));
+	assertTrue (response.get("Accept-Ranges") == "bytes");
+	assertTrue (rbody == data);
+
+	request.set("Range", "bytes=10-29");
+	cs.sendRequest(request);
+	rbody.clear();
+	StreamCopier::copyToString(cs.receiveResponse(response), rbody);
+	assertTrue (response.getStatus() == HTTPResponse::HTTP_PARTIAL_CONTENT);
+	assertTrue (response.get("Content-Range") == "bytes 10-29/100000");
+	assertTrue (rbody == "01234567890123456789");
+
+	request.set("Range", "bytes=-5");
+	cs.sendRequest(request);
+	rbody.clear();
+	StreamCopier::copyToString(cs.receiveResponse(response), rbody);
+	assertTrue (response.getStatus() == HTTPResponse::HTTP_PARTIAL_CONTENT);
+	assertTrue (response.get("Content-Range") == "bytes 99995-99999/100000");
+	assertTrue (rbody == "56789");
+
+	request.set("Range", "bytes=99990-");
+	cs.sendRequest(request);
+	rbody.clear();
+	StreamCopier::copyToString(cs.receiveResponse(response), rbody);
+	assertTrue (response.getStatus() == HTTPResponse::HTTP_PARTIAL_CONTENT);
+	assertTrue (rbody == "0123456789");
+
+	request.set("Range", "bytes=100000-");
+	cs.sendRequest(request);
+	rbody.clear();
+	StreamCopier::copyToString(cs.receiveResponse(response), rbody);
+	assertTrue (response.getStatus() == HTTPResponse::HTTP_REQUESTED_RANGE_NOT_SATISFIABLE);
+	assertTrue (response.get("Content-Range") == "bytes */100000");
+	assertTrue (rbody.empty());
+
+	request.set("Range", "bytes=0-1,5-6");
+	cs.sendRequest(request);
+	rbody.clear();
+	StreamCopier::copyToString(cs.receiveResponse(response), rbody);
+	assertTrue (response.getStatus() == HTTPResponse::HTTP_OK);
+	assertTrue (rbody == data);
+}
+
+
 void HTTPServerTest::testChunkedTrailer()
 {
 	ServerSocket svs(0);
@@ -557,6 +645,61 @@ void HTTPServerTest::testChunkedTrailer()
 }
 
 
+void HTTPServerTest::testPipelining()
+{
+	ServerSocket svs(0);
+	HTTPServerParams* pParams = new HTTPServerParams;
+	pParams->setKeepAlive(true);
+	pParams->setPipelining(true);
+	HTTPServer srv(new RequestHandlerFactory, svs, pParams);
+	srv.start();
+
+	std::string requests;
+	for (int i = 1; i <= 3; ++i)
+	{
+		requests += "GET /echoHeader HTTP/1.1\r\nHost: localhost\r\nX-Seq: ";
+		requests += static_cast<char>('0' + i);
+		requests += i == 3 ? "\r\nConnection: close\r\n\r\n" : "\r\n\r\n";
+	}
+	StreamSocket ss;
+	ss.connect(SocketAddress("127.0.0.1", svs.address().port()));
+	ss.sendBytes(requests.data(), static_cast<int>(requests.size()));
+
+	std::string responses;
+	char buffer[1024];
+	int n = ss.receiveBytes(buffer, sizeof(buffer));
+	while (n > 0)
+	{
+		responses.append(buffer, n);
+		n = ss.receiveBytes(buffer, sizeof(buffer));
+	}
+
+	std::string::size_type pos1 = responses.find("X-Seq: 1");
+	std::string::size_type pos2 = responses.find("X-Seq: 2");
+	std::string::size_type pos3 = responses.find("X-Seq: 3");
+	assertTrue (responses.compare(0, 15, "HTTP/1.1 200 OK") == 0);
+	assertTrue (pos1 != std::string::npos && pos2 != std::string::npos && pos3 != std::string::npos);
+	assertTrue (pos1 < pos2 && pos2 < pos3);
+	assertTrue (responses.find("HTTP/1.1 200 OK", pos1) < pos2);
+	assertTrue (responses.find("HTTP/1.1 200 OK", pos2) < pos3);
+
+	// requests sent one at a time must not be delayed
+	HTTPClientSession cs("127.0.0.1", svs.address().port());
+	cs.setKeepAlive(true);
+	for (int i = 0; i < 3; ++i)
+	{
+		HTTPRequest request("GET", "/echoHeader", HTTPMessage::HTTP_1_1);
+		cs.sendRequest(request);
+		HTTPResponse response;
+		std::istream& rs = cs.receiveResponse(response);
+		std::ostringstream ostr;
+		StreamCopier::copyStream(rs, ostr);
+		assertTrue (response.getStatus() == HTTPResponse::HTTP_OK);
+		assertTrue (ostr.str().find("GET /echoHeader HTTP/1.1") == 0);
+	}
+}
+
+
 void HTTPServerTest::setUp()
 {
 }
@@ -586,6 +729,8 @@ CppUnit::Test* HTTPServerTest::suite()
 	CppUnit_addTest(pSuite, HTTPServerTest, testNotImpl);
 	CppUnit_addTest(pSuite, HTTPServerTest, testBuffer);
 	CppUnit_addTest(pSuite, HTTPServerTest, testChunkedTrailer);
+	CppUnit_addTest(pSuite, HTTPServerTest, testSendFile);
+	CppUnit_addTest(pSuite, HTTPServerTest, testPipelining);
 
 	return pSuite;
 }
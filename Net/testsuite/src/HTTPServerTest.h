@@ -39,6 +39,8 @@ public:
 	void testNotImpl();
 	void testBuffer();
 	void testChunkedTrailer();
+	void testSendFile();
+	void testPipelining();
 
 	void setUp();
 	void tearDown();
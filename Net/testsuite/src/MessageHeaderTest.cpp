@@ -114,6 +114,31 @@ void MessageHeaderTest::testRead5()
 }
 
 
+void MessageHeaderTest::testRead6()
+{
+	// long values cross the vectorized scan and line buffer boundaries
+	std::string longValue(5000, 'x');
+	longValue[4000] = '=';
+	std::string s("Name1: ");
+	s.append(longValue);
+	s.append("\r\nInvalid line\r\nName2:\tValue 2  \r\nName3: =?UTF-8?B?RnJhbmNpcw==?=\r\nName4: a=b\r\n\r\n");
+	std::istringstream istr(s);
+	MessageHeader mh;
+	mh.read(istr);
+	assertTrue (mh.size() == 4);
+	assertTrue (mh["Name1"] == longValue);
+	assertTrue (mh["Name2"] == "Value 2");
+	assertTrue (mh["Name3"] == "Francis");
+	assertTrue (mh["Name4"] == "a=b");
+	char c = istr.get();
+	assertTrue (c == '\r');
+	c = istr.get();
+	assertTrue (c == '\n');
+	c = istr.get();
+	assertTrue (istr.eof());
+}
+
+
 void MessageHeaderTest::testReadFolding1()
 {
 	std::string s("name1: value1\r\nname2: value21\r\n value22\r\nname3: value3\r\n");
@@ -194,6 +219,22 @@ void MessageHeaderTest::testReadInvalid1()
 }
 
 
+void MessageHeaderTest::testReadInvalid3()
+{
+	std::string s("name1: value1\rvalue2\r\n\r\n");
+	std::istringstream istr(s);
+	MessageHeader mh;
+	try
+	{
+		mh.read(istr);
+		fail("malformed message - must throw");
+	}
+	catch (MessageException&)
+	{
+	}
+}
+
+
 void MessageHeaderTest::testReadInvalid2()
 {
 	std::string s("name1: value1\r\nname2: ");
@@ -429,6 +470,7 @@ CppUnit::Test* MessageHeaderTest::suite()
 	CppUnit_addTest(pSuite, MessageHeaderTest, testRead3);
 	CppUnit_addTest(pSuite, MessageHeaderTest, testRead4);
 	CppUnit_addTest(pSuite, MessageHeaderTest, testRead5);
+	CppUnit_addTest(pSuite, MessageHeaderTest, testRead6);
 	CppUnit_addTest(pSuite, MessageHeaderTest, testReadFolding1);
 	CppUnit_addTest(pSuite, MessageHeaderTest, testReadFolding2);
 	CppUnit_addTest(pSuite, MessageHeaderTest, testReadFolding3);
@@ -436,6 +478,7 @@ CppUnit::Test* MessageHeaderTest::suite()
 	CppUnit_addTest(pSuite, MessageHeaderTest, testReadFolding5);
 	CppUnit_addTest(pSuite, MessageHeaderTest, testReadInvalid1);
 	CppUnit_addTest(pSuite, MessageHeaderTest, testReadInvalid2);
+	CppUnit_addTest(pSuite, MessageHeaderTest, testReadInvalid3);
 	CppUnit_addTest(pSuite, MessageHeaderTest, testSplitElements);
 	CppUnit_addTest(pSuite, MessageHeaderTest, testSplitParameters);
 	CppUnit_addTest(pSuite, MessageHeaderTest, testFieldLimit);
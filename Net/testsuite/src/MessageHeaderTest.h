@@ -30,6 +30,7 @@ public:
 	void testRead3();
 	void testRead4();
 	void testRead5();
+	void testRead6();
 	void testReadFolding1();
 	void testReadFolding2();
 	void testReadFolding3();
@@ -37,6 +38,7 @@ public:
 	void testReadFolding5();
 	void testReadInvalid1();
 	void testReadInvalid2();
+	void testReadInvalid3();
 	void testSplitElements();
 	void testSplitParameters();
 	void testFieldLimit();
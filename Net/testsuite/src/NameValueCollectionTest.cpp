@@ -106,6 +106,47 @@ void NameValueCollectionTest::testNameValueCollection()
 }
 
 
+void NameValueCollectionTest::testOrder()
+{
+	NameValueCollection nvc;
+	nvc.add("Host", "www.example.com");
+	nvc.add("Set-Cookie", "a=1");
+	nvc.add("Content-Length", "42");
+	nvc.add("set-cookie", "b=2");
+	nvc.add("Connection", "close");
+	nvc.set("CONTENT-LENGTH", "43");
+
+	assertTrue (nvc.size() == 5);
+	NameValueCollection::ConstIterator it = nvc.begin();
+	assertTrue (it->first == "Host");
+	++it;
+	assertTrue (it->first == "Set-Cookie" && it->second == "a=1");
+	++it;
+	assertTrue (it->first == "set-cookie" && it->second == "b=2");
+	++it;
+	assertTrue (it->first == "Content-Length" && it->second == "43");
+	++it;
+	assertTrue (it->first == "Connection");
+	++it;
+	assertTrue (it == nvc.end());
+
+	NameValueCollection copy(nvc);
+	nvc.erase("SET-COOKIE");
+	assertTrue (nvc.size() == 3);
+	assertTrue (!nvc.has("Set-Cookie"));
+	assertTrue (nvc.get("content-length") == "43");
+	assertTrue (nvc.get("connection") == "close");
+	assertTrue (copy.size() == 5);
+	assertTrue (copy.get("Set-Cookie") == "a=1");
+
+	// names differing only in non-letters must not match
+	nvc.add("X-A", "1");
+	assertTrue (!nvc.has("X\rA"));
+	assertTrue (!nvc.has("x-a "));
+	assertTrue (nvc.has("x-a"));
+}
+
+
 void NameValueCollectionTest::setUp()
 {
 }
@@ -121,6 +162,7 @@ CppUnit::Test* NameValueCollectionTest::suite()
 	CppUnit::TestSuite* pSuite = new CppUnit::TestSuite("NameValueCollectionTest");
 
 	CppUnit_addTest(pSuite, NameValueCollectionTest, testNameValueCollection);
+	CppUnit_addTest(pSuite, NameValueCollectionTest, testOrder);
 
 	return pSuite;
 }
@@ -25,6 +25,7 @@ public:
 	~NameValueCollectionTest();
 
 	void testNameValueCollection();
+	void testOrder();
 
 	void setUp();
 	void tearDown();
@@ -437,6 +437,171 @@ void PollSetTest::testClear()
 }
 
 
+void PollSetTest::testPollList()
+{
+	EchoServer echoServer1;
+	EchoServer echoServer2;
+	StreamSocket ss1;
+	StreamSocket ss2;
+	ss1.connect(SocketAddress("127.0.0.1", echoServer1.port()));
+	ss2.connect(SocketAddress("127.0.0.1", echoServer2.port()));
+
+	PollSet ps;
+	ps.add(ss1, PollSet::POLL_READ);
+	ps.add(ss2, PollSet::POLL_READ);
+
+	PollSet::SocketModeList sl;
+	assertTrue (ps.poll(Timespan(0), sl) == 0);
+	assertTrue (sl.empty());
+
+	ss1.sendBytes("hello", 5);
+	ss2.sendBytes("HELLO", 5);
+	while (!ss1.poll(Timespan(0, 10000), Socket::SELECT_READ) ||
+		!ss2.poll(Timespan(0, 10000), Socket::SELECT_READ))
+		Poco::Thread::sleep(10);
+
+	assertTrue (ps.poll(Timespan(1000000), sl) == 2);
+	assertTrue (sl.size() == 2);
+	assertTrue (sl[0].first == ss1 || sl[1].first == ss1);
+	assertTrue (sl[0].first == ss2 || sl[1].first == ss2);
+	assertTrue (sl[0].second == PollSet::POLL_READ);
+	assertTrue (sl[1].second == PollSet::POLL_READ);
+
+	char buffer[5];
+	ss1.receiveBytes(buffer, sizeof(buffer));
+	std::size_t capacity = sl.capacity();
+
+	// result list is reset on every call, but its storage is reused
+	assertTrue (ps.poll(Timespan(1000000), sl) == 1);
+	assertTrue (sl.size() == 1);
+	assertTrue (sl[0].first == ss2);
+	assertTrue (sl.capacity() == capacity);
+
+	ss2.receiveBytes(buffer, sizeof(buffer));
+	ps.update(ss1, PollSet::POLL_WRITE);
+	assertTrue (ps.poll(Timespan(1000000), sl) == 1);
+	assertTrue (sl[0].first == ss1);
+	assertTrue (sl[0].second == PollSet::POLL_WRITE);
+
+	ps.remove(ss1);
+	assertTrue (ps.poll(Timespan(0), sl) == 0);
+	assertTrue (sl.empty());
+}
+
+
+void PollSetTest::testEdgeTriggered()
+{
+#if defined(POCO_HAVE_FD_EPOLL) && !defined(POCO_OS_FAMILY_WINDOWS)
+	EchoServer echoServer;
+	StreamSocket ss;
+	ss.connect(SocketAddress("127.0.0.1", echoServer.port()));
+	PollSet ps;
+	ps.add(ss, PollSet::POLL_READ | PollSet::POLL_EDGE);
+
+	ss.sendBytes("hello", 5);
+	while (!ss.poll(Timespan(0, 10000), Socket::SELECT_READ))
+		Poco::Thread::sleep(10);
+
+	PollSet::SocketModeList sl;
+	assertTrue (ps.poll(Timespan(1000000), sl) == 1);
+	assertTrue (sl[0].second == PollSet::POLL_READ);
+
+	// data has not been read, but there is no new edge
+	assertTrue (ps.poll(Timespan(100000), sl) == 0);
+
+	ss.sendBytes("HELLO", 5);
+	assertTrue (ps.poll(Timespan(1000000), sl) == 1);
+
+	char buffer[10];
+	int n = 0;
+	while (n < 10) n += ss.receiveBytes(buffer + n, sizeof(buffer) - n);
+	assertTrue (std::string(buffer, n) == "helloHELLO");
+
+	// options are cumulative and retained on add()
+	ps.add(ss, PollSet::POLL_WRITE);
+	assertTrue (ps.poll(Timespan(1000000), sl) == 1);
+	assertTrue (sl[0].second == PollSet::POLL_WRITE);
+	assertTrue (ps.poll(Timespan(100000), sl) == 0);
+#else
+	std::cout << "not implemented";
+#endif
+}
+
+
+void PollSetTest::testOneShot()
+{
+#if defined(POCO_HAVE_FD_EPOLL) && !defined(POCO_OS_FAMILY_WINDOWS)
+	EchoServer echoServer;
+	StreamSocket ss;
+	ss.connect(SocketAddress("127.0.0.1", echoServer.port()));
+	PollSet ps;
+	ps.add(ss, PollSet::POLL_READ | PollSet::POLL_ONESHOT);
+
+	ss.sendBytes("hello", 5);
+	PollSet::SocketModeList sl;
+	assertTrue (ps.poll(Timespan(1000000), sl) == 1);
+
+	// disabled until re-armed
+	ss.sendBytes("HELLO", 5);
+	assertTrue (ps.poll(Timespan(100000), sl) == 0);
+	assertTrue (ps.has(ss));
+
+	ps.rearm(ss);
+	assertTrue (ps.poll(Timespan(1000000), sl) == 1);
+	assertTrue (sl[0].first == ss);
+	assertTrue (ps.poll(Timespan(100000), sl) == 0);
+
+	ps.remove(ss);
+	ps.rearm(ss);
+	assertTrue (!ps.has(ss));
+	assertTrue (ps.poll(Timespan(100000), sl) == 0);
+#else
+	std::cout << "not implemented";
+#endif
+}
+
+
+void PollSetTest::testExclusive()
+{
+#if defined(POCO_HAVE_FD_EPOLL) && !defined(POCO_OS_FAMILY_WINDOWS)
+	ServerSocket server(SocketAddress("127.0.0.1", 0));
+	PollSet ps1;
+	PollSet ps2;
+	ps1.add(server, PollSet::POLL_READ | PollSet::POLL_EXCLUSIVE);
+	ps2.add(server, PollSet::POLL_READ | PollSet::POLL_EXCLUSIVE);
+
+	try
+	{
+		ps1.update(server, PollSet::POLL_READ | PollSet::POLL_EXCLUSIVE | PollSet::POLL_ONESHOT);
+		fail("POLL_EXCLUSIVE and POLL_ONESHOT are mutually exclusive - must throw");
+	}
+	catch (Poco::InvalidArgumentException&)
+	{
+	}
+
+	// exclusive sockets can be updated
+	ps1.update(server, PollSet::POLL_READ | PollSet::POLL_ERROR | PollSet::POLL_EXCLUSIVE);
+
+	StreamSocket ss;
+	ss.connect(server.address());
+	while (!server.poll(Timespan(0, 10000), Socket::SELECT_READ))
+		Poco::Thread::sleep(10);
+
+	// at least one of the poll sets must be notified
+	PollSet::SocketModeList sl1;
+	PollSet::SocketModeList sl2;
+	int n = ps1.poll(Timespan(100000), sl1) + ps2.poll(Timespan(100000), sl2);
+	assertTrue (n >= 1);
+	PollSet::SocketModeList& sl = sl1.empty() ? sl2 : sl1;
+	assertTrue (sl[0].first == server);
+	assertTrue (sl[0].second & PollSet::POLL_READ);
+	StreamSocket cs = server.acceptConnection();
+#else
+	std::cout << "not implemented";
+#endif
+}
+
+
 void PollSetTest::setUp()
 {
 }
@@ -459,6 +624,10 @@ CppUnit::Test* PollSetTest::suite()
 	CppUnit_addTest(pSuite, PollSetTest, testPollClosedServer);
 	CppUnit_addTest(pSuite, PollSetTest, testPollSetWakeUp);
 	CppUnit_addTest(pSuite, PollSetTest, testClear);
+	CppUnit_addTest(pSuite, PollSetTest, testPollList);
+	CppUnit_addTest(pSuite, PollSetTest, testEdgeTriggered);
+	CppUnit_addTest(pSuite, PollSetTest, testOneShot);
+	CppUnit_addTest(pSuite, PollSetTest, testExclusive);
 
 	return pSuite;
 }
@@ -32,6 +32,10 @@ public:
 	void testPollClosedServer();
 	void testPollSetWakeUp();
 	void testClear();
+	void testPollList();
+	void testEdgeTriggered();
+	void testOneShot();
+	void testExclusive();
 
 	void setUp();
 	void tearDown();
@@ -10,6 +10,7 @@
 
 #include "SocketProactorTest.h"
 #include "UDPEchoServer.h"
+#include "EchoServer.h"
 #include "CppUnit/TestCaller.h"
 #include "CppUnit/TestSuite.h"
 #include "Poco/Net/StreamSocket.h"
@@ -331,6 +332,113 @@ void SocketProactorTest::testTimedWork()
 }
 
 
+void SocketProactorTest::testRegisteredBuffers()
+{
+	EchoServer echoServer;
+	SocketProactor proactor(false);
+	if (!proactor.hasIOUring())
+	{
+		std::cerr << "io_uring not supported, test skipped" << std::endl;
+		return;
+	}
+	StreamSocket s;
+	s.connect(SocketAddress("127.0.0.1", echoServer.port()));
+	std::string hello = "hello registered buffers";
+	SocketProactor::Buffer buf(hello.size(), 0);
+	proactor.registerBuffers({&buf});
+
+	bool sent = false;
+	std::atomic<bool> received(false), receivePassed(false);
+	proactor.addSend(s, SocketProactor::Buffer(hello.begin(), hello.end()),
+		[&](std::error_code err, int bytes) { sent = (err.value() == 0) && (bytes == static_cast<int>(hello.length())); });
+	proactor.addReceive(s, buf, [&](std::error_code err, int bytes)
+	{
+		receivePassed = (err.value() == 0) &&
+						(bytes == static_cast<int>(hello.length())) &&
+						(std::string(buf.begin(), buf.end()) == hello);
+		received = true;
+	});
+	Stopwatch sw;
+	sw.start();
+	while (!received)
+	{
+		if (sw.elapsedSeconds() > 1)
+			fail("SocketProactor receive completion timed out.", __LINE__, __FILE__);
+		proactor.poll();
+	}
+	assertTrue (sent);
+	assertTrue (receivePassed);
+	proactor.registerBuffers({});
+}
+
+
+void SocketProactorTest::testReceiveBufferSize()
+{
+	UDPEchoServer echoServer;
+	DatagramSocket s(SocketAddress::IPv4);
+	SocketProactor proactor(false);
+	std::string hello = "hello proactor world";
+	SocketAddress sa;
+
+	// a smaller buffer is enlarged, an empty one is sized to the datagram
+	SocketProactor::Buffer small(4, 0);
+	SocketProactor::Buffer empty;
+	int smallBytes = 0, emptyBytes = 0;
+	std::atomic<int> received(0);
+	proactor.addSendTo(s, SocketProactor::Buffer(hello.begin(), hello.end()),
+		SocketAddress("127.0.0.1", echoServer.port()), nullptr);
+	proactor.addSendTo(s, SocketProactor::Buffer(hello.begin(), hello.end()),
+		SocketAddress("127.0.0.1", echoServer.port()), nullptr);
+	proactor.addReceiveFrom(s, small, sa, [&](std::error_code, int bytes) { smallBytes = bytes; ++received; });
+	proactor.addReceiveFrom(s, empty, sa, [&](std::error_code, int bytes) { emptyBytes = bytes; ++received; });
+	Stopwatch sw;
+	sw.start();
+	while (received < 2)
+	{
+		if (sw.elapsedSeconds() > 1)
+			fail("SocketProactor receive completion timed out.", __LINE__, __FILE__);
+		proactor.poll();
+	}
+	assertEquals (static_cast<int>(hello.size()), smallBytes);
+	assertTrue (std::string(small.begin(), small.end()) == hello);
+	assertEquals (static_cast<int>(hello.size()), emptyBytes);
+	assertTrue (std::string(empty.begin(), empty.end()) == hello);
+}
+
+
+void SocketProactorTest::testWakeUp()
+{
+	EchoServer echoServer;
+	SocketProactor proactor(false);
+	proactor.setTimeout(Poco::Timespan(5, 0));
+	StreamSocket s;
+	s.connect(SocketAddress("127.0.0.1", echoServer.port()));
+	Thread thread;
+	thread.start(proactor);
+	// let the proactor thread start waiting
+	Thread::sleep(100);
+
+	// I/O added from another thread must not wait for the timeout
+	std::string hello = "hello proactor world";
+	SocketProactor::Buffer buf;
+	std::atomic<bool> received(false);
+	proactor.addSend(s, SocketProactor::Buffer(hello.begin(), hello.end()), nullptr);
+	proactor.addReceive(s, buf, [&](std::error_code, int) { received = true; });
+	Stopwatch sw;
+	sw.start();
+	while (!received)
+	{
+		if (sw.elapsedSeconds() > 1)
+			fail("SocketProactor was not woken up.", __LINE__, __FILE__);
+		Thread::sleep(10);
+	}
+	assertTrue (std::string(buf.begin(), buf.end()) == hello);
+	proactor.stop();
+	proactor.wakeUp();
+	thread.join();
+}
+
+
 void SocketProactorTest::setUp()
 {
 }
@@ -350,6 +458,9 @@ CppUnit::Test* SocketProactorTest::suite()
 	CppUnit_addTest(pSuite, SocketProactorTest, testSocketProactorStartStop);
 	CppUnit_addTest(pSuite, SocketProactorTest, testWork);
 	CppUnit_addTest(pSuite, SocketProactorTest, testTimedWork);
+	CppUnit_addTest(pSuite, SocketProactorTest, testRegisteredBuffers);
+	CppUnit_addTest(pSuite, SocketProactorTest, testReceiveBufferSize);
+	CppUnit_addTest(pSuite, SocketProactorTest, testWakeUp);
 
 	return pSuite;
 }
@@ -36,6 +36,9 @@ public:
 
 	void testWork();
 	void testTimedWork();
+	void testRegisteredBuffers();
+	void testReceiveBufferSize();
+	void testWakeUp();
 
 	void setUp();
 	void tearDown();
@@ -27,6 +27,7 @@
 
 
 using Poco::Net::SocketReactor;
+using Poco::Net::PollSet;
 using Poco::Net::SocketConnector;
 using Poco::Net::SocketAcceptor;
 using Poco::Net::ParallelSocketAcceptor;
@@ -86,6 +87,39 @@ namespace
 		SocketReactor& _reactor;
 	};
 
+	class EdgeTriggeredEchoServiceHandler
+		/// Reads only a few bytes per notification;
+		/// relies on the reactor to drain the socket.
+	{
+	public:
+		EdgeTriggeredEchoServiceHandler(const StreamSocket& socket, SocketReactor& reactor):
+			_socket(socket),
+			_reactor(reactor)
+		{
+			_reactor.addEventHandler(_socket, Observer<EdgeTriggeredEchoServiceHandler, ReadableNotification>(*this, &EdgeTriggeredEchoServiceHandler::onReadable), PollSet::POLL_EDGE);
+		}
+
+		void onReadable(ReadableNotification* pNf)
+		{
+			pNf->release();
+			char buffer[8];
+			int n = _socket.receiveBytes(buffer, sizeof(buffer));
+			if (n > 0)
+			{
+				_socket.sendBytes(buffer, n);
+			}
+			else
+			{
+				_reactor.removeEventHandler(_socket, Observer<EdgeTriggeredEchoServiceHandler, ReadableNotification>(*this, &EdgeTriggeredEchoServiceHandler::onReadable));
+				delete this;
+			}
+		}
+
+	private:
+		StreamSocket   _socket;
+		SocketReactor& _reactor;
+	};
+
 	class ClientServiceHandler
 	{
 	public:
@@ -427,6 +461,25 @@ void SocketReactorTest::testSocketReactor()
 }
 
 
+void SocketReactorTest::testSocketReactorEdgeTriggered()
+{
+	SocketAddress ssa;
+	ServerSocket ss(ssa);
+	SocketReactor reactor;
+	SocketAcceptor<EdgeTriggeredEchoServiceHandler> acceptor(ss, reactor);
+	SocketAddress sa("127.0.0.1", ss.address().port());
+	SocketConnector<ClientServiceHandler> connector(sa, reactor);
+	ClientServiceHandler::setOnce(true);
+	ClientServiceHandler::resetData();
+	reactor.run();
+	std::string data(ClientServiceHandler::data());
+	assertTrue (data.size() == DATA_SIZE);
+	assertTrue (!ClientServiceHandler::readableError());
+	assertTrue (!ClientServiceHandler::writableError());
+	assertTrue (!ClientServiceHandler::timeoutError());
+}
+
+
 void SocketReactorTest::testSetSocketReactor()
 {
 	SocketAddress ssa;
@@ -646,6 +699,7 @@ CppUnit::Test* SocketReactorTest::suite()
 	CppUnit_addTest(pSuite, SocketReactorTest, testDataCollection);
 	CppUnit_addTest(pSuite, SocketReactorTest, testSocketConnectorDeadlock);
 	CppUnit_addTest(pSuite, SocketReactorTest, testSocketReactorWakeup);
+	CppUnit_addTest(pSuite, SocketReactorTest, testSocketReactorEdgeTriggered);
 
 	return pSuite;
 }
@@ -32,6 +32,7 @@ public:
 	void testDataCollection();
 	void testSocketConnectorDeadlock();
 	void testSocketReactorWakeup();
+	void testSocketReactorEdgeTriggered();
 
 	void setUp();
 	void tearDown();
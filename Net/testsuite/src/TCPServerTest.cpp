@@ -18,7 +18,10 @@
 #include "Poco/Net/StreamSocket.h"
 #include "Poco/Net/ServerSocket.h"
 #include "Poco/Thread.h"
+#include "Poco/Stopwatch.h"
+#include "Poco/WorkStealingExecutor.h"
 #include <iostream>
+#include <vector>
 
 
 using Poco::Net::TCPServer;
@@ -31,6 +34,8 @@ using Poco::Net::StreamSocket;
 using Poco::Net::ServerSocket;
 using Poco::Net::SocketAddress;
 using Poco::Thread;
+using Poco::Stopwatch;
+using Poco::WorkStealingExecutor;
 
 
 namespace
@@ -277,6 +282,99 @@ void TCPServerTest::testFilter()
 }
 
 
+void TCPServerTest::testShardedServer()
+{
+	TCPServerParams::Ptr pParams = new TCPServerParams;
+	pParams->setMaxThreads(4);
+	pParams->setShards(2);
+	pParams->setShardAffinity(true);
+	TCPServer srv(new TCPServerConnectionFactoryImpl<EchoConnection>(), SocketAddress("127.0.0.1", 0), pParams);
+	assertTrue (srv.shards() == 2);
+	assertTrue (pParams->getThreadAffinity() == -1);
+	srv.start();
+	assertTrue (srv.currentConnections() == 0);
+	assertTrue (srv.totalConnections() == 0);
+	assertTrue (srv.maxThreads() >= 8);
+
+	// fewer connections than a single shard can serve, as all of
+	// them may end up on the same shard
+	SocketAddress sa("127.0.0.1", srv.port());
+	std::vector<StreamSocket> sockets;
+	for (int i = 0; i < 3; i++)
+	{
+		sockets.push_back(StreamSocket(sa));
+		sockets.back().setReceiveTimeout(Poco::Timespan(10, 0));
+	}
+
+	std::string data("hello, world");
+	char buffer[256];
+	for (auto& ss: sockets)
+	{
+		ss.sendBytes(data.data(), (int) data.size());
+		int n = ss.receiveBytes(buffer, sizeof(buffer));
+		assertTrue (n > 0);
+		assertTrue (std::string(buffer, n) == data);
+	}
+
+	assertTrue (srv.currentConnections() == 3);
+	assertTrue (srv.totalConnections() == 3);
+	assertTrue (srv.currentConnections(0) + srv.currentConnections(1) == 3);
+	assertTrue (srv.totalConnections(0) + srv.totalConnections(1) == 3);
+	assertTrue (srv.queuedConnections() == 0);
+
+	for (auto& ss: sockets)
+	{
+		ss.close();
+	}
+	Thread::sleep(1000);
+	assertTrue (srv.currentConnections() == 0);
+}
+
+
+void TCPServerTest::testExecutor()
+{
+	WorkStealingExecutor executor(4);
+	ServerSocket svs(0);
+	TCPServer srv(new TCPServerConnectionFactoryImpl<EchoConnection>(), executor, svs);
+	srv.start();
+	assertTrue (srv.maxThreads() == 4);
+	assertTrue (srv.currentConnections() == 0);
+
+	SocketAddress sa("127.0.0.1", svs.address().port());
+	std::vector<StreamSocket> sockets;
+	for (int i = 0; i < 3; i++)
+	{
+		sockets.push_back(StreamSocket(sa));
+	}
+
+	std::string data("hello, world");
+	char buffer[256];
+	for (auto& ss: sockets)
+	{
+		ss.sendBytes(data.data(), (int) data.size());
+		int n = ss.receiveBytes(buffer, sizeof(buffer));
+		assertTrue (n > 0);
+		assertTrue (std::string(buffer, n) == data);
+	}
+	assertTrue (srv.currentConnections() == 3);
+	assertTrue (srv.totalConnections() == 3);
+
+	for (auto& ss: sockets)
+	{
+		ss.close();
+	}
+	Thread::sleep(1000);
+	assertTrue (srv.currentConnections() == 0);
+
+	// all dispatcher tasks must exit promptly, not after the thread idle time
+	Stopwatch sw;
+	sw.start();
+	srv.stop();
+	executor.joinAll();
+	assertTrue (sw.elapsedSeconds() < 5);
+}
+
+
 void TCPServerTest::setUp()
 {
 }
@@ -296,6 +394,8 @@ CppUnit::Test* TCPServerTest::suite()
 	CppUnit_addTest(pSuite, TCPServerTest, testMultiConnections);
 	CppUnit_addTest(pSuite, TCPServerTest, testThreadCapacity);
 	CppUnit_addTest(pSuite, TCPServerTest, testFilter);
+	CppUnit_addTest(pSuite, TCPServerTest, testShardedServer);
+	CppUnit_addTest(pSuite, TCPServerTest, testExecutor);
 
 	return pSuite;
 }
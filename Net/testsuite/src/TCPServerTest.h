@@ -29,6 +29,8 @@ public:
 	void testMultiConnections();
 	void testThreadCapacity();
 	void testFilter();
+	void testShardedServer();
+	void testExecutor();
 
 	void setUp();
 	void tearDown();
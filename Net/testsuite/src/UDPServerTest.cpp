@@ -19,6 +19,7 @@
 #include "Poco/Net/NetworkInterface.h"
 #include "Poco/Net/NetException.h"
 #include "Poco/Timespan.h"
+#include "Poco/Timestamp.h"
 #include "Poco/AtomicCounter.h"
 #include "Poco/StringTokenizer.h"
 #include <cstring>
@@ -82,6 +83,31 @@ namespace
 
 	AtomicCounter TestUDPHandler::errors;
 
+	struct SegmentUDPHandler : public Poco::Net::UDPHandler
+	{
+		SegmentUDPHandler() : counter(0), errors(0)
+		{
+			start();
+		}
+
+		void processData(char *buf)
+		{
+			std::string data(payload(buf), payloadSize(buf));
+			if (data.size() != 100 || data != std::string(100, data[0])) ++errors;
+			++counter;
+			std::memset(buf, 0, blockSize());
+		}
+
+		void processError(char *buf)
+		{
+			++errors;
+			std::memset(buf, 0, blockSize());
+		}
+
+		AtomicCounter counter;
+		AtomicCounter errors;
+	};
+
 	template<typename S>
 	bool server(int handlerCount, int reps, int port = 0)
 	{
@@ -183,6 +209,41 @@ void UDPServerTest::testServer()
 }
 
 
+void UDPServerTest::testReceiveOffload()
+{
+	DatagramSocket probe(SocketAddress("127.0.0.1", 0), false);
+	try
+	{
+		probe.setReceiveOffload(true);
+	}
+	catch (Poco::Exception&)
+	{
+		std::cerr << "UDP offload not supported, test skipped" << std::endl;
+		return;
+	}
+
+	Poco::Net::UDPHandler::List handlers;
+	SegmentUDPHandler* pHandler = new SegmentUDPHandler;
+	handlers.push_back(pHandler);
+	Poco::Net::UDPServerParams params(SocketAddress("127.0.0.1", 0), 1, 250000, 1000, false, 10, 32, true);
+	UDPServer server(handlers, params);
+	Poco::Thread::sleep(100);
+
+	std::string data;
+	for (int i = 0; i < 50; ++i) data.append(100, static_cast<char>('a' + i % 26));
+	DatagramSocket sender(SocketAddress("127.0.0.1", 0), false);
+	for (int i = 0; i < 10; ++i)
+	{
+		assertTrue (sender.sendSegments(data.data(), static_cast<int>(data.size()), 100, server.address()) == static_cast<int>(data.size()));
+	}
+
+	Poco::Timestamp start;
+	while (pHandler->counter < 500 && !start.isElapsed(5000000)) Poco::Thread::sleep(10);
+	assertTrue (pHandler->counter == 500);
+	assertTrue (pHandler->errors == 0);
+}
+
+
 void UDPServerTest::setUp()
 {
 }
@@ -198,6 +259,7 @@ CppUnit::Test* UDPServerTest::suite()
 	CppUnit::TestSuite* pSuite = new CppUnit::TestSuite("UDPServerTest");
 
 	CppUnit_addTest(pSuite, UDPServerTest, testServer);
+	CppUnit_addTest(pSuite, UDPServerTest, testReceiveOffload);
 
 	return pSuite;
 }
@@ -25,6 +25,7 @@ public:
 	~UDPServerTest();
 
 	void testServer();
+	void testReceiveOffload();
 
 	void setUp();
 	void tearDown();
@@ -12,6 +12,7 @@
 #include "CppUnit/TestCaller.h"
 #include "CppUnit/TestSuite.h"
 #include "Poco/Net/WebSocket.h"
+#include "Poco/Net/WebSocketImpl.h"
 #include "Poco/Net/SocketStream.h"
 #include "Poco/Net/HTTPClientSession.h"
 #include "Poco/Net/HTTPServer.h"
@@ -23,6 +24,7 @@
 #include "Poco/Net/ServerSocket.h"
 #include "Poco/Net/NetException.h"
 #include "Poco/Thread.h"
+#include "Poco/Stopwatch.h"
 #include "Poco/Buffer.h"
 
 
@@ -34,6 +36,7 @@ using Poco::Net::HTTPServerResponse;
 using Poco::Net::SocketStream;
 using Poco::Net::WebSocket;
 using Poco::Net::WebSocketException;
+using Poco::Net::PerMessageDeflate;
 
 
 namespace
@@ -41,7 +44,9 @@ namespace
 	class WebSocketRequestHandler: public Poco::Net::HTTPRequestHandler
 	{
 	public:
-		WebSocketRequestHandler(std::size_t bufSize = 1024): _bufSize(bufSize)
+		WebSocketRequestHandler(std::size_t bufSize = 1024, const PerMessageDeflate::Config* pCompression = 0):
+			_bufSize(bufSize),
+			_pCompression(pCompression)
 		{
 		}
 
@@ -49,7 +54,7 @@ namespace
 		{
 			try
 			{
-				WebSocket ws(request, response);
+				WebSocket ws = _pCompression ? WebSocket(request, response, *_pCompression) : WebSocket(request, response);
 				Poco::Buffer<char> buffer(_bufSize);
 				int flags;
 				int n;
@@ -80,23 +85,59 @@ namespace
 
 	private:
 		std::size_t _bufSize;
+		const PerMessageDeflate::Config* _pCompression;
 	};
 
 	class WebSocketRequestHandlerFactory: public Poco::Net::HTTPRequestHandlerFactory
 	{
 	public:
-		WebSocketRequestHandlerFactory(std::size_t bufSize = 1024): _bufSize(bufSize)
+		WebSocketRequestHandlerFactory(std::size_t bufSize = 1024, const PerMessageDeflate::Config* pCompression = 0):
+			_bufSize(bufSize),
+			_pCompression(pCompression)
 		{
 		}
 
 		Poco::Net::HTTPRequestHandler* createRequestHandler(const HTTPServerRequest& request)
 		{
-			return new WebSocketRequestHandler(_bufSize);
+			return new WebSocketRequestHandler(_bufSize, _pCompression);
 		}
 
 	private:
 		std::size_t _bufSize;
+		const PerMessageDeflate::Config* _pCompression;
 	};
+
+	std::string makeJSON(int records)
+	{
+		std::string json("[");
+		for (int i = 0; i < records; i++)
+		{
+			if (i > 0) json += ',';
+			json += "{\"symbol\":\"SYM";
+			json += std::to_string(i % 50);
+			json += "\",\"bid\":";
+			json += std::to_string(100 + i % 17);
+			json += ".25,\"ask\":";
+			json += std::to_string(101 + i % 13);
+			json += ".5,\"volume\":";
+			json += std::to_string(i*31 % 10007);
+			json += "}";
+		}
+		json += "]";
+		return json;
+	}
+
+	void waitForConnections(const Poco::Net::HTTPServer& server)
+	{
+		// make sure no connection thread is still running
+		// when the test program terminates
+		Poco::Stopwatch sw;
+		sw.start();
+		while (server.currentConnections() > 0 && sw.elapsedSeconds() < 5)
+		{
+			Poco::Thread::sleep(10);
+		}
+	}
 }
 
 
@@ -272,6 +313,253 @@ void WebSocketTest::testWebSocketLargeInOneFrame()
 }
 
 
+void WebSocketTest::testWebSocketBinary()
+{
+	const int msgSize = 100000;
+
+	Poco::Net::ServerSocket ss(0);
+	Poco::Net::HTTPServer server(new WebSocketRequestHandlerFactory(msgSize), ss, new Poco::Net::HTTPServerParams);
+	server.start();
+
+	Poco::Thread::sleep(200);
+
+	HTTPClientSession cs("127.0.0.1", ss.address().port());
+	HTTPRequest request(HTTPRequest::HTTP_GET, "/ws", HTTPRequest::HTTP_1_1);
+	HTTPResponse response;
+	WebSocket ws(cs, request, response);
+
+	std::string payload(msgSize, '\0');
+	for (int i = 0; i < msgSize; i++) payload[i] = static_cast<char>((i*7 + i/256) & 0xff);
+
+	const int sizes[] = {1, 3, 17, 125, 126, 1023, 1024, 1025, 4099, 65535, 65536, 65537, msgSize};
+	Poco::Buffer<char> buffer(0);
+	int flags;
+	for (int size: sizes)
+	{
+		ws.sendFrame(payload.data(), size, WebSocket::FRAME_BINARY);
+		int n = ws.receiveFrame(buffer, flags);
+		assertTrue (n == size);
+		assertTrue (payload.compare(0, size, buffer.begin(), n) == 0);
+		assertTrue (flags == WebSocket::FRAME_BINARY);
+		buffer.resize(0);
+	}
+
+	ws.shutdown();
+	int n = ws.receiveFrame(buffer, flags);
+	assertTrue (n == 2);
+	assertTrue ((flags & WebSocket::FRAME_OP_BITMASK) == WebSocket::FRAME_OP_CLOSE);
+
+	server.stop();
+}
+
+
+void WebSocketTest::testMaskPayload()
+{
+	const char mask[4] = {'\x12', '\x34', '\x56', '\x78'};
+	std::string src(300, '\0');
+	for (std::size_t i = 0; i < src.size(); i++) src[i] = static_cast<char>(i*13);
+
+	for (std::size_t offset = 0; offset < 8; offset++)
+	{
+		for (std::size_t length = 0; length + offset <= src.size(); length += 7)
+		{
+			std::string dest(length, '\0');
+			Poco::Net::WebSocketImpl::maskPayload(&dest[0], src.data() + offset, length, mask);
+			for (std::size_t i = 0; i < length; i++)
+			{
+				assertTrue (dest[i] == static_cast<char>(src[offset + i] ^ mask[i % 4]));
+			}
+			Poco::Net::WebSocketImpl::maskPayload(&dest[0], dest.data(), length, mask);
+			assertTrue (dest.compare(0, length, src, offset, length) == 0);
+		}
+	}
+}
+
+
+void WebSocketTest::testCompression()
+{
+	PerMessageDeflate::Config config;
+	Poco::Net::ServerSocket ss(0);
+	Poco::Net::HTTPServer server(new WebSocketRequestHandlerFactory(256000, &config), ss, new Poco::Net::HTTPServerParams);
+	server.start();
+
+	Poco::Thread::sleep(200);
+
+	HTTPClientSession cs("127.0.0.1", ss.address().port());
+	HTTPRequest request(HTTPRequest::HTTP_GET, "/ws", HTTPRequest::HTTP_1_1);
+	HTTPResponse response;
+	WebSocket ws(cs, request, response, config);
+	assertTrue (ws.compressionEnabled());
+	assertTrue (response.get("Sec-WebSocket-Extensions") == "permessage-deflate");
+
+	Poco::Buffer<char> buffer(0);
+	int flags;
+	for (int records: {0, 1, 10, 1000, 3000})
+	{
+		std::string payload = makeJSON(records);
+		for (int i = 0; i < 2; i++)
+		{
+			ws.sendFrame(payload.data(), static_cast<int>(payload.size()));
+			buffer.resize(0);
+			int n = ws.receiveFrame(buffer, flags);
+			assertTrue (n == static_cast<int>(payload.size()));
+			assertTrue (payload.compare(0, payload.size(), buffer.begin(), n) == 0);
+			assertTrue (flags == WebSocket::FRAME_TEXT);
+		}
+	}
+
+	// fragmented message
+	std::string payload = makeJSON(100);
+	const int half = static_cast<int>(payload.size()/2);
+	ws.sendFrame(payload.data(), half, WebSocket::FRAME_OP_TEXT);
+	ws.sendFrame(payload.data() + half, static_cast<int>(payload.size()) - half, WebSocket::FRAME_FLAG_FIN | WebSocket::FRAME_OP_CONT);
+	char frame[256000];
+	int n = ws.receiveFrame(frame, sizeof(frame), flags);
+	assertTrue (n == half);
+	assertTrue (flags == WebSocket::FRAME_OP_TEXT);
+	int m = ws.receiveFrame(frame + n, sizeof(frame) - n, flags);
+	assertTrue (flags == (WebSocket::FRAME_FLAG_FIN | WebSocket::FRAME_OP_CONT));
+	assertTrue (payload.compare(0, payload.size(), frame, n + m) == 0);
+
+	// decompressed payload exceeds maximum payload size
+	ws.setMaxPayloadSize(1000);
+	payload = makeJSON(1000);
+	ws.sendFrame(payload.data(), static_cast<int>(payload.size()));
+	try
+	{
+		buffer.resize(0);
+		ws.receiveFrame(buffer, flags);
+		fail("payload too big - must throw");
+	}
+	catch (WebSocketException& exc)
+	{
+		assertTrue (exc.code() == WebSocket::WS_ERR_PAYLOAD_TOO_BIG);
+	}
+
+	ws.close();
+	server.stop();
+	waitForConnections(server);
+}
+
+
+void WebSocketTest::testCompressionNoContextTakeover()
+{
+	PerMessageDeflate::Config serverConfig;
+	serverConfig.serverNoContextTakeover = true;
+	serverConfig.minMessageSize = 64;
+	Poco::Net::ServerSocket ss(0);
+	Poco::Net::HTTPServer server(new WebSocketRequestHandlerFactory(256000, &serverConfig), ss, new Poco::Net::HTTPServerParams);
+	server.start();
+
+	Poco::Thread::sleep(200);
+
+	PerMessageDeflate::Config clientConfig;
+	clientConfig.clientNoContextTakeover = true;
+	clientConfig.clientMaxWindowBits = 10;
+	clientConfig.serverMaxWindowBits = 12;
+
+	HTTPClientSession cs("127.0.0.1", ss.address().port());
+	HTTPRequest request(HTTPRequest::HTTP_GET, "/ws", HTTPRequest::HTTP_1_1);
+	HTTPResponse response;
+	WebSocket ws(cs, request, response, clientConfig);
+	assertTrue (request.get("Sec-WebSocket-Extensions") == "permessage-deflate; client_no_context_takeover; server_max_window_bits=12; client_max_window_bits=10");
+	assertTrue (ws.compressionEnabled());
+	assertTrue (response.get("Sec-WebSocket-Extensions") == "permessage-deflate; client_no_context_takeover; server_max_window_bits=12");
+
+	Poco::Buffer<char> buffer(0);
+	int flags;
+	for (int records: {0, 2, 100, 3000, 100})
+	{
+		std::string payload = makeJSON(records);
+		ws.sendFrame(payload.data(), static_cast<int>(payload.size()), WebSocket::FRAME_BINARY);
+		buffer.resize(0);
+		int n = ws.receiveFrame(buffer, flags);
+		assertTrue (n == static_cast<int>(payload.size()));
+		assertTrue (payload.compare(0, payload.size(), buffer.begin(), n) == 0);
+		assertTrue (flags == WebSocket::FRAME_BINARY);
+	}
+
+	ws.close();
+	server.stop();
+	waitForConnections(server);
+}
+
+
+void WebSocketTest::testCompressionNegotiation()
+{
+	PerMessageDeflate::Config config;
+	PerMessageDeflate::Parameters params;
+	std::string response;
+
+	assertTrue (PerMessageDeflate::offer(config) == "permessage-deflate; client_max_window_bits");
+
+	assertTrue (!PerMessageDeflate::accept("x-webkit-deflate-frame", config, params, response));
+	assertTrue (!PerMessageDeflate::accept("permessage-deflate; server_max_window_bits=8", config, params, response));
+	assertTrue (!PerMessageDeflate::accept("permessage-deflate; server_max_window_bits=16", config, params, response));
+	assertTrue (!PerMessageDeflate::accept("permessage-deflate; unknown_parameter", config, params, response));
+	assertTrue (!PerMessageDeflate::accept("permessage-deflate; client_no_context_takeover; client_no_context_takeover", config, params, response));
+
+	assertTrue (PerMessageDeflate::accept("permessage-deflate; server_max_window_bits=8, permessage-deflate; server_no_context_takeover; server_max_window_bits=10", config, params, response));
+	assertTrue (response == "permessage-deflate; server_no_context_takeover; server_max_window_bits=10");
+	assertTrue (params.serverNoContextTakeover);
+	assertTrue (!params.clientNoContextTakeover);
+	assertTrue (params.serverMaxWindowBits == 10);
+	assertTrue (params.clientMaxWindowBits == 15);
+
+	config.clientMaxWindowBits = 12;
+	assertTrue (PerMessageDeflate::accept("permessage-deflate; client_max_window_bits", config, params, response));
+	assertTrue (response == "permessage-deflate; client_max_window_bits=12");
+	assertTrue (params.clientMaxWindowBits == 12);
+
+	// memory limit: the client's window can only be reduced if offered
+	config = PerMessageDeflate::Config();
+	config.maxMemory = 16*1024;
+	assertTrue (!PerMessageDeflate::accept("permessage-deflate", config, params, response));
+	assertTrue (PerMessageDeflate::accept("permessage-deflate; client_max_window_bits", config, params, response));
+	assertTrue (params.clientMaxWindowBits < 15);
+	PerMessageDeflate deflate(params, config, true);
+	assertTrue (deflate.memoryUsage() <= config.maxMemory);
+
+	config = PerMessageDeflate::Config();
+	PerMessageDeflate::confirm("permessage-deflate; server_no_context_takeover; client_max_window_bits=11", config, params);
+	assertTrue (params.serverNoContextTakeover);
+	assertTrue (params.clientMaxWindowBits == 11);
+	assertTrue (params.serverMaxWindowBits == 15);
+
+	const char* invalid[] =
+	{
+		"x-webkit-deflate-frame",
+		"permessage-deflate, permessage-deflate",
+		"permessage-deflate; server_max_window_bits",
+		"permessage-deflate; client_max_window_bits=8",
+		"permessage-deflate; unknown_parameter"
+	};
+	for (const char* ext: invalid)
+	{
+		try
+		{
+			PerMessageDeflate::confirm(ext, config, params);
+			failmsg(ext);
+		}
+		catch (WebSocketException& exc)
+		{
+			assertTrue (exc.code() == WebSocket::WS_ERR_HANDSHAKE_EXTENSION);
+		}
+	}
+
+	config.serverMaxWindowBits = 12;
+	try
+	{
+		PerMessageDeflate::confirm("permessage-deflate", config, params);
+		fail("server_max_window_bits missing - must throw");
+	}
+	catch (WebSocketException& exc)
+	{
+		assertTrue (exc.code() == WebSocket::WS_ERR_HANDSHAKE_EXTENSION);
+	}
+}
+
+
 void WebSocketTest::setUp()
 {
 }
@@ -289,6 +577,11 @@ CppUnit::Test* WebSocketTest::suite()
 	CppUnit_addTest(pSuite, WebSocketTest, testWebSocket);
 	CppUnit_addTest(pSuite, WebSocketTest, testWebSocketLarge);
 	CppUnit_addTest(pSuite, WebSocketTest, testWebSocketLargeInOneFrame);
+	CppUnit_addTest(pSuite, WebSocketTest, testWebSocketBinary);
+	CppUnit_addTest(pSuite, WebSocketTest, testMaskPayload);
+	CppUnit_addTest(pSuite, WebSocketTest, testCompression);
+	CppUnit_addTest(pSuite, WebSocketTest, testCompressionNoContextTakeover);
+	CppUnit_addTest(pSuite, WebSocketTest, testCompressionNegotiation);
 
 	return pSuite;
 }
@@ -27,6 +27,11 @@ public:
 	void testWebSocket();
 	void testWebSocketLarge();
 	void testWebSocketLargeInOneFrame();
+	void testWebSocketBinary();
+	void testMaskPayload();
+	void testCompression();
+	void testCompressionNoContextTakeover();
+	void testCompressionNegotiation();
 
 	void setUp();
 	void tearDown();
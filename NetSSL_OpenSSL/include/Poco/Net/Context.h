@@ -21,12 +21,14 @@
 #include "Poco/Net/NetSSL.h"
 #include "Poco/Net/SocketDefs.h"
 #include "Poco/Net/InvalidCertificateHandler.h"
+#include "Poco/Net/SessionCache.h"
 #include "Poco/Crypto/X509Certificate.h"
 #include "Poco/Crypto/EVPPKey.h"
 #include "Poco/Crypto/RSAKey.h"
 #include "Poco/RefCountedObject.h"
 #include "Poco/SharedPtr.h"
 #include "Poco/AutoPtr.h"
+#include "Poco/Timespan.h"
 #include <openssl/ssl.h>
 #include <cstdlib>
 
@@ -386,6 +388,68 @@ public:
 		///
 		/// This method may only be called on SERVER_USE Context objects.
 
+	void setSessionCache(SessionCache::Ptr pCache);
+		/// Replaces the internal session cache of OpenSSL on the
+		/// server with the given SessionCache (e.g., a ShardedSessionCache
+		/// or a SharedMemorySessionCache), and enables session caching.
+		///
+		/// Sessions are serialized and stored in the given cache
+		/// when created, and looked up there when a client attempts
+		/// to resume a session. A cache may be shared by several
+		/// Context objects. Passing a null pointer restores the
+		/// internal session cache.
+		///
+		/// Note that, unless disableStatelessSessionResumption() is
+		/// called, clients will usually resume sessions using session
+		/// tickets, which do not require a server session cache.
+		///
+		/// This method may only be called on SERVER_USE Context objects.
+
+	SessionCache::Ptr getSessionCache() const;
+		/// Returns the SessionCache set with setSessionCache(),
+		/// or a null pointer if the internal session cache is used.
+
+	void enableSessionTicketKeyRotation(const Poco::Timespan& interval, const std::string& secret = std::string());
+		/// Enables stateless session resumption (RFC 5077 session tickets)
+		/// with session ticket keys that are automatically replaced
+		/// after the given interval.
+		///
+		/// The keys for each interval are derived from the given secret
+		/// and the current time, so that all servers (processes or hosts)
+		/// configured with the same secret and interval accept each
+		/// other's tickets without having to exchange keys. If no secret
+		/// is given, a random secret is generated.
+		///
+		/// Tickets encrypted with the key of the previous interval
+		/// are still accepted, and replaced by a new ticket.
+		/// A ticket is therefore valid for at most two intervals.
+		///
+		/// This method may only be called on SERVER_USE Context objects.
+
+	struct SessionStatistics
+		/// Server-side session resumption statistics.
+	{
+		long handshakes;
+			/// Number of completed handshakes.
+		long resumed;
+			/// Number of handshakes that resumed a session
+			/// (using a cached session or a ticket).
+		long misses;
+			/// Number of sessions requested by clients
+			/// but not found in the session cache.
+		long timeouts;
+			/// Number of sessions requested by clients that
+			/// were found in the session cache, but had expired.
+		long cacheHits;
+			/// Number of sessions found in the SessionCache
+			/// set with setSessionCache().
+	};
+
+	SessionStatistics sessionStatistics() const;
+		/// Returns the session resumption statistics of the server.
+		/// The number of full handshakes avoided is given by
+		/// SessionStatistics::resumed.
+
 	void enableExtendedCertificateVerification(bool flag = true);
 		/// Enable or disable the automatic post-connection
 		/// extended certificate verification.
@@ -439,6 +503,26 @@ public:
 	void setSecurityLevel(SecurityLevel level);
 		/// Sets the security level.
 
+	void enableKernelTLS(bool flag = true);
+		/// Enables or disables kernel TLS (kTLS) offload for connections
+		/// using this Context. Disabled by default.
+		///
+		/// If enabled, and supported by OpenSSL, the kernel and the
+		/// negotiated cipher suite, OpenSSL hands over the TLS record
+		/// layer to the kernel after the handshake. Data is then
+		/// encrypted and decrypted in the kernel, and files can be sent
+		/// without copying them to user space (see
+		/// SecureStreamSocket::kernelTLSSend() and StreamSocket::sendFile()).
+		///
+		/// If kTLS is not available (e.g., the Linux tls module is
+		/// not loaded), connections transparently fall back to
+		/// user space TLS.
+		///
+		/// Requires OpenSSL 3.0 or newer; does nothing otherwise.
+
+	bool kernelTLSEnabled() const;
+		/// Returns true iff kernel TLS offload is enabled.
+
 private:
 	void init(const Params& params);
 		/// Initializes the Context with the given parameters.
@@ -453,12 +537,43 @@ private:
 	void createSSLContext();
 		/// Create a SSL_CTX object according to Context configuration.
 
+	int serverSessionCacheMode() const;
+		/// Returns the session cache mode for an enabled server session cache.
+
+	void deriveTicketKeys(Poco::Int64 epoch, unsigned char name[16], unsigned char aesKey[32], unsigned char hmacKey[32]) const;
+		/// Derives the session ticket keys for the given interval.
+
+	static int newSessionCallback(SSL* pSSL, SSL_SESSION* pSession);
+		/// Stores a new session in the SessionCache.
+
+#if OPENSSL_VERSION_NUMBER >= 0x10100000L
+	static SSL_SESSION* getSessionCallback(SSL* pSSL, const unsigned char* id, int length, int* pCopy);
+#else
+	static SSL_SESSION* getSessionCallback(SSL* pSSL, unsigned char* id, int length, int* pCopy);
+#endif
+		/// Looks up a session in the SessionCache.
+
+	static void removeSessionCallback(SSL_CTX* pSSLContext, SSL_SESSION* pSession);
+		/// Removes a session from the SessionCache.
+
+#if OPENSSL_VERSION_NUMBER >= 0x30000000L
+	static int ticketKeyCallback(SSL* pSSL, unsigned char* name, unsigned char* iv, EVP_CIPHER_CTX* pCipherContext, EVP_MAC_CTX* pMacContext, int encrypt);
+#else
+	static int ticketKeyCallback(SSL* pSSL, unsigned char* name, unsigned char* iv, EVP_CIPHER_CTX* pCipherContext, HMAC_CTX* pMacContext, int encrypt);
+#endif
+		/// Selects the session ticket keys.
+
+	static Context* fromSSL(SSL* pSSL);
+
 	Usage _usage;
 	VerificationMode _mode;
 	SSL_CTX* _pSSLContext;
 	bool _extendedCertificateVerification;
 	bool _ocspStaplingResponseVerification;
 	InvalidCertificateHandlerPtr _pInvalidCertificateHandler;
+	SessionCache::Ptr _pSessionCache;
+	Poco::Timespan _ticketKeyInterval;
+	std::string _ticketKeySecret;
 };
 
 
@@ -512,6 +627,12 @@ inline Context::InvalidCertificateHandlerPtr Context::getInvalidCertificateHandl
 }
 
 
+inline SessionCache::Ptr Context::getSessionCache() const
+{
+	return _pSessionCache;
+}
+
+
 } } // namespace Poco::Net
 
 
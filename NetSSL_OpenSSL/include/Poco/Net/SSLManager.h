@@ -76,6 +76,7 @@ class NetSSL_API SSLManager
 	///            <loadDefaultCAFile>true|false</loadDefaultCAFile>
 	///            <cipherList>ALL:!ADH:!LOW:!EXP:!MD5:@STRENGTH</cipherList>
 	///            <preferServerCiphers>true|false</preferServerCiphers>
+	///            <kernelTLS>true|false</kernelTLS>
 	///            <privateKeyPassphraseHandler>
 	///                <name>KeyFileHandler</name>
 	///                <options>
@@ -122,6 +123,7 @@ class NetSSL_API SSLManager
 	///      client preferences. When not called, the SSL server will always follow the clients
 	///      preferences. When called, the SSL/TLS server will choose following its own
 	///      preferences.
+	///    - kernelTLS (bool): Enables kernel TLS offload (see Context::enableKernelTLS()).
 	///    - privateKeyPassphraseHandler.name (string): The name of the class (subclass of PrivateKeyPassphraseHandler)
 	///      used for obtaining the passphrase for accessing the private key.
 	///    - privateKeyPassphraseHandler.options.password (string): The password to be used by KeyFileHandler.
@@ -335,6 +337,7 @@ private:
 	static const std::string CFG_CYPHER_LIST; // for backwards compatibility
 	static const std::string VAL_CIPHER_LIST;
 	static const std::string CFG_PREFER_SERVER_CIPHERS;
+	static const std::string CFG_KERNEL_TLS;
 	static const std::string CFG_DELEGATE_HANDLER;
 	static const std::string VAL_DELEGATE_HANDLER;
 	static const std::string CFG_CERTIFICATE_HANDLER;
@@ -0,0 +1,239 @@
+//
+// SecureHandshakeHandler.h
+//
+// Library: NetSSL_OpenSSL
+// Package: SSLSockets
+// Module:  SecureHandshakeHandler
+//
+// Definition of the SecureHandshakeHandler class template.
+//
+// Copyright (c) 2005-2023, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef NetSSL_SecureHandshakeHandler_INCLUDED
+#define NetSSL_SecureHandshakeHandler_INCLUDED
+
+
+#include "Poco/Net/NetSSL.h"
+#include "Poco/Net/SecureStreamSocket.h"
+#include "Poco/Net/SocketReactor.h"
+#include "Poco/Net/SocketNotification.h"
+#include "Poco/Observer.h"
+#include "Poco/Timestamp.h"
+#include "Poco/Timespan.h"
+
+
+namespace Poco {
+namespace Net {
+
+
+template <class ServiceHandler>
+class SecureHandshakeHandler
+	/// SecureHandshakeHandler performs the server-side SSL/TLS handshake
+	/// of an accepted SecureStreamSocket without blocking the thread
+	/// of the SocketReactor, and then hands the connection over to a
+	/// ServiceHandler.
+	///
+	/// SecureHandshakeHandler satisfies the requirements for a
+	/// ServiceHandler of SocketAcceptor and ParallelSocketAcceptor,
+	/// so that a reactor-based TLS server is set up with, e.g.:
+	///
+	///     SecureServerSocket socket(port);
+	///     SocketReactor reactor;
+	///     SocketAcceptor<SecureHandshakeHandler<MyServiceHandler>> acceptor(socket, reactor);
+	///
+	/// The socket is put into non-blocking mode, and the handshake
+	/// is advanced with SecureStreamSocket::completeHandshake()
+	/// whenever the socket becomes readable or writable, as
+	/// requested by OpenSSL (ERR_SSL_WANT_READ or ERR_SSL_WANT_WRITE).
+	/// Once the handshake has completed and the peer certificate
+	/// has been verified, the original blocking mode of the socket
+	/// is restored and a ServiceHandler is created with the socket
+	/// and the reactor. The ServiceHandler thus never sees a
+	/// connection with a pending handshake.
+	///
+	/// If the handshake fails, the peer closes the connection, the
+	/// reactor is stopped, or the handshake does not complete within
+	/// the receive timeout of the accepted socket (which is inherited
+	/// from the server socket on most platforms), or within
+	/// DEFAULT_TIMEOUT seconds if no receive timeout has been set, the
+	/// connection is closed without creating a ServiceHandler. Note that
+	/// the timeout is checked when the SocketReactor dispatches a
+	/// TimeoutNotification, i.e., when none of its sockets is ready.
+	///
+	/// A SecureHandshakeHandler destroys itself when it is done.
+{
+public:
+	enum
+	{
+		DEFAULT_TIMEOUT = 30
+			/// Handshake timeout in seconds, if the socket has no receive timeout.
+	};
+
+	SecureHandshakeHandler(const StreamSocket& socket, SocketReactor& reactor):
+		_socket(socket),
+		_reactor(reactor),
+		_blocking(_socket.getBlocking()),
+		_wantWrite(false)
+		/// Creates the SecureHandshakeHandler and registers it
+		/// with the given SocketReactor.
+		///
+		/// Throws a Poco::InvalidArgumentException if the
+		/// socket is not a SecureStreamSocket.
+	{
+		Poco::Timespan timeout = _socket.getReceiveTimeout();
+		if (timeout.totalMicroseconds() == 0) timeout = Poco::Timespan(DEFAULT_TIMEOUT, 0);
+		_deadline += timeout;
+
+		_socket.setBlocking(false);
+		_reactor.addEventHandler(_socket, Poco::Observer<SecureHandshakeHandler, ReadableNotification>(*this, &SecureHandshakeHandler::onReadable));
+		_reactor.addEventHandler(_socket, Poco::Observer<SecureHandshakeHandler, ErrorNotification>(*this, &SecureHandshakeHandler::onError));
+		_reactor.addEventHandler(_socket, Poco::Observer<SecureHandshakeHandler, TimeoutNotification>(*this, &SecureHandshakeHandler::onTimeout));
+		_reactor.addEventHandler(_socket, Poco::Observer<SecureHandshakeHandler, ShutdownNotification>(*this, &SecureHandshakeHandler::onShutdown));
+	}
+
+	~SecureHandshakeHandler()
+		/// Unregisters and destroys the SecureHandshakeHandler.
+	{
+		try
+		{
+			if (_wantWrite)
+				_reactor.removeEventHandler(_socket, Poco::Observer<SecureHandshakeHandler, WritableNotification>(*this, &SecureHandshakeHandler::onWritable));
+			else
+				_reactor.removeEventHandler(_socket, Poco::Observer<SecureHandshakeHandler, ReadableNotification>(*this, &SecureHandshakeHandler::onReadable));
+			_reactor.removeEventHandler(_socket, Poco::Observer<SecureHandshakeHandler, ErrorNotification>(*this, &SecureHandshakeHandler::onError));
+			_reactor.removeEventHandler(_socket, Poco::Observer<SecureHandshakeHandler, TimeoutNotification>(*this, &SecureHandshakeHandler::onTimeout));
+			_reactor.removeEventHandler(_socket, Poco::Observer<SecureHandshakeHandler, ShutdownNotification>(*this, &SecureHandshakeHandler::onShutdown));
+		}
+		catch (...)
+		{
+			poco_unexpected();
+		}
+	}
+
+	void onReadable(ReadableNotification* pNotification)
+	{
+		pNotification->release();
+		handshake();
+	}
+
+	void onWritable(WritableNotification* pNotification)
+	{
+		pNotification->release();
+		handshake();
+	}
+
+	void onError(ErrorNotification* pNotification)
+	{
+		pNotification->release();
+		abort();
+	}
+
+	void onTimeout(TimeoutNotification* pNotification)
+	{
+		pNotification->release();
+		if (_deadline.isElapsed(0)) abort();
+	}
+
+	void onShutdown(ShutdownNotification* pNotification)
+	{
+		pNotification->release();
+		abort();
+	}
+
+protected:
+	void handshake()
+		/// Advances the handshake.
+	{
+		int rc = 0;
+		try
+		{
+			rc = _socket.completeHandshake();
+			if (rc == 1) _socket.verifyPeerCertificate();
+		}
+		catch (Poco::Exception&)
+		{
+			rc = 0;
+		}
+
+		switch (rc)
+		{
+		case 1:
+			complete();
+			break;
+		case SecureStreamSocket::ERR_SSL_WANT_READ:
+			waitFor(false);
+			break;
+		case SecureStreamSocket::ERR_SSL_WANT_WRITE:
+			waitFor(true);
+			break;
+		default:
+			abort();
+			break;
+		}
+	}
+
+	void waitFor(bool write)
+		/// Waits for the socket to become writable (if write is true)
+		/// or readable.
+	{
+		if (write == _wantWrite) return;
+
+		if (write)
+		{
+			_reactor.removeEventHandler(_socket, Poco::Observer<SecureHandshakeHandler, ReadableNotification>(*this, &SecureHandshakeHandler::onReadable));
+			_reactor.addEventHandler(_socket, Poco::Observer<SecureHandshakeHandler, WritableNotification>(*this, &SecureHandshakeHandler::onWritable));
+		}
+		else
+		{
+			_reactor.removeEventHandler(_socket, Poco::Observer<SecureHandshakeHandler, WritableNotification>(*this, &SecureHandshakeHandler::onWritable));
+			_reactor.addEventHandler(_socket, Poco::Observer<SecureHandshakeHandler, ReadableNotification>(*this, &SecureHandshakeHandler::onReadable));
+		}
+		_wantWrite = write;
+	}
+
+	void complete()
+		/// Hands over the connection to a new ServiceHandler.
+	{
+		StreamSocket socket(_socket);
+		SocketReactor& reactor = _reactor;
+		socket.setBlocking(_blocking);
+		delete this;
+		new ServiceHandler(socket, reactor);
+	}
+
+	void abort()
+		/// Closes the connection.
+	{
+		SecureStreamSocket socket(_socket);
+		delete this;
+		try
+		{
+			socket.abort();
+		}
+		catch (...)
+		{
+		}
+	}
+
+private:
+	SecureHandshakeHandler();
+	SecureHandshakeHandler(const SecureHandshakeHandler&);
+	SecureHandshakeHandler& operator = (const SecureHandshakeHandler&);
+
+	SecureStreamSocket _socket;
+	SocketReactor& _reactor;
+	bool _blocking;
+	bool _wantWrite;
+	Poco::Timestamp _deadline;
+};
+
+
+} } // namespace Poco::Net
+
+
+#endif // NetSSL_SecureHandshakeHandler_INCLUDED
@@ -194,6 +194,9 @@ public:
 		/// the server-side handshake is completed, otherwise
 		/// a client-side handshake is performed.
 
+	bool handshakeCompleted() const;
+		/// Returns true iff the SSL handshake has been completed.
+
 	poco_socket_t sockfd();
 		/// Returns the underlying socket descriptor.
 
@@ -239,6 +242,23 @@ public:
 		/// Returns true iff a reused session was negotiated during
 		/// the handshake.
 
+	bool kernelTLSSend() const;
+		/// Returns true iff the kernel has taken over the TLS record
+		/// layer for sending (see Context::enableKernelTLS()).
+
+	bool kernelTLSReceive() const;
+		/// Returns true iff the kernel has taken over the TLS record
+		/// layer for receiving (see Context::enableKernelTLS()).
+
+	std::streamsize sendFile(FileInputStream& fileInputStream, std::streamoff offset, std::streamsize count);
+		/// Sends the contents of a file through the socket with
+		/// SSL_sendfile(), without copying the data to user space.
+		///
+		/// Must only be called if kernelTLSSend() returns true.
+		///
+		/// Returns the number of bytes sent, which may be less than
+		/// count for a non-blocking socket.
+
 protected:
 	void acceptSSL();
 		/// Performs a server-side SSL handshake and certificate verification.
@@ -305,6 +325,12 @@ inline poco_socket_t SecureSocketImpl::sockfd()
 }
 
 
+inline bool SecureSocketImpl::handshakeCompleted() const
+{
+	return _pSSL && !_needHandshake;
+}
+
+
 inline Context::Ptr SecureSocketImpl::context() const
 {
 	return _pContext;
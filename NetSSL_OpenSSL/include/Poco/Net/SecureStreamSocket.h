@@ -146,6 +146,18 @@ public:
 		/// Returns true iff the peer has presented a
 		/// certificate.
 
+	bool kernelTLSSend() const;
+		/// Returns true iff the kernel performs TLS encryption of data
+		/// sent over this connection (kTLS, see Context::enableKernelTLS()).
+		/// In this case, sendFile() sends files without copying their
+		/// contents to user space.
+		///
+		/// Only meaningful after the SSL handshake has been completed.
+
+	bool kernelTLSReceive() const;
+		/// Returns true iff the kernel performs TLS decryption of data
+		/// received over this connection (kTLS, see Context::enableKernelTLS()).
+
 	X509Certificate peerCertificate() const;
 		/// Returns the peer's X509 certificate.
 		///
@@ -233,6 +245,12 @@ public:
 		/// ERR_SSL_WANT_WRITE if more data is required to complete the
 		/// handshake. In this case, completeHandshake() should be called
 		/// again, after the necessary condition has been met.
+		///
+		/// See SecureHandshakeHandler for performing the handshake
+		/// of accepted connections on a SocketReactor.
+
+	bool handshakeCompleted() const;
+		/// Returns true iff the SSL handshake has been completed.
 
 	Session::Ptr currentSession();
 		/// Returns the SSL session of the current connection,
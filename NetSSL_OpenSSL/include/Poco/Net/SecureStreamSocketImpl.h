@@ -87,6 +87,16 @@ public:
 		///
 		/// Returns the number of bytes received.
 
+	std::streamsize sendFile(FileInputStream& fileInputStream, std::streamoff offset = 0, std::streamsize count = 0);
+		/// Sends the contents of a file through the socket.
+		///
+		/// If the kernel has taken over TLS encryption (see kernelTLSSend()),
+		/// the file is sent with SSL_sendfile() without copying its contents
+		/// to user space. Otherwise, the file is read into a buffer and sent
+		/// with sendBytes().
+		///
+		/// Returns the number of bytes sent.
+
 	int sendTo(const void* buffer, int length, const SocketAddress& address, int flags = 0);
 		/// Not supported by a SecureStreamSocket.
 		///
@@ -102,6 +112,17 @@ public:
 		///
 		/// Throws a Poco::InvalidAccessException.
 
+	void setBlocking(bool flag);
+		/// Sets the socket in blocking mode if flag is true,
+		/// disables blocking mode if flag is false.
+		///
+		/// The blocking mode of the underlying socket, which determines
+		/// whether sendBytes(), receiveBytes() and completeHandshake()
+		/// wait for the SSL connection to become ready, is changed as well.
+
+	bool getBlocking() const;
+		/// Returns the blocking mode of the socket.
+
 	int available();
 		/// Returns the number of bytes available that can be read
 		/// without causing the socket to block.
@@ -143,6 +164,14 @@ public:
 		/// Returns true iff the peer has presented a
 		/// certificate.
 
+	bool kernelTLSSend() const;
+		/// Returns true iff the kernel performs TLS encryption of
+		/// data sent over this connection (see Context::enableKernelTLS()).
+
+	bool kernelTLSReceive() const;
+		/// Returns true iff the kernel performs TLS decryption of
+		/// data received over this connection (see Context::enableKernelTLS()).
+
 	X509Certificate peerCertificate() const;
 		/// Returns the peer's X509 certificate.
 		///
@@ -175,6 +204,9 @@ public:
 		/// the server-side handshake is completed, otherwise
 		/// a client-side handshake is performed.
 
+	bool handshakeCompleted() const;
+		/// Returns true iff the SSL handshake has been completed.
+
 	Session::Ptr currentSession();
 		/// Returns the SSL session of the current connection,
 		/// for reuse in a future connection (if session caching
@@ -245,6 +277,12 @@ inline Context::Ptr SecureStreamSocketImpl::context() const
 }
 
 
+inline bool SecureStreamSocketImpl::handshakeCompleted() const
+{
+	return _impl.handshakeCompleted();
+}
+
+
 inline Session::Ptr SecureStreamSocketImpl::currentSession()
 {
 	return _impl.currentSession();
@@ -0,0 +1,101 @@
+//
+// SessionCache.h
+//
+// Library: NetSSL_OpenSSL
+// Package: SSLCore
+// Module:  SessionCache
+//
+// Definition of the SessionCache class.
+//
+// Copyright (c) 2005-2023, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef NetSSL_SessionCache_INCLUDED
+#define NetSSL_SessionCache_INCLUDED
+
+
+#include "Poco/Net/NetSSL.h"
+#include "Poco/RefCountedObject.h"
+#include "Poco/AutoPtr.h"
+#include "Poco/Timestamp.h"
+#include <string>
+
+
+namespace Poco {
+namespace Net {
+
+
+class NetSSL_API SessionCache: public Poco::RefCountedObject
+	/// SessionCache is the base class for server-side SSL/TLS
+	/// session caches that replace the internal session cache
+	/// of OpenSSL (see Context::setSessionCache()).
+	///
+	/// Sessions are stored in their serialized (DER) form,
+	/// keyed by the session ID. Implementations must be
+	/// thread-safe.
+{
+public:
+	using Ptr = Poco::AutoPtr<SessionCache>;
+
+	struct Statistics
+		/// Cache statistics.
+	{
+		Statistics();
+
+		Poco::UInt64 hits;
+			/// Number of lookups that found a session.
+		Poco::UInt64 misses;
+			/// Number of lookups that did not find a session
+			/// (including expired sessions).
+		Poco::UInt64 stores;
+			/// Number of sessions added.
+		Poco::UInt64 evictions;
+			/// Number of sessions removed to make room for new ones.
+		std::size_t size;
+			/// Current number of sessions in the cache.
+	};
+
+	virtual void add(const std::string& id, const std::string& session, const Poco::Timestamp& expires) = 0;
+		/// Adds the given serialized session with the given ID to
+		/// the cache, replacing an existing session with the same ID.
+		/// The session must not be returned by get() after the given
+		/// expiration time.
+		///
+		/// The cache may evict other sessions, or silently
+		/// discard the session if it cannot be stored.
+
+	virtual bool get(const std::string& id, std::string& session) = 0;
+		/// Looks up the session with the given ID. If found and not
+		/// yet expired, stores the serialized session in session and
+		/// returns true. Otherwise, returns false.
+
+	virtual void remove(const std::string& id) = 0;
+		/// Removes the session with the given ID from the cache.
+
+	virtual void clear() = 0;
+		/// Removes all sessions from the cache.
+
+	virtual Statistics statistics() const = 0;
+		/// Returns the cache statistics.
+
+protected:
+	SessionCache();
+		/// Creates the SessionCache.
+
+	~SessionCache();
+		/// Destroys the SessionCache.
+
+private:
+	SessionCache(const SessionCache&);
+	SessionCache& operator = (const SessionCache&);
+};
+
+
+} } // namespace Poco::Net
+
+
+#endif // NetSSL_SessionCache_INCLUDED
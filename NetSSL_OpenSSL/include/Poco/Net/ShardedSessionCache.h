@@ -0,0 +1,120 @@
+//
+// ShardedSessionCache.h
+//
+// Library: NetSSL_OpenSSL
+// Package: SSLCore
+// Module:  ShardedSessionCache
+//
+// Definition of the ShardedSessionCache class.
+//
+// Copyright (c) 2005-2023, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef NetSSL_ShardedSessionCache_INCLUDED
+#define NetSSL_ShardedSessionCache_INCLUDED
+
+
+#include "Poco/Net/NetSSL.h"
+#include "Poco/Net/SessionCache.h"
+#include <list>
+#include <unordered_map>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <atomic>
+
+
+namespace Poco {
+namespace Net {
+
+
+class NetSSL_API ShardedSessionCache: public SessionCache
+	/// An in-process SessionCache that distributes sessions over
+	/// a number of independently locked shards, selected by a hash
+	/// of the session ID, to reduce lock contention among threads
+	/// performing handshakes concurrently.
+	///
+	/// Every shard evicts its least recently used sessions
+	/// when it is full.
+{
+public:
+	using Ptr = Poco::AutoPtr<ShardedSessionCache>;
+
+	enum
+	{
+		DEFAULT_CAPACITY = 20480,
+		DEFAULT_SHARDS   = 16
+	};
+
+	explicit ShardedSessionCache(std::size_t capacity = DEFAULT_CAPACITY, std::size_t shards = DEFAULT_SHARDS);
+		/// Creates a ShardedSessionCache holding up to capacity
+		/// sessions, distributed over the given number of shards.
+
+	std::size_t capacity() const;
+		/// Returns the maximum number of sessions in the cache.
+
+	std::size_t shards() const;
+		/// Returns the number of shards.
+
+	// SessionCache
+	void add(const std::string& id, const std::string& session, const Poco::Timestamp& expires);
+	bool get(const std::string& id, std::string& session);
+	void remove(const std::string& id);
+	void clear();
+	Statistics statistics() const;
+
+protected:
+	~ShardedSessionCache();
+
+private:
+	struct Entry
+	{
+		std::string id;
+		std::string session;
+		Poco::Timestamp expires;
+	};
+
+	typedef std::list<Entry> EntryList;
+	typedef std::unordered_map<std::string, EntryList::iterator> EntryIndex;
+
+	struct Shard
+	{
+		std::mutex mutex;
+		EntryList  entries; // most recently used first
+		EntryIndex index;
+	};
+
+	Shard& shardFor(const std::string& id);
+
+	std::vector<std::unique_ptr<Shard>> _shards;
+	std::size_t _shardCapacity;
+	std::atomic<Poco::UInt64> _hits;
+	std::atomic<Poco::UInt64> _misses;
+	std::atomic<Poco::UInt64> _stores;
+	std::atomic<Poco::UInt64> _evictions;
+};
+
+
+//
+// inlines
+//
+inline std::size_t ShardedSessionCache::capacity() const
+{
+	return _shardCapacity*_shards.size();
+}
+
+
+inline std::size_t ShardedSessionCache::shards() const
+{
+	return _shards.size();
+}
+
+
+} } // namespace Poco::Net
+
+
+#endif // NetSSL_ShardedSessionCache_INCLUDED
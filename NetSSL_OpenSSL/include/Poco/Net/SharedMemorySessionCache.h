@@ -0,0 +1,136 @@
+//
+// SharedMemorySessionCache.h
+//
+// Library: NetSSL_OpenSSL
+// Package: SSLCore
+// Module:  SharedMemorySessionCache
+//
+// Definition of the SharedMemorySessionCache class.
+//
+// Copyright (c) 2005-2023, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef NetSSL_SharedMemorySessionCache_INCLUDED
+#define NetSSL_SharedMemorySessionCache_INCLUDED
+
+
+#include "Poco/Net/NetSSL.h"
+#include "Poco/Net/SessionCache.h"
+#include "Poco/SharedMemory.h"
+
+
+namespace Poco {
+namespace Net {
+
+
+class NetSSL_API SharedMemorySessionCache: public SessionCache
+	/// A SessionCache kept in a named shared memory segment
+	/// (see Poco::SharedMemory), which allows several server
+	/// processes accepting connections on the same port
+	/// (e.g., using SO_REUSEPORT) to resume each other's sessions.
+	///
+	/// The cache consists of a fixed number of slots of fixed size,
+	/// organized into buckets of WAYS slots, each protected by its
+	/// own spin lock. A session is stored in the bucket selected by
+	/// a (FNV-1a) hash of its ID, replacing an expired or the least recently
+	/// used session in the bucket if the bucket is full. Sessions
+	/// larger than the slot size are not cached.
+	///
+	/// All processes sharing a cache must use the same name,
+	/// number of slots and maximum session size. The shared memory
+	/// segment is removed when the owning cache object is destroyed.
+	///
+	/// Note that the bucket spin locks are not robust. If a process
+	/// terminates while holding one (e.g., by crashing in the middle
+	/// of add() or find()), all other processes using the bucket
+	/// will block forever. The cache must then be removed by
+	/// restarting all processes sharing it.
+{
+public:
+	using Ptr = Poco::AutoPtr<SharedMemorySessionCache>;
+
+	enum
+	{
+		DEFAULT_SLOTS = 4096,
+		DEFAULT_MAX_SESSION_SIZE = 2048,
+		WAYS = 4,
+		MAX_ID_LENGTH = 32
+	};
+
+	SharedMemorySessionCache(const std::string& name, std::size_t slots = DEFAULT_SLOTS, std::size_t maxSessionSize = DEFAULT_MAX_SESSION_SIZE, bool owner = false);
+		/// Creates or attaches to the shared memory session cache
+		/// with the given name.
+		///
+		/// If owner is true, the shared memory segment is created if
+		/// it does not exist yet, and removed when the cache is destroyed.
+		/// Otherwise, the segment must have been created by another
+		/// process. Only one process, typically the one starting the
+		/// others, should be the owner.
+		///
+		/// Throws a Poco::SystemException if the shared memory segment
+		/// cannot be created or opened, or a Poco::DataFormatException
+		/// if an existing segment has been created with a different
+		/// geometry.
+
+	std::size_t slots() const;
+		/// Returns the number of slots in the cache.
+
+	std::size_t maxSessionSize() const;
+		/// Returns the maximum size of a serialized session.
+
+	// SessionCache
+	void add(const std::string& id, const std::string& session, const Poco::Timestamp& expires);
+	bool get(const std::string& id, std::string& session);
+	void remove(const std::string& id);
+	void clear();
+	Statistics statistics() const;
+
+protected:
+	~SharedMemorySessionCache();
+
+	struct Header;
+	struct Slot;
+
+	static std::size_t segmentSize(std::size_t buckets, std::size_t slotSize);
+	Header* header() const;
+	char* bucket(std::size_t index) const;
+	Slot* slot(char* pBucket, int way) const;
+	char* bucketFor(const std::string& id) const;
+	static void lock(char* pBucket);
+	static void unlock(char* pBucket);
+
+private:
+	SharedMemorySessionCache(const SharedMemorySessionCache&);
+	SharedMemorySessionCache& operator = (const SharedMemorySessionCache&);
+
+	std::size_t _buckets;
+	std::size_t _maxSessionSize;
+	std::size_t _slotSize;
+	std::size_t _bucketSize;
+	Poco::SharedMemory _memory;
+};
+
+
+//
+// inlines
+//
+inline std::size_t SharedMemorySessionCache::slots() const
+{
+	return _buckets*WAYS;
+}
+
+
+inline std::size_t SharedMemorySessionCache::maxSessionSize() const
+{
+	return _maxSessionSize;
+}
+
+
+} } // namespace Poco::Net
+
+
+#endif // NetSSL_SharedMemorySessionCache_INCLUDED
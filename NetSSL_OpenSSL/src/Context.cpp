@@ -22,10 +22,14 @@
 #include "Poco/Timestamp.h"
 #include "Poco/Format.h"
 #include "Poco/Error.h"
+#include "Poco/ByteOrder.h"
 #include <openssl/bio.h>
 #include <openssl/bn.h>
 #include <openssl/dh.h>
 #include <openssl/err.h>
+#include <openssl/evp.h>
+#include <openssl/hmac.h>
+#include <openssl/rand.h>
 #include <openssl/ssl.h>
 #include <openssl/x509v3.h>
 #if OPENSSL_VERSION_NUMBER >= 0x30000000L
@@ -33,6 +37,7 @@
 #include <openssl/decoder.h>
 #endif // OPENSSL_VERSION_NUMBER >= 0x30000000L
 #include <iostream>
+#include <cstring>
 
 
 namespace Poco {
@@ -294,7 +299,7 @@ void Context::enableSessionCache(bool flag)
 {
 	if (flag)
 	{
-		SSL_CTX_set_session_cache_mode(_pSSLContext, isForServerUse() ? SSL_SESS_CACHE_SERVER : SSL_SESS_CACHE_CLIENT);
+		SSL_CTX_set_session_cache_mode(_pSSLContext, isForServerUse() ? serverSessionCacheMode() : SSL_SESS_CACHE_CLIENT);
 	}
 	else
 	{
@@ -309,7 +314,7 @@ void Context::enableSessionCache(bool flag, const std::string& sessionIdContext)
 
 	if (flag)
 	{
-		SSL_CTX_set_session_cache_mode(_pSSLContext, SSL_SESS_CACHE_SERVER);
+		SSL_CTX_set_session_cache_mode(_pSSLContext, serverSessionCacheMode());
 	}
 	else
 	{
@@ -370,6 +375,64 @@ void Context::flushSessionCache()
 }
 
 
+void Context::setSessionCache(SessionCache::Ptr pCache)
+{
+	poco_assert (isForServerUse());
+
+	_pSessionCache = pCache;
+	if (_pSessionCache)
+	{
+		SSL_CTX_sess_set_new_cb(_pSSLContext, &Context::newSessionCallback);
+		SSL_CTX_sess_set_get_cb(_pSSLContext, &Context::getSessionCallback);
+		SSL_CTX_sess_set_remove_cb(_pSSLContext, &Context::removeSessionCallback);
+	}
+	else
+	{
+		SSL_CTX_sess_set_new_cb(_pSSLContext, 0);
+		SSL_CTX_sess_set_get_cb(_pSSLContext, 0);
+		SSL_CTX_sess_set_remove_cb(_pSSLContext, 0);
+	}
+	SSL_CTX_set_session_cache_mode(_pSSLContext, serverSessionCacheMode());
+}
+
+
+void Context::enableSessionTicketKeyRotation(const Poco::Timespan& interval, const std::string& secret)
+{
+	poco_assert (isForServerUse());
+	poco_assert (interval.totalSeconds() > 0);
+
+	_ticketKeyInterval = interval;
+	if (secret.empty())
+	{
+		unsigned char random[32];
+		if (RAND_bytes(random, sizeof(random)) != 1) throw SSLContextException("cannot generate session ticket secret");
+		_ticketKeySecret.assign(reinterpret_cast<const char*>(random), sizeof(random));
+	}
+	else _ticketKeySecret = secret;
+
+#if OPENSSL_VERSION_NUMBER >= 0x30000000L
+	SSL_CTX_set_tlsext_ticket_key_evp_cb(_pSSLContext, &Context::ticketKeyCallback);
+#else
+	SSL_CTX_set_tlsext_ticket_key_cb(_pSSLContext, &Context::ticketKeyCallback);
+#endif
+#if defined(SSL_OP_NO_TICKET)
+	SSL_CTX_clear_options(_pSSLContext, SSL_OP_NO_TICKET);
+#endif
+}
+
+
+Context::SessionStatistics Context::sessionStatistics() const
+{
+	SessionStatistics stats;
+	stats.handshakes = SSL_CTX_sess_accept_good(_pSSLContext);
+	stats.resumed = SSL_CTX_sess_hits(_pSSLContext);
+	stats.misses = SSL_CTX_sess_misses(_pSSLContext);
+	stats.timeouts = SSL_CTX_sess_timeouts(_pSSLContext);
+	stats.cacheHits = SSL_CTX_sess_cb_hits(_pSSLContext);
+	return stats;
+}
+
+
 void Context::enableExtendedCertificateVerification(bool flag)
 {
 	_extendedCertificateVerification = flag;
@@ -502,12 +565,177 @@ void Context::preferServerCiphers()
 }
 
 
+void Context::enableKernelTLS(bool flag)
+{
+#if defined(SSL_OP_ENABLE_KTLS)
+	if (flag)
+		SSL_CTX_set_options(_pSSLContext, SSL_OP_ENABLE_KTLS);
+	else
+		SSL_CTX_clear_options(_pSSLContext, SSL_OP_ENABLE_KTLS);
+#endif
+}
+
+
+bool Context::kernelTLSEnabled() const
+{
+#if defined(SSL_OP_ENABLE_KTLS)
+	return (SSL_CTX_get_options(_pSSLContext) & SSL_OP_ENABLE_KTLS) != 0;
+#else
+	return false;
+#endif
+}
+
+
 void Context::setInvalidCertificateHandler(InvalidCertificateHandlerPtr pInvalidCertificateHandler)
 {
 	_pInvalidCertificateHandler = pInvalidCertificateHandler;
 }
 
 
+int Context::serverSessionCacheMode() const
+{
+	return _pSessionCache ? SSL_SESS_CACHE_SERVER | SSL_SESS_CACHE_NO_INTERNAL : SSL_SESS_CACHE_SERVER;
+}
+
+
+Context* Context::fromSSL(SSL* pSSL)
+{
+	return reinterpret_cast<Context*>(SSL_CTX_get_ex_data(SSL_get_SSL_CTX(pSSL), SSLManager::instance().contextIndex()));
+}
+
+
+int Context::newSessionCallback(SSL* pSSL, SSL_SESSION* pSession)
+{
+	Context* pContext = fromSSL(pSSL);
+	if (!pContext || !pContext->_pSessionCache) return 0;
+
+	unsigned idLength = 0;
+	const unsigned char* pId = SSL_SESSION_get_id(pSession, &idLength);
+	int length = i2d_SSL_SESSION(pSession, 0);
+	if (idLength == 0 || length <= 0) return 0;
+
+	std::string session(length, '\0');
+	unsigned char* p = reinterpret_cast<unsigned char*>(&session[0]);
+	i2d_SSL_SESSION(pSession, &p);
+	Poco::Timestamp expires = Poco::Timestamp::fromEpochTime(SSL_SESSION_get_time(pSession) + SSL_SESSION_get_timeout(pSession));
+	try
+	{
+		pContext->_pSessionCache->add(std::string(reinterpret_cast<const char*>(pId), idLength), session, expires);
+	}
+	catch (...)
+	{
+	}
+	return 0; // we do not keep a reference to the session
+}
+
+
+#if OPENSSL_VERSION_NUMBER >= 0x10100000L
+SSL_SESSION* Context::getSessionCallback(SSL* pSSL, const unsigned char* id, int length, int* pCopy)
+#else
+SSL_SESSION* Context::getSessionCallback(SSL* pSSL, unsigned char* id, int length, int* pCopy)
+#endif
+{
+	*pCopy = 0;
+	Context* pContext = fromSSL(pSSL);
+	if (!pContext || !pContext->_pSessionCache) return 0;
+
+	std::string session;
+	try
+	{
+		if (!pContext->_pSessionCache->get(std::string(reinterpret_cast<const char*>(id), length), session))
+			return 0;
+	}
+	catch (...)
+	{
+		return 0;
+	}
+	const unsigned char* p = reinterpret_cast<const unsigned char*>(session.data());
+	return d2i_SSL_SESSION(0, &p, static_cast<long>(session.size()));
+}
+
+
+void Context::removeSessionCallback(SSL_CTX* pSSLContext, SSL_SESSION* pSession)
+{
+	Context* pContext = reinterpret_cast<Context*>(SSL_CTX_get_ex_data(pSSLContext, SSLManager::instance().contextIndex()));
+	if (!pContext || !pContext->_pSessionCache) return;
+
+	unsigned idLength = 0;
+	const unsigned char* pId = SSL_SESSION_get_id(pSession, &idLength);
+	try
+	{
+		pContext->_pSessionCache->remove(std::string(reinterpret_cast<const char*>(pId), idLength));
+	}
+	catch (...)
+	{
+	}
+}
+
+
+void Context::deriveTicketKeys(Poco::Int64 epoch, unsigned char name[16], unsigned char aesKey[32], unsigned char hmacKey[32]) const
+{
+	static const char* labels[] = {"name", "aes", "hmac"};
+	unsigned char* keys[] = {name, aesKey, hmacKey};
+	const std::size_t sizes[] = {16, 32, 32};
+
+	Poco::Int64 beEpoch = Poco::ByteOrder::toBigEndian(epoch);
+	for (int i = 0; i < 3; i++)
+	{
+		std::string message(labels[i]);
+		message.append(reinterpret_cast<const char*>(&beEpoch), sizeof(beEpoch));
+		unsigned char digest[EVP_MAX_MD_SIZE];
+		unsigned int digestLength = 0;
+		HMAC(EVP_sha256(), _ticketKeySecret.data(), static_cast<int>(_ticketKeySecret.size()),
+			reinterpret_cast<const unsigned char*>(message.data()), message.size(), digest, &digestLength);
+		std::memcpy(keys[i], digest, sizes[i]);
+	}
+}
+
+
+#if OPENSSL_VERSION_NUMBER >= 0x30000000L
+int Context::ticketKeyCallback(SSL* pSSL, unsigned char* name, unsigned char* iv, EVP_CIPHER_CTX* pCipherContext, EVP_MAC_CTX* pMacContext, int encrypt)
+#else
+int Context::ticketKeyCallback(SSL* pSSL, unsigned char* name, unsigned char* iv, EVP_CIPHER_CTX* pCipherContext, HMAC_CTX* pMacContext, int encrypt)
+#endif
+{
+	Context* pContext = fromSSL(pSSL);
+	if (!pContext || pContext->_ticketKeySecret.empty()) return -1;
+
+	Poco::Int64 epoch = Poco::Timestamp().epochMicroseconds()/pContext->_ticketKeyInterval.totalMicroseconds();
+	unsigned char keyName[16];
+	unsigned char aesKey[32];
+	unsigned char hmacKey[32];
+	int rc = 1;
+	if (encrypt)
+	{
+		pContext->deriveTicketKeys(epoch, keyName, aesKey, hmacKey);
+		if (RAND_bytes(iv, EVP_MAX_IV_LENGTH) != 1) return -1;
+		std::memcpy(name, keyName, sizeof(keyName));
+		if (EVP_EncryptInit_ex(pCipherContext, EVP_aes_256_cbc(), 0, aesKey, iv) != 1) return -1;
+	}
+	else
+	{
+		pContext->deriveTicketKeys(epoch, keyName, aesKey, hmacKey);
+		if (std::memcmp(name, keyName, sizeof(keyName)) != 0)
+		{
+			pContext->deriveTicketKeys(epoch - 1, keyName, aesKey, hmacKey);
+			if (std::memcmp(name, keyName, sizeof(keyName)) != 0) return 0; // unknown key, full handshake
+			rc = 2; // valid, but issue a new ticket with the current key
+		}
+		if (EVP_DecryptInit_ex(pCipherContext, EVP_aes_256_cbc(), 0, aesKey, iv) != 1) return -1;
+	}
+#if OPENSSL_VERSION_NUMBER >= 0x30000000L
+	char digestName[] = "SHA256";
+	OSSL_PARAM params[2];
+	params[0] = OSSL_PARAM_construct_utf8_string(OSSL_MAC_PARAM_DIGEST, digestName, 0);
+	params[1] = OSSL_PARAM_construct_end();
+	if (EVP_MAC_init(pMacContext, hmacKey, sizeof(hmacKey), params) != 1) return -1;
+#else
+	if (HMAC_Init_ex(pMacContext, hmacKey, sizeof(hmacKey), EVP_sha256(), 0) != 1) return -1;
+#endif
+	return rc;
+}
+
+
 void Context::createSSLContext()
 {
 	int minTLSVersion = 0;
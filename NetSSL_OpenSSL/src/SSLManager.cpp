@@ -52,6 +52,7 @@ const std::string SSLManager::CFG_CIPHER_LIST("cipherList");
 const std::string SSLManager::CFG_CYPHER_LIST("cypherList");
 const std::string SSLManager::VAL_CIPHER_LIST("ALL:!ADH:!LOW:!EXP:!MD5:@STRENGTH");
 const std::string SSLManager::CFG_PREFER_SERVER_CIPHERS("preferServerCiphers");
+const std::string SSLManager::CFG_KERNEL_TLS("kernelTLS");
 const std::string SSLManager::CFG_DELEGATE_HANDLER("privateKeyPassphraseHandler.name");
 const std::string SSLManager::VAL_DELEGATE_HANDLER("KeyConsoleHandler");
 const std::string SSLManager::CFG_CERTIFICATE_HANDLER("invalidCertificateHandler.name");
@@ -552,6 +553,15 @@ void SSLManager::initDefaultContext(bool server)
 		else
 			_ptrDefaultClientContext->preferServerCiphers();
 	}
+
+	bool kernelTLS = config.getBool(prefix + CFG_KERNEL_TLS, false);
+	if (kernelTLS)
+	{
+		if (server)
+			_ptrDefaultServerContext->enableKernelTLS();
+		else
+			_ptrDefaultClientContext->enableKernelTLS();
+	}
 }
 
 
@@ -26,6 +26,7 @@
 #include "Poco/NumberFormatter.h"
 #include "Poco/NumberParser.h"
 #include "Poco/Format.h"
+#include "Poco/FileStream.h"
 #include <openssl/x509v3.h>
 #include <openssl/err.h>
 
@@ -37,6 +38,11 @@ using Poco::NumberFormatter;
 using Poco::Timespan;
 
 
+#if OPENSSL_VERSION_NUMBER >= 0x30000000L && !defined(OPENSSL_NO_KTLS) && defined(POCO_OS_FAMILY_UNIX)
+#define POCO_HAVE_KTLS 1
+#endif
+
+
 // workaround for C++-incompatible macro
 #define POCO_BIO_set_nbio_accept(b,n) BIO_ctrl(b,BIO_C_SET_ACCEPT,1,(void*)((n)?"a":NULL))
 
@@ -648,4 +654,63 @@ bool SecureSocketImpl::sessionWasReused()
 }
 
 
+bool SecureSocketImpl::kernelTLSSend() const
+{
+#if defined(POCO_HAVE_KTLS)
+	return _pSSL && BIO_get_ktls_send(SSL_get_wbio(_pSSL));
+#else
+	return false;
+#endif
+}
+
+
+bool SecureSocketImpl::kernelTLSReceive() const
+{
+#if defined(POCO_HAVE_KTLS)
+	return _pSSL && BIO_get_ktls_recv(SSL_get_rbio(_pSSL));
+#else
+	return false;
+#endif
+}
+
+
+std::streamsize SecureSocketImpl::sendFile(FileInputStream& fileInputStream, std::streamoff offset, std::streamsize count)
+{
+	poco_check_ptr (_pSSL);
+
+#if defined(POCO_HAVE_KTLS)
+	poco_assert (kernelTLSSend());
+
+	if (count == 0)
+	{
+		Poco::UInt64 size = fileInputStream.size();
+		if (static_cast<Poco::UInt64>(offset) >= size) return 0;
+		count = static_cast<std::streamsize>(size - offset);
+	}
+
+	std::streamsize sent = 0;
+	while (sent < count)
+	{
+		ossl_ssize_t rc;
+		do
+		{
+			rc = SSL_sendfile(_pSSL, fileInputStream.nativeHandle(), static_cast<off_t>(offset + sent), static_cast<std::size_t>(count - sent), 0);
+		}
+		while (rc <= 0 && mustRetry(static_cast<int>(rc)));
+		if (rc <= 0)
+		{
+			if (sent > 0) break;
+			int err = handleError(static_cast<int>(rc));
+			if (err == 0) throw SSLConnectionUnexpectedlyClosedException();
+			return err;
+		}
+		sent += rc;
+	}
+	return sent;
+#else
+	throw Poco::NotImplementedException("SSL_sendfile");
+#endif
+}
+
+
 } } // namespace Poco::Net
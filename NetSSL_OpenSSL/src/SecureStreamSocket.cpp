@@ -129,6 +129,18 @@ bool SecureStreamSocket::havePeerCertificate() const
 }
 
 
+bool SecureStreamSocket::kernelTLSSend() const
+{
+	return static_cast<SecureStreamSocketImpl*>(impl())->kernelTLSSend();
+}
+
+
+bool SecureStreamSocket::kernelTLSReceive() const
+{
+	return static_cast<SecureStreamSocketImpl*>(impl())->kernelTLSReceive();
+}
+
+
 X509Certificate SecureStreamSocket::peerCertificate() const
 {
 	return static_cast<SecureStreamSocketImpl*>(impl())->peerCertificate();
@@ -260,6 +272,12 @@ int SecureStreamSocket::completeHandshake()
 }
 
 
+bool SecureStreamSocket::handshakeCompleted() const
+{
+	return static_cast<SecureStreamSocketImpl*>(impl())->handshakeCompleted();
+}
+
+
 Session::Ptr SecureStreamSocket::currentSession()
 {
 	return static_cast<SecureStreamSocketImpl*>(impl())->currentSession();
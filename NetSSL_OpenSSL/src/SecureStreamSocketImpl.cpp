@@ -127,6 +127,15 @@ int SecureStreamSocketImpl::receiveBytes(void* buffer, int length, int flags)
 }
 
 
+std::streamsize SecureStreamSocketImpl::sendFile(FileInputStream& fileInputStream, std::streamoff offset, std::streamsize count)
+{
+	if (_impl.kernelTLSSend())
+		return _impl.sendFile(fileInputStream, offset, count);
+	else
+		return StreamSocketImpl::sendFile(fileInputStream, offset, count);
+}
+
+
 int SecureStreamSocketImpl::sendTo(const void* buffer, int length, const SocketAddress& address, int flags)
 {
 	throw Poco::InvalidAccessException("Cannot sendTo() on a SecureStreamSocketImpl");
@@ -145,6 +154,19 @@ void SecureStreamSocketImpl::sendUrgent(unsigned char data)
 }
 
 
+void SecureStreamSocketImpl::setBlocking(bool flag)
+{
+	_impl.setBlocking(flag);
+	StreamSocketImpl::setBlocking(flag);
+}
+
+
+bool SecureStreamSocketImpl::getBlocking() const
+{
+	return _impl.getBlocking();
+}
+
+
 int SecureStreamSocketImpl::available()
 {
 	return _impl.available();
@@ -185,6 +207,18 @@ bool SecureStreamSocketImpl::havePeerCertificate() const
 }
 
 
+bool SecureStreamSocketImpl::kernelTLSSend() const
+{
+	return _impl.kernelTLSSend();
+}
+
+
+bool SecureStreamSocketImpl::kernelTLSReceive() const
+{
+	return _impl.kernelTLSReceive();
+}
+
+
 X509Certificate SecureStreamSocketImpl::peerCertificate() const
 {
 	X509* pCert = _impl.peerCertificate();
@@ -0,0 +1,42 @@
+//
+// SessionCache.cpp
+//
+// Library: NetSSL_OpenSSL
+// Package: SSLCore
+// Module:  SessionCache
+//
+// Copyright (c) 2005-2023, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "Poco/Net/SessionCache.h"
+
+
+namespace Poco {
+namespace Net {
+
+
+SessionCache::Statistics::Statistics():
+	hits(0),
+	misses(0),
+	stores(0),
+	evictions(0),
+	size(0)
+{
+}
+
+
+SessionCache::SessionCache()
+{
+}
+
+
+SessionCache::~SessionCache()
+{
+}
+
+
+} } // namespace Poco::Net
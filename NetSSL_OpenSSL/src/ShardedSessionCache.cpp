@@ -0,0 +1,147 @@
+//
+// ShardedSessionCache.cpp
+//
+// Library: NetSSL_OpenSSL
+// Package: SSLCore
+// Module:  ShardedSessionCache
+//
+// Copyright (c) 2005-2023, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "Poco/Net/ShardedSessionCache.h"
+#include "Poco/Exception.h"
+#include <functional>
+
+
+namespace Poco {
+namespace Net {
+
+
+ShardedSessionCache::ShardedSessionCache(std::size_t capacity, std::size_t shards):
+	_shardCapacity(0),
+	_hits(0),
+	_misses(0),
+	_stores(0),
+	_evictions(0)
+{
+	if (shards == 0) throw Poco::InvalidArgumentException("ShardedSessionCache requires at least one shard");
+	if (capacity < shards) capacity = shards;
+
+	_shardCapacity = (capacity + shards - 1)/shards;
+	_shards.reserve(shards);
+	for (std::size_t i = 0; i < shards; i++)
+	{
+		_shards.emplace_back(new Shard);
+	}
+}
+
+
+ShardedSessionCache::~ShardedSessionCache()
+{
+}
+
+
+ShardedSessionCache::Shard& ShardedSessionCache::shardFor(const std::string& id)
+{
+	return *_shards[std::hash<std::string>()(id) % _shards.size()];
+}
+
+
+void ShardedSessionCache::add(const std::string& id, const std::string& session, const Poco::Timestamp& expires)
+{
+	Shard& shard = shardFor(id);
+	std::lock_guard<std::mutex> lock(shard.mutex);
+
+	EntryIndex::iterator it = shard.index.find(id);
+	if (it != shard.index.end())
+	{
+		shard.entries.erase(it->second);
+		shard.index.erase(it);
+	}
+	while (shard.entries.size() >= _shardCapacity)
+	{
+		shard.index.erase(shard.entries.back().id);
+		shard.entries.pop_back();
+		++_evictions;
+	}
+	Entry entry;
+	entry.id = id;
+	entry.session = session;
+	entry.expires = expires;
+	shard.entries.push_front(std::move(entry));
+	shard.index[id] = shard.entries.begin();
+	++_stores;
+}
+
+
+bool ShardedSessionCache::get(const std::string& id, std::string& session)
+{
+	Shard& shard = shardFor(id);
+	std::lock_guard<std::mutex> lock(shard.mutex);
+
+	EntryIndex::iterator it = shard.index.find(id);
+	if (it == shard.index.end())
+	{
+		++_misses;
+		return false;
+	}
+	if (it->second->expires <= Poco::Timestamp())
+	{
+		shard.entries.erase(it->second);
+		shard.index.erase(it);
+		++_misses;
+		return false;
+	}
+	shard.entries.splice(shard.entries.begin(), shard.entries, it->second);
+	session = it->second->session;
+	++_hits;
+	return true;
+}
+
+
+void ShardedSessionCache::remove(const std::string& id)
+{
+	Shard& shard = shardFor(id);
+	std::lock_guard<std::mutex> lock(shard.mutex);
+
+	EntryIndex::iterator it = shard.index.find(id);
+	if (it != shard.index.end())
+	{
+		shard.entries.erase(it->second);
+		shard.index.erase(it);
+	}
+}
+
+
+void ShardedSessionCache::clear()
+{
+	for (auto& pShard: _shards)
+	{
+		std::lock_guard<std::mutex> lock(pShard->mutex);
+		pShard->index.clear();
+		pShard->entries.clear();
+	}
+}
+
+
+SessionCache::Statistics ShardedSessionCache::statistics() const
+{
+	Statistics stats;
+	stats.hits = _hits;
+	stats.misses = _misses;
+	stats.stores = _stores;
+	stats.evictions = _evictions;
+	for (const auto& pShard: _shards)
+	{
+		std::lock_guard<std::mutex> lock(pShard->mutex);
+		stats.size += pShard->entries.size();
+	}
+	return stats;
+}
+
+
+} } // namespace Poco::Net
@@ -0,0 +1,322 @@
+//
+// SharedMemorySessionCache.cpp
+//
+// Library: NetSSL_OpenSSL
+// Package: SSLCore
+// Module:  SharedMemorySessionCache
+//
+// Copyright (c) 2005-2023, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "Poco/Net/SharedMemorySessionCache.h"
+#include "Poco/Exception.h"
+#include "Poco/Thread.h"
+#include <atomic>
+#include <cstring>
+
+
+namespace Poco {
+namespace Net {
+
+
+namespace
+{
+	const Poco::UInt32 CACHE_MAGIC = 0x50534331; // "PSC1"
+
+	enum HeaderState
+	{
+		STATE_EMPTY = 0,
+		STATE_INITIALIZING = 1,
+		STATE_READY = 2
+	};
+
+	const std::size_t HEADER_SIZE = 64;
+	const std::size_t BUCKET_HEADER_SIZE = 8;
+
+	std::size_t align8(std::size_t n)
+	{
+		return (n + 7) & ~std::size_t(7);
+	}
+
+	Poco::UInt32 fnv1a(const std::string& s)
+		/// Returns the 32-bit FNV-1a hash of the given string.
+		/// Unlike std::hash, it is the same in all processes
+		/// sharing the cache, regardless of how they were built.
+	{
+		Poco::UInt32 hash = 2166136261U;
+		for (unsigned char c: s)
+		{
+			hash ^= c;
+			hash *= 16777619U;
+		}
+		return hash;
+	}
+}
+
+
+struct SharedMemorySessionCache::Header
+{
+	std::atomic<Poco::UInt32> state;
+	Poco::UInt32 magic;
+	Poco::UInt32 buckets;
+	Poco::UInt32 slotSize;
+	std::atomic<Poco::UInt64> hits;
+	std::atomic<Poco::UInt64> misses;
+	std::atomic<Poco::UInt64> stores;
+	std::atomic<Poco::UInt64> evictions;
+};
+
+
+struct SharedMemorySessionCache::Slot
+{
+	Poco::UInt32 idLength; // 0 if the slot is empty
+	Poco::UInt32 sessionLength;
+	Poco::Int64  expires;
+	Poco::Int64  lastUsed;
+	char id[MAX_ID_LENGTH];
+	// followed by the serialized session
+};
+
+
+SharedMemorySessionCache::SharedMemorySessionCache(const std::string& name, std::size_t slots, std::size_t maxSessionSize, bool owner):
+	_buckets((slots + WAYS - 1)/WAYS),
+	_maxSessionSize(maxSessionSize),
+	_slotSize(align8(sizeof(Slot) + maxSessionSize)),
+	_bucketSize(BUCKET_HEADER_SIZE + WAYS*_slotSize),
+	_memory(name, segmentSize(_buckets, _slotSize), Poco::SharedMemory::AM_WRITE, 0, owner)
+{
+	static_assert(sizeof(Header) <= HEADER_SIZE, "SharedMemorySessionCache header too large");
+	static_assert(sizeof(std::atomic<Poco::UInt32>) == sizeof(Poco::UInt32), "atomic must not add state");
+
+	if (_buckets == 0) throw Poco::InvalidArgumentException("SharedMemorySessionCache requires at least one slot");
+
+	Header* pHeader = header();
+	Poco::UInt32 state = STATE_EMPTY;
+	if (owner && pHeader->state.compare_exchange_strong(state, STATE_INITIALIZING))
+	{
+		pHeader->magic = CACHE_MAGIC;
+		pHeader->buckets = static_cast<Poco::UInt32>(_buckets);
+		pHeader->slotSize = static_cast<Poco::UInt32>(_slotSize);
+		pHeader->hits = 0;
+		pHeader->misses = 0;
+		pHeader->stores = 0;
+		pHeader->evictions = 0;
+		pHeader->state.store(STATE_READY, std::memory_order_release);
+	}
+	else
+	{
+		int retries = 1000;
+		while (pHeader->state.load(std::memory_order_acquire) != STATE_READY && --retries > 0)
+		{
+			Poco::Thread::sleep(1);
+		}
+		if (retries == 0) throw Poco::TimeoutException("SharedMemorySessionCache not initialized", name);
+	}
+	if (pHeader->magic != CACHE_MAGIC || pHeader->buckets != _buckets || pHeader->slotSize != _slotSize)
+		throw Poco::DataFormatException("SharedMemorySessionCache has different geometry", name);
+}
+
+
+SharedMemorySessionCache::~SharedMemorySessionCache()
+{
+}
+
+
+std::size_t SharedMemorySessionCache::segmentSize(std::size_t buckets, std::size_t slotSize)
+{
+	return HEADER_SIZE + buckets*(BUCKET_HEADER_SIZE + WAYS*slotSize);
+}
+
+
+SharedMemorySessionCache::Header* SharedMemorySessionCache::header() const
+{
+	return reinterpret_cast<Header*>(_memory.begin());
+}
+
+
+char* SharedMemorySessionCache::bucket(std::size_t index) const
+{
+	return _memory.begin() + HEADER_SIZE + index*_bucketSize;
+}
+
+
+SharedMemorySessionCache::Slot* SharedMemorySessionCache::slot(char* pBucket, int way) const
+{
+	return reinterpret_cast<Slot*>(pBucket + BUCKET_HEADER_SIZE + way*_slotSize);
+}
+
+
+char* SharedMemorySessionCache::bucketFor(const std::string& id) const
+{
+	return bucket(fnv1a(id) % _buckets);
+}
+
+
+void SharedMemorySessionCache::lock(char* pBucket)
+{
+	std::atomic<Poco::UInt32>* pLock = reinterpret_cast<std::atomic<Poco::UInt32>*>(pBucket);
+	int spins = 0;
+	Poco::UInt32 expected = 0;
+	while (!pLock->compare_exchange_weak(expected, 1, std::memory_order_acquire))
+	{
+		expected = 0;
+		if (++spins > 64)
+		{
+			Poco::Thread::yield();
+			spins = 0;
+		}
+	}
+}
+
+
+void SharedMemorySessionCache::unlock(char* pBucket)
+{
+	reinterpret_cast<std::atomic<Poco::UInt32>*>(pBucket)->store(0, std::memory_order_release);
+}
+
+
+void SharedMemorySessionCache::add(const std::string& id, const std::string& session, const Poco::Timestamp& expires)
+{
+	if (id.empty() || id.size() > MAX_ID_LENGTH || session.size() > _maxSessionSize) return;
+
+	Poco::Int64 now = Poco::Timestamp().epochMicroseconds();
+	char* pBucket = bucketFor(id);
+	lock(pBucket);
+	Slot* pVictim = 0;
+	bool evicted = false;
+	for (int i = 0; i < WAYS; i++)
+	{
+		Slot* pSlot = slot(pBucket, i);
+		if (pSlot->idLength == id.size() && std::memcmp(pSlot->id, id.data(), id.size()) == 0)
+		{
+			pVictim = pSlot;
+			evicted = false;
+			break;
+		}
+		if (pSlot->idLength == 0 || pSlot->expires <= now)
+		{
+			if (!pVictim || pVictim->idLength != 0) pVictim = pSlot;
+			evicted = false;
+		}
+		else if (!pVictim || (evicted && pSlot->lastUsed < pVictim->lastUsed))
+		{
+			pVictim = pSlot;
+			evicted = true;
+		}
+	}
+	pVictim->idLength = static_cast<Poco::UInt32>(id.size());
+	pVictim->sessionLength = static_cast<Poco::UInt32>(session.size());
+	pVictim->expires = expires.epochMicroseconds();
+	pVictim->lastUsed = now;
+	std::memcpy(pVictim->id, id.data(), id.size());
+	std::memcpy(reinterpret_cast<char*>(pVictim) + sizeof(Slot), session.data(), session.size());
+	unlock(pBucket);
+
+	Header* pHeader = header();
+	++pHeader->stores;
+	if (evicted) ++pHeader->evictions;
+}
+
+
+bool SharedMemorySessionCache::get(const std::string& id, std::string& session)
+{
+	Header* pHeader = header();
+	if (id.empty() || id.size() > MAX_ID_LENGTH)
+	{
+		++pHeader->misses;
+		return false;
+	}
+
+	Poco::Int64 now = Poco::Timestamp().epochMicroseconds();
+	bool found = false;
+	char* pBucket = bucketFor(id);
+	lock(pBucket);
+	for (int i = 0; i < WAYS; i++)
+	{
+		Slot* pSlot = slot(pBucket, i);
+		if (pSlot->idLength == id.size() && std::memcmp(pSlot->id, id.data(), id.size()) == 0)
+		{
+			if (pSlot->expires > now)
+			{
+				pSlot->lastUsed = now;
+				session.assign(reinterpret_cast<const char*>(pSlot) + sizeof(Slot), pSlot->sessionLength);
+				found = true;
+			}
+			else pSlot->idLength = 0;
+			break;
+		}
+	}
+	unlock(pBucket);
+
+	if (found)
+		++pHeader->hits;
+	else
+		++pHeader->misses;
+	return found;
+}
+
+
+void SharedMemorySessionCache::remove(const std::string& id)
+{
+	if (id.empty() || id.size() > MAX_ID_LENGTH) return;
+
+	char* pBucket = bucketFor(id);
+	lock(pBucket);
+	for (int i = 0; i < WAYS; i++)
+	{
+		Slot* pSlot = slot(pBucket, i);
+		if (pSlot->idLength == id.size() && std::memcmp(pSlot->id, id.data(), id.size()) == 0)
+		{
+			pSlot->idLength = 0;
+			break;
+		}
+	}
+	unlock(pBucket);
+}
+
+
+void SharedMemorySessionCache::clear()
+{
+	for (std::size_t b = 0; b < _buckets; b++)
+	{
+		char* pBucket = bucket(b);
+		lock(pBucket);
+		for (int i = 0; i < WAYS; i++)
+		{
+			slot(pBucket, i)->idLength = 0;
+		}
+		unlock(pBucket);
+	}
+}
+
+
+SessionCache::Statistics SharedMemorySessionCache::statistics() const
+{
+	Header* pHeader = header();
+	Statistics stats;
+	stats.hits = pHeader->hits;
+	stats.misses = pHeader->misses;
+	stats.stores = pHeader->stores;
+	stats.evictions = pHeader->evictions;
+
+	Poco::Int64 now = Poco::Timestamp().epochMicroseconds();
+	for (std::size_t b = 0; b < _buckets; b++)
+	{
+		char* pBucket = bucket(b);
+		lock(pBucket);
+		for (int i = 0; i < WAYS; i++)
+		{
+			const Slot* pSlot = slot(pBucket, i);
+			if (pSlot->idLength != 0 && pSlot->expires > now) stats.size++;
+		}
+		unlock(pBucket);
+	}
+	return stats;
+}
+
+
+} } // namespace Poco::Net
@@ -21,7 +21,11 @@
 #include "Poco/Net/HTTPResponse.h"
 #include "Poco/Net/HTTPServerResponse.h"
 #include "Poco/Net/SecureServerSocket.h"
+#include "Poco/Net/SSLManager.h"
+#include "Poco/Net/Context.h"
 #include "Poco/StreamCopier.h"
+#include "Poco/TemporaryFile.h"
+#include "Poco/FileStream.h"
 #include <sstream>
 
 
@@ -36,7 +40,10 @@ using Poco::Net::HTTPResponse;
 using Poco::Net::HTTPServerResponse;
 using Poco::Net::HTTPMessage;
 using Poco::Net::SecureServerSocket;
+using Poco::Net::SSLManager;
+using Poco::Net::Context;
 using Poco::StreamCopier;
+using Poco::TemporaryFile;
 
 
 namespace
@@ -93,6 +100,17 @@ namespace
 		}
 	};
 
+	std::string filePath;
+
+	class FileRequestHandler: public HTTPRequestHandler
+	{
+	public:
+		void handleRequest(HTTPServerRequest& /*request*/, HTTPServerResponse& response)
+		{
+			response.sendFile(filePath, "application/octet-stream");
+		}
+	};
+
 	class RequestHandlerFactory: public HTTPRequestHandlerFactory
 	{
 	public:
@@ -106,6 +124,8 @@ namespace
 				return new RedirectRequestHandler();
 			else if (request.getURI() == "/auth")
 				return new AuthRequestHandler();
+			else if (request.getURI() == "/file")
+				return new FileRequestHandler();
 			else
 				return 0;
 		}
@@ -322,6 +342,48 @@ void HTTPSServerTest::testNotImpl()
 }
 
 
+void HTTPSServerTest::testSendFileKernelTLS()
+{
+	TemporaryFile file;
+	std::string content;
+	for (int i = 0; i < 200000; ++i) content += static_cast<char>('a' + i % 26);
+	{
+		Poco::FileOutputStream ostr(file.path());
+		ostr << content;
+	}
+	filePath = file.path();
+
+	Context::Ptr pContext = SSLManager::instance().defaultServerContext();
+	pContext->enableKernelTLS();
+	try
+	{
+		SecureServerSocket svs(0);
+		HTTPServerParams* pParams = new HTTPServerParams;
+		pParams->setKeepAlive(false);
+		HTTPServer srv(new RequestHandlerFactory, svs, pParams);
+		srv.start();
+
+		// the file must be received intact, whether or not
+		// the kernel supports TLS offload
+		HTTPSClientSession cs("127.0.0.1", svs.address().port());
+		HTTPRequest request("GET", "/file");
+		cs.sendRequest(request);
+		HTTPResponse response;
+		std::string rbody;
+		StreamCopier::copyToString(cs.receiveResponse(response), rbody);
+		assertTrue (response.getStatus() == HTTPResponse::HTTP_OK);
+		assertTrue (response.getContentLength() == static_cast<std::streamsize>(content.size()));
+		assertTrue (rbody == content);
+	}
+	catch (...)
+	{
+		pContext->enableKernelTLS(false);
+		throw;
+	}
+	pContext->enableKernelTLS(false);
+}
+
+
 void HTTPSServerTest::setUp()
 {
 }
@@ -344,6 +406,7 @@ CppUnit::Test* HTTPSServerTest::suite()
 	CppUnit_addTest(pSuite, HTTPSServerTest, testRedirect);
 	CppUnit_addTest(pSuite, HTTPSServerTest, testAuth);
 	CppUnit_addTest(pSuite, HTTPSServerTest, testNotImpl);
+	CppUnit_addTest(pSuite, HTTPSServerTest, testSendFileKernelTLS);
 
 	return pSuite;
 }
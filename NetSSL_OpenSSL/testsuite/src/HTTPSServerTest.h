@@ -32,6 +32,7 @@ public:
 	void testRedirect();
 	void testAuth();
 	void testNotImpl();
+	void testSendFileKernelTLS();
 
 	void setUp();
 	void tearDown();
@@ -10,6 +10,7 @@
 
 #include "HTTPSServerTestSuite.h"
 #include "HTTPSServerTest.h"
+#include "SessionCacheTest.h"
 
 
 CppUnit::Test* HTTPSServerTestSuite::suite()
@@ -17,6 +18,7 @@ CppUnit::Test* HTTPSServerTestSuite::suite()
 	CppUnit::TestSuite* pSuite = new CppUnit::TestSuite("HTTPSServerTestSuite");
 
 	pSuite->addTest(HTTPSServerTest::suite());
+	pSuite->addTest(SessionCacheTest::suite());
 
 	return pSuite;
 }
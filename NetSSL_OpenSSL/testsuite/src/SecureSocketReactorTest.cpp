@@ -0,0 +1,235 @@
+//
+// SecureSocketReactorTest.cpp
+//
+// Copyright (c) 2005-2023, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "SecureSocketReactorTest.h"
+#include "CppUnit/TestCaller.h"
+#include "CppUnit/TestSuite.h"
+#include "Poco/Net/SecureHandshakeHandler.h"
+#include "Poco/Net/SecureServerSocket.h"
+#include "Poco/Net/SecureStreamSocket.h"
+#include "Poco/Net/SocketAcceptor.h"
+#include "Poco/Net/SocketReactor.h"
+#include "Poco/Net/SocketNotification.h"
+#include "Poco/Net/NetException.h"
+#include "Poco/Observer.h"
+#include "Poco/Thread.h"
+#include "Poco/Stopwatch.h"
+#include <atomic>
+
+
+using Poco::Net::SecureHandshakeHandler;
+using Poco::Net::SecureServerSocket;
+using Poco::Net::SecureStreamSocket;
+using Poco::Net::StreamSocket;
+using Poco::Net::SocketAddress;
+using Poco::Net::SocketAcceptor;
+using Poco::Net::SocketReactor;
+using Poco::Net::ReadableNotification;
+using Poco::Observer;
+using Poco::Thread;
+using Poco::Timespan;
+
+
+namespace
+{
+	std::atomic<int> handlerCount(0);
+
+	class EchoServiceHandler
+	{
+	public:
+		EchoServiceHandler(const StreamSocket& socket, SocketReactor& reactor):
+			_socket(socket),
+			_reactor(reactor)
+		{
+			++handlerCount;
+			_reactor.addEventHandler(_socket, Observer<EchoServiceHandler, ReadableNotification>(*this, &EchoServiceHandler::onReadable));
+		}
+
+		~EchoServiceHandler()
+		{
+			_reactor.removeEventHandler(_socket, Observer<EchoServiceHandler, ReadableNotification>(*this, &EchoServiceHandler::onReadable));
+		}
+
+		void onReadable(ReadableNotification* pNf)
+		{
+			pNf->release();
+			char buffer[256];
+			int n = 0;
+			try
+			{
+				n = _socket.receiveBytes(buffer, sizeof(buffer));
+				if (n > 0) _socket.sendBytes(buffer, n);
+			}
+			catch (Poco::Exception&)
+			{
+				n = 0;
+			}
+			if (n <= 0) delete this;
+		}
+
+	private:
+		StreamSocket   _socket;
+		SocketReactor& _reactor;
+	};
+
+	typedef SecureHandshakeHandler<EchoServiceHandler> SecureEchoServiceHandler;
+
+	std::string echo(Poco::UInt16 port, const std::string& message)
+	{
+		SecureStreamSocket socket(SocketAddress("127.0.0.1", port));
+		socket.setReceiveTimeout(Timespan(10, 0));
+		socket.sendBytes(message.data(), static_cast<int>(message.size()));
+		char buffer[256];
+		int n = socket.receiveBytes(buffer, sizeof(buffer));
+		socket.close();
+		return std::string(buffer, n > 0 ? n : 0);
+	}
+
+	bool closedByPeer(StreamSocket& socket)
+	{
+		try
+		{
+			char buffer[256];
+			int n = socket.receiveBytes(buffer, sizeof(buffer));
+			while (n > 0) n = socket.receiveBytes(buffer, sizeof(buffer));
+			return true;
+		}
+		catch (Poco::TimeoutException&)
+		{
+			return false;
+		}
+		catch (Poco::Net::NetException&)
+		{
+			return true;
+		}
+	}
+}
+
+
+SecureSocketReactorTest::SecureSocketReactorTest(const std::string& name): CppUnit::TestCase(name)
+{
+}
+
+
+SecureSocketReactorTest::~SecureSocketReactorTest()
+{
+}
+
+
+void SecureSocketReactorTest::testHandshake()
+{
+	SecureServerSocket ss(0);
+	SocketReactor reactor;
+	SocketAcceptor<SecureEchoServiceHandler> acceptor(ss, reactor);
+	Thread thread;
+	thread.start(reactor);
+
+	handlerCount = 0;
+	assertTrue (echo(ss.address().port(), "hello") == "hello");
+	assertTrue (echo(ss.address().port(), "world") == "world");
+	assertTrue (handlerCount == 2);
+
+	reactor.stop();
+	thread.join();
+}
+
+
+void SecureSocketReactorTest::testSlowClient()
+{
+	SecureServerSocket ss(0);
+	SocketReactor reactor;
+	SocketAcceptor<SecureEchoServiceHandler> acceptor(ss, reactor);
+	Thread thread;
+	thread.start(reactor);
+
+	// a client that connects, but never starts the handshake,
+	// must not prevent other connections from being served
+	StreamSocket slow(SocketAddress("127.0.0.1", ss.address().port()));
+	Thread::sleep(200);
+
+	Poco::Stopwatch sw;
+	sw.start();
+	assertTrue (echo(ss.address().port(), "hello") == "hello");
+	assertTrue (sw.elapsedSeconds() < 5);
+
+	slow.close();
+	reactor.stop();
+	thread.join();
+}
+
+
+void SecureSocketReactorTest::testHandshakeFailure()
+{
+	SecureServerSocket ss(0);
+	SocketReactor reactor;
+	SocketAcceptor<SecureEchoServiceHandler> acceptor(ss, reactor);
+	Thread thread;
+	thread.start(reactor);
+
+	handlerCount = 0;
+	StreamSocket plain(SocketAddress("127.0.0.1", ss.address().port()));
+	plain.setReceiveTimeout(Timespan(10, 0));
+	std::string request("GET / HTTP/1.0\r\n\r\n");
+	plain.sendBytes(request.data(), static_cast<int>(request.size()));
+	assertTrue (closedByPeer(plain));
+	assertTrue (handlerCount == 0);
+
+	assertTrue (echo(ss.address().port(), "hello") == "hello");
+	assertTrue (handlerCount == 1);
+
+	reactor.stop();
+	thread.join();
+}
+
+
+void SecureSocketReactorTest::testHandshakeTimeout()
+{
+	SecureServerSocket ss(0);
+	ss.setReceiveTimeout(Timespan(1, 0));
+	SocketReactor reactor(Timespan(0, 100000));
+	SocketAcceptor<SecureEchoServiceHandler> acceptor(ss, reactor);
+	Thread thread;
+	thread.start(reactor);
+
+	handlerCount = 0;
+	StreamSocket silent(SocketAddress("127.0.0.1", ss.address().port()));
+	silent.setReceiveTimeout(Timespan(10, 0));
+	Poco::Stopwatch sw;
+	sw.start();
+	assertTrue (closedByPeer(silent));
+	assertTrue (sw.elapsedSeconds() < 5);
+	assertTrue (handlerCount == 0);
+
+	reactor.stop();
+	thread.join();
+}
+
+
+void SecureSocketReactorTest::setUp()
+{
+}
+
+
+void SecureSocketReactorTest::tearDown()
+{
+}
+
+
+CppUnit::Test* SecureSocketReactorTest::suite()
+{
+	CppUnit::TestSuite* pSuite = new CppUnit::TestSuite("SecureSocketReactorTest");
+
+	CppUnit_addTest(pSuite, SecureSocketReactorTest, testHandshake);
+	CppUnit_addTest(pSuite, SecureSocketReactorTest, testSlowClient);
+	CppUnit_addTest(pSuite, SecureSocketReactorTest, testHandshakeFailure);
+	CppUnit_addTest(pSuite, SecureSocketReactorTest, testHandshakeTimeout);
+
+	return pSuite;
+}
@@ -0,0 +1,41 @@
+//
+// SecureSocketReactorTest.h
+//
+// Definition of the SecureSocketReactorTest class.
+//
+// Copyright (c) 2005-2023, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef SecureSocketReactorTest_INCLUDED
+#define SecureSocketReactorTest_INCLUDED
+
+
+#include "Poco/Net/Net.h"
+#include "CppUnit/TestCase.h"
+
+
+class SecureSocketReactorTest: public CppUnit::TestCase
+{
+public:
+	SecureSocketReactorTest(const std::string& name);
+	~SecureSocketReactorTest();
+
+	void testHandshake();
+	void testSlowClient();
+	void testHandshakeFailure();
+	void testHandshakeTimeout();
+
+	void setUp();
+	void tearDown();
+
+	static CppUnit::Test* suite();
+
+private:
+};
+
+
+#endif // SecureSocketReactorTest_INCLUDED
@@ -0,0 +1,303 @@
+//
+// SessionCacheTest.cpp
+//
+// Copyright (c) 2005-2023, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "SessionCacheTest.h"
+#include "CppUnit/TestCaller.h"
+#include "CppUnit/TestSuite.h"
+#include "Poco/Net/ShardedSessionCache.h"
+#include "Poco/Net/SharedMemorySessionCache.h"
+#include "Poco/Net/SecureStreamSocket.h"
+#include "Poco/Net/Context.h"
+#include "Poco/Net/Session.h"
+#include "Poco/Net/SSLManager.h"
+#include "Poco/Util/Application.h"
+#include "Poco/Util/AbstractConfiguration.h"
+#include "Poco/Process.h"
+#include "Poco/NumberFormatter.h"
+#include "HTTPSTestServer.h"
+
+
+using namespace Poco::Net;
+using Poco::Util::Application;
+using Poco::Timestamp;
+using Poco::Timespan;
+
+
+namespace
+{
+	Context::Ptr createServerContext()
+	{
+		return new Context(
+			Context::SERVER_USE,
+			Application::instance().config().getString("openSSL.server.privateKeyFile"),
+			Application::instance().config().getString("openSSL.server.privateKeyFile"),
+			Application::instance().config().getString("openSSL.server.caConfig"),
+			Context::VERIFY_NONE,
+			9,
+			true,
+			"ALL:!ADH:!LOW:!EXP:!MD5:@STRENGTH");
+	}
+
+	Context::Ptr createClientContext()
+	{
+		Context::Ptr pContext = new Context(
+			Context::CLIENT_USE,
+			Application::instance().config().getString("openSSL.client.privateKeyFile"),
+			Application::instance().config().getString("openSSL.client.privateKeyFile"),
+			Application::instance().config().getString("openSSL.client.caConfig"),
+			Context::VERIFY_RELAXED,
+			9,
+			true,
+			"ALL:!ADH:!LOW:!EXP:!MD5:@STRENGTH");
+		pContext->enableSessionCache(true);
+		return pContext;
+	}
+
+	Session::Ptr request(Poco::UInt16 port, Context::Ptr pContext, Session::Ptr pSession, bool& reused)
+		/// Performs a request and returns the session, which
+		/// is complete once the response has been received.
+	{
+		SecureStreamSocket socket(SocketAddress("127.0.0.1", port), pContext, pSession);
+		std::string request("GET /small HTTP/1.1\r\nHost: localhost\r\n\r\n");
+		socket.sendBytes(request.data(), static_cast<int>(request.size()));
+		std::string response;
+		char buffer[256];
+		int n = 0;
+		do
+		{
+			n = socket.receiveBytes(buffer, sizeof(buffer));
+			if (n > 0) response.append(buffer, n);
+		}
+		while (n > 0 && response.find(HTTPSTestServer::SMALL_BODY) == std::string::npos);
+		reused = socket.sessionWasReused();
+		Session::Ptr pNewSession = socket.currentSession();
+		socket.close();
+		return pNewSession;
+	}
+}
+
+
+SessionCacheTest::SessionCacheTest(const std::string& name): CppUnit::TestCase(name)
+{
+}
+
+
+SessionCacheTest::~SessionCacheTest()
+{
+}
+
+
+void SessionCacheTest::testShardedSessionCache()
+{
+	ShardedSessionCache::Ptr pCache = new ShardedSessionCache(64, 4);
+	assertTrue (pCache->shards() == 4);
+	assertTrue (pCache->capacity() == 64);
+
+	Timestamp expires;
+	expires += Timespan(60, 0);
+	pCache->add("id1", "session1", expires);
+	pCache->add("id2", "session2", expires);
+
+	std::string session;
+	assertTrue (pCache->get("id1", session));
+	assertTrue (session == "session1");
+	assertTrue (pCache->get("id2", session));
+	assertTrue (session == "session2");
+	assertTrue (!pCache->get("id3", session));
+
+	pCache->add("id1", "session1a", expires);
+	assertTrue (pCache->get("id1", session));
+	assertTrue (session == "session1a");
+
+	pCache->remove("id1");
+	assertTrue (!pCache->get("id1", session));
+
+	pCache->add("expired", "session", Timestamp() - Timespan(1, 0));
+	assertTrue (!pCache->get("expired", session));
+
+	SessionCache::Statistics stats = pCache->statistics();
+	assertTrue (stats.hits == 3);
+	assertTrue (stats.misses == 3);
+	assertTrue (stats.stores == 4);
+	assertTrue (stats.evictions == 0);
+	assertTrue (stats.size == 1);
+
+	pCache->clear();
+	assertTrue (pCache->statistics().size == 0);
+}
+
+
+void SessionCacheTest::testShardedSessionCacheEviction()
+{
+	ShardedSessionCache::Ptr pCache = new ShardedSessionCache(3, 1);
+
+	Timestamp expires;
+	expires += Timespan(60, 0);
+	pCache->add("id1", "session1", expires);
+	pCache->add("id2", "session2", expires);
+	pCache->add("id3", "session3", expires);
+
+	std::string session;
+	assertTrue (pCache->get("id1", session));
+
+	pCache->add("id4", "session4", expires);
+	assertTrue (!pCache->get("id2", session));
+	assertTrue (pCache->get("id1", session));
+	assertTrue (pCache->get("id3", session));
+	assertTrue (pCache->get("id4", session));
+
+	SessionCache::Statistics stats = pCache->statistics();
+	assertTrue (stats.evictions == 1);
+	assertTrue (stats.size == 3);
+}
+
+
+void SessionCacheTest::testSharedMemorySessionCache()
+{
+	std::string name("PocoSessionCacheTest");
+	name += Poco::NumberFormatter::format(Poco::Process::id());
+
+	SharedMemorySessionCache::Ptr pOwner = new SharedMemorySessionCache(name, 64, 256, true);
+	SharedMemorySessionCache::Ptr pOther = new SharedMemorySessionCache(name, 64, 256, false);
+	assertTrue (pOwner->slots() == 64);
+
+	Timestamp expires;
+	expires += Timespan(60, 0);
+	pOwner->add("id1", "session1", expires);
+	pOther->add("id2", "session2", expires);
+	pOwner->add("toolong", std::string(257, 'x'), expires);
+	pOwner->add("expired", "session", Timestamp() - Timespan(1, 0));
+
+	std::string session;
+	assertTrue (pOther->get("id1", session));
+	assertTrue (session == "session1");
+	assertTrue (pOwner->get("id2", session));
+	assertTrue (session == "session2");
+	assertTrue (!pOwner->get("toolong", session));
+	assertTrue (!pOwner->get("expired", session));
+
+	pOther->remove("id1");
+	assertTrue (!pOwner->get("id1", session));
+
+	SessionCache::Statistics stats = pOwner->statistics();
+	assertTrue (stats.hits == 2);
+	assertTrue (stats.misses == 3);
+	assertTrue (stats.stores == 3);
+	assertTrue (stats.size == 1);
+
+	for (int i = 0; i < 1000; i++)
+	{
+		pOwner->add("session" + Poco::NumberFormatter::format(i), "data", expires);
+	}
+	stats = pOther->statistics();
+	assertTrue (stats.size == 64);
+	assertTrue (stats.evictions > 0);
+
+	try
+	{
+		SharedMemorySessionCache::Ptr pWrong = new SharedMemorySessionCache(name, 128, 256, false);
+		fail("different geometry - must throw");
+	}
+	catch (Poco::DataFormatException&)
+	{
+	}
+}
+
+
+void SessionCacheTest::testServerSessionCache()
+{
+	// ensure OpenSSL machinery is fully setup
+	Context::Ptr pDefaultServerContext = SSLManager::instance().defaultServerContext();
+	Context::Ptr pDefaultClientContext = SSLManager::instance().defaultClientContext();
+
+	ShardedSessionCache::Ptr pCache = new ShardedSessionCache;
+	Context::Ptr pServerContext = createServerContext();
+	pServerContext->enableSessionCache(true, "TestSuite");
+	pServerContext->disableStatelessSessionResumption();
+	pServerContext->setSessionCache(pCache);
+	assertTrue (pServerContext->getSessionCache().get() == pCache.get());
+	assertTrue (pServerContext->sessionCacheEnabled());
+
+	HTTPSTestServer srv(pServerContext);
+	Context::Ptr pClientContext = createClientContext();
+
+	bool reused = false;
+	Session::Ptr pSession = request(srv.port(), pClientContext, 0, reused);
+	assertTrue (!reused);
+	assertTrue (!pSession.isNull());
+	assertTrue (pCache->statistics().stores > 0);
+
+	request(srv.port(), pClientContext, pSession, reused);
+	assertTrue (reused);
+
+	SessionCache::Statistics stats = pCache->statistics();
+	assertTrue (stats.hits > 0);
+
+	Context::SessionStatistics serverStats = pServerContext->sessionStatistics();
+	assertTrue (serverStats.handshakes == 2);
+	assertTrue (serverStats.resumed == 1);
+	assertTrue (serverStats.cacheHits == 1);
+}
+
+
+void SessionCacheTest::testSessionTicketKeyRotation()
+{
+	// ensure OpenSSL machinery is fully setup
+	Context::Ptr pDefaultServerContext = SSLManager::instance().defaultServerContext();
+	Context::Ptr pDefaultClientContext = SSLManager::instance().defaultClientContext();
+
+	Context::Ptr pServerContext1 = createServerContext();
+	pServerContext1->enableSessionTicketKeyRotation(Timespan(3600, 0), "secret");
+	Context::Ptr pServerContext2 = createServerContext();
+	pServerContext2->enableSessionTicketKeyRotation(Timespan(3600, 0), "secret");
+	Context::Ptr pServerContext3 = createServerContext();
+	pServerContext3->enableSessionTicketKeyRotation(Timespan(3600, 0), "other secret");
+
+	HTTPSTestServer srv1(pServerContext1);
+	HTTPSTestServer srv2(pServerContext2);
+	HTTPSTestServer srv3(pServerContext3);
+	Context::Ptr pClientContext = createClientContext();
+
+	bool reused = false;
+	Session::Ptr pSession = request(srv1.port(), pClientContext, 0, reused);
+	assertTrue (!reused);
+
+	request(srv2.port(), pClientContext, pSession, reused);
+	assertTrue (reused);
+	assertTrue (pServerContext2->sessionStatistics().resumed == 1);
+
+	request(srv3.port(), pClientContext, pSession, reused);
+	assertTrue (!reused);
+	assertTrue (pServerContext3->sessionStatistics().resumed == 0);
+}
+
+
+void SessionCacheTest::setUp()
+{
+}
+
+
+void SessionCacheTest::tearDown()
+{
+}
+
+
+CppUnit::Test* SessionCacheTest::suite()
+{
+	CppUnit::TestSuite* pSuite = new CppUnit::TestSuite("SessionCacheTest");
+
+	CppUnit_addTest(pSuite, SessionCacheTest, testShardedSessionCache);
+	CppUnit_addTest(pSuite, SessionCacheTest, testShardedSessionCacheEviction);
+	CppUnit_addTest(pSuite, SessionCacheTest, testSharedMemorySessionCache);
+	CppUnit_addTest(pSuite, SessionCacheTest, testServerSessionCache);
+	CppUnit_addTest(pSuite, SessionCacheTest, testSessionTicketKeyRotation);
+
+	return pSuite;
+}
@@ -0,0 +1,42 @@
+//
+// SessionCacheTest.h
+//
+// Definition of the SessionCacheTest class.
+//
+// Copyright (c) 2005-2023, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef SessionCacheTest_INCLUDED
+#define SessionCacheTest_INCLUDED
+
+
+#include "Poco/Net/Net.h"
+#include "CppUnit/TestCase.h"
+
+
+class SessionCacheTest: public CppUnit::TestCase
+{
+public:
+	SessionCacheTest(const std::string& name);
+	~SessionCacheTest();
+
+	void testShardedSessionCache();
+	void testShardedSessionCacheEviction();
+	void testSharedMemorySessionCache();
+	void testServerSessionCache();
+	void testSessionTicketKeyRotation();
+
+	void setUp();
+	void tearDown();
+
+	static CppUnit::Test* suite();
+
+private:
+};
+
+
+#endif // SessionCacheTest_INCLUDED
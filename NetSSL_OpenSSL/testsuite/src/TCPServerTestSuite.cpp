@@ -10,6 +10,7 @@
 
 #include "TCPServerTestSuite.h"
 #include "TCPServerTest.h"
+#include "SecureSocketReactorTest.h"
 
 
 CppUnit::Test* TCPServerTestSuite::suite()
@@ -17,6 +18,7 @@ CppUnit::Test* TCPServerTestSuite::suite()
 	CppUnit::TestSuite* pSuite = new CppUnit::TestSuite("TCPServerTestSuite");
 
 	pSuite->addTest(TCPServerTest::suite());
+	pSuite->addTest(SecureSocketReactorTest::suite());
 
 	return pSuite;
 }